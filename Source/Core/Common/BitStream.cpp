@@ -4,6 +4,29 @@
 namespace Plasma
 {
 
+// Bits are stored most significant first, so bytes are loaded into words
+// big endian with the first byte in the highest bits.
+static const Bits cBitWordChunkBits = 56;
+
+static inline u64 BitWordMask(Bits bits)
+{
+  return ~u64(0) << (64 - bits);
+}
+
+static inline u64 LoadBitWord(const ::byte* bytes, Bytes count)
+{
+  u64 word = 0;
+  for (Bytes i = 0; i < count; ++i)
+    word |= u64(bytes[i]) << (56 - BYTES_TO_BITS(i));
+  return word;
+}
+
+static inline void StoreBitWord(::byte* bytes, u64 word, Bytes count)
+{
+  for (Bytes i = 0; i < count; ++i)
+    bytes[i] = ::byte(word >> (56 - BYTES_TO_BITS(i)));
+}
+
 //                                  BitStream //
 
 BitStream::BitStream()
@@ -165,70 +188,39 @@ Bits BitStream::WriteBits(const ::byte* data, Bits dataBits)
   // Ensure there is enough space before continuing
   ReallocateIfNecessary(dataBits);
 
-  // Get full bytes and remaining bits written
-  Bytes fullBytesWritten = DIV8(mBitsWritten);
   Bits remBitsWritten = MOD8(mBitsWritten);
-  Bytes fullDataBytes = DIV8(dataBits);
-  Bits remDataBits = MOD8(dataBits);
-  ::byte* writeCursor = mData + fullBytesWritten;
-  ::byte* dataCursor = (::byte*)data;
-  bool writeCursorByteAligned = !remBitsWritten;
-
-  Assert(BYTES_TO_BITS(fullBytesWritten) + remBitsWritten == mBitsWritten &&
-         BYTES_TO_BITS(fullDataBytes) + remDataBits == dataBits);
+  ::byte* writeCursor = mData + DIV8(mBitsWritten);
+  const ::byte* dataCursor = data;
 
-  // Write full data bytes first (if any)
-  if (writeCursorByteAligned && fullDataBytes)
+  // Byte aligned?
+  // Write full data bytes using memcpy
+  if (!remBitsWritten)
   {
-    // Byte aligned?
-    // Write bytes using memcpy
+    Bytes fullDataBytes = DIV8(dataBits);
     memcpy(writeCursor, dataCursor, fullDataBytes);
-    dataCursor += fullDataBytes;
-    fullBytesWritten += fullDataBytes;
     writeCursor += fullDataBytes;
-  }
-  else
-  {
-    // Not byte aligned?
-    // Write bytes manually
-    for (Bytes k = 0; k < fullDataBytes; ++k)
-    {
-      // Write a data byte
-      for (Bits i = 0; i < 8; ++i)
-      {
-        // Write value at cursor
-        ASSIGN_LBIT(*dataCursor & LBIT(i), writeCursor, remBitsWritten);
-
-        ++remBitsWritten;
-
-        // Write cursor reached a byte boundary?
-        if (remBitsWritten == 8)
-        {
-          remBitsWritten = 0;
-          ++fullBytesWritten;
-          ++writeCursor;
-        }
-      }
-
-      ++dataCursor;
-    }
+    dataCursor += fullDataBytes;
   }
 
-  // Write remaining data bits second (if any)
-  for (Bits i = 0; i < remDataBits; ++i)
+  // Write the rest a word at a time. Each chunk plus the write cursor's bit
+  // offset fits in one 64 bit word.
+  Bits remDataBits = dataBits - BYTES_TO_BITS(Bits(dataCursor - data));
+  while (remDataBits)
   {
-    // Write value at cursor
-    ASSIGN_LBIT(*dataCursor & LBIT(i), writeCursor, remBitsWritten);
-
-    ++remBitsWritten;
-
-    // Write cursor reached a byte boundary?
-    if (remBitsWritten == 8)
-    {
-      remBitsWritten = 0;
-      ++fullBytesWritten;
-      ++writeCursor;
-    }
+    Bits chunkBits = std::min(remDataBits, cBitWordChunkBits);
+    u64 chunkMask = BitWordMask(chunkBits);
+    u64 value = LoadBitWord(dataCursor, BITS_TO_BYTES(chunkBits)) & chunkMask;
+
+    // Keep the bits around the chunk that are already in the stream
+    Bytes wordBytes = BITS_TO_BYTES(remBitsWritten + chunkBits);
+    u64 word = LoadBitWord(writeCursor, wordBytes);
+    word = (word & ~(chunkMask >> remBitsWritten)) | (value >> remBitsWritten);
+    StoreBitWord(writeCursor, word, wordBytes);
+
+    // Only the last chunk can end partway through a byte
+    writeCursor += DIV8(chunkBits);
+    dataCursor += DIV8(chunkBits);
+    remDataBits -= chunkBits;
   }
 
   mBitsWritten += dataBits;
@@ -257,10 +249,11 @@ Bits BitStream::WriteUntilByteAligned()
   Bits remBitsWritten = MOD8(mBitsWritten);
   if (remBitsWritten)
   {
-    // Write pad bits
+    // Write pad bits (cleared)
     Bits padBits = 8 - remBitsWritten;
-    for (Bits i = 0; i < padBits; ++i)
-      WriteBit(false);
+    ReallocateIfNecessary(padBits);
+    mData[DIV8(mBitsWritten)] &= ~uint8(0xFF >> remBitsWritten);
+    mBitsWritten += padBits;
 
     // Write cursor should now be byte aligned
     Assert(!MOD8(mBitsWritten));
@@ -397,73 +390,33 @@ Bits BitStream::ReadBits(::byte* data, Bits dataBits) const
     return 0;
   }
 
-  // Plasma data memory
-  memset(data, 0, BITS_TO_BYTES(dataBits));
-
-  // Get full bytes and remaining bits read
-  Bytes fullBytesRead = DIV8(mBitsRead);
   Bits remBitsRead = MOD8(mBitsRead);
-  Bytes fullDataBytes = DIV8(dataBits);
-  Bits remDataBits = MOD8(dataBits);
-  ::byte* readCursor = mData + fullBytesRead;
+  const ::byte* readCursor = mData + DIV8(mBitsRead);
   ::byte* dataCursor = data;
-  bool readCursorByteAligned = !remBitsRead;
 
-  Assert(BYTES_TO_BITS(fullBytesRead) + remBitsRead == mBitsRead &&
-         BYTES_TO_BITS(fullDataBytes) + remDataBits == dataBits);
-
-  // Read full data bytes first (if any)
-  if (readCursorByteAligned && fullDataBytes)
+  // Byte aligned?
+  // Read full data bytes using memcpy
+  if (!remBitsRead)
   {
-    // Byte aligned?
-    // Read bytes using memcpy
+    Bytes fullDataBytes = DIV8(dataBits);
     memcpy(dataCursor, readCursor, fullDataBytes);
-    dataCursor += fullDataBytes;
-    fullBytesRead += fullDataBytes;
     readCursor += fullDataBytes;
-  }
-  else
-  {
-    // Not byte aligned?
-    // Read bytes manually
-    for (Bytes k = 0; k < fullDataBytes; ++k)
-    {
-      // Read a data byte
-      for (Bits i = 0; i < 8; ++i)
-      {
-        // Write value at data cursor
-        ASSIGN_LBIT(*readCursor & LBIT(remBitsRead), dataCursor, i);
-
-        ++remBitsRead;
-
-        // Read cursor reached a byte boundary?
-        if (remBitsRead == 8)
-        {
-          remBitsRead = 0;
-          ++fullBytesRead;
-          ++readCursor;
-        }
-      }
-
-      ++dataCursor;
-    }
+    dataCursor += fullDataBytes;
   }
 
-  // Read remaining data bits second (if any)
-  for (Bits i = 0; i < remDataBits; ++i)
+  // Read the rest a word at a time (unused bits of the last data byte are
+  // cleared)
+  Bits remDataBits = dataBits - BYTES_TO_BITS(Bits(dataCursor - data));
+  while (remDataBits)
   {
-    // Write value at data cursor
-    ASSIGN_LBIT(*readCursor & LBIT(remBitsRead), dataCursor, i);
-
-    ++remBitsRead;
-
-    // Read cursor reached a byte boundary?
-    if (remBitsRead == 8)
-    {
-      remBitsRead = 0;
-      ++fullBytesRead;
-      ++readCursor;
-    }
+    Bits chunkBits = std::min(remDataBits, cBitWordChunkBits);
+    u64 word = LoadBitWord(readCursor, BITS_TO_BYTES(remBitsRead + chunkBits));
+    StoreBitWord(dataCursor, (word << remBitsRead) & BitWordMask(chunkBits), BITS_TO_BYTES(chunkBits));
+
+    // Only the last chunk can end partway through a byte
+    readCursor += DIV8(chunkBits);
+    dataCursor += DIV8(chunkBits);
+    remDataBits -= chunkBits;
   }
 
   mBitsRead += dataBits;
@@ -558,18 +511,14 @@ Bits BitStream::ReadUntilByteAligned() const
   Bits remBitsRead = MOD8(mBitsRead);
   if (remBitsRead)
   {
-    // Read pad bits
-    bool padValue;
+    // Skip pad bits
     Bits padBits = 8 - remBitsRead;
-    for (Bits i = 0; i < padBits; ++i)
+    if (padBits > GetBitsUnread()) // Unable?
     {
-      if (!ReadBit(padValue)) // Unable?
-      {
-        // Failure
-        Unread(i);
-        return 0;
-      }
+      // Failure
+      return 0;
     }
+    mBitsRead += padBits;
 
     // Read cursor should now be byte aligned
     Assert(!MOD8(mBitsRead));
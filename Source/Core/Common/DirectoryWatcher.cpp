@@ -4,7 +4,8 @@
 namespace Plasma
 {
 
-DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, CallbackFunction callback, void* callbackInstance)
+DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, CallbackFunction callback, void* callbackInstance) :
+    mCancelled(false)
 {
   PlasmaCStringCopy(mDirectoryToWatch, File::MaxPath, directoryToWatch, strlen(directoryToWatch));
 
@@ -29,6 +30,7 @@ void DirectoryWatcher::Shutdown()
 {
   if (ThreadingEnabled)
   {
+    mCancelled = true;
     mCancelEvent.Signal();
     mWorkThread.WaitForCompletion();
   }
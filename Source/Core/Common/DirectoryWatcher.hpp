@@ -47,6 +47,8 @@ private:
   OsInt RunThreadEntryPoint();
   Thread mWorkThread;
   OsEvent mCancelEvent;
+  // Set on shutdown for platforms that poll instead of waiting on the event
+  Atomic<bool> mCancelled;
 };
 
 } // namespace Plasma
@@ -83,13 +83,13 @@ ByteBufferBlock ReadFileIntoByteBufferBlock(cstr path)
 
 String ReadFileIntoString(StringParam path)
 {
-  Plasma::DataBlock block = Plasma::ReadFileIntoDataBlock(path.c_str());
-  if (block.Data == nullptr)
+  // Build the string straight from the mapping so the contents are only copied
+  // once (into the string's node)
+  MappedFile file;
+  if (!file.Open(path, FileAccessPattern::Sequential) || file.Size() == 0)
     return String();
 
-  Plasma::String dataFormat((char*)block.Data, block.Size);
-  plDeallocate(block.Data);
-  return dataFormat;
+  return String((cstr)file.Data(), file.Size());
 }
 
 bool CompareFile(Status& status, StringParam filePath1, StringParam filePath2)
@@ -186,6 +186,27 @@ bool CompareFileAndString(Status& status, StringParam filePath, StringParam stri
   return true;
 }
 
+bool MappedFile::IsOpen()
+{
+  return mOpen;
+}
+
+const ::byte* MappedFile::Data()
+{
+  return mData;
+}
+
+size_t MappedFile::Size()
+{
+  return mSize;
+}
+
+StringRange MappedFile::ToStringRange()
+{
+  cstr begin = (cstr)mData;
+  return StringRange(begin, begin + mSize);
+}
+
 FileStream::FileStream(File& file) : mFile(&file)
 {
 }
@@ -109,6 +109,44 @@ private:
   FileMode::Enum mFileMode;
 };
 
+/// Read only view of an entire file in memory. Where the platform supports it
+/// the file is mapped into the address space and pages are only read from disk
+/// as they are touched, so loaders can parse the contents in place instead of
+/// copying the whole file into a heap buffer first. Platforms without mapping
+/// support read the file into memory when it is opened.
+class PlasmaShared MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+  /// Map the file for reading. The access pattern is passed to the OS as a
+  /// read ahead hint. Empty files open successfully with a null Data.
+  bool Open(StringParam filePath, FileAccessPattern::Enum accessPattern, Status* status = nullptr);
+
+  /// Unmap the file. Any pointers into the data become invalid.
+  void Close();
+
+  /// Is a file currently mapped?
+  bool IsOpen();
+
+  /// Start of the file contents (valid until the file is closed).
+  const ::byte* Data();
+
+  /// Size of the file contents in bytes.
+  size_t Size();
+
+  /// The file contents as a range of characters, for text formats.
+  StringRange ToStringRange();
+
+private:
+  PlasmaDeclarePrivateData(MappedFile, 32);
+
+  const ::byte* mData;
+  size_t mSize;
+  bool mOpen;
+};
+
 class FileStream : public Stream
 {
 public:
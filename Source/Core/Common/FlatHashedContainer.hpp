@@ -0,0 +1,671 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+#include "Allocator.hpp"
+#include "Hashing.hpp"
+#include "HashedContainer.hpp"
+#include "Intrinsics.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define PlasmaFlatHashSse2 1
+#  include <emmintrin.h>
+#endif
+
+namespace Plasma
+{
+
+namespace FlatHash
+{
+
+// Every slot in the table has a control byte. A full slot stores the low 7
+// bits of its hash (always positive) so that most mismatches are rejected
+// without ever touching the slot. Open slots have the high bit set.
+typedef s8 Control;
+const Control cEmpty = -128;
+const Control cDeleted = -2;
+const Control cSentinel = -1;
+
+// How many control bytes are probed at once.
+const size_t cGroupWidth = 16;
+const size_t cMinCapacity = 16;
+
+// The hashers in this engine are not guaranteed to spread their bits (pointers
+// and integers often hash to themselves) so the hash is always mixed before
+// being split into the probe position and the control byte.
+inline u64 MixHash(u64 hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+inline u32 LowestBitIndex(u32 mask)
+{
+  return CountTrailingPlasmas(mask);
+}
+
+// Matches against 16 consecutive control bytes. Each method returns a mask
+// with bit 'i' set if control byte 'i' matched.
+struct Group
+{
+#if defined(PlasmaFlatHashSse2)
+  explicit Group(const Control* control) : mControl(_mm_loadu_si128((const __m128i*)control))
+  {
+  }
+
+  u32 Match(Control hash) const
+  {
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), mControl));
+  }
+
+  u32 MatchEmpty() const
+  {
+    return Match(cEmpty);
+  }
+
+  u32 MatchEmptyOrDeleted() const
+  {
+    return (u32)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(cSentinel), mControl));
+  }
+
+  __m128i mControl;
+#else
+  explicit Group(const Control* control) : mControl(control)
+  {
+  }
+
+  u32 Match(Control hash) const
+  {
+    u32 mask = 0;
+    for (size_t i = 0; i < cGroupWidth; ++i)
+      mask |= (u32)(mControl[i] == hash) << i;
+    return mask;
+  }
+
+  u32 MatchEmpty() const
+  {
+    return Match(cEmpty);
+  }
+
+  u32 MatchEmptyOrDeleted() const
+  {
+    u32 mask = 0;
+    for (size_t i = 0; i < cGroupWidth; ++i)
+      mask |= (u32)(mControl[i] < cSentinel) << i;
+    return mask;
+  }
+
+  const Control* mControl;
+#endif
+};
+
+} // namespace FlatHash
+
+/// Open addressing hashed container with the same interface as
+/// HashedContainer. Values are stored inline in a power of two sized table and
+/// a separate array of control bytes is probed a group at a time (with SSE2
+/// when available), so lookups and misses rarely touch more than one cache
+/// line of values. Erasing only leaves a tombstone when a probe could have
+/// passed over the erased slot.
+///
+/// Like HashedContainer, inserting may move every value in the table. Unlike
+/// HashedContainer, erasing never moves the other values.
+template <typename ValueType, typename Hasher, typename Allocator>
+class PlasmaSharedTemplate FlatHashedContainer : public AllocationContainer<Allocator>
+{
+public:
+  // standard container typedefs
+  typedef ValueType value_type;
+  typedef size_t size_type;
+  typedef ValueType& reference;
+  typedef const ValueType& const_reference;
+  typedef AllocationContainer<Allocator> base_type;
+  typedef FlatHashedContainer<ValueType, Hasher, Allocator> this_type;
+  typedef FlatHash::Control Control;
+  using base_type::mAllocator;
+
+protected:
+  // Internal node value (whether or not it is alive is stored in the control
+  // bytes)
+  struct Node
+  {
+    ValueType Value;
+  };
+
+public:
+  //
+  struct InsertResult
+  {
+    bool mIsNewInsert;
+    ValueType* mValue;
+
+    InsertResult(bool newInsert, Node* node) : mIsNewInsert(newInsert), mValue(&node->Value)
+    {
+    }
+
+    operator bool() const
+    {
+      return mIsNewInsert;
+    }
+  };
+
+  // Default constructor
+  FlatHashedContainer()
+  {
+    mTable = nullptr;
+    mControl = nullptr;
+    mTableSize = 0;
+    mSize = 0;
+    mGrowthLeft = 0;
+    mMaxLoadFactor = 0.875f;
+  }
+
+  ~FlatHashedContainer()
+  {
+    Deallocate();
+  }
+
+  // Range for hash map.
+  struct range
+  {
+    typedef typename this_type::value_type value_type;
+    typedef reference FrontResult;
+
+    range() : mBegin(nullptr), mEnd(nullptr), mControl(nullptr), mSize(0)
+    {
+    }
+
+    // A range without control bytes walks every node (used for single values)
+    range(Node* rbegin, Node* rend, size_t size) : mBegin(rbegin), mEnd(rend), mControl(nullptr), mSize(size)
+    {
+    }
+
+    range(Node* rbegin, Node* rend, const Control* control, size_t size) :
+        mBegin(rbegin),
+        mEnd(rend),
+        mControl(control),
+        mSize(size)
+    {
+    }
+
+    bool Empty()
+    {
+      return mBegin == mEnd;
+    }
+
+    reference Front()
+    {
+      return mBegin->Value;
+    }
+
+    void PopFront()
+    {
+      ErrorIf(Empty(), "Popped an empty range.");
+      ++mBegin;
+      --mSize;
+
+      if (mControl == nullptr)
+        return;
+
+      // Skip open slots
+      ++mControl;
+      while (mBegin != mEnd && *mControl < 0)
+      {
+        ++mBegin;
+        ++mControl;
+      }
+    }
+
+    size_t Length()
+    {
+      return mSize;
+    }
+
+    size_type Size()
+    {
+      return Length();
+    }
+    range& All()
+    {
+      return *this;
+    }
+
+    range begin()
+    {
+      return *this;
+    }
+    range end()
+    {
+      return range(mEnd, mEnd, 0);
+    }
+
+    bool operator==(const range& rhs) const
+    {
+      return mBegin == rhs.mBegin && mEnd == rhs.mEnd;
+    }
+    bool operator!=(const range& rhs) const
+    {
+      return !(*this == rhs);
+    }
+    range& operator++()
+    {
+      PopFront();
+      return *this;
+    }
+    reference operator*()
+    {
+      return Front();
+    }
+
+  private:
+    Node* mBegin;
+    Node* mEnd;
+    const Control* mControl;
+    size_t mSize;
+  };
+
+  ///////Container Global Modify//////////////////
+
+  // Rehash the contents of the table into a table that can hold at least the
+  // given number of values (rounded up to a power of two).
+  void Rehash(size_type newTableSize)
+  {
+    if (newTableSize < mSize)
+      return;
+
+    size_type capacity = FlatHash::cMinCapacity;
+    while (capacity < newTableSize || MaxSizeFor(capacity) < mSize)
+      capacity *= 2;
+
+    Node* oldTable = mTable;
+    Control* oldControl = mControl;
+    size_type oldTableSize = mTableSize;
+
+    // Allocate the new table and mark every slot (and the mirrored group at
+    // the end) as empty
+    mTable = (Node*)mAllocator.Allocate(capacity * sizeof(Node));
+    mControl = (Control*)mAllocator.Allocate(ControlBytesFor(capacity));
+    memset(mControl, (u8)FlatHash::cEmpty, ControlBytesFor(capacity));
+    mTableSize = capacity;
+    mGrowthLeft = MaxSizeFor(capacity) - mSize;
+
+    // Now reinsert all full slots. Every value is known to be unique so the
+    // first open slot in each probe sequence can be used directly
+    for (size_type i = 0; i < oldTableSize; ++i)
+    {
+      if (oldControl[i] < 0)
+        continue;
+
+      Node& node = oldTable[i];
+      u64 hash = FlatHash::MixHash((u64)mHasher(node.Value));
+      size_type index = FindOpenSlot(hash);
+      new (&mTable[index].Value) value_type(node.Value);
+      SetControl(index, H2(hash));
+      node.Value.~ValueType();
+    }
+
+    // Free the old table if it existed
+    if (oldTableSize != 0)
+    {
+      mAllocator.Deallocate(oldTable, oldTableSize * sizeof(Node));
+      mAllocator.Deallocate(oldControl, ControlBytesFor(oldTableSize));
+    }
+  }
+
+  // Destroy all elements.
+  void Clear()
+  {
+    if (mTableSize == 0)
+      return;
+
+    DestructTableValues();
+    memset(mControl, (u8)FlatHash::cEmpty, ControlBytesFor(mTableSize));
+    mSize = 0;
+    mGrowthLeft = MaxSizeFor(mTableSize);
+  }
+
+  // Destroy all elements and frees all memory.
+  void Deallocate()
+  {
+    if (mTable != nullptr)
+    {
+      DestructTableValues();
+      mAllocator.Deallocate(mTable, mTableSize * sizeof(Node));
+      mAllocator.Deallocate(mControl, ControlBytesFor(mTableSize));
+    }
+
+    mTable = nullptr;
+    mControl = nullptr;
+    mTableSize = 0;
+    mSize = 0;
+    mGrowthLeft = 0;
+  }
+
+  range All() const
+  {
+    size_type start = 0;
+    while (start != mTableSize && mControl[start] < 0)
+      ++start;
+    return range(mTable + start, mTable + mTableSize, mControl + start, mSize);
+  }
+
+  range begin()
+  {
+    return All();
+  }
+
+  range end()
+  {
+    return All().end();
+  }
+
+  void Swap(this_type& other)
+  {
+    Plasma::Swap(mTable, other.mTable);
+    Plasma::Swap(mControl, other.mControl);
+    Plasma::Swap(mTableSize, other.mTableSize);
+    Plasma::Swap(mSize, other.mSize);
+    Plasma::Swap(mGrowthLeft, other.mGrowthLeft);
+    Plasma::Swap(mMaxLoadFactor, other.mMaxLoadFactor);
+    Plasma::Swap(mHasher, other.mHasher);
+  }
+
+  ////////////Insertion///////////////////////
+
+  // Override
+  static Node* OnCollisionOverride(Node* dest, const_reference value)
+  {
+    dest->Value = value;
+    return dest;
+  }
+
+  // Error
+  static Node* OnCollisionError(Node* dest, const_reference value)
+  {
+    (void)value;
+    (void)dest;
+    Error("Double Insert, value was not inserted!");
+    return nullptr;
+  }
+
+  // Just return the bucket
+  static Node* OnCollisionReturn(Node* dest, const_reference value)
+  {
+    (void)value;
+    return dest;
+  }
+
+  // Insert a value.
+  template <typename CollisionFunc>
+  InsertResult InsertInternal(const_reference value, CollisionFunc onCollison)
+  {
+    u64 hash = FlatHash::MixHash((u64)mHasher(value));
+
+    Node* found = FindWithHash(value, mHasher, hash);
+    if (found != cHashOpenNode)
+    {
+      onCollison(found, value);
+      return InsertResult(false, found);
+    }
+
+    // Tombstones can be reused without growing, empty slots can not
+    size_type index = 0;
+    if (mTableSize != 0)
+      index = FindOpenSlot(hash);
+
+    if (mTableSize == 0 || (mGrowthLeft == 0 && mControl[index] == FlatHash::cEmpty))
+    {
+      // Copy the value first in case it lives in the table being replaced
+      value_type toInsert(value);
+      Grow();
+      return InsertNew(hash, FindOpenSlot(hash), toInsert);
+    }
+
+    return InsertNew(hash, index, value);
+  }
+
+  ////////Find//////////////////////////////
+
+  // Find an element value that hashes and compares to a
+  // value in the hash map.
+  template <typename searchType, typename searchHasherType>
+  Node* InternalFindAs(const searchType& searchValue, searchHasherType searchHasher) const
+  {
+    if (mTableSize == 0)
+      return (Node*)cHashOpenNode;
+
+    u64 hash = FlatHash::MixHash((u64)searchHasher(searchValue));
+    return FindWithHash(searchValue, searchHasher, hash);
+  }
+
+  size_t Count(const_reference value)
+  {
+    Node* foundNode = InternalFindAs(value, mHasher);
+    if (foundNode != cHashOpenNode)
+      return 1;
+    else
+      return 0;
+  }
+
+  ///////Erasing//////////////////////////
+
+  // Erase a value if found.
+  bool Erase(const_reference value)
+  {
+    Node* foundNode = InternalFindAs(value, mHasher);
+    if (foundNode != cHashOpenNode)
+    {
+      EraseNode(foundNode);
+      return true;
+    }
+    return false;
+  }
+
+  void EraseNode(Node* node)
+  {
+    size_type index = (size_type)(node - mTable);
+    ErrorIf(node == nullptr || index >= mTableSize || mControl[index] < 0, "Attempted to erase an invalid node.");
+
+    node->Value.~ValueType();
+    --mSize;
+
+    // If the slot is surrounded by an empty slot within one group width on
+    // either side then no probe sequence ever saw a full group here and it
+    // can become empty again instead of a tombstone
+    size_type mask = mTableSize - 1;
+    size_type indexBefore = (index - FlatHash::cGroupWidth) & mask;
+    u32 emptyAfter = FlatHash::Group(mControl + index).MatchEmpty();
+    u32 emptyBefore = FlatHash::Group(mControl + indexBefore).MatchEmpty();
+
+    bool wasNeverFull = emptyBefore != 0 && emptyAfter != 0 &&
+                        FlatHash::LowestBitIndex(emptyAfter) + (CountLeadingPlasmas(emptyBefore) - 16) <
+                            FlatHash::cGroupWidth;
+
+    if (wasNeverFull)
+    {
+      SetControl(index, FlatHash::cEmpty);
+      ++mGrowthLeft;
+    }
+    else
+    {
+      SetControl(index, FlatHash::cDeleted);
+    }
+  }
+
+  //////////Information Functions///////////
+  size_type BucketCount() const
+  {
+    return mTableSize;
+  }
+  size_type Size() const
+  {
+    return mSize;
+  }
+  bool Empty() const
+  {
+    return mSize == 0;
+  }
+
+  //////////Load Factor///////////////////////
+  float MaxLoadFactor() const
+  {
+    return mMaxLoadFactor;
+  }
+  float LoadFactor() const
+  {
+    return float(mSize) / float(mTableSize);
+  }
+  // Probing requires at least one empty slot so the load factor is clamped to
+  // 7/8.
+  void SetMaxLoadFactor(float newMax)
+  {
+    mMaxLoadFactor = newMax < 0.25f ? 0.25f : (newMax > 0.875f ? 0.875f : newMax);
+    if (mTableSize != 0)
+      Rehash(mTableSize);
+  }
+
+  /// Equals///////////
+
+  bool operator==(const this_type& other)
+  {
+    if (other.Size() != this->Size())
+      return false;
+
+    range r = this->All();
+    while (!r.Empty())
+    {
+      Node* node = other.InternalFindAs(r.Front(), mHasher);
+      if (node == (Node*)cHashOpenNode)
+        return false;
+
+      if (r.Front() != node->Value)
+        return false;
+
+      r.PopFront();
+    }
+
+    return true;
+  }
+
+protected:
+  Node* mTable;
+  // mTableSize control bytes followed by a copy of the first group so that a
+  // group can be loaded from any slot without wrapping.
+  Control* mControl;
+  size_type mTableSize;
+  size_type mSize;
+  // How many more empty slots can be filled before the table must grow.
+  size_type mGrowthLeft;
+  float mMaxLoadFactor;
+  Hasher mHasher;
+  typedef Node node_type;
+
+  static Control H2(u64 hash)
+  {
+    return (Control)(hash & 0x7F);
+  }
+
+  static size_type H1(u64 hash)
+  {
+    return (size_type)(hash >> 7);
+  }
+
+  static size_type ControlBytesFor(size_type capacity)
+  {
+    return capacity + FlatHash::cGroupWidth;
+  }
+
+  size_type MaxSizeFor(size_type capacity) const
+  {
+    return (size_type)(float(capacity) * mMaxLoadFactor);
+  }
+
+  void SetControl(size_type index, Control control)
+  {
+    mControl[index] = control;
+    if (index < FlatHash::cGroupWidth)
+      mControl[mTableSize + index] = control;
+  }
+
+  template <typename searchType, typename searchHasherType>
+  Node* FindWithHash(const searchType& searchValue, searchHasherType& searchHasher, u64 hash) const
+  {
+    if (mTableSize == 0)
+      return (Node*)cHashOpenNode;
+
+    // Probe a group at a time (triangular steps visit every group)
+    size_type mask = mTableSize - 1;
+    size_type offset = H1(hash) & mask;
+    size_type step = 0;
+    Control h2 = H2(hash);
+    for (;;)
+    {
+      FlatHash::Group group(mControl + offset);
+      for (u32 match = group.Match(h2); match != 0; match &= match - 1)
+      {
+        Node* node = mTable + ((offset + FlatHash::LowestBitIndex(match)) & mask);
+        if (searchHasher.Equal(searchValue, node->Value))
+          return node;
+      }
+
+      // An empty slot means the value would have been placed here
+      if (group.MatchEmpty() != 0)
+        return (Node*)cHashOpenNode;
+
+      step += FlatHash::cGroupWidth;
+      offset = (offset + step) & mask;
+    }
+  }
+
+  // Returns the first empty or deleted slot in the value's probe sequence.
+  size_type FindOpenSlot(u64 hash) const
+  {
+    size_type mask = mTableSize - 1;
+    size_type offset = H1(hash) & mask;
+    size_type step = 0;
+    for (;;)
+    {
+      u32 open = FlatHash::Group(mControl + offset).MatchEmptyOrDeleted();
+      if (open != 0)
+        return (offset + FlatHash::LowestBitIndex(open)) & mask;
+
+      step += FlatHash::cGroupWidth;
+      offset = (offset + step) & mask;
+    }
+  }
+
+  InsertResult InsertNew(u64 hash, size_type index, const_reference value)
+  {
+    if (mControl[index] == FlatHash::cEmpty)
+      --mGrowthLeft;
+
+    Node* node = mTable + index;
+    new (&node->Value) value_type(value);
+    SetControl(index, H2(hash));
+    ++mSize;
+    return InsertResult(true, node);
+  }
+
+  void Grow()
+  {
+    // If most of the used slots are tombstones then clean them up in place
+    // instead of doubling the table
+    if (mTableSize != 0 && mSize + 1 <= MaxSizeFor(mTableSize) / 2)
+      Rehash(mTableSize);
+    else
+      Rehash(mTableSize == 0 ? FlatHash::cMinCapacity : mTableSize * 2);
+  }
+
+  void DestructTableValues()
+  {
+    for (size_type i = 0; i < mTableSize; ++i)
+    {
+      // call the destructor on all the value types
+      if (mControl[i] >= 0)
+        mTable[i].Value.~ValueType();
+    }
+  }
+};
+
+} // namespace Plasma
@@ -3,6 +3,7 @@
 
 #include "ContainerCommon.hpp"
 #include "HashedContainer.hpp"
+#include "FlatHashedContainer.hpp"
 
 namespace Plasma
 {
@@ -28,17 +29,21 @@ struct SetHashAdapter
   }
 };
 
-/// Hash Set is an Associative Hashed Container.
-template <typename ValueType, typename Hasher = HashPolicy<ValueType>, typename Allocator = DefaultAllocator>
-class PlasmaSharedTemplate HashSet : public HashedContainer<ValueType, SetHashAdapter<Hasher, ValueType>, Allocator>
+/// Hash Set is an Associative Hashed Container. The table implementation can
+/// be selected per set (see FlatHashSet).
+template <typename ValueType,
+          typename Hasher = HashPolicy<ValueType>,
+          typename Allocator = DefaultAllocator,
+          template <typename, typename, typename> class Container = HashedContainer>
+class PlasmaSharedTemplate HashSet : public Container<ValueType, SetHashAdapter<Hasher, ValueType>, Allocator>
 {
 public:
   typedef ValueType value_type;
   typedef size_t size_type;
   typedef value_type& reference;
   typedef const value_type& const_reference;
-  typedef HashSet<ValueType, Hasher, Allocator> this_type;
-  typedef HashedContainer<ValueType, SetHashAdapter<Hasher, ValueType>, Allocator> base_type;
+  typedef HashSet<ValueType, Hasher, Allocator, Container> this_type;
+  typedef Container<ValueType, SetHashAdapter<Hasher, ValueType>, Allocator> base_type;
   typedef typename base_type::Node* iterator;
   typedef typename base_type::Node Node;
   typedef typename base_type::range range;
@@ -199,4 +204,8 @@ public:
   }
 };
 
+/// Hash Set stored in an open addressing table (see FlatHashedContainer).
+template <typename ValueType, typename Hasher = HashPolicy<ValueType>, typename Allocator = DefaultAllocator>
+using FlatHashSet = HashSet<ValueType, Hasher, Allocator, FlatHashedContainer>;
+
 } // namespace Plasma
@@ -8,9 +8,23 @@ namespace Plasma
 // StringPool
 #if defined(PlasmaStringPooling)
 typedef HashSet<StringNode*, PoolPolicy> StringPoolSet;
+
+// Strings are split between shards picked from their hash, each with its own
+// lock, so threads creating and releasing different strings rarely contend.
 class StringPool
 {
 public:
+  static const size_t cShardBits = 5;
+  static const size_t cShardCount = (size_t)1 << cShardBits;
+
+  struct Shard
+  {
+    SpinLock mLock;
+    StringPoolSet mPool;
+    // Keeps the locks of neighboring shards off of the same cache line
+    ::byte mPadding[64];
+  };
+
   StringPool();
   ~StringPool();
   static StringPool& GetInstance();
@@ -19,13 +33,15 @@ public:
   // in the pool
   StringNode& GetEmptyNode();
 
-  SpinLock mLock;
-  StringPoolSet mPool;
+  Shard& GetShard(size_t hash);
+
+  Shard mShards[cShardCount];
 };
 
 StringPool::StringPool()
 {
-  mPool.Insert(&GetEmptyNode());
+  StringNode& emptyNode = GetEmptyNode();
+  GetShard(emptyNode.HashCode).mPool.Insert(&emptyNode);
 }
 
 StringPool::~StringPool()
@@ -33,12 +49,23 @@ StringPool::~StringPool()
   // It is possible that the StringPool can be freed before the last few Strings
   // This only occurs post main (due to pre-main allocated strings)
   // We handle this by setting a special flag on the StringNode
-  forRange (StringNode* node, mPool.All())
+  for (size_t i = 0; i < cShardCount; ++i)
   {
-    node->HashCode = StringNode::StringPoolFreeHashCode;
+    forRange (StringNode* node, mShards[i].mPool.All())
+    {
+      node->HashCode = StringNode::StringPoolFreeHashCode;
+    }
   }
 }
 
+StringPool::Shard& StringPool::GetShard(size_t hash)
+{
+  // String hashes don't mix their upper bits well, so scramble the hash
+  // before using its top bits as the shard index
+  u32 mixed = (u32)hash * 2654435769u;
+  return mShards[mixed >> (32 - cShardBits)];
+}
+
 StringNode& StringPool::GetEmptyNode()
 {
   static StringNode node = {1, 0, 0, {0}};
@@ -353,15 +380,15 @@ void String::Assign(const_pointer data, size_type size)
   temp.mSize = size;
   temp.mHash = hash;
 
-  StringPool& pool = StringPool::GetInstance();
-  pool.mLock.Lock();
+  StringPool::Shard& shard = StringPool::GetInstance().GetShard(hash);
+  shard.mLock.Lock();
   {
     TemporaryStringHashPolicy policy;
-    StringPoolSet::range foundRange = pool.mPool.FindAs(temp, policy);
+    StringPoolSet::range foundRange = shard.mPool.FindAs(temp, policy);
     if (foundRange.Empty())
     {
       CreateAndAssignNode(data, size, hash);
-      pool.mPool.InsertOrError(mNode);
+      shard.mPool.InsertOrError(mNode);
     }
     else
     {
@@ -373,7 +400,7 @@ void String::Assign(const_pointer data, size_type size)
       Assign(existingNode);
     }
   }
-  pool.mLock.Unlock();
+  shard.mLock.Unlock();
 #else
   CreateAndAssignNode(data, size, hash);
 #endif
@@ -405,12 +432,12 @@ bool String::DebugIsNodePointerInPool(String* str)
 
   bool isInPool = false;
 #if defined(PlasmaStringPooling)
-  StringPool& pool = StringPool::GetInstance();
-  pool.mLock.Lock();
+  StringPool::Shard& shard = StringPool::GetInstance().GetShard(str->mNode->HashCode);
+  shard.mLock.Lock();
   {
-    isInPool = pool.mPool.Contains(str->mNode);
+    isInPool = shard.mPool.Contains(str->mNode);
   }
-  pool.mLock.Unlock();
+  shard.mLock.Unlock();
 #endif
   return isInPool;
 }
@@ -418,17 +445,23 @@ bool String::DebugIsNodePointerInPool(String* str)
 void String::ComputeStringStats(StringStats& stats)
 {
   StringPool& pool = StringPool::GetInstance();
-  pool.mLock.Lock();
 
   stats.mTotalSize = 0;
-  stats.mTotalCount = pool.mPool.Size();
+  stats.mTotalCount = 0;
 
-  forRange (StringNode* node, pool.mPool.All())
+  for (size_t i = 0; i < StringPool::cShardCount; ++i)
   {
-    stats.mTotalSize += node->Size;
-  }
+    StringPool::Shard& shard = pool.mShards[i];
+    shard.mLock.Lock();
+
+    stats.mTotalCount += shard.mPool.Size();
+    forRange (StringNode* node, shard.mPool.All())
+    {
+      stats.mTotalSize += node->Size;
+    }
 
-  pool.mLock.Unlock();
+    shard.mLock.Unlock();
+  }
 }
 
 void String::DebugForceReleaseStringPoolLock()
@@ -440,20 +473,21 @@ void String::DebugForceReleaseStringPoolLock()
   // and get no report instead of infinite looping on a background process.
 #if defined(PlasmaStringPooling)
   StringPool& pool = StringPool::GetInstance();
-  pool.mLock.Unlock();
+  for (size_t i = 0; i < StringPool::cShardCount; ++i)
+    pool.mShards[i].mLock.Unlock();
 #endif
 }
 
 void String::poolOrDeleteNode(StringNode* node)
 {
 #if defined(PlasmaStringPooling)
-  StringPool& pool = StringPool::GetInstance();
-  pool.mLock.Lock();
+  StringPool::Shard& shard = StringPool::GetInstance().GetShard(node->HashCode);
+  shard.mLock.Lock();
   {
-    StringNode* existingNode = pool.mPool.FindValue(node, nullptr);
+    StringNode* existingNode = shard.mPool.FindValue(node, nullptr);
     if (existingNode == nullptr)
     {
-      pool.mPool.InsertOrError(node);
+      shard.mPool.InsertOrError(node);
     }
     else
     {
@@ -465,7 +499,7 @@ void String::poolOrDeleteNode(StringNode* node)
       Assign(existingNode);
     }
   }
-  pool.mLock.Unlock();
+  shard.mLock.Unlock();
 #endif
 }
 
@@ -482,16 +516,29 @@ void StringNode::release()
     return;
   }
 
-  StringPool& pool = StringPool::GetInstance();
-  pool.mLock.Lock();
+  // Dropping a reference that can't be the last one doesn't need the pool.
+  // Only the final release has to be under the lock so that no other thread
+  // can find the node in the pool after it's been freed.
+  for (;;)
+  {
+    count_type count = RefCount;
+    if (count <= 1)
+      break;
+
+    if (AtomicCompareExchange(&RefCount, count - 1, count))
+      return;
+  }
+
+  StringPool::Shard& shard = StringPool::GetInstance().GetShard(HashCode);
+  shard.mLock.Lock();
 
   if (AtomicPreDecrement(&RefCount) == 0)
   {
-    ErrorIf(pool.mPool.FindValue(this, nullptr) == nullptr, "Did not find node in pool");
-    pool.mPool.Erase(this);
+    ErrorIf(shard.mPool.FindValue(this, nullptr) == nullptr, "Did not find node in pool");
+    shard.mPool.Erase(this);
     plDeallocate(this);
   }
-  pool.mLock.Unlock();
+  shard.mLock.Unlock();
 #else
   if (AtomicPreDecrement(&RefCount) == 0)
     plDeallocate(this);
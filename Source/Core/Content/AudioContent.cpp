@@ -69,23 +69,40 @@ void SoundBuilder::Serialize(Serializer& stream)
 
 void SoundBuilder::BuildContent(BuildOptions& options)
 {
-  Status status;
+  PrepareBuild(options);
+  BuildThreaded(options);
+  FinishBuild(options);
+}
+
+bool SoundBuilder::SupportsThreadedBuild()
+{
+  return true;
+}
+
+uint SoundBuilder::GetBuildCacheVersion()
+{
+  // Increment if the encoded sound format changes
+  return 1;
+}
+
+void SoundBuilder::BuildThreaded(BuildOptions& options)
+{
+  mEncodeStatus.Reset();
   String sourceFile = FilePath::Combine(options.SourcePath, mOwner->Filename);
   String destFile = FilePath::Combine(options.OutputPath, BuildString(Name, SoundExtension));
 
   // Create the AudioFile object and open the source file
-  AudioFileData audioFile = AudioFileEncoder::OpenFile(status, sourceFile);
+  AudioFileData audioFile = AudioFileEncoder::OpenFile(mEncodeStatus, sourceFile);
 
-  if (status.Succeeded())
-  {
-    // Encode the file and write it out to disk
-    AudioFileEncoder::WriteFile(status, destFile, audioFile, mNormalize, mMaxVolume);
+  // Encode the file and write it out to disk
+  if (mEncodeStatus.Succeeded())
+    AudioFileEncoder::WriteFile(mEncodeStatus, destFile, audioFile, mNormalize, mMaxVolume);
+}
 
-    if (status.Failed())
-      DoNotifyWarning("Error Processing Audio File", status.Message);
-  }
-  else
-    DoNotifyWarning("Error Processing Audio File", status.Message);
+void SoundBuilder::FinishBuild(BuildOptions& options)
+{
+  if (mEncodeStatus.Failed())
+    DoNotifyWarning("Error Processing Audio File", mEncodeStatus.Message);
 }
 
 bool SoundBuilder::NeedsBuilding(BuildOptions& options)
@@ -57,9 +57,16 @@ public:
   void BuildContent(BuildOptions& options) override;
   bool NeedsBuilding(BuildOptions& options) override;
   void BuildListing(ResourceListing& listing) override;
+  bool SupportsThreadedBuild() override;
+  void BuildThreaded(BuildOptions& options) override;
+  void FinishBuild(BuildOptions& options) override;
+  uint GetBuildCacheVersion() override;
 
   // This should be removed at the next major version
   bool mStreamed;
+
+  // The result of encoding, reported on the main thread in FinishBuild.
+  Status mEncodeStatus;
 };
 
 } // namespace Plasma
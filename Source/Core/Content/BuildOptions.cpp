@@ -10,4 +10,9 @@ BuildOptions::BuildOptions(ContentLibrary* library)
   SourcePath = library->SourcePath;
   OutputPath = library->GetOutputPath();
 }
+
+void BuildOptions::RecordBuildTime(StringParam builderType, double seconds)
+{
+  BuildTimes[builderType] += seconds;
+}
 } // namespace Plasma
@@ -8,8 +8,9 @@ namespace Plasma
 typedef Array<ContentItem*> ContentItemArray;
 
 // Options used to control content building
-// Treat this as an immutable object once we pass it to the
-// content items to be processed, it's used my multiple threads!
+// Each content item being built gets its own options (content items may be
+// built on different threads), which is also where failures and build times
+// are reported back to the content system.
 class BuildOptions
 {
 public:
@@ -23,6 +24,16 @@ public:
   String ToolPath;
   // The error message if the build fails.
   String Message;
+
+  // Seconds spent in each builder type, used for the content build report.
+  HashMap<String, double> BuildTimes;
+  void RecordBuildTime(StringParam builderType, double seconds);
+
+  // Content build cache results, also used for the content build report.
+  uint CacheHits = 0;
+  uint CacheMisses = 0;
+  // How long the content restored from the cache originally took to build.
+  double CacheSecondsSaved = 0.0;
 };
 
 } // namespace Plasma
@@ -0,0 +1,120 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+namespace
+{
+const String cManifestFile = "Entry.manifest";
+// Incremented if the way keys are computed or entries are stored changes.
+const uint cCacheFormatVersion = 1;
+} // namespace
+
+bool ContentBuildCache::IsEnabled()
+{
+  return !Directory.Empty();
+}
+
+String ContentBuildCache::ComputeKey(StringParam sourceFile, StringParam builderType, uint builderVersion)
+{
+  Lightning::Sha1Builder builder;
+  builder.Append(String::Format("%u:%s:%u:", cCacheFormatVersion, builderType.c_str(), builderVersion));
+
+  File source;
+  if (!source.Open(sourceFile, FileMode::Read, FileAccessPattern::Sequential) || !builder.Append(source))
+    return String();
+  source.Close();
+
+  // Every builder's settings are serialized in the meta file
+  String metaFile = BuildString(sourceFile, ".meta");
+  File meta;
+  if (meta.Open(metaFile, FileMode::Read, FileAccessPattern::Sequential))
+  {
+    builder.Append(":meta:");
+    builder.Append(meta);
+    meta.Close();
+  }
+
+  return builder.OutputHashString();
+}
+
+bool ContentBuildCache::Restore(StringParam key,
+                                StringParam outputPath,
+                                Array<String>& outputFiles,
+                                double& buildSeconds)
+{
+  if (!IsEnabled() || key.Empty() || outputFiles.Empty())
+    return false;
+
+  String entryPath = GetEntryPath(key);
+  String manifest = ReadFileIntoString(FilePath::Combine(entryPath, cManifestFile));
+  if (manifest.Empty())
+    return false;
+
+  forRange (String& outputFile, outputFiles.All())
+  {
+    if (!FileExists(FilePath::Combine(entryPath, outputFile)))
+      return false;
+  }
+
+  forRange (String& outputFile, outputFiles.All())
+  {
+    String destFile = FilePath::Combine(outputPath, outputFile);
+    if (!CopyFile(destFile, FilePath::Combine(entryPath, outputFile)))
+      return false;
+
+    // The output must look newer than the source so it isn't considered out
+    // of date the next time the library is built
+    SetFileToCurrentTime(destFile);
+  }
+
+  buildSeconds = 0.0;
+  ToValue(manifest.All(), buildSeconds);
+  return true;
+}
+
+void ContentBuildCache::Store(StringParam key,
+                              StringParam outputPath,
+                              Array<String>& outputFiles,
+                              double buildSeconds)
+{
+  if (!IsEnabled() || key.Empty() || outputFiles.Empty())
+    return;
+
+  String entryPath = GetEntryPath(key);
+  CreateDirectoryAndParents(entryPath);
+
+  forRange (String& outputFile, outputFiles.All())
+  {
+    String builtFile = FilePath::Combine(outputPath, outputFile);
+    if (!FileExists(builtFile) || !CopyFile(FilePath::Combine(entryPath, outputFile), builtFile))
+      return;
+  }
+
+  // Write the manifest to a unique file and move it into place so other
+  // machines building the same content never see a partial manifest
+  String manifest = String::Format("%f", buildSeconds);
+  String manifestFile = FilePath::Combine(entryPath, cManifestFile);
+  String tempFile = String::Format("%s.%llx", manifestFile.c_str(), (unsigned long long)GenerateUniqueId64());
+  WriteToFile(tempFile.c_str(), (const ::byte*)manifest.Data(), manifest.SizeInBytes());
+  if (!MoveFile(manifestFile, tempFile))
+    DeleteFile(tempFile);
+}
+
+String ContentBuildCache::GetEntryPath(StringParam key)
+{
+  // Spread the entries over sub folders so no one folder gets too large
+  String prefix = key.SubStringFromByteIndices(0, 2);
+  return FilePath::Combine(Directory, prefix, key);
+}
+
+void GetBuildCacheOutputs(BuilderComponent* builder, Array<String>& outputFiles)
+{
+  ResourceListing listing;
+  builder->BuildListing(listing);
+  forRange (ResourceEntry& entry, listing.All())
+    outputFiles.PushBack(entry.Location);
+}
+
+} // namespace Plasma
@@ -0,0 +1,45 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+class BuilderComponent;
+
+/// Stores built content in a directory keyed by a hash of everything the
+/// output depends on: the source file, its meta file (which holds every
+/// builder's settings), the builder type and the builder's version. Unlike
+/// the file time checks done by NeedsBuilding, the key does not change when a
+/// file is checked out again, so the directory can be shared between branches,
+/// checkouts and machines (e.g. on a network drive).
+///
+/// Each entry is a folder named after the key holding a copy of every output
+/// and a manifest. The manifest is written last, so a half written entry is
+/// never restored.
+class ContentBuildCache
+{
+public:
+  /// Where entries are stored. The cache is disabled while this is empty.
+  String Directory;
+
+  bool IsEnabled();
+
+  /// Returns an empty key if the source file can not be read.
+  String ComputeKey(StringParam sourceFile, StringParam builderType, uint builderVersion);
+
+  /// Copies every output file from the entry into the output path. Returns
+  /// false if there is no complete entry for the key. The time it originally
+  /// took to build the outputs is returned in buildSeconds.
+  bool Restore(StringParam key, StringParam outputPath, Array<String>& outputFiles, double& buildSeconds);
+
+  /// Copies the freshly built output files into a new entry.
+  void Store(StringParam key, StringParam outputPath, Array<String>& outputFiles, double buildSeconds);
+
+private:
+  String GetEntryPath(StringParam key);
+};
+
+/// Adds the output files (relative to the output path) listed by the builder.
+void GetBuildCacheOutputs(BuilderComponent* builder, Array<String>& outputFiles);
+
+} // namespace Plasma
@@ -164,18 +164,129 @@ bool ContentComposition::AnyNeedsBuilding(BuildOptions& options)
 
 void ContentComposition::BuildContentItem(BuildOptions& options)
 {
-  bool anyBuilt = false;
+  PrepareBuild(options);
+  BuildThreaded(options);
+  FinishBuild(options);
+}
+
+bool ContentComposition::SupportsThreadedBuild()
+{
   forRange (BuilderComponent* bc, Builders.All())
   {
-    if (bc->NeedsBuilding(options))
-    {
-      anyBuilt = true;
+    if (bc->SupportsThreadedBuild())
+      return true;
+  }
+  return false;
+}
+
+void ContentComposition::PrepareBuild(BuildOptions& options)
+{
+  mBuilding.Clear();
+  forRange (BuilderComponent* bc, Builders.All())
+  {
+    if (!bc->NeedsBuilding(options))
+      continue;
+
+    String cacheKey;
+    if (RestoreFromBuildCache(bc, options, cacheKey))
+      continue;
+
+    PendingBuild& pending = mBuilding.PushBack();
+    pending.mBuilder = bc;
+    pending.mCacheKey = cacheKey;
+
+    // Builders that can't be threaded are fully built now
+    Timer timer;
+    if (bc->SupportsThreadedBuild())
+      bc->PrepareBuild(options);
+    else
       bc->BuildContent(options);
+    pending.mSeconds = timer.UpdateAndGetTime();
+    options.RecordBuildTime(LightningVirtualTypeId(bc)->Name, pending.mSeconds);
+  }
+}
+
+void ContentComposition::BuildThreaded(BuildOptions& options)
+{
+  forRange (PendingBuild& pending, mBuilding.All())
+  {
+    BuilderComponent* bc = pending.mBuilder;
+    if (!bc->SupportsThreadedBuild())
+      continue;
+
+    Timer timer;
+    bc->BuildThreaded(options);
+    double seconds = timer.UpdateAndGetTime();
+    pending.mSeconds += seconds;
+    options.RecordBuildTime(LightningVirtualTypeId(bc)->Name, seconds);
+  }
+}
+
+void ContentComposition::FinishBuild(BuildOptions& options)
+{
+  forRange (PendingBuild& pending, mBuilding.All())
+  {
+    BuilderComponent* bc = pending.mBuilder;
+    if (bc->SupportsThreadedBuild())
+    {
+      Timer timer;
+      bc->FinishBuild(options);
+      double seconds = timer.UpdateAndGetTime();
+      pending.mSeconds += seconds;
+      options.RecordBuildTime(LightningVirtualTypeId(bc)->Name, seconds);
+    }
+
+    if (!options.Failure && !pending.mCacheKey.Empty())
+    {
+      // Building can update the meta file (e.g. the TextureInfo written by
+      // the TextureBuilder) and the meta file is part of the key, so the
+      // entry is stored under the key the next build will compute
+      String cacheKey = ComputeBuildCacheKey(bc, options);
+      if (!cacheKey.Empty())
+      {
+        Array<String> outputFiles;
+        GetBuildCacheOutputs(bc, outputFiles);
+        PL::gContentSystem->BuildCache.Store(cacheKey, options.OutputPath, outputFiles, pending.mSeconds);
+      }
     }
   }
 
-  if (anyBuilt)
+  if (!mBuilding.Empty())
     PlasmaPrint("Built %s\n", Filename.c_str());
+  mBuilding.Clear();
+}
+
+bool ContentComposition::RestoreFromBuildCache(BuilderComponent* builder, BuildOptions& options, String& cacheKey)
+{
+  ContentBuildCache& cache = PL::gContentSystem->BuildCache;
+  cacheKey = ComputeBuildCacheKey(builder, options);
+  if (cacheKey.Empty())
+    return false;
+
+  Array<String> outputFiles;
+  GetBuildCacheOutputs(builder, outputFiles);
+
+  double buildSeconds = 0.0;
+  if (!cache.Restore(cacheKey, options.OutputPath, outputFiles, buildSeconds))
+  {
+    ++options.CacheMisses;
+    return false;
+  }
+
+  ++options.CacheHits;
+  options.CacheSecondsSaved += buildSeconds;
+  return true;
+}
+
+String ContentComposition::ComputeBuildCacheKey(BuilderComponent* builder, BuildOptions& options)
+{
+  ContentBuildCache& cache = PL::gContentSystem->BuildCache;
+  uint version = builder->GetBuildCacheVersion();
+  if (!cache.IsEnabled() || version == 0)
+    return String();
+
+  String sourceFile = FilePath::Combine(options.SourcePath, Filename);
+  return cache.ComputeKey(sourceFile, LightningVirtualTypeId(builder)->Name, version);
 }
 
 void ContentComposition::Serialize(Serializer& stream)
@@ -76,6 +76,10 @@ public:
   void BuildListing(ResourceListing& listing) override;
   void OnInitialize() override;
   ContentComponent* QueryComponentId(BoundType* typeId) override;
+  bool SupportsThreadedBuild() override;
+  void PrepareBuild(BuildOptions& options) override;
+  void BuildThreaded(BuildOptions& options) override;
+  void FinishBuild(BuildOptions& options) override;
 
   void RemoveComponent(BoundType* componentType);
 
@@ -93,6 +97,23 @@ public:
   // is desired, other times all components (including builders)
   // need to undergo an operation.
   Array<BuilderComponent*> Builders;
+
+  struct PendingBuild
+  {
+    BuilderComponent* mBuilder;
+    // Key the output was looked up with in the content build cache (empty if
+    // the output is not cached).
+    String mCacheKey;
+    double mSeconds;
+  };
+
+  // Builders that needed building in the build in progress.
+  Array<PendingBuild> mBuilding;
+
+private:
+  bool RestoreFromBuildCache(BuilderComponent* builder, BuildOptions& options, String& cacheKey);
+  /// Returns an empty key if the builder's output is not cached.
+  String ComputeBuildCacheKey(BuilderComponent* builder, BuildOptions& options);
 };
 
 /// Builder component is a content component that builds resources.
@@ -114,6 +135,33 @@ public:
   {
   }
 
+  // Builders that do expensive work (decoding, compressing, encoding) can
+  // return true to have that work done on a job thread. BuildContent is then
+  // replaced by PrepareBuild and FinishBuild on the main thread with
+  // BuildThreaded on a job thread in between.
+  virtual bool SupportsThreadedBuild()
+  {
+    return false;
+  }
+  virtual void PrepareBuild(BuildOptions& buildOptions)
+  {
+  }
+  virtual void BuildThreaded(BuildOptions& buildOptions)
+  {
+  }
+  virtual void FinishBuild(BuildOptions& buildOptions)
+  {
+  }
+
+  // Builders whose outputs only depend on the source file and the settings in
+  // the meta file can return a version above 0 to have their outputs stored in
+  // and restored from the content build cache. The version must be
+  // incremented whenever the builder's output changes.
+  virtual uint GetBuildCacheVersion()
+  {
+    return 0;
+  }
+
   // Add built resources to listing.
   virtual void BuildListing(ResourceListing& listing);
 
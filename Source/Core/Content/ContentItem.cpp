@@ -210,6 +210,23 @@ void ContentItem::BuildListing(ResourceListing& listing)
 {
 }
 
+bool ContentItem::SupportsThreadedBuild()
+{
+  return false;
+}
+
+void ContentItem::PrepareBuild(BuildOptions& buildOptions)
+{
+}
+
+void ContentItem::BuildThreaded(BuildOptions& buildOptions)
+{
+}
+
+void ContentItem::FinishBuild(BuildOptions& buildOptions)
+{
+}
+
 void ContentItem::Serialize(Serializer& stream)
 {
 }
@@ -24,6 +24,7 @@ class ContentItem : public EventObject
 {
 public:
   LightningDeclareType(ContentItem, TypeCopyMode::ReferenceType);
+  friend class ContentSystem;
 
   ContentItem();
   virtual ~ContentItem();
@@ -99,6 +100,17 @@ public:
   // Build the resource listing that this content item makes
   virtual void BuildListing(ResourceListing& listing);
 
+  // Threaded Build Interface
+  // Items that return true from SupportsThreadedBuild are built in three
+  // steps instead of through BuildContentItem. PrepareBuild and FinishBuild
+  // run on the main thread in build order, BuildThreaded runs on a job thread
+  // (in parallel with other items) and must only touch the item's own
+  // builders and output files.
+  virtual bool SupportsThreadedBuild();
+  virtual void PrepareBuild(BuildOptions& buildOptions);
+  virtual void BuildThreaded(BuildOptions& buildOptions);
+  virtual void FinishBuild(BuildOptions& buildOptions);
+
   // Serialize this content item.
   virtual void Serialize(Serializer& stream);
 
@@ -32,6 +32,7 @@ public:
 #include "ContentItem.hpp"
 #include "ContentLibrary.hpp"
 #include "BuildOptions.hpp"
+#include "ContentBuildCache.hpp"
 #include "ContentSystem.hpp"
 #include "ContentUtility.hpp"
 #include "ContentComposition.hpp"
@@ -232,7 +232,7 @@ HandleOf<ResourcePackage> ContentSystem::BuildLibrary(Status& status, ContentLib
   Array<ContentItem*> items;
   items.Reserve(library->ContentItems.Size());
   items.Append(library->ContentItems.Values());
-  HandleOf<ResourcePackage> package = PL::gContentSystem->BuildContentItems(status, items, library, false);
+  HandleOf<ResourcePackage> package = PL::gContentSystem->BuildContentItems(status, items, library, true);
 
   String libraryPackageFile = FilePath::CombineWithExtension(outputPath, library->Name, ".pack");
   package->Save(libraryPackageFile);
@@ -741,6 +741,156 @@ ContentItem* ContentSystem::CreateFromName(StringRange name)
   return nullptr;
 }
 
+// Content Build Queue
+// At most this many jobs build content at once. Content builders may queue
+// jobs of their own (e.g. cubemap filtering) and wait on them, so some job
+// threads are always left free for those.
+const uint cMaxContentBuildJobs = 4;
+
+/// A content item being built by BuildContentItems.
+struct ContentBuildTask
+{
+  ContentBuildTask(ContentItem* item, ContentLibrary* library) : mItem(item), mOptions(library), mThreaded(false)
+  {
+  }
+
+  ContentItem* mItem;
+  BuildOptions mOptions;
+  /// Built through the threaded build interface.
+  bool mThreaded;
+};
+
+/// Items are pushed once they've been prepared on the main thread and taken
+/// off by the content build jobs. After every item has been pushed the main
+/// thread takes items as well until none are left.
+class ContentBuildQueue
+{
+public:
+  ContentBuildQueue() : mNext(0)
+  {
+  }
+
+  void Push(ContentBuildTask* task)
+  {
+    mLock.Lock();
+    mTasks.PushBack(task);
+    mLock.Unlock();
+    mAvailable.Increment();
+  }
+
+  /// Wakes the given number of jobs so they see that the queue is empty.
+  void Close(uint jobCount)
+  {
+    for (uint i = 0; i < jobCount; ++i)
+      mAvailable.Increment();
+  }
+
+  /// Returns null if every task has been taken.
+  ContentBuildTask* TakeNext()
+  {
+    ContentBuildTask* task = nullptr;
+    mLock.Lock();
+    if (mNext < mTasks.Size())
+      task = mTasks[mNext++];
+    mLock.Unlock();
+    return task;
+  }
+
+  ThreadLock mLock;
+  Array<ContentBuildTask*> mTasks;
+  size_t mNext;
+  Semaphore mAvailable;
+  CountdownEvent mJobsRunning;
+};
+
+class ContentBuildJob : public Job
+{
+public:
+  ContentBuildJob(ContentBuildQueue* queue) : mQueue(queue)
+  {
+  }
+
+  void Execute() override
+  {
+    ZoneScoped;
+    for (;;)
+    {
+      mQueue->mAvailable.WaitAndDecrement();
+      ContentBuildTask* task = mQueue->TakeNext();
+      if (task == nullptr)
+        break;
+
+      task->mItem->BuildThreaded(task->mOptions);
+    }
+
+    mQueue->mJobsRunning.DecrementCount();
+  }
+
+  ContentBuildQueue* mQueue;
+};
+
+struct ContentBuildTime
+{
+  ContentBuildTime() : mCount(0), mSeconds(0.0)
+  {
+  }
+
+  String mBuilderType;
+  uint mCount;
+  double mSeconds;
+};
+
+struct SortBySlowest
+{
+  bool operator()(const ContentBuildTime& left, const ContentBuildTime& right)
+  {
+    return left.mSeconds > right.mSeconds || (left.mSeconds == right.mSeconds && left.mBuilderType < right.mBuilderType);
+  }
+};
+
+void PrintContentBuildReport(ContentLibrary* library, Array<ContentBuildTask>& tasks, double wallSeconds)
+{
+  HashMap<String, ContentBuildTime> times;
+  uint cacheHits = 0;
+  uint cacheMisses = 0;
+  double cacheSecondsSaved = 0.0;
+  forRange (ContentBuildTask& task, tasks.All())
+  {
+    forRange (auto& entry, task.mOptions.BuildTimes.All())
+    {
+      ContentBuildTime& time = times[entry.first];
+      time.mBuilderType = entry.first;
+      ++time.mCount;
+      time.mSeconds += entry.second;
+    }
+
+    cacheHits += task.mOptions.CacheHits;
+    cacheMisses += task.mOptions.CacheMisses;
+    cacheSecondsSaved += task.mOptions.CacheSecondsSaved;
+  }
+
+  if (times.Empty() && cacheHits == 0)
+    return;
+
+  Array<ContentBuildTime> sorted;
+  sorted.Append(times.Values());
+  Sort(sorted.All(), SortBySlowest());
+
+  PlasmaPrint("Content build times for '%s' (%.3fs):\n", library->Name.c_str(), wallSeconds);
+  forRange (ContentBuildTime& time, sorted.All())
+    PlasmaPrint("  %-24s %5u built %9.3fs\n", time.mBuilderType.c_str(), time.mCount, time.mSeconds);
+
+  uint cacheLookups = cacheHits + cacheMisses;
+  if (cacheLookups != 0)
+  {
+    PlasmaPrint("  Build cache: %u of %u restored (%.1f%% hit rate), %.3fs of building saved\n",
+                cacheHits,
+                cacheLookups,
+                100.0 * cacheHits / cacheLookups,
+                cacheSecondsSaved);
+  }
+}
+
 HandleOf<ResourcePackage>
 ContentSystem::BuildContentItems(Status& status, ContentItemArray& toBuild, ContentLibrary* library, bool useJobs)
 {
@@ -754,10 +904,17 @@ ContentSystem::BuildContentItems(Status& status, ContentItemArray& toBuild, Cont
   package->Location = library->GetOutputPath();
   CreateDirectoryAndParents(package->Location);
 
-  BuildOptions buildOptions(library);
+  Timer timer;
+  bool threaded = useJobs && ThreadingEnabled;
 
-  bool allBuilt = true;
+  // Reserved up front so the queue can point at the tasks
+  Array<ContentBuildTask> tasks;
+  tasks.Reserve(toBuild.Size());
+  ContentBuildQueue queue;
+  uint jobCount = 0;
 
+  // Items that can't be threaded are built here in order while the threaded
+  // items are picked up by jobs as soon as they've been prepared
   for (uint i = 0; i < toBuild.Size(); ++i)
   {
     // Process from this contentItem down.
@@ -766,13 +923,47 @@ ContentSystem::BuildContentItems(Status& status, ContentItemArray& toBuild, Cont
     PL::gEngine->LoadingUpdate(
             cProcessing, library->Name, contentItem->Filename, ProgressType::Normal, (float)(i + 1) / toBuild.Size());
 
-    contentItem->BuildContentItem(useJobs);
+    tasks.PushBack(ContentBuildTask(contentItem, library));
+    ContentBuildTask& task = tasks.Back();
+    task.mThreaded = threaded && contentItem->SupportsThreadedBuild();
+
+    if (task.mThreaded)
+    {
+      contentItem->PrepareBuild(task.mOptions);
+      queue.Push(&task);
 
-    if (buildOptions.Failure)
+      if (jobCount < cMaxContentBuildJobs)
+      {
+        ++jobCount;
+        queue.mJobsRunning.IncrementCount();
+        PL::gJobs->AddJob(new ContentBuildJob(&queue));
+      }
+    }
+    else
     {
-      PlasmaPrint("Content Build Failed, %s\n", buildOptions.Message.c_str());
-      buildOptions.Failure = false;
-      buildOptions.Message = String();
+      ZoneScopedN("BuildContentItem");
+      ProfileScopeFunctionArgs(contentItem->Filename);
+      contentItem->BuildContentItem(task.mOptions);
+    }
+  }
+
+  // Help build whatever is left, then wait for the jobs to finish their items
+  queue.Close(jobCount);
+  while (ContentBuildTask* task = queue.TakeNext())
+    task->mItem->BuildThreaded(task->mOptions);
+  queue.mJobsRunning.Wait();
+
+  // Finish in build order so the package doesn't depend on how the jobs ran
+  bool allBuilt = true;
+  forRange (ContentBuildTask& task, tasks.All())
+  {
+    ContentItem* contentItem = task.mItem;
+    if (task.mThreaded)
+      contentItem->FinishBuild(task.mOptions);
+
+    if (task.mOptions.Failure)
+    {
+      PlasmaPrint("Content Build Failed, %s\n", task.mOptions.Message.c_str());
       allBuilt = false;
     }
 
@@ -785,6 +976,8 @@ ContentSystem::BuildContentItems(Status& status, ContentItemArray& toBuild, Cont
 
   Sort(package->Resources.All(), SortByLoadOrder());
 
+  PrintContentBuildReport(library, tasks, timer.UpdateAndGetTime());
+
   if (!allBuilt)
     status.SetFailed(String::Format("Failed to build content library '%s'", library->Name.c_str()));
 
@@ -205,6 +205,9 @@ public:
   String PrebuiltContentPath;
   /// Where the tools (curl, crash handler, etc) are located
   String ToolPath;
+  /// Built content shared between checkouts and machines (disabled unless a
+  /// directory is set).
+  ContentBuildCache BuildCache;
 
   HashSet<ContentItemId> mModifiedContentItems;
 
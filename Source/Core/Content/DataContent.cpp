@@ -64,6 +64,11 @@ String DataBuilder::GetOutputFile()
   return mOwner->Filename;
 }
 
+bool DataBuilder::ShouldCook()
+{
+  return LoaderType == "Level" || LoaderType == "Cog" || LoaderType == "Space" || LoaderType == "GameSession";
+}
+
 void DataBuilder::Generate(ContentInitializer& initializer)
 {
   // For DataBuilders a ResourceId can be provided
@@ -94,6 +99,12 @@ bool DataBuilder::NeedsBuilding(BuildOptions& options)
 {
   String destFile = FilePath::Combine(options.OutputPath, GetOutputFile());
   String sourceFile = FilePath::Combine(options.SourcePath, mOwner->Filename);
+
+  // Cooked files never match the size of the source, so only the time stamps
+  // and the cooked format version are checked
+  if (ShouldCook())
+    return CheckFileAndMeta(options, sourceFile, destFile) || !IsCookedDataFileCurrent(destFile);
+
   return CheckFileMetaAndSize(options, sourceFile, destFile);
 }
 
@@ -101,9 +112,18 @@ void DataBuilder::BuildContent(BuildOptions& buildOptions)
 {
   String destFile = FilePath::Combine(buildOptions.OutputPath, GetOutputFile());
   String sourceFile = FilePath::Combine(buildOptions.SourcePath, mOwner->Filename);
-  bool fileCopied = CopyFile(destFile, sourceFile);
 
-  if (!fileCopied)
+  if (ShouldCook())
+  {
+    Status status;
+    if (!CookDataFile(status, sourceFile, destFile))
+    {
+      buildOptions.Failure = true;
+      buildOptions.Message = status.Message;
+      return;
+    }
+  }
+  else if (!CopyFile(destFile, sourceFile))
   {
     buildOptions.Failure = true;
     buildOptions.Message = String::Format("Failed to copy data file %s to %s", sourceFile.c_str(), destFile.c_str());
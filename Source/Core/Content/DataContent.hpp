@@ -31,6 +31,10 @@ public:
 
   String GetOutputFile();
 
+  /// Levels and Archetypes are written to the output in the cooked binary data
+  /// format instead of being copied.
+  bool ShouldCook();
+
   // BuilderComponent Interface
   void Generate(ContentInitializer& initializer) override;
   void Serialize(Serializer& stream) override;
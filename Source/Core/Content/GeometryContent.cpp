@@ -511,8 +511,33 @@ void GeometryContent::BuildContentItem(BuildOptions& options)
   if (needToBuild)
   {
     String fullFilePath = FilePath::Combine(options.SourcePath, Filename);
+
+    // Every builder's output comes out of the same import so they are cached
+    // together
+    ContentBuildCache& cache = PL::gContentSystem->BuildCache;
+    String cacheKey;
+    Array<String> outputFiles;
+    if (cache.IsEnabled())
+    {
+      cacheKey = cache.ComputeKey(fullFilePath, LightningVirtualTypeId(this)->Name, MeshFileVersion);
+      forRange (BuilderComponent* bc, Builders.All())
+        GetBuildCacheOutputs(bc, outputFiles);
+
+      double buildSeconds = 0.0;
+      if (cache.Restore(cacheKey, options.OutputPath, outputFiles, buildSeconds))
+      {
+        ++options.CacheHits;
+        options.CacheSecondsSaved += buildSeconds;
+        return;
+      }
+      ++options.CacheMisses;
+    }
+
     GeometryImporter importer(fullFilePath, options.OutputPath, String());
+    Timer timer;
     GeometryProcessorCodes::Enum result = importer.ProcessModelFiles();
+    double buildSeconds = timer.UpdateAndGetTime();
+    options.RecordBuildTime(LightningVirtualTypeId(this)->Name, buildSeconds);
 
     bool needsLoading = false;
     switch (result)
@@ -532,6 +557,7 @@ void GeometryContent::BuildContentItem(BuildOptions& options)
     }
     // it worked
     case Plasma::GeometryProcessorCodes::Success:
+      cache.Store(cacheKey, options.OutputPath, outputFiles, buildSeconds);
       return;
     // something went wrong, abort processing imported file.
     // the geometry processor outputs its own error messages to the console.
@@ -14,13 +14,9 @@ ImageContent::ImageContent()
   mReload = false;
 }
 
-void ImageContent::BuildContentItem(BuildOptions& options)
+void ImageContent::FinishBuild(BuildOptions& options)
 {
-  forRange (BuilderComponent* bc, Builders.All())
-  {
-    if (bc->NeedsBuilding(options))
-      bc->BuildContent(options);
-  }
+  ContentComposition::FinishBuild(options);
 
   if (mReload)
   {
@@ -103,42 +103,30 @@ void PhysicsMeshProcessor::WriteConvexMesh(VertexPositionArray& vertices, IndexA
 
 void PhysicsMeshProcessor::WriteAabbTree(VertexPositionArray& vertices, IndexArray& indices, Serializer& saver)
 {
-  // Build the Aabb-Tree
-  StaticAabbTree<uint> aabbTree;
-  aabbTree.SetPartitionMethod(PartitionMethods::MinimizeVolumeSum);
-
-  // Dummy proxy. They will not be needed.
-  BroadPhaseProxy proxy;
-
-  // Populate the Aabb-Tree
-  for (uint i = 0; i < indices.Size(); i += 3)
+  // Gather the Aabb of each triangle (in triangle order so the tree reports triangle indices)
+  Array<Aabb> triangleAabbs;
+  triangleAabbs.Resize(indices.Size() / 3);
+  for (uint i = 0; i < triangleAabbs.Size(); ++i)
   {
     // Grab the vertices of the triangle
     Vec3 p0, p1, p2;
-    p0 = vertices[indices[i]];
-    p1 = vertices[indices[i + 1]];
-    p2 = vertices[indices[i + 2]];
+    p0 = vertices[indices[i * 3]];
+    p1 = vertices[indices[i * 3 + 1]];
+    p2 = vertices[indices[i * 3 + 2]];
 
     // Build the Aabb of the triangle
-    Aabb aabb;
+    Aabb& aabb = triangleAabbs[i];
     aabb.Compute(p0);
     aabb.Expand(p1);
     aabb.Expand(p2);
-
-    // Create the broad phase data.
-    BaseBroadPhaseData<uint> data;
-    data.mClientData = i;
-    data.mAabb = aabb;
-
-    // Insert it into the tree
-    aabbTree.CreateProxy(proxy, data);
   }
 
-  // Construct the tree
-  aabbTree.Construct();
+  // Build the tree here so that loading the mesh doesn't have to
+  QuantizedAabbTree aabbTree;
+  aabbTree.Build(triangleAabbs);
 
   // Save the tree
-  SerializeAabbTree(saver, aabbTree);
+  aabbTree.Serialize(saver);
 }
 
 uint PhysicsMeshProcessor::RemoveDegenerateTriangles(VertexPositionArray& vertices, IndexArray& indicies)
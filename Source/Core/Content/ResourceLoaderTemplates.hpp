@@ -155,14 +155,14 @@ public:
   {
     ResourceType* newResource = new ResourceType();
 
-    ChunkFileReader reader;
-    reader.Open(entry.FullPath);
+    MappedFile mappedFile;
+    mappedFile.Open(entry.FullPath, FileAccessPattern::Sequential);
+    ChunkBufferReader reader;
+    reader.Open(mappedFile);
 
     LoadPattern::Load(newResource, reader);
 
     ResourceMananger::GetInstance()->AddResource(entry, newResource);
-
-    reader.Close();
     return newResource;
   }
 
@@ -185,13 +185,45 @@ public:
     ResourceType* newResource = (ResourceType*)resource;
     newResource->Unload();
 
-    ChunkFileReader reader;
-    reader.Open(entry.FullPath);
+    MappedFile mappedFile;
+    mappedFile.Open(entry.FullPath, FileAccessPattern::Sequential);
+    ChunkBufferReader reader;
+    reader.Open(mappedFile);
 
     LoadPattern::Load(newResource, reader);
 
     resource->SendModified();
   }
+
+  // Chunk files are only decoded into the resource's own memory, so they can
+  // be read on a job and registered afterwards.
+  bool SupportsThreadedLoad() override
+  {
+    return true;
+  }
+
+  Resource* PrepareFromFile(ResourceEntry& entry) override
+  {
+    ResourceType* newResource = new ResourceType();
+
+    MappedFile mappedFile;
+    mappedFile.Open(entry.FullPath, FileAccessPattern::Sequential);
+    ChunkBufferReader reader;
+    reader.Open(mappedFile);
+
+    LoadPattern::Load(newResource, reader);
+    return newResource;
+  }
+
+  HandleOf<Resource> CommitFromFile(ResourceEntry& entry, Resource* prepared) override
+  {
+    if (prepared == nullptr)
+      return nullptr;
+
+    ResourceType* newResource = (ResourceType*)prepared;
+    ResourceMananger::GetInstance()->AddResource(entry, newResource);
+    return newResource;
+  }
 };
 
 } // namespace Plasma
@@ -119,6 +119,15 @@ void TextureBuilder::Serialize(Serializer& stream)
   SerializeNameDefault(mGammaCorrection, false);
 }
 
+TextureBuilder::TextureBuilder() : mImporter(nullptr)
+{
+}
+
+TextureBuilder::~TextureBuilder()
+{
+  delete mImporter;
+}
+
 void TextureBuilder::Initialize(ContentComposition* item)
 {
   BuilderComponent::Initialize(item);
@@ -200,14 +209,55 @@ void TextureBuilder::BuildListing(ResourceListing& listing)
 }
 
 void TextureBuilder::BuildContent(BuildOptions& buildOptions)
+{
+  PrepareBuild(buildOptions);
+  BuildThreaded(buildOptions);
+  FinishBuild(buildOptions);
+}
+
+bool TextureBuilder::SupportsThreadedBuild()
+{
+  return true;
+}
+
+uint TextureBuilder::GetBuildCacheVersion()
+{
+  return TextureFileVersion;
+}
+
+void TextureBuilder::PrepareBuild(BuildOptions& buildOptions)
 {
   String inputFile = FilePath::Combine(buildOptions.SourcePath, mOwner->Filename);
   String outputFile = FilePath::Combine(buildOptions.OutputPath, GetOutputFile());
 
-  TextureImporter importer(inputFile, outputFile, String());
+  delete mImporter;
+  mImporter = new TextureImporter(inputFile, outputFile, String());
+  mImportStatus.Reset();
+
+  // Failing to load the meta file is reported in FinishBuild
+  if (!mImporter->LoadMetaFile(mImportStatus))
+  {
+    delete mImporter;
+    mImporter = nullptr;
+  }
+}
+
+void TextureBuilder::BuildThreaded(BuildOptions& buildOptions)
+{
+  // Decoding, mipmapping, and compressing the image only touches the importer
+  if (mImporter != nullptr)
+    mImporter->ProcessImage(mImportStatus);
+}
 
-  Status status;
-  ImageProcessorCodes::Enum result = importer.ProcessTexture(status);
+void TextureBuilder::FinishBuild(BuildOptions& buildOptions)
+{
+  ImageProcessorCodes::Enum result = ImageProcessorCodes::Failed;
+  if (mImporter != nullptr)
+  {
+    result = mImporter->UpdateMetaFile(mImportStatus);
+    delete mImporter;
+    mImporter = nullptr;
+  }
 
   switch (result)
   {
@@ -4,6 +4,8 @@
 namespace Plasma
 {
 
+class TextureImporter;
+
 const String PTexLoader = "TexturePTex";
 
 const uint TextureFileId = 'ptex';
@@ -74,6 +76,9 @@ class TextureBuilder : public BuilderComponent
 public:
   LightningDeclareType(TextureBuilder, TypeCopyMode::ReferenceType);
 
+  TextureBuilder();
+  ~TextureBuilder();
+
   // BuilderComponent Interface
 
   void Serialize(Serializer& stream) override;
@@ -83,6 +88,11 @@ public:
   void BuildListing(ResourceListing& listing) override;
   void BuildContent(BuildOptions& buildOptions) override;
   void Rename(StringParam newName) override;
+  bool SupportsThreadedBuild() override;
+  void PrepareBuild(BuildOptions& buildOptions) override;
+  void BuildThreaded(BuildOptions& buildOptions) override;
+  void FinishBuild(BuildOptions& buildOptions) override;
+  uint GetBuildCacheVersion() override;
 
   bool AlbedoString(String name);
   bool NormalString(String name);
@@ -126,6 +136,10 @@ public:
   String GetOutputFile();
 
   ResourceId mResourceId;
+
+  // The texture being imported between PrepareBuild and FinishBuild.
+  TextureImporter* mImporter;
+  Status mImportStatus;
 };
 
 // DeclareEnum2(NormalGeneration, AverageRGB, Alpha);
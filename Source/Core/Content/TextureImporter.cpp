@@ -318,6 +318,8 @@ TextureImporter::TextureImporter(StringParam inputFile, StringParam outputFile,
 
 TextureImporter::~TextureImporter()
 {
+  delete mImageContent;
+
   for (size_t i = 0; i < mImageData.Size(); ++i)
     delete[] mImageData[i];
 
@@ -370,17 +372,26 @@ float GetCompressionRatio(TextureCompression::Enum compression)
 }
 
 ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
+{
+  if (!LoadMetaFile(status))
+    return ImageProcessorCodes::Failed;
+
+  ProcessImage(status);
+  return UpdateMetaFile(status);
+}
+
+bool TextureImporter::LoadMetaFile(Status& status)
 {
   if (!FileExists(mInputFile))
   {
     PlasmaPrint("Missing image file '%s'\n", mInputFile.c_str());
-    return ImageProcessorCodes::Failed;
+    return false;
   }
 
   if (!FileExists(mMetaFile))
   {
     PlasmaPrint("Missing meta file '%s'\n", mMetaFile.c_str());
-    return ImageProcessorCodes::Failed;
+    return false;
   }
 
   mImageContent = new ImageContent();
@@ -390,21 +401,21 @@ ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
   if (metaLoaded == false || mBuilder == nullptr)
   {
     mBuilder = nullptr;
-    delete mImageContent;
     status.SetFailed(String::Format("Failed to load meta file '%s'", mMetaFile.c_str()));
-    return ImageProcessorCodes::Failed;
+    return false;
   }
 
+  return true;
+}
+
+void TextureImporter::ProcessImage(Status& status)
+{
   String extension = FilePath::GetExtension(mInputFile);
 
   LoadImageData(status, extension);
 
   if (status.Failed())
-  {
-    mBuilder = nullptr;
-    delete mImageContent;
-    return ImageProcessorCodes::Failed;
-  }
+    return;
 
   // Progressive downsample, done before any other processing
   if (mBuilder->mHalfScaleCount > 0)
@@ -462,9 +473,6 @@ ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
     mImageData[0] = newImageData;
   }
 
-  String fileType = extension;
-  String loadFormat = TextureFormat::Names[mLoadFormat];
-
   if (mLoadFormat == TextureFormat::RGBA8)
   {
     ::byte* imageData = mImageData[0];
@@ -650,10 +658,8 @@ ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
 
       if (!result)
       {
-        mBuilder = nullptr;
-        delete mImageContent;
         status.SetFailed("Compression failed");
-        return ImageProcessorCodes::Failed;
+        return;
       }
 
       mMipHeaders[i].mWidth = width;
@@ -667,6 +673,16 @@ ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
     }
   }
 
+  WriteTextureFile(status);
+}
+
+ImageProcessorCodes::Enum TextureImporter::UpdateMetaFile(Status& status)
+{
+  if (status.Failed())
+    return ImageProcessorCodes::Failed;
+
+  String fileType = FilePath::GetExtension(mInputFile);
+  String loadFormat = TextureFormat::Names[mLoadFormat];
   String dimensions = String::Format("%d x %d", mMipHeaders[0].mWidth, mMipHeaders[0].mHeight);
 
   MipHeader& mipHeader = mMipHeaders.Back();
@@ -694,15 +710,7 @@ ImageProcessorCodes::Enum TextureImporter::ProcessTexture(Status& status)
     mMetaChanged = true;
   }
 
-  // Write output
-  WriteTextureFile(status);
-
-  mBuilder = nullptr;
-  delete mImageContent;
-
-  if (status.Failed())
-    return ImageProcessorCodes::Failed;
-  else if (mMetaChanged)
+  if (mMetaChanged)
     return ImageProcessorCodes::Reload;
   else
     return ImageProcessorCodes::Success;
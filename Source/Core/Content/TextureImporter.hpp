@@ -24,6 +24,13 @@ public:
 
   ImageProcessorCodes::Enum ProcessTexture(Status& status);
 
+  // ProcessTexture is split into these steps so the content system can run
+  // ProcessImage on a job thread. LoadMetaFile and UpdateMetaFile serialize
+  // the meta file and must run on the main thread.
+  bool LoadMetaFile(Status& status);
+  void ProcessImage(Status& status);
+  ImageProcessorCodes::Enum UpdateMetaFile(Status& status);
+
   void LoadImageData(Status& status, StringParam extension);
 
   void WriteTextureFile(Status& status);
@@ -70,6 +70,7 @@ LightningDefineType(ContentConfig, builder, type)
   type->AddAttribute(ObjectAttributes::cCore);
   LightningBindFieldProperty(ContentOutput);
   LightningBindMethodProperty(PickNewContentOutput);
+  LightningBindFieldProperty(BuildCache);
   PlasmaTodo("Change this into a warning that pops up when bContentOutputDirty is true");
   LightningBindCustomGetter(ContentPathChangedAndRequiresRestart);
 }
@@ -79,6 +80,7 @@ void ContentConfig::Serialize(Serializer& stream)
   SerializeNameDefault(ContentOutput, String());
   SerializeNameDefault(LibraryDirectories, LibraryDirectories);
   SerializeNameDefault(HistoryEnabled, true);
+  SerializeNameDefault(BuildCache, String());
 }
 
 void ContentConfig::PickNewContentOutput()
@@ -105,6 +105,11 @@ public:
 
   /// History stores files instead of deleting them
   bool HistoryEnabled;
+
+  /// Directory (can be a network share) where built content is cached by the
+  /// hash of its source and settings so it is never built twice. Empty
+  /// disables the cache. Takes effect after a restart.
+  String BuildCache;
 };
 
 /// Configuration component that Contains developer settings. Used to indicate a
@@ -54,13 +54,14 @@ public:
     if (!mData)
       return;
 
+    // The lock lives in the data, so it must be released before the data is
+    // deleted (the last reference may be released on another thread)
     mData->mLock.Lock();
-    if (--mData->mReferenceCount == 0)
-    {
-      mData->mLock.Unlock();
-      delete mData;
-    }
+    bool lastReference = (--mData->mReferenceCount == 0);
     mData->mLock.Unlock();
+
+    if (lastReference)
+      delete mData;
   }
 
   CopyOnWriteHandle& operator=(const CopyOnWriteHandle& rhs)
@@ -163,6 +163,7 @@ void Engine::Update()
     PL::gTracker->ClearDeletedObjects();
 
     PL::gJobs->RunJobsTimeSliced();
+    PL::gResources->UpdateLoading();
     PL::gDispatch->DispatchEvents();
 
     LoadPendingLevels();
@@ -62,6 +62,7 @@ private:
 #include "LightningResource.hpp"
 #include "ResourceLibrary.hpp"
 #include "JobSystem.hpp"
+#include "ResourceLoading.hpp"
 #include "EngineEvents.hpp"
 #include "System.hpp"
 #include "Time.hpp"
@@ -82,6 +82,15 @@ void LightningManager::InternalCompile()
 
   if (!mShouldAttemptCompile)
     return;
+
+  // Scripts in packages still loading in the background would be missing from
+  // the compile, so wait until they're all in
+  forRange (ResourceLibrary* resourceLibrary, PL::gResources->LoadedResourceLibraries.Values())
+  {
+    if (PL::gResources->IsLoading(resourceLibrary))
+      return;
+  }
+
   mShouldAttemptCompile = false;
 
   forRange (ResourceLibrary* resourceLibrary, PL::gResources->LoadedResourceLibraries.Values())
@@ -91,14 +100,22 @@ void LightningManager::InternalCompile()
       Event eventToSend;
       this->DispatchEvent(Events::ScriptCompilationFailed, &eventToSend);
       mLastCompileResult = CompileResult::CompilationFailed;
+
+      // Listeners of the failure only hear that scripts work again from the
+      // compiled events, so every library has to actually compile next time
+      // (e.g. when a broken script is reverted to its last compiled text)
+      forRange (ResourceLibrary* library, PL::gResources->LoadedResourceLibraries.Values())
+        library->ClearScriptFingerprint();
       return;
     }
   }
 
-  // If there are no pending libraries, nothing was compiled
-  ErrorIf(mPendingLibraries.Empty(),
-          "If the mShouldAttemptCompile flag was set, we should always have "
-          "pending libraries (even at startup with no scripts)!");
+  // If there are no pending libraries, every library was up to date
+  if (mPendingLibraries.Empty())
+  {
+    mLastCompileResult = CompileResult::CompilationSucceeded;
+    return;
+  }
 
   // Since we binary cache archetypes (in a way that is NOT saving the data
   // tree, but rather a 'known serialization format' then if we moved any
@@ -185,7 +185,7 @@ LightningDefineType(ResourceLibrary, builder, type)
 {
 }
 
-ResourceLibrary::ResourceLibrary()
+ResourceLibrary::ResourceLibrary() : mLoadSeconds(0.0)
 {
   Resources.Reserve(256);
 
@@ -429,6 +429,19 @@ void ResourceLibrary::PluginsModified()
   ScriptsModified();
 }
 
+bool SameLibraries(Module& left, Module& right)
+{
+  if (left.Size() != right.Size())
+    return false;
+
+  for (size_t i = 0; i < left.Size(); ++i)
+  {
+    if (left[i] != right[i])
+      return false;
+  }
+  return true;
+}
+
 bool AddDependencies(Module& module,
                      ResourceLibrary* library,
                      HashSet<ResourceLibrary*>& modifiedLibrariesOut,
@@ -533,6 +546,32 @@ bool ResourceLibrary::CompileScripts(HashSet<ResourceLibrary*>& modifiedLibrarie
       dependencies.Append(pluginLibrary);
   }
 
+  // Hash every script that will be compiled. Templates shouldn't be compiled.
+  // They contain potentially invalid code and identifiers such as
+  // RESOURCE_NAME_ that are replaced when a new resource is created from the
+  // template
+  Lightning::Sha1Builder sourceHash;
+  forRange (LightningDocumentResource* script, mScripts)
+  {
+    if (script->GetResourceTemplate() == nullptr)
+    {
+      sourceHash.Append(BuildString(script->GetOrigin(), ":"));
+      sourceHash.Append(script->mText);
+    }
+  }
+  String scriptSourceHash = sourceHash.OutputHashString();
+
+  // Scripts are often marked as modified without any change that affects the
+  // library (e.g. a script saved without edits). If the sources and every
+  // library compiled against are the same, the current library is kept.
+  if (mSwapScript.mCurrentLibrary != nullptr && mSwapScript.mPendingLibrary == nullptr &&
+      scriptSourceHash == mScriptSourceHash && SameLibraries(dependencies, mScriptDependencies))
+  {
+    PlasmaPrint("  %s Scripts are unchanged\n", this->Name.c_str());
+    mSwapScript.mCompileStatus = LightningCompileStatus::Compiled;
+    return true;
+  }
+
   // By this point, we've already compiled all our dependencies
   PlasmaPrint("  Compiling %s Scripts\n", this->Name.c_str());
 
@@ -542,9 +581,6 @@ bool ResourceLibrary::CompileScripts(HashSet<ResourceLibrary*>& modifiedLibrarie
   // Add all scripts
   forRange (LightningDocumentResource* script, mScripts)
   {
-    // Templates shouldn't be compiled. They contain potentially invalid code
-    // and identifiers such as RESOURCE_NAME_ that are replaced when a new
-    // resource is created from the template
     if (script->GetResourceTemplate() == nullptr)
       mScriptProject.AddCodeFromString(script->mText, script->GetOrigin(), script);
   }
@@ -555,12 +591,26 @@ bool ResourceLibrary::CompileScripts(HashSet<ResourceLibrary*>& modifiedLibrarie
   {
     modifiedLibrariesOut.Insert(this);
     mSwapScript.mCompileStatus = LightningCompileStatus::Compiled;
+
+    // The references also keep the libraries alive, so a library compiled
+    // later can never be mistaken for one of these. They only describe the
+    // current library once the pending library is committed.
+    mPendingScriptSourceHash = scriptSourceHash;
+    mPendingScriptDependencies = dependencies;
     return true;
   }
 
+  mPendingScriptSourceHash.Clear();
+  mPendingScriptDependencies.Clear();
   return false;
 }
 
+void ResourceLibrary::ClearScriptFingerprint()
+{
+  mScriptSourceHash.Clear();
+  mScriptDependencies.Clear();
+}
+
 bool ResourceLibrary::CompileFragments(HashSet<ResourceLibrary*>& modifiedLibraries)
 {
   // If we already compiled, then we know that all dependent libraries must have
@@ -671,6 +721,13 @@ void ResourceLibrary::Commit()
   }
 
   // Replace the script library
+  if (mSwapScript.mPendingLibrary)
+  {
+    mScriptSourceHash = mPendingScriptSourceHash;
+    mScriptDependencies = mPendingScriptDependencies;
+    mPendingScriptSourceHash.Clear();
+    mPendingScriptDependencies.Clear();
+  }
   mSwapScript.Commit();
 }
 
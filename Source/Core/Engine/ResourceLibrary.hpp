@@ -189,6 +189,9 @@ public:
   bool CompileScripts(HashSet<ResourceLibrary*>& modifiedLibrariesOut);
   bool CompileFragments(HashSet<ResourceLibrary*>& modifiedLibrariesOut);
   bool CompilePlugins(HashSet<ResourceLibrary*>& modifiedLibrariesOut);
+  // Forgets what the current script library was compiled from so the next
+  // compile can't be skipped
+  void ClearScriptFingerprint();
 
   void OnScriptProjectPreParser(ParseEvent* e);
   void OnScriptProjectPostSyntaxer(ParseEvent* e);
@@ -202,6 +205,10 @@ public:
   String Name;
   String Location;
 
+  /// Seconds it took to load the package (from being requested to the last
+  /// resource being committed).
+  double mLoadSeconds;
+
   // All the resource libraries that we are dependent upon
   // This must form a DAG (cycles are not allowed) where the core set is the
   // root
@@ -232,6 +239,16 @@ public:
   // We need this to stick around for the Lightning debugger
   Project mScriptProject;
 
+  // Hash of the script sources and the libraries the current script library
+  // was compiled from. Used to skip compiling when nothing changed. These only
+  // last for the session: compiled libraries point at native types and
+  // functions, so they can't be saved and reloaded on a later startup.
+  String mScriptSourceHash;
+  Module mScriptDependencies;
+  // The same for the pending script library, moved over when it's committed.
+  String mPendingScriptSourceHash;
+  Module mPendingScriptDependencies;
+
   // All loaded resources. These handles are the ones in charge of keeping the
   // Resources in this library alive.
   Array<HandleOf<Resource>> Resources;
@@ -0,0 +1,156 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+// Resource Load Task
+ResourceLoadTask::ResourceLoadTask() :
+    mLoader(nullptr),
+    mPrepared(nullptr),
+    mPriority(ResourceLoadPriority::Normal),
+    mState(ResourceLoadState::Queued)
+{
+}
+
+void ResourceLoadTask::Prepare()
+{
+  ZoneScoped;
+  ProfileScopeFunctionArgs(mEntry.Name);
+
+  if (mLoader == nullptr)
+    return;
+
+  if (mLoader->SupportsThreadedLoad())
+    mPrepared = mLoader->PrepareFromFile(mEntry);
+  else
+    PrefetchResourceFile(mEntry.FullPath);
+}
+
+// Resource Load Request
+ResourceLoadRequest::ResourceLoadRequest(ResourceLibrary* library, StringParam packageName) :
+    mLibrary(library),
+    mPackageName(packageName),
+    mNextCommit(0),
+    mPriority(ResourceLoadPriority::Normal),
+    mIsNew(false),
+    mPlaceholders(false)
+{
+  mTimer.Reset();
+}
+
+ResourceLoadRequest::~ResourceLoadRequest()
+{
+  // Resources prepared but never committed were never registered
+  for (uint i = mNextCommit; i < mTasks.Size(); ++i)
+    delete mTasks[i].mPrepared;
+}
+
+bool ResourceLoadRequest::IsFinished()
+{
+  return mNextCommit == mTasks.Size();
+}
+
+// Resource Load Queue
+void ResourceLoadQueue::Push(ResourceLoadTask* task)
+{
+  mLock.Lock();
+  mQueued[task->mPriority].PushBack(task);
+  mLock.Unlock();
+}
+
+ResourceLoadTask* ResourceLoadQueue::TakeNext()
+{
+  ResourceLoadTask* task = nullptr;
+  mLock.Lock();
+  for (int priority = ResourceLoadPriority::Size - 1; priority >= 0 && task == nullptr; --priority)
+  {
+    Array<ResourceLoadTask*>& queued = mQueued[priority];
+    if (!queued.Empty())
+    {
+      task = queued.Front();
+      queued.PopFront();
+      task->mState.Store(ResourceLoadState::Preparing);
+    }
+  }
+  mLock.Unlock();
+  return task;
+}
+
+bool ResourceLoadQueue::Take(ResourceLoadTask* task)
+{
+  bool taken = false;
+  mLock.Lock();
+  if (task->mState.Load() == ResourceLoadState::Queued)
+  {
+    mQueued[task->mPriority].EraseValue(task);
+    task->mState.Store(ResourceLoadState::Preparing);
+    taken = true;
+  }
+  mLock.Unlock();
+  return taken;
+}
+
+void ResourceLoadQueue::Raise(ResourceLoadTask* task, ResourceLoadPriority::Enum priority)
+{
+  mLock.Lock();
+  if (task->mState.Load() == ResourceLoadState::Queued && task->mPriority < priority)
+  {
+    mQueued[task->mPriority].EraseValue(task);
+    task->mPriority = priority;
+    mQueued[priority].PushBack(task);
+  }
+  mLock.Unlock();
+}
+
+void ResourceLoadQueue::WaitForTask(ResourceLoadTask* task)
+{
+  if (Take(task))
+  {
+    task->Prepare();
+    task->mState.Store(ResourceLoadState::Prepared);
+    return;
+  }
+
+  // Every prepared task signals, so keep waiting until it's this one
+  while (task->mState.Load() != ResourceLoadState::Prepared)
+    mPrepared.WaitAndDecrement();
+}
+
+void ResourceLoadQueue::TaskPrepared(ResourceLoadTask* task)
+{
+  task->mState.Store(ResourceLoadState::Prepared);
+  mPrepared.Increment();
+}
+
+// Resource Load Job
+ResourceLoadJob::ResourceLoadJob(ResourceLoadQueue* queue) : mQueue(queue)
+{
+}
+
+void ResourceLoadJob::Execute()
+{
+  ZoneScoped;
+  if (ResourceLoadTask* task = mQueue->TakeNext())
+  {
+    task->Prepare();
+    mQueue->TaskPrepared(task);
+  }
+}
+
+void PrefetchResourceFile(StringParam fileName)
+{
+  MappedFile file;
+  if (!file.Open(fileName, FileAccessPattern::Sequential))
+    return;
+
+  // Touching one byte per page is enough to have the whole page read in
+  const size_t cPageSize = 4096;
+  const ::byte* data = file.Data();
+  size_t size = file.Size();
+  volatile ::byte touched = 0;
+  for (size_t i = 0; i < size; i += cPageSize)
+    touched = data[i];
+}
+
+} // namespace Plasma
@@ -0,0 +1,132 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+class ResourceLoader;
+class ResourceLibrary;
+
+/// How soon a resource loading in the background is needed. Higher priority
+/// entries are read and decoded first.
+DeclareEnum3(ResourceLoadPriority, Low, Normal, High);
+
+/// Progress of a resource library being loaded.
+struct ResourceLoadProgress
+{
+  ResourceLoadProgress() : mTotal(0), mCommitted(0), mSeconds(0.0), mFinished(true)
+  {
+  }
+
+  /// From 0 to 1.
+  float GetPercentage()
+  {
+    return mTotal == 0 ? 1.0f : (float)mCommitted / (float)mTotal;
+  }
+
+  /// Number of resources in the package.
+  uint mTotal;
+  /// Number of resources registered so far.
+  uint mCommitted;
+  /// Seconds from the load being requested to now (or to when it finished).
+  double mSeconds;
+  bool mFinished;
+};
+
+DeclareEnum3(ResourceLoadState,
+             // Waiting in the load queue for a job
+             Queued,
+             // Being read and decoded on a job (or the main thread)
+             Preparing,
+             // Ready to be committed on the main thread
+             Prepared);
+
+/// One entry of a package being loaded.
+class ResourceLoadTask
+{
+public:
+  ResourceLoadTask();
+
+  /// Reads and decodes the entry. Called on a job thread unless threading is
+  /// disabled.
+  void Prepare();
+
+  ResourceEntry mEntry;
+  /// Null if the entry can't be loaded (the error is in mStatus).
+  ResourceLoader* mLoader;
+  /// The resource created by the loader's PrepareFromFile.
+  Resource* mPrepared;
+  Status mStatus;
+  ResourceLoadPriority::Enum mPriority;
+  Atomic<int> mState;
+};
+
+/// A resource package being loaded into a library. Entries are prepared in
+/// priority order but always committed in package order, as later entries may
+/// reference earlier ones.
+class ResourceLoadRequest
+{
+public:
+  ResourceLoadRequest(ResourceLibrary* library, StringParam packageName);
+  ~ResourceLoadRequest();
+
+  bool IsFinished();
+
+  ResourceLibrary* mLibrary;
+  String mPackageName;
+  /// Never resized once the tasks are queued.
+  Array<ResourceLoadTask> mTasks;
+  uint mNextCommit;
+  ResourceLoadPriority::Enum mPriority;
+  bool mIsNew;
+  /// Only set for background loads, whose resources get placeholders until
+  /// they're committed.
+  bool mPlaceholders;
+  Timer mTimer;
+};
+
+/// Tasks waiting to be prepared, taken by the resource load jobs highest
+/// priority first and in the order they were queued within a priority.
+class ResourceLoadQueue
+{
+public:
+  void Push(ResourceLoadTask* task);
+
+  /// Returns null if nothing is queued. The task is marked as preparing.
+  ResourceLoadTask* TakeNext();
+
+  /// Takes the given task if it's still queued so the caller can prepare it.
+  bool Take(ResourceLoadTask* task);
+
+  /// Moves a queued task to a different priority.
+  void Raise(ResourceLoadTask* task, ResourceLoadPriority::Enum priority);
+
+  /// Blocks until the task has been prepared, preparing it here if no job has
+  /// taken it yet.
+  void WaitForTask(ResourceLoadTask* task);
+
+  /// Called when a task has been prepared.
+  void TaskPrepared(ResourceLoadTask* task);
+
+private:
+  ThreadLock mLock;
+  Array<ResourceLoadTask*> mQueued[ResourceLoadPriority::Size];
+  Semaphore mPrepared;
+};
+
+/// Prepares one queued resource (not necessarily the one that queued the job).
+class ResourceLoadJob : public Job
+{
+public:
+  ResourceLoadJob(ResourceLoadQueue* queue);
+
+  void Execute() override;
+
+  ResourceLoadQueue* mQueue;
+};
+
+/// Reads the whole file so that the main thread's reads are served from the
+/// OS file cache.
+void PrefetchResourceFile(StringParam fileName);
+
+} // namespace Plasma
@@ -235,6 +235,7 @@ Resource* ResourceManager::GetResource(StringParam resourceString, ResourceNotFo
   // The reason we're using 'SizeInBytes' instead of 'ComputeRuneCount' because
   // we can guarantee that each rune is 1 byte for the hex portion of the
   // resource string
+  ResourceId pendingId = 0;
   if (resourceString.SizeInBytes() > cHex64Size + 1 && resourceString.Data()[cHex64Size] == ':')
   {
     /// Isolate Hex sub string
@@ -247,6 +248,8 @@ Resource* ResourceManager::GetResource(StringParam resourceString, ResourceNotFo
     Resource* resource = GetResourceNameOrId(stringName, resourceId);
     if (resource)
       return resource;
+
+    pendingId = resourceId;
   }
 
   // Old resource id is 16 digit hex followed by (name)
@@ -267,6 +270,8 @@ Resource* ResourceManager::GetResource(StringParam resourceString, ResourceNotFo
     Resource* resource = GetResourceNameOrId(stringName, resourceId);
     if (resource)
       return resource;
+
+    pendingId = resourceId;
   }
 
   /// Try to find Resource as a simple string
@@ -285,6 +290,9 @@ Resource* ResourceManager::GetResource(StringParam resourceString, ResourceNotFo
   if (notFound == ResourceNotFound::ReturnDefault)
     return GetDefaultResource();
 
+  if (Resource* placeholder = GetPlaceholderResource(pendingId))
+    return placeholder;
+
   // Empty string use default resource
   if (resourceString.Empty())
     return GetDefaultResource();
@@ -313,12 +321,25 @@ Resource* ResourceManager::GetResource(ResourceId resourceId, ResourceNotFound::
   if (notFound == ResourceNotFound::ReturnDefault)
     return GetDefaultResource();
 
+  if (Resource* placeholder = GetPlaceholderResource(resourceId))
+    return placeholder;
+
   // Signal the error
   MissingResource(String(), resourceId);
 
   return GetFallbackResource();
 }
 
+Resource* ResourceManager::GetPlaceholderResource(ResourceId resourceId)
+{
+  if (resourceId == 0 || !PL::gResources->IsLoadPending(resourceId))
+    return nullptr;
+
+  // Something is waiting on it so have it read before the rest of its package
+  PL::gResources->SetLoadPriority(resourceId, ResourceLoadPriority::High);
+  return GetDefaultResource();
+}
+
 Resource* ResourceManager::GetDefaultResource()
 {
   return GetResourceByName(DefaultResourceName);
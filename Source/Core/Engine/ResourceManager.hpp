@@ -59,7 +59,7 @@ public:
   OverloadedNew();
 
   // Typedefs.
-  typedef HashMap<ResourceId, Resource*> ResourceIdMapType;
+  typedef FlatHashMap<ResourceId, Resource*> ResourceIdMapType;
   typedef ResourceIdMapType::valuerange ResourceRange;
 
   // Constructor / Destructor.
@@ -182,6 +182,8 @@ private:
   Resource* GetResourceNameOrId(StringRange name, ResourceId resourceId);
   Resource* GetResourceById(ResourceId id);
   Resource* GetResourceByName(StringParam name);
+  // The default resource if the id is still being loaded in the background.
+  Resource* GetPlaceholderResource(ResourceId resourceId);
   void MissingResource(StringParam resourceName, ResourceId resourceId);
 
   // Used internally to allocated the derived resource type, do not call this
@@ -204,6 +206,24 @@ public:
   {
     return nullptr;
   }
+
+  // Loaders that can read and decode their files without touching any engine
+  // state return true to have PrepareFromFile called on a job thread. The
+  // resource it creates must not be visible to anything else until
+  // CommitFromFile registers it on the main thread. Loaders that don't support
+  // threading have their files read ahead on a job and are loaded on commit.
+  virtual bool SupportsThreadedLoad()
+  {
+    return false;
+  }
+  virtual Resource* PrepareFromFile(ResourceEntry& entry)
+  {
+    return nullptr;
+  }
+  virtual HandleOf<Resource> CommitFromFile(ResourceEntry& entry, Resource* prepared)
+  {
+    return LoadFromFile(entry);
+  }
 };
 
 // Manager Setup
@@ -23,6 +23,10 @@ LightningDefineType(ResourceSystem, builder, type)
 
   LightningBindMethod(GetResourceByName);
   LightningBindMethod(GetResourceByTypeAndName);
+  LightningBindMethod(IsLibraryLoading);
+  LightningBindMethod(GetLibraryLoadPercentage);
+  LightningBindGetterProperty(Loading);
+  LightningBindGetterProperty(LoadPercentage);
 }
 
 ResourceSystem::ResourceSystem()
@@ -153,6 +157,20 @@ ResourceLibrary* ResourceSystem::LoadPackage(Status& status, ResourcePackage* pa
   event.Path = package->Location;
   DispatchEvent(Events::PackagedStarted, &event);
 
+  ResourceLibrary* resourceLibrary = CreateLibrary(package);
+  LoadIntoLibrary(status, resourceLibrary, package, false);
+
+  event.EventResourceLibrary = resourceLibrary;
+  DispatchEvent(Events::PackagedFinished, &event);
+
+  float time = (float)timer.UpdateAndGetTime();
+  PlasmaPrintFilter(Filter::DefaultFilter, "Loaded Resource Package '%s' in %.2fs\n", package->Name.c_str(), time);
+
+  return resourceLibrary;
+}
+
+ResourceLibrary* ResourceSystem::CreateLibrary(ResourcePackage* package)
+{
   // METAREFACTOR this is the worst way to handle this, but it works until we
   // get true dependencies. Find the last resource library (assuming we load
   // Core first, then others) and pretend we're always dependent upon the
@@ -177,17 +195,200 @@ ResourceLibrary* ResourceSystem::LoadPackage(Status& status, ResourcePackage* pa
   if (lastLoadedDependencyLibrary != nullptr)
     resourceLibrary->AddDependency(lastLoadedDependencyLibrary);
 
-  LoadIntoLibrary(status, resourceLibrary, package, false);
+  return resourceLibrary;
+}
 
-  event.EventResourceLibrary = resourceLibrary;
-  DispatchEvent(Events::PackagedFinished, &event);
+ResourceLibrary* ResourceSystem::LoadPackageAsync(ResourcePackage* package, ResourceLoadPriority::Enum priority)
+{
+  ZoneScoped;
+  ProfileScopeFunctionArgs(package->Name);
 
-  float time = (float)timer.UpdateAndGetTime();
-  PlasmaPrintFilter(Filter::DefaultFilter, "Loaded Resource Package '%s' in %.2fs\n", package->Name.c_str(), time);
+  ResourceLibrary* currentSet = LoadedResourceLibraries.FindValue(package->Name, nullptr);
+  if (currentSet)
+  {
+    PlasmaPrintFilter(Filter::DefaultFilter, "Resource Package Already Loaded '%s'...\n", package->Name.c_str());
+    return currentSet;
+  }
+
+  PlasmaPrintFilter(Filter::DefaultFilter, "Loading Resource Package '%s' in the background...\n", package->Name.c_str());
+
+  ResourceEvent event;
+  event.Name = package->Name;
+  event.Path = package->Location;
+  DispatchEvent(Events::PackagedStarted, &event);
+
+  ResourceLibrary* resourceLibrary = CreateLibrary(package);
+
+  ResourceLoadRequest* request = new ResourceLoadRequest(resourceLibrary, package->Name);
+  request->mPriority = priority;
+  request->mPlaceholders = true;
+  QueueLoad(request, package);
+
+  // Higher priority requests are committed first
+  uint index = 0;
+  while (index < mLoadRequests.Size() && mLoadRequests[index]->mPriority >= priority)
+    ++index;
+  mLoadRequests.InsertAt(index, request);
 
   return resourceLibrary;
 }
 
+ResourceLibrary* ResourceSystem::LoadPackageFileAsync(StringParam fileName, ResourceLoadPriority::Enum priority)
+{
+  // The package is copied into the load request, so it can live on the stack
+  ResourcePackage package;
+  package.Load(fileName);
+  package.Location = FilePath::GetDirectoryPath(fileName);
+
+  return LoadPackageAsync(&package, priority);
+}
+
+void ResourceSystem::UpdateLoading(double budgetSeconds)
+{
+  if (mLoadRequests.Empty())
+    return;
+
+  ZoneScoped;
+  Timer timer;
+  timer.Reset();
+
+  uint index = 0;
+  while (index < mLoadRequests.Size() && timer.UpdateAndGetTime() < budgetSeconds)
+  {
+    ResourceLoadRequest* request = mLoadRequests[index];
+    while (!request->IsFinished() && timer.UpdateAndGetTime() < budgetSeconds)
+    {
+      if (!CommitNext(request, false))
+        break;
+    }
+
+    if (request->IsFinished())
+    {
+      // Removed first as the finished events may queue more loads
+      mLoadRequests.EraseAt(index);
+      FinishLoadRequest(request);
+      delete request;
+    }
+    else
+    {
+      ++index;
+    }
+  }
+}
+
+void ResourceSystem::WaitForLoad(ResourceLibrary* library)
+{
+  uint index = 0;
+  while (index < mLoadRequests.Size())
+  {
+    ResourceLoadRequest* request = mLoadRequests[index];
+    if (library != nullptr && request->mLibrary != library)
+    {
+      ++index;
+      continue;
+    }
+
+    PL::gEngine->LoadingStart();
+    uint count = request->mTasks.Size();
+    while (!request->IsFinished())
+    {
+      ResourceEntry& entry = request->mTasks[request->mNextCommit].mEntry;
+      PL::gEngine->LoadingUpdate(
+          "Loading", request->mPackageName, entry.Name, ProgressType::Normal, (float)(request->mNextCommit + 1) / count);
+      CommitNext(request, true);
+    }
+    PL::gEngine->LoadingFinish();
+
+    mLoadRequests.EraseAt(index);
+    FinishLoadRequest(request);
+    delete request;
+
+    // The finished events may have changed the requests
+    index = 0;
+  }
+}
+
+bool ResourceSystem::IsLoading(ResourceLibrary* library)
+{
+  if (library == nullptr)
+    return !mLoadRequests.Empty();
+
+  forRange (ResourceLoadRequest* request, mLoadRequests.All())
+  {
+    if (request->mLibrary == library)
+      return true;
+  }
+  return false;
+}
+
+ResourceLoadProgress ResourceSystem::GetLoadProgress(ResourceLibrary* library)
+{
+  ResourceLoadProgress progress;
+  if (library == nullptr)
+  {
+    forRange (ResourceLoadRequest* request, mLoadRequests.All())
+    {
+      progress.mTotal += request->mTasks.Size();
+      progress.mCommitted += request->mNextCommit;
+      progress.mSeconds = Math::Max(progress.mSeconds, request->mTimer.UpdateAndGetTime());
+    }
+    progress.mFinished = mLoadRequests.Empty();
+    return progress;
+  }
+
+  forRange (ResourceLoadRequest* request, mLoadRequests.All())
+  {
+    if (request->mLibrary == library)
+    {
+      progress.mTotal = request->mTasks.Size();
+      progress.mCommitted = request->mNextCommit;
+      progress.mSeconds = request->mTimer.UpdateAndGetTime();
+      progress.mFinished = false;
+      return progress;
+    }
+  }
+
+  progress.mTotal = library->Resources.Size();
+  progress.mCommitted = progress.mTotal;
+  progress.mSeconds = library->mLoadSeconds;
+  return progress;
+}
+
+bool ResourceSystem::IsLibraryLoading(StringParam libraryName)
+{
+  ResourceLibrary* library = LoadedResourceLibraries.FindValue(libraryName, nullptr);
+  return library != nullptr && IsLoading(library);
+}
+
+float ResourceSystem::GetLibraryLoadPercentage(StringParam libraryName)
+{
+  ResourceLibrary* library = LoadedResourceLibraries.FindValue(libraryName, nullptr);
+  if (library == nullptr)
+    return 0.0f;
+  return GetLoadProgress(library).GetPercentage();
+}
+
+bool ResourceSystem::GetLoading()
+{
+  return IsLoading(nullptr);
+}
+
+float ResourceSystem::GetLoadPercentage()
+{
+  return GetLoadProgress(nullptr).GetPercentage();
+}
+
+bool ResourceSystem::IsLoadPending(ResourceId resourceId)
+{
+  return mPendingResources.ContainsKey(resourceId);
+}
+
+void ResourceSystem::SetLoadPriority(ResourceId resourceId, ResourceLoadPriority::Enum priority)
+{
+  if (ResourceLoadTask* task = mPendingResources.FindValue(resourceId, nullptr))
+    mLoadQueue.Raise(task, priority);
+}
+
 ResourceLibrary* ResourceSystem::GetResourceLibrary(StringParam name)
 {
   return LoadedResourceLibraries.FindValue(name, nullptr);
@@ -221,6 +422,8 @@ void ResourceSystem::ReloadPackage(ResourceLibrary* resourceLibrary, ResourcePac
 
 void ResourceSystem::UnloadAll()
 {
+  CancelLoads();
+
   // Unload all libraries. We want to unload libraries that no one depends on
   // first
   while (!LoadedResourceLibraries.Empty())
@@ -275,6 +478,22 @@ Resource* ResourceSystem::GetResource(ResourceId resourceId)
   return ResourceIdMap.FindValue(resourceId, nullptr);
 }
 
+// ErrorContext for loading resources
+class ErrorContextResourceEntry : public ErrorContext
+{
+public:
+  ResourceEntry* mEntry;
+
+  ErrorContextResourceEntry(ResourceEntry* entry) : mEntry(entry)
+  {
+  }
+
+  String GetDescription() override
+  {
+    return BuildString("Loading ", mEntry->ToString());
+  }
+};
+
 void ResourceSystem::LoadIntoLibrary(Status& status,
                                      ResourceLibrary* resourceLibrary,
                                      ResourcePackage* resourcePackage,
@@ -282,68 +501,141 @@ void ResourceSystem::LoadIntoLibrary(Status& status,
 {
   PL::gEngine->LoadingStart();
 
-  StringBuilder errorString;
-  uint count = resourcePackage->Resources.Size();
+  // Everything is queued up front so jobs can read and decode ahead of the
+  // commits, which happen in package order on this thread
+  ResourceLoadRequest request(resourceLibrary, resourcePackage->Name);
+  request.mPriority = ResourceLoadPriority::High;
+  request.mIsNew = isNew;
+  QueueLoad(&request, resourcePackage);
 
+  uint count = request.mTasks.Size();
   ProgressType::Enum progressType = count > 1 ? ProgressType::Normal : ProgressType::None;
 
-  for (uint i = 0; i < count; ++i)
+  while (!request.IsFinished())
   {
-    ResourceEntry& entry = resourcePackage->Resources[i];
-    entry.mLibrary = resourceLibrary;
+    ResourceEntry& entry = request.mTasks[request.mNextCommit].mEntry;
 
     // Blocking update of progress
-    PL::gEngine->LoadingUpdate("Loading", resourcePackage->Name, entry.Name, progressType, (float)(i + 1) / count);
+    PL::gEngine->LoadingUpdate(
+        "Loading", resourcePackage->Name, entry.Name, progressType, (float)(request.mNextCommit + 1) / count);
+
+    CommitNext(&request, true);
+  }
+
+  PL::gEngine->LoadingFinish();
+
+  FinishLoadIntoLibrary(resourceLibrary);
+}
+
+void ResourceSystem::QueueLoad(ResourceLoadRequest* request, ResourcePackage* package)
+{
+  uint count = package->Resources.Size();
+  request->mTasks.Resize(count);
+
+  for (uint i = 0; i < count; ++i)
+  {
+    ResourceEntry& entry = package->Resources[i];
+    entry.mLibrary = request->mLibrary;
+    entry.FullPath = FilePath::Combine(package->Location, entry.Location);
 
-    entry.FullPath = FilePath::Combine(resourcePackage->Location, entry.Location);
+    ResourceLoadTask& task = request->mTasks[i];
+    task.mEntry = entry;
+    task.mPriority = request->mPriority;
+    task.mLoader = FindLoader(task.mStatus, task.mEntry);
 
-    Status entryStatus;
-    HandleOf<Resource> resource = LoadEntry(entryStatus, entry);
-    if (!entryStatus)
+    // Failed entries are skipped when committed
+    if (task.mLoader == nullptr)
     {
+      task.mState.Store(ResourceLoadState::Prepared);
       continue;
-      // Collect all error messages
-      status.SetFailed(String());
-      errorString << entryStatus.Message;
-      errorString << " \n";
     }
 
-    if (resource)
-      resourceLibrary->Add(resource, isNew);
+    if (request->mPlaceholders)
+      mPendingResources[task.mEntry.mResourceId] = &task;
+
+    mLoadQueue.Push(&task);
+    if (ThreadingEnabled)
+      PL::gJobs->AddJob(new ResourceLoadJob(&mLoadQueue));
   }
+}
 
-  if (resourceLibrary->mFragments.Size() > 0 && !LoadedDependencyLibraries.ContainsKey(resourceLibrary->Name))
+bool ResourceSystem::CommitNext(ResourceLoadRequest* request, bool wait)
+{
+  ResourceLoadTask& task = request->mTasks[request->mNextCommit];
+  if (task.mState.Load() != ResourceLoadState::Prepared)
   {
-      LoadedDependencyLibraries.InsertOrError(resourceLibrary->Name, resourceLibrary);
+    // Without threading nothing else will prepare it, so it's done here
+    if (!wait && ThreadingEnabled)
+      return false;
+    mLoadQueue.WaitForTask(&task);
   }
 
-  if (!status)
+  ++request->mNextCommit;
+  mPendingResources.Erase(task.mEntry.mResourceId);
+
+  if (task.mLoader == nullptr)
+    return true;
+
+  ZoneScoped;
+  ProfileScopeFunctionArgs(task.mEntry.Name);
+  ErrorContextResourceEntry loadingResourceContext(&task.mEntry);
+
+  HandleOf<Resource> resource = task.mLoader->CommitFromFile(task.mEntry, task.mPrepared);
+  task.mPrepared = nullptr;
+
+  if (resource)
+    request->mLibrary->Add(resource, request->mIsNew);
+  return true;
+}
+
+void ResourceSystem::FinishLoadIntoLibrary(ResourceLibrary* resourceLibrary)
+{
+  if (resourceLibrary->mFragments.Size() > 0 && !LoadedDependencyLibraries.ContainsKey(resourceLibrary->Name))
   {
-    status.Message = BuildString("Resource package failed to load. \n", errorString.ToString());
+      LoadedDependencyLibraries.InsertOrError(resourceLibrary->Name, resourceLibrary);
   }
 
-  PL::gEngine->LoadingFinish();
-
   ResourceEvent event;
   event.Name = resourceLibrary->Name;
   PL::gResources->DispatchEvent(Events::ResourcesLoaded, &event);
 }
 
-// ErrorContext for loading resources
-class ErrorContextResourceEntry : public ErrorContext
+void ResourceSystem::FinishLoadRequest(ResourceLoadRequest* request)
 {
-public:
-  ResourceEntry* mEntry;
+  ResourceLibrary* resourceLibrary = request->mLibrary;
+  resourceLibrary->mLoadSeconds = request->mTimer.UpdateAndGetTime();
 
-  ErrorContextResourceEntry(ResourceEntry* entry) : mEntry(entry)
-  {
-  }
+  FinishLoadIntoLibrary(resourceLibrary);
 
-  String GetDescription() override
+  ResourceEvent event;
+  event.Name = request->mPackageName;
+  event.Path = resourceLibrary->Location;
+  event.EventResourceLibrary = resourceLibrary;
+  DispatchEvent(Events::PackagedFinished, &event);
+
+  PlasmaPrintFilter(Filter::DefaultFilter,
+                    "Loaded Resource Package '%s' in %.2fs\n",
+                    request->mPackageName.c_str(),
+                    (float)resourceLibrary->mLoadSeconds);
+}
+
+void ResourceSystem::CancelLoads()
+{
+  // Jobs may still be preparing tasks, which must finish before the requests
+  // are deleted
+  forRange (ResourceLoadRequest* request, mLoadRequests.All())
   {
-    return BuildString("Loading ", mEntry->ToString());
+    for (uint i = request->mNextCommit; i < request->mTasks.Size(); ++i)
+    {
+      ResourceLoadTask* task = &request->mTasks[i];
+      if (!mLoadQueue.Take(task))
+        mLoadQueue.WaitForTask(task);
+    }
+    delete request;
   }
-};
+  mLoadRequests.Clear();
+  mPendingResources.Clear();
+}
 
 HandleOf<Resource> ResourceSystem::LoadEntry(Status& status, ResourceEntry& element)
 {
@@ -352,6 +644,17 @@ HandleOf<Resource> ResourceSystem::LoadEntry(Status& status, ResourceEntry& elem
 
   ErrorContextResourceEntry loadingResourceContext(&element);
 
+  ResourceLoader* loader = FindLoader(status, element);
+  if (loader == nullptr)
+    return nullptr;
+
+  // ideally we'd do a check here, but some resources don't load anything
+  // (fragments)
+  return loader->LoadFromFile(element);
+}
+
+ResourceLoader* ResourceSystem::FindLoader(Status& status, ResourceEntry& element)
+{
   if (!FileExists(element.FullPath))
   {
     String errMsg = String::Format("Resource file '%s' does not exist.", element.FullPath.c_str());
@@ -365,14 +668,7 @@ HandleOf<Resource> ResourceSystem::LoadEntry(Status& status, ResourceEntry& elem
     element.Type = "Cog";
 
   LoaderRange range = mLoaderMap.Find(element.Type);
-  if (!range.Empty())
-  {
-    HandleOf<Resource> newResource = range.Front().second->LoadFromFile(element);
-    // ideally we'd do a check here, but some resources don't load anything
-    // (fragments)
-    return newResource;
-  }
-  else
+  if (range.Empty())
   {
     String errMsg = String::Format("Failed to load file. Could not find loader for type"
                                    "'%s' for file '%s'.",
@@ -380,8 +676,10 @@ HandleOf<Resource> ResourceSystem::LoadEntry(Status& status, ResourceEntry& elem
                                    element.Location.c_str());
     PlasmaPrint("%s\n", errMsg.c_str());
     status.SetFailed(errMsg);
+    return nullptr;
   }
-  return nullptr;
+
+  return range.Front().second;
 }
 
 void ResourceSystem::ReloadEntry(Resource* resource, ResourceEntry& entry)
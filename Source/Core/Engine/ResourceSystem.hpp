@@ -49,6 +49,42 @@ public:
   // Load a resource package
   ResourceLibrary* LoadPackage(Status& status, ResourcePackage* package);
 
+  // Load a resource package in the background. The library is returned right
+  // away and its resources are registered over the following frames in package
+  // order. Until then lookups of its resources return the manager's default
+  // resource as a placeholder.
+  ResourceLibrary* LoadPackageAsync(ResourcePackage* package,
+                                    ResourceLoadPriority::Enum priority = ResourceLoadPriority::Normal);
+  // Load a resource package from a file in the background.
+  ResourceLibrary* LoadPackageFileAsync(StringParam fileName,
+                                        ResourceLoadPriority::Enum priority = ResourceLoadPriority::Normal);
+
+  // Commits background loads that are ready for up to the given number of
+  // seconds. Called by the engine every frame.
+  void UpdateLoading(double budgetSeconds = 0.004);
+
+  // Blocks until the library has finished loading in the background (or every
+  // background load if null).
+  void WaitForLoad(ResourceLibrary* library);
+
+  // Is the library still loading in the background (or any library if null)?
+  bool IsLoading(ResourceLibrary* library);
+  // Progress of the library (or of every background load if null).
+  ResourceLoadProgress GetLoadProgress(ResourceLibrary* library);
+
+  // Script versions of the above that find the library by name.
+  bool IsLibraryLoading(StringParam libraryName);
+  float GetLibraryLoadPercentage(StringParam libraryName);
+  // Is any library loading in the background?
+  bool GetLoading();
+  // From 0 to 1 over every library loading in the background.
+  float GetLoadPercentage();
+
+  // Is the resource waiting to be loaded in the background?
+  bool IsLoadPending(ResourceId resourceId);
+  // Raises the priority of a resource waiting to be loaded in the background.
+  void SetLoadPriority(ResourceId resourceId, ResourceLoadPriority::Enum priority);
+
   // Reload all resource in package into resource library.
   void ReloadPackage(ResourceLibrary* resourceLibrary, ResourcePackage* package);
 
@@ -86,7 +122,7 @@ public:
   ManagerMapType Managers;
 
   // Map of ResourceId to loaded resources
-  typedef HashMap<ResourceId, Resource*> ResourceIdMapType;
+  typedef FlatHashMap<ResourceId, Resource*> ResourceIdMapType;
   ResourceIdMapType ResourceIdMap;
 
   // Map of document names to document resources. The text resources are a
@@ -97,6 +133,23 @@ public:
   // private:
   HandleOf<Resource> LoadEntry(Status& status, ResourceEntry& entry);
   void ReloadEntry(Resource* resource, ResourceEntry& entry);
+  ResourceLoader* FindLoader(Status& status, ResourceEntry& entry);
+
+  ResourceLibrary* CreateLibrary(ResourcePackage* package);
+  void QueueLoad(ResourceLoadRequest* request, ResourcePackage* package);
+  // Commits the next entry of the request. Returns false if it isn't prepared
+  // yet and wait is false.
+  bool CommitNext(ResourceLoadRequest* request, bool wait);
+  void FinishLoadIntoLibrary(ResourceLibrary* resourceLibrary);
+  void FinishLoadRequest(ResourceLoadRequest* request);
+  void CancelLoads();
+
+  // Entries waiting to be prepared by the resource load jobs
+  ResourceLoadQueue mLoadQueue;
+  // Background loads, highest priority first
+  Array<ResourceLoadRequest*> mLoadRequests;
+  // Resources of background loads that haven't been committed yet
+  HashMap<ResourceId, ResourceLoadTask*> mPendingResources;
 
   // Map of resource type names to loaders
   typedef HashMap<String, ResourceLoader*> LoaderMapType;
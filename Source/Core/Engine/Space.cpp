@@ -746,6 +746,10 @@ void Space::LoadPendingLevel()
 {
   if (Level* level = mPendingLevel)
   {
+    // Wait for the rest of the level's package to load in the background
+    if (PL::gResources->IsLoading(level->mResourceLibrary))
+      return;
+
     LoadLevelAdditive(level);
     mPendingLevel = nullptr;
   }
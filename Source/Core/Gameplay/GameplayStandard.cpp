@@ -51,6 +51,7 @@ LightningDefineStaticLibrary(GameplayLibrary)
   LightningInitializeType(CameraViewport);
   LightningInitializeType(DefaultGameSetup);
   LightningInitializeType(PathFinderBaseEvent);
+  LightningInitializeType(PathFinderBatchEvent);
   LightningInitializeTypeAs(PathFinderEvent<Vec3>, "PathFinderEvent");
   LightningInitializeTypeAs(PathFinderEvent<IntVec3>, "PathFinderGridEvent");
   LightningInitializeType(PathFinder);
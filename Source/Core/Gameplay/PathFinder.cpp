@@ -6,8 +6,8 @@ namespace Plasma
 
 namespace Events
 {
-DefineEvent(PathFinderFinishedGeneric);
 DefineEvent(PathFinderFinished);
+DefineEvent(PathFinderBatchFinished);
 } // namespace Events
 
 LightningDefineType(PathFinder, builder, type)
@@ -20,20 +20,25 @@ LightningDefineType(PathFinder, builder, type)
   LightningBindMethod(FindPathThreaded);
 
   LightningBindField(mMaxIterations);
+  LightningBindField(mPathCacheSize);
 }
 
 const int cDefaultMaxIterations = 100000;
-PathFinder::PathFinder() : mMaxIterations(cDefaultMaxIterations)
+const int cDefaultPathCacheSize = 64;
+PathFinder::PathFinder() : mMaxIterations(cDefaultMaxIterations), mPathCacheSize(cDefaultPathCacheSize)
 {
 }
 
 void PathFinder::Serialize(Serializer& stream)
 {
   SerializeNameDefault(mMaxIterations, cDefaultMaxIterations);
+  SerializeNameDefault(mPathCacheSize, cDefaultPathCacheSize);
 }
 
 void PathFinder::Initialize(CogInitializer& initializer)
 {
+  ConnectThisTo(GetSpace(), Events::FrameUpdate, OnFrameUpdate);
+  ConnectThisTo(GetOwner(), Events::PathFinderBatchFinished, OnBatchFinished);
 }
 
 HandleOf<ArrayClass<Vec3>> PathFinder::FindPath(Vec3Param worldStart, Vec3Param worldGoal)
@@ -60,6 +65,20 @@ HandleOf<PathFinderRequest> PathFinder::FindPathThreaded(Vec3Param worldStart, V
   return FindPathGenericThreaded(nodeKeyStart, nodeKeyGoal);
 }
 
+void PathFinder::OnFrameUpdate(UpdateEvent* event)
+{
+  FlushPendingQueries();
+}
+
+void PathFinder::OnBatchFinished(PathFinderBatchEvent* event)
+{
+  // Every path finder on this Cog receives the batch event
+  if (event->mPathFinder != this)
+    return;
+
+  event->DeliverResults();
+}
+
 LightningDefineType(PathFinderRequest, builder, type)
 {
   PlasmaBindDocumented();
@@ -73,17 +92,17 @@ PathFinderRequest::PathFinderRequest(PathFinder* owner, Job* job) :
     mJob(job),
     mStatus(PathFinderStatus::Pending)
 {
-  // When the job is finished it sends an event to the request which uses thread
-  // safe handle id. Any script may listen upon the request, but the request
-  // will also forward the event to the Cog/Component and then delete the job.
-  ConnectThisTo(this, Events::PathFinderFinishedGeneric, OnJobFinished);
+  // When the batch job is finished the PathFinder hands the result to every
+  // request in the batch through OnJobFinished. Any script may listen upon the
+  // request, but the request will also forward the event to the Cog/Component
+  // and then release the job.
 }
 
 void PathFinderRequest::Cancel()
 {
+  // The job is shared with every other request in the batch, so we don't cancel
+  // it. The batch job skips any query whose requests were all cancelled.
   mStatus = PathFinderStatus::Cancelled;
-  if (mJob)
-    mJob->Cancel();
 }
 
 void PathFinderRequest::OnJobFinished(PathFinderBaseEvent* event)
@@ -136,8 +155,8 @@ void PathFinderRequest::OnJobFinished(PathFinderBaseEvent* event)
   }
 
   // The job is completed and it's safe to delete it / release it
-  // Note: The job keeps our request handle alive and may be the only reference
-  // We must ONLY delete this at the very end.
+  // Note: The batch results keep our request handle alive and may be the only
+  // reference. We must ONLY delete this at the very end.
   mJob = nullptr;
 }
 
@@ -148,4 +167,8 @@ LightningDefineType(PathFinderBaseEvent, builder, type)
   LightningBindFieldGetter(mDuration);
 }
 
+LightningDefineType(PathFinderBatchEvent, builder, type)
+{
+}
+
 } // namespace Plasma
@@ -5,12 +5,12 @@ namespace Plasma
 {
 namespace Events
 {
-DeclareEvent(PathFinderFinishedGeneric);
 DeclareEvent(PathFinderFinished);
+DeclareEvent(PathFinderBatchFinished);
 } // namespace Events
 
 template <typename NodeKey, typename Algorithm>
-class PathFinderJob;
+class PathFinderQueryBatch;
 
 // PathFinderAlgorithm
 // To derive from PathFinderAlgorithm you must provide the following interface:
@@ -125,6 +125,7 @@ public:
 // PathFinder
 class PathFinderRequest;
 class PathFinderBaseEvent;
+class PathFinderBatchEvent;
 class PathFinder;
 
 DeclareEnum4(PathFinderStatus, Pending, Succeeded, Failed, Cancelled);
@@ -142,6 +143,8 @@ public:
   PathFinderRequest(PathFinder* owner, Job* job);
 
   /// Requests to stop the thread running the path finding calculation.
+  /// Requests are computed in batches, so the result of a cancelled request is
+  /// simply never delivered (the batch still finishes the other requests).
   void Cancel();
 
   // Internals
@@ -183,61 +186,57 @@ public:
   // class event (e.g. PathFinderGridFinished or PathFinderNavMeshFinished).
   virtual StringParam GetCustomEventName() = 0;
 
+  // Sends every threaded request queued this frame to the job system as a
+  // single batch. The derived class owns the typed PathFinderQueryBatch.
+  virtual void FlushPendingQueries() = 0;
+
   template <typename NodeKey, typename Algorithm>
   HandleOf<ArrayClass<NodeKey>> FindPathHelper(CopyOnWriteHandle<Algorithm>& algorithm,
+                                               PathFinderQueryBatch<NodeKey, Algorithm>& queries,
                                                const NodeKey& start,
                                                const NodeKey& goal,
                                                size_t maxIterations)
   {
     HandleOf<ArrayClass<NodeKey>> array = LightningAllocate(ArrayClass<NodeKey>);
-    algorithm->FindNodePath(start, goal, array->NativeArray, maxIterations);
+    queries.FindNodePath(algorithm, start, goal, array->NativeArray, maxIterations, (size_t)mPathCacheSize);
     return array;
   }
 
   template <typename NodeKey, typename Algorithm>
   void GenericFindPathHelper(CopyOnWriteHandle<Algorithm>& algorithm,
+                             PathFinderQueryBatch<NodeKey, Algorithm>& queries,
                              VariantParam start,
                              VariantParam goal,
                              Array<Variant>& pathOut,
                              size_t maxIterations)
   {
     Array<NodeKey> path;
-    algorithm->FindNodePath(start.GetOrDefault<NodeKey>(), goal.GetOrDefault<NodeKey>(), path, maxIterations);
+    queries.FindNodePath(algorithm,
+                         start.GetOrDefault<NodeKey>(),
+                         goal.GetOrDefault<NodeKey>(),
+                         path,
+                         maxIterations,
+                         (size_t)mPathCacheSize);
 
     forRange (const NodeKey& nodeKey, path)
       pathOut.PushBack(Variant(nodeKey));
   }
 
   template <typename NodeKey, typename Algorithm>
-  HandleOf<PathFinderRequest> FindPathThreadedHelper(CopyOnWriteHandle<Algorithm>& algorithm,
+  HandleOf<PathFinderRequest> FindPathThreadedHelper(PathFinderQueryBatch<NodeKey, Algorithm>& queries,
                                                      const NodeKey& start,
-                                                     const NodeKey& goal,
-                                                     size_t maxIterations)
-  {
-    typedef PathFinderJob<NodeKey, Algorithm> PathFinderAlgorithmJob;
-    PathFinderAlgorithmJob* job = new PathFinderAlgorithmJob();
-    PathFinderRequest* request = new PathFinderRequest(this, job);
-
-    job->mStart = start;
-    job->mGoal = goal;
-    job->mRequest = request;
-    job->mMainThreadPathFinder = this;
-    job->mMainThreadPathFinderDispatcher = GetDispatcher();
-    job->mAlgorithm = algorithm;
-    job->mMaxIterations = maxIterations;
-    PL::gJobs->AddJob(job);
-
-    return request;
+                                                     const NodeKey& goal)
+  {
+    return queries.Enqueue(this, start, goal);
   }
 
   template <typename NodeKey, typename Algorithm>
-  HandleOf<PathFinderRequest> GenericFindPathThreadedHelper(CopyOnWriteHandle<Algorithm>& algorithm,
+  HandleOf<PathFinderRequest> GenericFindPathThreadedHelper(PathFinderQueryBatch<NodeKey, Algorithm>& queries,
                                                             VariantParam start,
-                                                            VariantParam goal,
-                                                            size_t maxIterations)
+                                                            VariantParam goal)
   {
     return FindPathThreadedHelper<NodeKey, Algorithm>(
-        algorithm, start.GetOrDefault<NodeKey>(), goal.GetOrDefault<NodeKey>(), maxIterations);
+        queries, start.GetOrDefault<NodeKey>(), goal.GetOrDefault<NodeKey>());
   }
 
   /// Finds a path between world positions (or returns an empty array if no path
@@ -251,10 +250,19 @@ public:
   /// this.Owner).
   HandleOf<PathFinderRequest> FindPathThreaded(Vec3Param worldStart, Vec3Param worldGoal);
 
+  /// Threaded requests are batched and sent out once per frame.
+  void OnFrameUpdate(UpdateEvent* event);
+  void OnBatchFinished(PathFinderBatchEvent* event);
+
   /// The number of iterations we allow for the path finding algorithm before we
   /// terminate it. This prevents infinite loops when we have an unbounded
   /// number of nodes/edges.
   int mMaxIterations;
+
+  /// The number of recently found paths that are remembered (by start and
+  /// goal) so that repeated queries don't need to be recomputed. The cache is
+  /// cleared whenever costs or collision change. A size of 0 disables caching.
+  int mPathCacheSize;
 };
 
 /// An event that contains common data between all path-finding implementations.
@@ -324,34 +332,238 @@ LightningDefineType(PathFinderEvent<NodeKey>, builder, type)
   LightningBindGetter(Path);
 }
 
+/// Sent (internally) on the PathFinder's owner when a batch of threaded
+/// requests has been computed. The typed derived event knows how to hand the
+/// results out to each individual PathFinderRequest.
+class PathFinderBatchEvent : public Event
+{
+public:
+  LightningDeclareType(PathFinderBatchEvent, TypeCopyMode::ReferenceType);
+
+  PathFinderBatchEvent() : mPathFinder(nullptr)
+  {
+  }
+
+  // Caches the new paths and sends the finished events to every request in
+  // the batch. Must be called on the main thread.
+  virtual void DeliverResults() = 0;
+
+  /// The component that queued the batch (multiple path finders can share the
+  /// same Cog's dispatcher).
+  PathFinder* mPathFinder;
+};
+
+/// Remembers the most recently found paths keyed by their start and goal node
+/// so that agents repathing to the same goal don't rerun A*. When the cache is
+/// full the least recently used path is evicted. Main thread only.
+template <typename NodeKey>
+class PathFinderPathCache
+{
+public:
+  typedef Pair<NodeKey, NodeKey> QueryKey;
+
+  struct Entry
+  {
+    QueryKey mKey;
+    Array<NodeKey> mPath;
+    Link<Entry> link;
+  };
+  typedef InList<Entry> EntryList;
+
+  PathFinderPathCache() : mGeneration(0)
+  {
+  }
+
+  ~PathFinderPathCache()
+  {
+    Clear();
+  }
+
+  /// Returns the cached path (and marks it as most recently used) or null if
+  /// the query has not been cached.
+  const Array<NodeKey>* Find(const NodeKey& start, const NodeKey& goal)
+  {
+    Entry* entry = mEntries.FindValue(QueryKey(start, goal), nullptr);
+    if (entry == nullptr)
+      return nullptr;
+
+    EntryList::Unlink(entry);
+    mUsage.PushBack(entry);
+    return &entry->mPath;
+  }
+
+  void Insert(const NodeKey& start, const NodeKey& goal, const Array<NodeKey>& path, size_t capacity)
+  {
+    if (capacity == 0)
+      return;
+
+    QueryKey key(start, goal);
+    Entry* entry = mEntries.FindValue(key, nullptr);
+    if (entry != nullptr)
+    {
+      EntryList::Unlink(entry);
+    }
+    else
+    {
+      // Evict the least recently used paths (the capacity may have shrunk)
+      while (mEntries.Size() >= capacity)
+      {
+        Entry* oldest = &mUsage.Front();
+        mUsage.PopFront();
+        mEntries.Erase(oldest->mKey);
+        delete oldest;
+      }
+
+      entry = new Entry();
+      entry->mKey = key;
+      mEntries.Insert(key, entry);
+    }
+
+    entry->mPath = path;
+    mUsage.PushBack(entry);
+  }
+
+  /// Removes every cached path. Paths that are still being computed against
+  /// the old version of the graph will not be added when they finish.
+  void Invalidate()
+  {
+    Clear();
+    ++mGeneration;
+  }
+
+  void Clear()
+  {
+    while (!mUsage.Empty())
+    {
+      Entry* entry = &mUsage.Front();
+      mUsage.PopFront();
+      delete entry;
+    }
+    mEntries.Clear();
+  }
+
+  /// Incremented every time the cache is invalidated.
+  u32 mGeneration;
+  HashMap<QueryKey, Entry*> mEntries;
+  /// Ordered from least to most recently used.
+  EntryList mUsage;
+};
+
 template <typename NodeKey, typename Algorithm>
-class PathFinderJob : public Job
+class PathFinderBatchResultEvent : public PathFinderBatchEvent
 {
 public:
-  PathFinderJob() : mMaxIterations((size_t)-1), mCancel(false), mMainThreadPathFinderDispatcher(nullptr)
+  struct Result
+  {
+    Result() : mDuration(0), mCached(false)
+    {
+    }
+
+    NodeKey mStart;
+    NodeKey mGoal;
+    Array<NodeKey> mPath;
+    float mDuration;
+    /// The path came out of the cache and doesn't need to be computed.
+    bool mCached;
+    /// Every request that asked for this start and goal in the same frame.
+    Array<HandleOf<PathFinderRequest>> mRequests;
+  };
+
+  PathFinderBatchResultEvent() : mBatch(nullptr), mCacheGeneration(0), mCacheSize(0)
+  {
+  }
+
+  // PathFinderBatchEvent Interface
+  void DeliverResults() override
   {
+    PathFinderPathCache<NodeKey>& cache = mBatch->mCache;
+
+    forRange (Result& result, mResults.All())
+    {
+      // Don't cache paths found on a version of the graph that has since been
+      // modified
+      if (!result.mCached && mCacheGeneration == cache.mGeneration)
+        cache.Insert(result.mStart, result.mGoal, result.mPath, mCacheSize);
+
+      PathFinderEvent<NodeKey> toSend;
+      toSend.mStart = result.mStart;
+      toSend.mGoal = result.mGoal;
+      toSend.mPath.Swap(result.mPath);
+      toSend.mDuration = result.mDuration;
+
+      forRange (HandleOf<PathFinderRequest>& requestHandle, result.mRequests.All())
+      {
+        PathFinderRequest* request = requestHandle;
+        if (request == nullptr)
+          continue;
+
+        toSend.mRequest = requestHandle;
+        request->OnJobFinished(&toSend);
+      }
+    }
+  }
+
+  PathFinderQueryBatch<NodeKey, Algorithm>* mBatch;
+  u32 mCacheGeneration;
+  size_t mCacheSize;
+  Array<Result> mResults;
+};
+
+/// Computes every uncached query of a batch on a single worker thread against
+/// one copy of the algorithm, then sends all of the results back to the main
+/// thread in one event.
+template <typename NodeKey, typename Algorithm>
+class PathFinderBatchJob : public Job
+{
+public:
+  typedef PathFinderBatchResultEvent<NodeKey, Algorithm> ResultEvent;
+  typedef typename ResultEvent::Result Result;
+
+  PathFinderBatchJob() :
+      mMaxIterations((size_t)-1),
+      mResults(nullptr),
+      mMainThreadPathFinderDispatcher(nullptr),
+      mCancel(false)
+  {
+  }
+
+  ~PathFinderBatchJob()
+  {
+    // We were never run (e.g. the job system shut down)
+    delete mResults;
   }
 
   // Job Interface
   void Execute() override
   {
     ZoneScoped;
-    Timer timer;
 
-    PathFinderEvent<NodeKey>* toSend = new PathFinderEvent<NodeKey>();
-    toSend->mStart = mStart;
-    toSend->mGoal = mGoal;
-    toSend->mRequest = mRequest;
-    mAlgorithm->FindNodePath(mStart, mGoal, toSend->mPath, mMaxIterations, &mCancel);
+    forRange (Result& result, mResults->mResults.All())
+    {
+      if (mCancel)
+        break;
+
+      if (result.mCached || AllRequestsCancelled(result))
+        continue;
 
-    // We may have cancelled right as the path was finished
-    if (mCancel)
-      toSend->mPath.Clear();
+      Timer timer;
+      mAlgorithm->FindNodePath(result.mStart, result.mGoal, result.mPath, mMaxIterations, &mCancel);
+      result.mDuration = (float)timer.UpdateAndGetTime();
+    }
 
-    toSend->mDuration = (float)timer.UpdateAndGetTime();
+    // We may have cancelled right as a path was finished
+    if (mCancel)
+    {
+      forRange (Result& result, mResults->mResults.All())
+      {
+        if (!result.mCached)
+          result.mPath.Clear();
+      }
+    }
 
     PL::gDispatch->DispatchOn(
-        mMainThreadPathFinder, mMainThreadPathFinderDispatcher, Events::PathFinderFinishedGeneric, toSend);
+        mMainThreadPathFinder, mMainThreadPathFinderDispatcher, Events::PathFinderBatchFinished, mResults);
+    mResults = nullptr;
   }
 
   int Cancel() override
@@ -360,14 +572,152 @@ public:
     return 0;
   }
 
-  NodeKey mStart;
-  NodeKey mGoal;
+  bool AllRequestsCancelled(Result& result)
+  {
+    forRange (HandleOf<PathFinderRequest>& requestHandle, result.mRequests.All())
+    {
+      PathFinderRequest* request = requestHandle;
+      if (request != nullptr && request->mStatus != PathFinderStatus::Cancelled)
+        return false;
+    }
+    return true;
+  }
+
   size_t mMaxIterations;
-  HandleOf<PathFinderRequest> mRequest;
+  ResultEvent* mResults;
   HandleOf<PathFinder> mMainThreadPathFinder;
   EventDispatcher* mMainThreadPathFinderDispatcher;
   CopyOnWriteHandle<Algorithm> mAlgorithm;
   bool mCancel;
 };
 
+/// Queues the threaded requests made during a frame so they can be computed by
+/// a single job. Requests with the same start and goal are merged into one
+/// query and queries whose path is already cached never reach the job system.
+/// Owned by the derived PathFinder alongside its algorithm.
+template <typename NodeKey, typename Algorithm>
+class PathFinderQueryBatch
+{
+public:
+  typedef Pair<NodeKey, NodeKey> QueryKey;
+  typedef PathFinderBatchResultEvent<NodeKey, Algorithm> ResultEvent;
+  typedef PathFinderBatchJob<NodeKey, Algorithm> BatchJob;
+
+  struct Query
+  {
+    NodeKey mStart;
+    NodeKey mGoal;
+    Array<HandleOf<PathFinderRequest>> mRequests;
+  };
+
+  /// Finds a path immediately on the calling (main) thread using the cache.
+  void FindNodePath(CopyOnWriteHandle<Algorithm>& algorithm,
+                    const NodeKey& start,
+                    const NodeKey& goal,
+                    Array<NodeKey>& pathOut,
+                    size_t maxIterations,
+                    size_t cacheSize)
+  {
+    if (const Array<NodeKey>* cachedPath = mCache.Find(start, goal))
+    {
+      pathOut = *cachedPath;
+      return;
+    }
+
+    algorithm->FindNodePath(start, goal, pathOut, maxIterations);
+    mCache.Insert(start, goal, pathOut, cacheSize);
+  }
+
+  /// Queues a request that will be computed when the batch is flushed.
+  HandleOf<PathFinderRequest> Enqueue(PathFinder* owner, const NodeKey& start, const NodeKey& goal)
+  {
+    PathFinderRequest* request = new PathFinderRequest(owner, nullptr);
+
+    QueryKey key(start, goal);
+    if (size_t* queryIndex = mPendingIndices.FindPointer(key))
+    {
+      mPending[*queryIndex].mRequests.PushBack(request);
+      return request;
+    }
+
+    mPendingIndices.Insert(key, mPending.Size());
+    Query& query = mPending.PushBack();
+    query.mStart = start;
+    query.mGoal = goal;
+    query.mRequests.PushBack(request);
+    return request;
+  }
+
+  /// Answers cached queries right away and sends the rest to a single job.
+  void Flush(PathFinder* owner, CopyOnWriteHandle<Algorithm>& algorithm, size_t maxIterations, size_t cacheSize)
+  {
+    if (mPending.Empty())
+      return;
+
+    ZoneScoped;
+
+    ResultEvent* results = new ResultEvent();
+    results->mPathFinder = owner;
+    results->mBatch = this;
+    results->mCacheGeneration = mCache.mGeneration;
+    results->mCacheSize = cacheSize;
+    results->mResults.Resize(mPending.Size());
+
+    bool allCached = true;
+    for (size_t i = 0; i < mPending.Size(); ++i)
+    {
+      Query& query = mPending[i];
+      typename ResultEvent::Result& result = results->mResults[i];
+      result.mStart = query.mStart;
+      result.mGoal = query.mGoal;
+      result.mRequests.Swap(query.mRequests);
+
+      if (const Array<NodeKey>* cachedPath = mCache.Find(query.mStart, query.mGoal))
+      {
+        result.mPath = *cachedPath;
+        result.mCached = true;
+      }
+      else
+      {
+        allCached = false;
+      }
+    }
+
+    mPending.Clear();
+    mPendingIndices.Clear();
+
+    if (allCached)
+    {
+      results->DeliverResults();
+      delete results;
+      return;
+    }
+
+    BatchJob* job = new BatchJob();
+    job->mResults = results;
+    job->mMainThreadPathFinder = owner;
+    job->mMainThreadPathFinderDispatcher = owner->GetDispatcher();
+    job->mAlgorithm = algorithm;
+    job->mMaxIterations = maxIterations;
+
+    forRange (typename ResultEvent::Result& result, results->mResults.All())
+    {
+      forRange (HandleOf<PathFinderRequest>& requestHandle, result.mRequests.All())
+        requestHandle->mJob = job;
+    }
+
+    PL::gJobs->AddJob(job);
+  }
+
+  /// Must be called whenever the algorithm's graph, costs, or collision change.
+  void InvalidateCache()
+  {
+    mCache.Invalidate();
+  }
+
+  Array<Query> mPending;
+  HashMap<QueryKey, size_t> mPendingIndices;
+  PathFinderPathCache<NodeKey> mCache;
+};
+
 } // namespace Plasma
@@ -291,7 +291,7 @@ void PathFinderGrid::DebugDraw()
 
 HandleOf<ArrayClass<IntVec3>> PathFinderGrid::FindPath(IntVec3Param start, IntVec3Param goal)
 {
-  return FindPathHelper<IntVec3, PathFinderAlgorithmGrid>(mGrid, start, goal, mMaxIterations);
+  return FindPathHelper<IntVec3, PathFinderAlgorithmGrid>(mGrid, mQueries, start, goal, mMaxIterations);
 }
 
 HandleOf<ArrayClass<Vec3>> PathFinderGrid::FindPath(Vec3Param worldStart, Vec3Param worldGoal)
@@ -301,7 +301,7 @@ HandleOf<ArrayClass<Vec3>> PathFinderGrid::FindPath(Vec3Param worldStart, Vec3Pa
 
 HandleOf<PathFinderRequest> PathFinderGrid::FindPathThreaded(IntVec3Param start, IntVec3Param goal)
 {
-  return FindPathThreadedHelper<IntVec3, PathFinderAlgorithmGrid>(mGrid, start, goal, mMaxIterations);
+  return FindPathThreadedHelper<IntVec3, PathFinderAlgorithmGrid>(mQueries, start, goal);
 }
 
 HandleOf<PathFinderRequest> PathFinderGrid::FindPathThreaded(Vec3Param worldStart, Vec3Param worldGoal)
@@ -323,6 +323,7 @@ void PathFinderGrid::SetDiagonalMovement(bool value)
 {
   mGrid.CopyIfNeeded();
   mGrid->mDiagonalMovement = value;
+  mQueries.InvalidateCache();
 }
 
 bool PathFinderGrid::GetDiagonalMovement()
@@ -358,12 +359,12 @@ Vec3 PathFinderGrid::NodeKeyToWorldPosition(VariantParam nodeKey)
 
 void PathFinderGrid::FindPathGeneric(VariantParam start, VariantParam goal, Array<Variant>& pathOut)
 {
-  GenericFindPathHelper<IntVec3, PathFinderAlgorithmGrid>(mGrid, start, goal, pathOut, mMaxIterations);
+  GenericFindPathHelper<IntVec3, PathFinderAlgorithmGrid>(mGrid, mQueries, start, goal, pathOut, mMaxIterations);
 }
 
 HandleOf<PathFinderRequest> PathFinderGrid::FindPathGenericThreaded(VariantParam start, VariantParam goal)
 {
-  return GenericFindPathThreadedHelper<IntVec3, PathFinderAlgorithmGrid>(mGrid, start, goal, mMaxIterations);
+  return GenericFindPathThreadedHelper<IntVec3, PathFinderAlgorithmGrid>(mQueries, start, goal);
 }
 
 StringParam PathFinderGrid::GetCustomEventName()
@@ -371,10 +372,16 @@ StringParam PathFinderGrid::GetCustomEventName()
   return Events::PathFinderGridFinished;
 }
 
+void PathFinderGrid::FlushPendingQueries()
+{
+  mQueries.Flush(this, mGrid, mMaxIterations, mPathCacheSize);
+}
+
 void PathFinderGrid::SetCollision(IntVec3Param index, bool collision)
 {
   mGrid.CopyIfNeeded();
   mGrid->SetCollision(index, collision);
+  mQueries.InvalidateCache();
 }
 
 bool PathFinderGrid::GetCollision(IntVec3Param index)
@@ -386,6 +393,7 @@ void PathFinderGrid::SetCost(IntVec3Param index, float cost)
 {
   mGrid.CopyIfNeeded();
   mGrid->SetCost(index, cost);
+  mQueries.InvalidateCache();
 }
 
 float PathFinderGrid::GetCost(IntVec3Param index)
@@ -397,6 +405,7 @@ void PathFinderGrid::Clear()
 {
   mGrid.CopyIfNeeded();
   mGrid->Clear();
+  mQueries.InvalidateCache();
 }
 
 Vec3 PathFinderGrid::CellIndexToWorldPosition(IntVec3Param index)
@@ -107,6 +107,7 @@ public:
   void FindPathGeneric(VariantParam start, VariantParam goal, Array<Variant>& pathOut) override;
   HandleOf<PathFinderRequest> FindPathGenericThreaded(VariantParam start, VariantParam goal) override;
   StringParam GetCustomEventName() override;
+  void FlushPendingQueries() override;
 
   // PathFinderGrid Interface
   /// If there is collision at a cell then the A* algorithm cannot traverse that
@@ -168,6 +169,7 @@ public:
   // Internals
   Transform* mTransform;
   CopyOnWriteHandle<PathFinderAlgorithmGrid> mGrid;
+  PathFinderQueryBatch<IntVec3, PathFinderAlgorithmGrid> mQueries;
   Vec3 mLocalCellSize;
 };
 
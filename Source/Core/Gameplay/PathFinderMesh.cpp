@@ -13,6 +13,8 @@ DefineEvent(PathFinderMeshFinished);
 NavMeshEdge::NavMeshEdge(NavMeshPolygon* owner) :
     mCost(0.0f),
     mTailVertex(u32(-1)),
+    mHeadVertex(u32(-1)),
+    mId(u32(-1)),
     mPolygon(owner),
     mNextConnected(this),
     mPreviousConnected(this)
@@ -71,6 +73,10 @@ NavMeshEdge::PolygonRange NavMeshEdge::AllConnectedTriangles(NavMeshPolygon* ign
 }
 
 // Nav Mesh Triangle
+NavMeshPolygon::NavMeshPolygon() : mCollision(false), mCost(0.0f), mId(cInvalidMeshId)
+{
+}
+
 Vec3 NavMeshPolygon::GetCenter(PathFinderAlgorithmMesh* mesh)
 {
   Array<Vec3>& vertices = mesh->mVertices;
@@ -99,9 +105,12 @@ NavMeshPolygon::PolygonRange NavMeshPolygon::AllNeighboringPolygons()
 }
 
 // Triangle Triangle Range
-NavMeshPolygon::PolygonRange::PolygonRange(NavMeshPolygon* polygon) : mCurrentEdge(polygon->AllEdges())
+NavMeshPolygon::PolygonRange::PolygonRange(NavMeshPolygon* polygon) :
+    mPolygon(polygon),
+    mCurrentEdge(polygon->AllEdges())
 {
-  mCurrentEdgesPolygons = CurrentEdge()->AllConnectedTriangles(mPolygon);
+  if (!mCurrentEdge.Empty())
+    mCurrentEdgesPolygons = CurrentEdge()->AllConnectedTriangles(mPolygon);
   FindNextValid();
 }
 
@@ -137,7 +146,8 @@ void NavMeshPolygon::PolygonRange::FindNextValid()
   {
     // If the triangles for the current edge are empty, move to the next edge
     mCurrentEdge.PopFront();
-    mCurrentEdgesPolygons = CurrentEdge()->AllConnectedTriangles(mPolygon);
+    if (!mCurrentEdge.Empty())
+      mCurrentEdgesPolygons = CurrentEdge()->AllConnectedTriangles(mPolygon);
   }
 }
 
@@ -146,26 +156,61 @@ float NavMeshPolygon::PolygonRange::GetFrontCost()
   return CurrentEdge()->mCost + Front()->mCost;
 }
 
+// Nav Mesh Compiled Polygon
+NavMeshCompiledPolygon::NavMeshCompiledPolygon() :
+    mCenter(Vec3::cZero),
+    mCost(0.0f),
+    mCollision(false),
+    mTile(u32(-1)),
+    mFirstLink(0),
+    mLinkCount(0),
+    mFirstVertex(0),
+    mVertexCount(0)
+{
+}
+
+bool NavMeshCompiledPolygon::IsValid() const
+{
+  return mTile != u32(-1);
+}
+
+// Nav Mesh Tile
+NavMeshTile::NavMeshTile()
+{
+  mTree.SetPartitionMethod(PartitionMethods::MinimizeVolumeSum);
+}
+
 // Finder Mesh Node Range
-PathFinderMeshNodeRange::PathFinderMeshNodeRange(NavMeshPolygon* polygon) : mRange(polygon->AllNeighboringPolygons())
+PathFinderMeshNodeRange::PathFinderMeshNodeRange(PathFinderAlgorithmMesh* mesh, NavMeshPolygonId polygonId) :
+    mMesh(mesh),
+    mBegin(nullptr),
+    mEnd(nullptr)
 {
+  NavMeshCompiledPolygon* polygon = mesh->GetCompiledPolygon(polygonId);
+  if (polygon != nullptr && polygon->mLinkCount != 0)
+  {
+    NavMeshTile* tile = mesh->GetTile(*polygon);
+    mBegin = tile->mLinks.Data() + polygon->mFirstLink;
+    mEnd = mBegin + polygon->mLinkCount;
+  }
+
   PopUntilValid();
 }
 
 bool PathFinderMeshNodeRange::Empty()
 {
-  return mRange.Empty();
+  return mBegin == mEnd;
 }
 
 void PathFinderMeshNodeRange::PopFront()
 {
-  mRange.PopFront();
+  ++mBegin;
   PopUntilValid();
 }
 
 PathFinderMeshNodeRange::FrontResult PathFinderMeshNodeRange::Front()
 {
-  return FrontResult(mRange.Front()->mId, mRange.GetFrontCost());
+  return FrontResult(mBegin->mNeighbor, mBegin->mCost);
 }
 
 PathFinderMeshNodeRange& PathFinderMeshNodeRange::All()
@@ -175,36 +220,34 @@ PathFinderMeshNodeRange& PathFinderMeshNodeRange::All()
 
 void PathFinderMeshNodeRange::PopUntilValid()
 {
-  while (!mRange.Empty())
+  while (mBegin != mEnd)
   {
-    NavMeshPolygon* triangle = mRange.Front();
-
-    // Skip over triangles with collision
-    if (triangle->mCollision == false)
+    // Skip over polygons with collision
+    if (mMesh->mCompiledPolygons[mBegin->mNeighbor].mCollision == false)
       break;
-    mRange.PopFront();
+    ++mBegin;
   }
 }
 
 // Finder Algorithm Mesh
-PathFinderAlgorithmMesh::PathFinderAlgorithmMesh() : mCurrentPolygonId(0), mCurrentEdgeId(0)
+PathFinderAlgorithmMesh::PathFinderAlgorithmMesh() : mCurrentPolygonId(0), mCurrentEdgeId(0), mTileSize(32.0f)
 {
 }
 
 PathFinderMeshNodeRange PathFinderAlgorithmMesh::QueryNeighbors(NavMeshPolygonId polygonId)
 {
-  return PathFinderMeshNodeRange(GetPolygon(polygonId));
+  return PathFinderMeshNodeRange(this, polygonId);
 }
 
 bool PathFinderAlgorithmMesh::QueryIsValid(NavMeshPolygonId polygonId)
 {
-  return (polygonId != u32(-1));
+  return GetCompiledPolygon(polygonId) != nullptr;
 }
 
 float PathFinderAlgorithmMesh::QueryHeuristic(NavMeshPolygonId start, NavMeshPolygonId goal)
 {
-  Vec3 startPos = GetPolygon(start)->GetCenter(this);
-  Vec3 goalPos = GetPolygon(goal)->GetCenter(this);
+  Vec3 startPos = mCompiledPolygons[start].mCenter;
+  Vec3 goalPos = mCompiledPolygons[goal].mCenter;
 
   return Math::DistanceSq(startPos, goalPos);
 }
@@ -221,6 +264,7 @@ NavMeshPolygonId PathFinderAlgorithmMesh::AddPolygon()
   NavMeshPolygon* polygon = new NavMeshPolygon();
   polygon->mId = id;
   mPolygons.Insert(id, polygon);
+  mModifiedPolygons.Insert(id);
   return id;
 }
 
@@ -245,6 +289,9 @@ NavMeshPolygonId PathFinderAlgorithmMesh::AddPolygon(Array<u32>& vertices)
     previous = current;
   }
 
+  // Close the polygon
+  AddEdgeToPolygon(id, previous, vertices.Front());
+
   return id;
 }
 
@@ -293,6 +340,8 @@ NavMeshEdgeId PathFinderAlgorithmMesh::AddEdgeToPolygon(NavMeshPolygonId polygon
   mEdges.Insert(edgeId, edge);
 
   edge->mTailVertex = vertex0;
+  edge->mHeadVertex = vertex1;
+  edge->mId = edgeId;
 
   // We need to search for other polygons connected to these two vertices
   u64 edgeIndex = GetLexicographicId(vertex0, vertex1);
@@ -314,13 +363,64 @@ NavMeshEdgeId PathFinderAlgorithmMesh::AddEdgeToPolygon(NavMeshPolygonId polygon
     mEdgeConnections.Insert(edgeIndex, edge);
   }
 
+  // Both this polygon and the polygons it now connects to need new links
+  MarkModified(polygon);
+
   return edgeId;
 }
 
+void PathFinderAlgorithmMesh::RemovePolygon(NavMeshPolygonId polygonId)
+{
+  NavMeshPolygon* polygon = GetPolygon(polygonId);
+
+  if (polygon == nullptr)
+  {
+    DoNotifyException("Cannot remove polygon", "Given polygon id is invalid");
+    return;
+  }
+
+  // Our neighbors will lose their links to us
+  MarkModified(polygon);
+
+  while (!polygon->mEdges.Empty())
+  {
+    NavMeshEdge* edge = &polygon->mEdges.Front();
+    polygon->mEdges.PopFront();
+
+    // Remove the edge from the list of edges sharing the same vertices
+    u64 edgeIndex = GetLexicographicId(edge->mTailVertex, edge->mHeadVertex);
+    NavMeshEdge* next = edge->mNextConnected;
+    if (next == edge)
+    {
+      mEdgeConnections.Erase(edgeIndex);
+    }
+    else
+    {
+      if (mEdgeConnections.FindValue(edgeIndex, nullptr) == edge)
+        mEdgeConnections[edgeIndex] = next;
+
+      next->mPreviousConnected = edge->mPreviousConnected;
+      edge->mPreviousConnected->mNextConnected = next;
+    }
+
+    mEdges.Erase(edge->mId);
+    mEdgeClientData.Erase(edge);
+    delete edge;
+  }
+
+  mPolygons.Erase(polygonId);
+  mPolygonClientData.Erase(polygon);
+  delete polygon;
+}
+
 void PathFinderAlgorithmMesh::SetPolygonCost(NavMeshPolygonId polygonId, float cost)
 {
   if (NavMeshPolygon* polygon = GetPolygon(polygonId))
+  {
     polygon->mCost = cost;
+    // The cost is baked into the links of our neighbors
+    MarkModified(polygon);
+  }
   else
     DoNotifyException("Cannot set polygon cost", "Given polygon id is invalid");
 }
@@ -336,7 +436,10 @@ void PathFinderAlgorithmMesh::SetPolygonClientData(NavMeshPolygonId polygonId, C
 void PathFinderAlgorithmMesh::SetEdgeCost(NavMeshEdgeId edgeId, float cost)
 {
   if (NavMeshEdge* edge = GetEdge(edgeId))
+  {
     edge->mCost = cost;
+    MarkModified(edge->mPolygon);
+  }
   else
     DoNotifyException("Cannot set edge cost", "Given edge id is invalid");
 }
@@ -362,6 +465,246 @@ void PathFinderAlgorithmMesh::Clear()
   mPolygons.Clear();
   mPolygonClientData.Clear();
   mEdgeClientData.Clear();
+
+  mModifiedPolygons.Clear();
+  mCompiledPolygons.Clear();
+  mTiles.Clear();
+  mTileIndices.Clear();
+}
+
+bool PathFinderAlgorithmMesh::NeedsCompile()
+{
+  return !mModifiedPolygons.Empty();
+}
+
+void PathFinderAlgorithmMesh::Compile()
+{
+  if (mModifiedPolygons.Empty())
+    return;
+
+  ZoneScoped;
+
+  if (mCompiledPolygons.Size() < mCurrentPolygonId)
+    mCompiledPolygons.Resize(mCurrentPolygonId);
+
+  // Recompute every modified polygon and move it into the tile its center now
+  // lies in. Both the old and the new tile have to be rebuilt
+  HashSet<u32> modifiedTiles;
+  forRange (NavMeshPolygonId polygonId, mModifiedPolygons.All())
+  {
+    NavMeshCompiledPolygon& compiled = mCompiledPolygons[polygonId];
+    if (compiled.IsValid())
+      modifiedTiles.Insert(compiled.mTile);
+
+    compiled = NavMeshCompiledPolygon();
+
+    // Removed polygons (and ones without edges yet) stay invalid
+    NavMeshPolygon* polygon = GetPolygon(polygonId);
+    if (polygon == nullptr || polygon->mEdges.Empty())
+      continue;
+
+    compiled.mCenter = polygon->GetCenter(this);
+    compiled.mCost = polygon->mCost;
+    compiled.mCollision = polygon->mCollision;
+    compiled.mTile = GetOrCreateTileIndex(GetTileKey(compiled.mCenter));
+    modifiedTiles.Insert(compiled.mTile);
+  }
+
+  // The new contents of each tile are the unmodified polygons it already had
+  // plus the modified polygons that now belong to it
+  HashMap<u32, Array<NavMeshPolygonId>> tilePolygons;
+  forRange (u32 tileIndex, modifiedTiles.All())
+  {
+    Array<NavMeshPolygonId>& polygons = tilePolygons[tileIndex];
+    forRange (NavMeshPolygonId polygonId, mTiles[tileIndex]->mPolygons.All())
+    {
+      if (!mModifiedPolygons.Contains(polygonId))
+        polygons.PushBack(polygonId);
+    }
+  }
+
+  forRange (NavMeshPolygonId polygonId, mModifiedPolygons.All())
+  {
+    NavMeshCompiledPolygon& compiled = mCompiledPolygons[polygonId];
+    if (compiled.IsValid())
+      tilePolygons[compiled.mTile].PushBack(polygonId);
+  }
+
+  typedef Pair<u32, Array<NavMeshPolygonId>> TileEntry;
+  forRange (TileEntry& entry, tilePolygons.All())
+    BuildTile(entry.first, entry.second);
+
+  mModifiedPolygons.Clear();
+}
+
+NavMeshPolygonId PathFinderAlgorithmMesh::LocatePolygon(Vec3Param localPosition)
+{
+  NavMeshPolygonId closest = cInvalidMeshId;
+  float closestDistance = Math::PositiveMax();
+
+  StaticAabbTree<NavMeshPolygonId>::NodeArray scratchBuffer;
+  forRange (CopyOnWriteHandle<NavMeshTile>& tileHandle, mTiles.All())
+  {
+    NavMeshTile* tile = tileHandle;
+    if (tile->mPolygons.Empty())
+      continue;
+
+    // Only the horizontal position has to be inside the polygon, the vertical
+    // distance is used to pick between stacked polygons
+    const Aabb& tileAabb = tile->mAabb;
+    if (localPosition.x < tileAabb.mMin.x || localPosition.x > tileAabb.mMax.x || localPosition.z < tileAabb.mMin.z ||
+        localPosition.z > tileAabb.mMax.z)
+      continue;
+
+    Aabb query;
+    query.SetMinAndMax(Vec3(localPosition.x, tileAabb.mMin.y, localPosition.z),
+                       Vec3(localPosition.x, tileAabb.mMax.y, localPosition.z));
+
+    scratchBuffer.Clear();
+    for (auto range = tile->mTree.Query(query, scratchBuffer); !range.Empty(); range.PopFront())
+    {
+      NavMeshPolygonId polygonId = range.Front();
+      NavMeshCompiledPolygon& polygon = mCompiledPolygons[polygonId];
+      if (!PolygonContainsPoint(polygon, tile, localPosition))
+        continue;
+
+      float distance = Math::Abs(polygon.mCenter.y - localPosition.y);
+      if (distance < closestDistance)
+      {
+        closest = polygonId;
+        closestDistance = distance;
+      }
+    }
+  }
+
+  if (closest != cInvalidMeshId)
+    return closest;
+
+  // The point is off the mesh, so use the polygon with the closest center
+  for (uint i = 0; i < mCompiledPolygons.Size(); ++i)
+  {
+    NavMeshCompiledPolygon& polygon = mCompiledPolygons[i];
+    if (!polygon.IsValid())
+      continue;
+
+    float distance = Math::DistanceSq(localPosition, polygon.mCenter);
+    if (distance < closestDistance)
+    {
+      closest = i;
+      closestDistance = distance;
+    }
+  }
+
+  return closest;
+}
+
+// Twice the signed area of the triangle abc when looking down the y axis. This
+// is positive when c is to the left of the direction from a to b.
+static float SignedArea2d(Vec3Param a, Vec3Param b, Vec3Param c)
+{
+  return (b.z - a.z) * (c.x - a.x) - (b.x - a.x) * (c.z - a.z);
+}
+
+static bool SamePoint2d(Vec3Param a, Vec3Param b)
+{
+  const float cEpsilon = 0.000001f;
+  float x = b.x - a.x;
+  float z = b.z - a.z;
+  return (x * x + z * z) < cEpsilon;
+}
+
+void PathFinderAlgorithmMesh::SmoothPath(Vec3Param start,
+                                         Vec3Param goal,
+                                         const Array<NavMeshPolygonId>& polygons,
+                                         Array<Vec3>& pathOut)
+{
+  pathOut.Clear();
+  if (polygons.Empty())
+    return;
+
+  // Collect the left and right sides of every portal (relative to the direction
+  // of travel). The start and goal are treated as portals of zero width
+  Array<Vec3> lefts;
+  Array<Vec3> rights;
+  lefts.PushBack(start);
+  rights.PushBack(start);
+  for (uint i = 0; i + 1 < polygons.Size(); ++i)
+  {
+    const NavMeshLink* link = FindLink(polygons[i], polygons[i + 1]);
+    if (link == nullptr)
+      continue;
+
+    Vec3 portal0 = mVertices[link->mPortalVertex0];
+    Vec3 portal1 = mVertices[link->mPortalVertex1];
+    Vec3 from = mCompiledPolygons[polygons[i]].mCenter;
+    Vec3 to = mCompiledPolygons[polygons[i + 1]].mCenter;
+    if (SignedArea2d(from, to, portal0) < 0.0f)
+      Swap(portal0, portal1);
+
+    lefts.PushBack(portal0);
+    rights.PushBack(portal1);
+  }
+  lefts.PushBack(goal);
+  rights.PushBack(goal);
+
+  // Simple stupid funnel algorithm. The funnel is narrowed by each portal
+  // until one side crosses over the other, at which point the other side
+  // becomes a corner of the path and the new apex of the funnel
+  pathOut.PushBack(start);
+  Vec3 apex = start;
+  Vec3 left = lefts[0];
+  Vec3 right = rights[0];
+  uint apexIndex = 0;
+  uint leftIndex = 0;
+  uint rightIndex = 0;
+
+  for (uint i = 1; i < lefts.Size(); ++i)
+  {
+    Vec3 newLeft = lefts[i];
+    Vec3 newRight = rights[i];
+
+    // Narrow the right side
+    if (SignedArea2d(apex, right, newRight) >= 0.0f)
+    {
+      if (SamePoint2d(apex, right) || SignedArea2d(apex, left, newRight) < 0.0f)
+      {
+        right = newRight;
+        rightIndex = i;
+      }
+      else
+      {
+        pathOut.PushBack(left);
+        apex = left;
+        apexIndex = leftIndex;
+        right = left = apex;
+        rightIndex = leftIndex = apexIndex;
+        i = apexIndex;
+        continue;
+      }
+    }
+
+    // Narrow the left side
+    if (SignedArea2d(apex, left, newLeft) <= 0.0f)
+    {
+      if (SamePoint2d(apex, left) || SignedArea2d(apex, right, newLeft) > 0.0f)
+      {
+        left = newLeft;
+        leftIndex = i;
+      }
+      else
+      {
+        pathOut.PushBack(right);
+        apex = right;
+        apexIndex = rightIndex;
+        right = left = apex;
+        rightIndex = leftIndex = apexIndex;
+        i = apexIndex;
+        continue;
+      }
+    }
+  }
+
+  pathOut.PushBack(goal);
 }
 
 NavMeshPolygon* PathFinderAlgorithmMesh::GetPolygon(NavMeshPolygonId id)
@@ -374,6 +717,18 @@ NavMeshEdge* PathFinderAlgorithmMesh::GetEdge(NavMeshEdgeId id)
   return mEdges.FindValue(id, nullptr);
 }
 
+NavMeshCompiledPolygon* PathFinderAlgorithmMesh::GetCompiledPolygon(NavMeshPolygonId id)
+{
+  if (id >= mCompiledPolygons.Size() || !mCompiledPolygons[id].IsValid())
+    return nullptr;
+  return &mCompiledPolygons[id];
+}
+
+NavMeshTile* PathFinderAlgorithmMesh::GetTile(const NavMeshCompiledPolygon& polygon)
+{
+  return mTiles[polygon.mTile];
+}
+
 NavMeshPolygonId PathFinderAlgorithmMesh::GetNextPolygonId()
 {
   return mCurrentPolygonId++;
@@ -384,6 +739,124 @@ NavMeshEdgeId PathFinderAlgorithmMesh::GetNextEdgeId()
   return mCurrentEdgeId++;
 }
 
+void PathFinderAlgorithmMesh::MarkModified(NavMeshPolygon* polygon)
+{
+  mModifiedPolygons.Insert(polygon->mId);
+  forRange (NavMeshEdge& edge, polygon->AllEdges())
+  {
+    forRange (NavMeshPolygon* neighbor, edge.AllConnectedTriangles(polygon))
+      mModifiedPolygons.Insert(neighbor->mId);
+  }
+}
+
+IntVec3 PathFinderAlgorithmMesh::GetTileKey(Vec3Param position)
+{
+  Vec3 tile = position / mTileSize;
+  return IntVec3((int)Math::Floor(tile.x), (int)Math::Floor(tile.y), (int)Math::Floor(tile.z));
+}
+
+u32 PathFinderAlgorithmMesh::GetOrCreateTileIndex(IntVec3Param tileKey)
+{
+  if (u32* tileIndex = mTileIndices.FindPointer(tileKey))
+    return *tileIndex;
+
+  u32 tileIndex = mTiles.Size();
+  mTiles.PushBack(CopyOnWriteHandle<NavMeshTile>(new CopyOnWriteData<NavMeshTile>()));
+  mTileIndices.Insert(tileKey, tileIndex);
+  return tileIndex;
+}
+
+void PathFinderAlgorithmMesh::BuildTile(u32 tileIndex, Array<NavMeshPolygonId>& polygons)
+{
+  // The old tile may still be used by a copy of this algorithm on another
+  // thread, so a new tile is always built instead of modifying it
+  CopyOnWriteHandle<NavMeshTile> tileHandle(new CopyOnWriteData<NavMeshTile>());
+  NavMeshTile* tile = tileHandle;
+
+  Sort(polygons.All());
+  tile->mPolygons = polygons;
+
+  BroadPhaseProxy proxy;
+  forRange (NavMeshPolygonId polygonId, polygons.All())
+  {
+    NavMeshPolygon* polygon = GetPolygon(polygonId);
+    NavMeshCompiledPolygon& compiled = mCompiledPolygons[polygonId];
+    compiled.mFirstLink = tile->mLinks.Size();
+    compiled.mFirstVertex = tile->mVertexIndices.Size();
+
+    Aabb aabb;
+    aabb.SetInvalid();
+    forRange (NavMeshEdge& edge, polygon->AllEdges())
+    {
+      tile->mVertexIndices.PushBack(edge.mTailVertex);
+      aabb.Expand(mVertices[edge.mTailVertex]);
+
+      forRange (NavMeshPolygon* neighbor, edge.AllConnectedTriangles(polygon))
+      {
+        NavMeshLink& link = tile->mLinks.PushBack();
+        link.mNeighbor = neighbor->mId;
+        link.mCost = edge.mCost + neighbor->mCost;
+        link.mPortalVertex0 = edge.mTailVertex;
+        link.mPortalVertex1 = edge.mHeadVertex;
+      }
+    }
+
+    compiled.mLinkCount = tile->mLinks.Size() - compiled.mFirstLink;
+    compiled.mVertexCount = tile->mVertexIndices.Size() - compiled.mFirstVertex;
+
+    BaseBroadPhaseData<NavMeshPolygonId> data;
+    data.mClientData = polygonId;
+    data.mAabb = aabb;
+    tile->mTree.CreateProxy(proxy, data);
+    tile->mAabb.Combine(aabb);
+  }
+
+  tile->mTree.Construct();
+  mTiles[tileIndex] = tileHandle;
+}
+
+bool PathFinderAlgorithmMesh::PolygonContainsPoint(const NavMeshCompiledPolygon& polygon,
+                                                   NavMeshTile* tile,
+                                                   Vec3Param point)
+{
+  // The point is inside a convex polygon (of either winding) when it is on the
+  // same side of every edge
+  float side = 0.0f;
+  for (uint i = 0; i < polygon.mVertexCount; ++i)
+  {
+    u32 next = (i + 1) % polygon.mVertexCount;
+    Vec3Param a = mVertices[tile->mVertexIndices[polygon.mFirstVertex + i]];
+    Vec3Param b = mVertices[tile->mVertexIndices[polygon.mFirstVertex + next]];
+
+    float area = SignedArea2d(a, b, point);
+    if (area == 0.0f)
+      continue;
+
+    if (side == 0.0f)
+      side = area;
+    else if (area * side < 0.0f)
+      return false;
+  }
+
+  return true;
+}
+
+const NavMeshLink* PathFinderAlgorithmMesh::FindLink(NavMeshPolygonId from, NavMeshPolygonId to)
+{
+  NavMeshCompiledPolygon* polygon = GetCompiledPolygon(from);
+  if (polygon == nullptr)
+    return nullptr;
+
+  NavMeshTile* tile = GetTile(*polygon);
+  for (uint i = 0; i < polygon->mLinkCount; ++i)
+  {
+    const NavMeshLink& link = tile->mLinks[polygon->mFirstLink + i];
+    if (link.mNeighbor == to)
+      return &link;
+  }
+  return nullptr;
+}
+
 // Path Finder Mesh
 LightningDefineType(PathFinderMesh, builder, type)
 {
@@ -404,6 +877,7 @@ LightningDefineType(PathFinderMesh, builder, type)
   LightningBindOverloadedMethod(AddPolygon, LightningInstanceOverload(NavMeshPolygonId, u32, u32, u32));
   LightningBindOverloadedMethod(AddPolygon, LightningInstanceOverload(NavMeshPolygonId, u32, u32, u32, u32));
 
+  LightningBindMethod(RemovePolygon);
   LightningBindMethod(SetPolygonCost);
   LightningBindMethod(SetPolygonClientData);
   LightningBindMethod(SetEdgeCost);
@@ -420,6 +894,7 @@ LightningDefineType(PathFinderMesh, builder, type)
   // LightningInstanceOverload(HandleOf<PathFinderRequest>, Real3Param,
   // Real3Param));
 
+  LightningBindMethod(FindSmoothPath);
   LightningBindMethod(WorldPositionToPolygon);
   LightningBindMethod(LocalPositionToPolygon);
 }
@@ -495,18 +970,19 @@ Variant PathFinderMesh::WorldPositionToNodeKey(Vec3Param worldPosition)
 
 Vec3 PathFinderMesh::NodeKeyToWorldPosition(VariantParam nodeKey)
 {
-  NavMeshPolygon* triangle = (NavMeshPolygon*)nodeKey;
-  return triangle->GetCenter(mMesh);
+  return PolygonToWorldPosition(nodeKey.GetOrDefault<NavMeshPolygonId>(cInvalidMeshId));
 }
 
 void PathFinderMesh::FindPathGeneric(VariantParam start, VariantParam goal, Array<Variant>& pathOut)
 {
-  GenericFindPathHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(mMesh, start, goal, pathOut, mMaxIterations);
+  CompileMesh();
+  GenericFindPathHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(
+      mMesh, mQueries, start, goal, pathOut, mMaxIterations);
 }
 
 HandleOf<PathFinderRequest> PathFinderMesh::FindPathGenericThreaded(VariantParam start, VariantParam goal)
 {
-  return GenericFindPathThreadedHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(mMesh, start, goal, mMaxIterations);
+  return GenericFindPathThreadedHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(mQueries, start, goal);
 }
 
 StringParam PathFinderMesh::GetCustomEventName()
@@ -514,6 +990,12 @@ StringParam PathFinderMesh::GetCustomEventName()
   return Events::PathFinderMeshFinished;
 }
 
+void PathFinderMesh::FlushPendingQueries()
+{
+  CompileMesh();
+  mQueries.Flush(this, mMesh, mMaxIterations, mPathCacheSize);
+}
+
 void PathFinderMesh::SetMesh(Mesh* graphicsMesh)
 {
   SetMesh(graphicsMesh, Math::DegToRad(90.0f));
@@ -522,6 +1004,7 @@ void PathFinderMesh::SetMesh(Mesh* graphicsMesh)
 void PathFinderMesh::SetMesh(Mesh* graphicsMesh, float maxSlope)
 {
   mMesh.CopyIfNeeded();
+  mQueries.InvalidateCache();
   PathFinderAlgorithmMesh* mesh = mMesh;
 
   // Add all vertices
@@ -552,31 +1035,43 @@ uint PathFinderMesh::AddVertex(Vec3Param pos)
 NavMeshPolygonId PathFinderMesh::AddPolygon(Array<u32>& vertices)
 {
   mMesh.CopyIfNeeded();
+  mQueries.InvalidateCache();
   return mMesh->AddPolygon(vertices);
 }
 
 NavMeshPolygonId PathFinderMesh::AddPolygon(ArrayClass<u32>& vertices)
 {
   mMesh.CopyIfNeeded();
+  mQueries.InvalidateCache();
   return mMesh->AddPolygon(vertices);
 }
 
 NavMeshPolygonId PathFinderMesh::AddPolygon(u32 vertex0, u32 vertex1, u32 vertex2)
 {
   mMesh.CopyIfNeeded();
+  mQueries.InvalidateCache();
   return mMesh->AddPolygon(vertex0, vertex1, vertex2);
 }
 
 NavMeshPolygonId PathFinderMesh::AddPolygon(u32 vertex0, u32 vertex1, u32 vertex2, u32 vertex3)
 {
   mMesh.CopyIfNeeded();
+  mQueries.InvalidateCache();
   return mMesh->AddPolygon(vertex0, vertex1, vertex2, vertex3);
 }
 
+void PathFinderMesh::RemovePolygon(NavMeshPolygonId polygonId)
+{
+  mMesh.CopyIfNeeded();
+  mMesh->RemovePolygon(polygonId);
+  mQueries.InvalidateCache();
+}
+
 void PathFinderMesh::SetPolygonCost(NavMeshPolygonId polygonId, float cost)
 {
   mMesh.CopyIfNeeded();
   mMesh->SetPolygonCost(polygonId, cost);
+  mQueries.InvalidateCache();
 }
 
 void PathFinderMesh::SetPolygonClientData(NavMeshPolygonId polygonId, Cog* clientData)
@@ -589,6 +1084,7 @@ void PathFinderMesh::SetEdgeCost(NavMeshEdgeId edgeId, float cost)
 {
   mMesh.CopyIfNeeded();
   mMesh->SetEdgeCost(edgeId, cost);
+  mQueries.InvalidateCache();
 }
 
 void PathFinderMesh::SetEdgeClientData(NavMeshEdgeId edgeId, Cog* clientData)
@@ -601,69 +1097,75 @@ void PathFinderMesh::Clear()
 {
   mMesh.CopyIfNeeded();
   mMesh->Clear();
+  mQueries.InvalidateCache();
+}
+
+HandleOf<ArrayClass<Vec3>> PathFinderMesh::FindSmoothPath(Vec3Param worldStart, Vec3Param worldGoal)
+{
+  HandleOf<ArrayClass<Vec3>> output = LightningAllocate(ArrayClass<Vec3>);
+
+  Vec3 localStart = mTransform->TransformPointInverse(worldStart);
+  Vec3 localGoal = mTransform->TransformPointInverse(worldGoal);
+  NavMeshPolygonId start = LocalPositionToPolygon(localStart);
+  NavMeshPolygonId goal = LocalPositionToPolygon(localGoal);
+
+  Array<NavMeshPolygonId> polygons;
+  mQueries.FindNodePath(mMesh, start, goal, polygons, mMaxIterations, mPathCacheSize);
+  if (polygons.Empty())
+    return output;
+
+  Array<Vec3>& path = output->NativeArray;
+  mMesh->SmoothPath(localStart, localGoal, polygons, path);
+  for (uint i = 0; i < path.Size(); ++i)
+    path[i] = mTransform->TransformPoint(path[i]);
+
+  return output;
 }
 
 HandleOf<ArrayClass<Vec3>> PathFinderMesh::FindPath(NavMeshPolygonId start, NavMeshPolygonId goal)
 {
-  PathFinderAlgorithmMesh* mesh = mMesh;
-  // NavMeshPolygon* startPoly = mesh->GetPolygon(start);
-  // NavMeshPolygon* goalPoly = mesh->GetPolygon(goal);
+  CompileMesh();
 
   HandleOf<ArrayClass<NavMeshPolygonId>> polygons =
-      FindPathHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(mMesh, start, goal, mMaxIterations);
+      FindPathHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(mMesh, mQueries, start, goal, mMaxIterations);
 
   HandleOf<ArrayClass<Vec3>> output = LightningAllocate(ArrayClass<Vec3>);
   forRange (NavMeshPolygonId polygonId, polygons->NativeArray.All())
-  {
-    NavMeshPolygon* polygon = mesh->GetPolygon(polygonId);
-    output->NativeArray.PushBack(polygon->GetCenter(mesh));
-  }
+    output->NativeArray.PushBack(PolygonToWorldPosition(polygonId));
   return output;
 }
 
 HandleOf<PathFinderRequest> PathFinderMesh::FindPathThreaded(NavMeshPolygonId start, NavMeshPolygonId goal)
 {
-  PathFinderAlgorithmMesh* mesh = mMesh;
-  // NavMeshPolygon* startPoly = mesh->GetPolygon(start);
-  // NavMeshPolygon* goalPoly = mesh->GetPolygon(goal);
-
-  return FindPathThreadedHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(mMesh, start, goal, mMaxIterations);
+  return FindPathThreadedHelper<NavMeshPolygonId, PathFinderAlgorithmMesh>(mQueries, start, goal);
 }
 
 NavMeshPolygonId PathFinderMesh::WorldPositionToPolygon(Vec3Param worldPosition)
 {
-  PathFinderAlgorithmMesh* mesh = mMesh;
-  NavMeshPolygonId closest = u32(-1);
-  float closestDistance = Math::PositiveMax();
-
-  typedef Pair<NavMeshPolygonId, NavMeshPolygon*> PairEntry;
-  forRange (PairEntry& entry, mesh->mPolygons.All())
-  {
-    NavMeshPolygon* polygon = entry.second;
-    Vec3 center = polygon->GetCenter(mesh);
-    float currDistance = Math::DistanceSq(worldPosition, center);
-
-    if (currDistance < closestDistance)
-    {
-      closest = entry.first;
-      closestDistance = currDistance;
-    }
-  }
-
-  return closest;
+  return LocalPositionToPolygon(mTransform->TransformPointInverse(worldPosition));
 }
 
 NavMeshPolygonId PathFinderMesh::LocalPositionToPolygon(Vec3Param localPosition)
 {
-  return 0;
+  CompileMesh();
+  return mMesh->LocatePolygon(localPosition);
 }
 
 Vec3 PathFinderMesh::PolygonToWorldPosition(NavMeshPolygonId polygonId)
 {
-  PathFinderAlgorithmMesh* mesh = mMesh;
-  if (NavMeshPolygon* polygon = mesh->GetPolygon(polygonId))
-    return polygon->GetCenter(mesh);
+  CompileMesh();
+  if (NavMeshCompiledPolygon* polygon = mMesh->GetCompiledPolygon(polygonId))
+    return mTransform->TransformPoint(polygon->mCenter);
   return Vec3::cZero;
 }
 
+void PathFinderMesh::CompileMesh()
+{
+  if (!mMesh->NeedsCompile())
+    return;
+
+  mMesh.CopyIfNeeded();
+  mMesh->Compile();
+}
+
 } // namespace Plasma
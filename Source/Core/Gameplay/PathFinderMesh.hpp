@@ -71,6 +71,12 @@ struct NavMeshEdge
   /// first.
   u32 mTailVertex;
 
+  /// The index to the head vertex of this edge (the vertex given when the edge
+  /// was added, normally the next edge's tail vertex).
+  u32 mHeadVertex;
+
+  NavMeshEdgeId mId;
+
   /// The owning polygon of this edge.
   NavMeshPolygon* mPolygon;
 
@@ -116,6 +122,8 @@ struct NavMeshPolygon
     NavMeshEdge::PolygonRange mCurrentEdgesPolygons;
   };
 
+  NavMeshPolygon();
+
   EdgeRange AllEdges();
   PolygonRange AllNeighboringPolygons();
 
@@ -133,11 +141,68 @@ struct NavMeshPolygon
   u32 mId;
 };
 
+// Nav Mesh Link
+/// A compiled connection from one polygon to a neighbor through a shared edge
+/// (the portal between the two polygons).
+struct NavMeshLink
+{
+  NavMeshPolygonId mNeighbor;
+
+  /// The cost of the edge plus the cost of the neighboring polygon.
+  float mCost;
+
+  /// Vertex indices of the shared edge.
+  u32 mPortalVertex0;
+  u32 mPortalVertex1;
+};
+
+// Nav Mesh Compiled Polygon
+/// Flat per polygon data of the compiled nav mesh (indexed by polygon id).
+/// The polygon's vertices and links are stored in the tile that owns it.
+struct NavMeshCompiledPolygon
+{
+  NavMeshCompiledPolygon();
+
+  bool IsValid() const;
+
+  Vec3 mCenter;
+  float mCost;
+  bool mCollision;
+
+  u32 mTile;
+  u32 mFirstLink;
+  u32 mLinkCount;
+  u32 mFirstVertex;
+  u32 mVertexCount;
+};
+
+// Nav Mesh Tile
+/// All polygons whose center lies within one cell of the nav mesh's tile grid.
+/// A tile is immutable once built and is shared between copies of the
+/// algorithm (including the ones held by threaded path requests). Modifying
+/// the mesh rebuilds only the tiles that were touched.
+class NavMeshTile
+{
+public:
+  NavMeshTile();
+
+  /// The polygons owned by this tile.
+  Array<NavMeshPolygonId> mPolygons;
+  /// The links and vertex rings of all polygons, indexed through
+  /// NavMeshCompiledPolygon::mFirstLink and mFirstVertex.
+  Array<NavMeshLink> mLinks;
+  Array<u32> mVertexIndices;
+
+  /// Used to find the polygon containing a point.
+  StaticAabbTree<NavMeshPolygonId> mTree;
+  Aabb mAabb;
+};
+
 // Finder Mesh Node Range
 class PathFinderMeshNodeRange
 {
 public:
-  PathFinderMeshNodeRange(NavMeshPolygon* polygon);
+  PathFinderMeshNodeRange(PathFinderAlgorithmMesh* mesh, NavMeshPolygonId polygonId);
 
   // Range Interface
   typedef Pair<NavMeshPolygonId, float> FrontResult;
@@ -149,7 +214,9 @@ public:
   // Returns true if it pops, or false if the cell is valid
   inline void PopUntilValid();
 
-  NavMeshPolygon::PolygonRange mRange;
+  PathFinderAlgorithmMesh* mMesh;
+  const NavMeshLink* mBegin;
+  const NavMeshLink* mEnd;
 };
 
 // Finder Algorithm Mesh
@@ -178,6 +245,9 @@ public:
   /// Adds an edge to the polygon with the given id.
   NavMeshEdgeId AddEdgeToPolygon(NavMeshPolygonId polygonId, u32 vertex0, u32 vertex1);
 
+  /// Removes the polygon and all of its edges.
+  void RemovePolygon(NavMeshPolygonId polygonId);
+
   /// A higher cost of a polygon makes the A* algorithm less likely to traverse
   /// that polygon.
   void SetPolygonCost(NavMeshPolygonId polygonId, float cost);
@@ -195,13 +265,40 @@ public:
   /// Clear the grid of all collision and costs.
   void Clear();
 
+  /// Whether any polygons were modified since the last compile.
+  bool NeedsCompile();
+
+  /// Rebuilds the tiles containing (or neighboring) any polygon that was
+  /// modified since the last compile. Path finding and point location only use
+  /// the compiled data, so this must be called before either.
+  void Compile();
+
+  /// Returns the polygon containing the given point (when looking down the up
+  /// axis) or the polygon with the closest center if no polygon contains it.
+  NavMeshPolygonId LocatePolygon(Vec3Param localPosition);
+
+  /// Straightens a polygon path into the shortest line through the portals
+  /// of each polygon (funnel algorithm). The output includes start and goal.
+  void SmoothPath(Vec3Param start, Vec3Param goal, const Array<NavMeshPolygonId>& polygons, Array<Vec3>& pathOut);
+
   // Internals
   NavMeshPolygon* GetPolygon(NavMeshPolygonId id);
   NavMeshEdge* GetEdge(NavMeshEdgeId id);
+  NavMeshCompiledPolygon* GetCompiledPolygon(NavMeshPolygonId id);
+  NavMeshTile* GetTile(const NavMeshCompiledPolygon& polygon);
 
   NavMeshPolygonId GetNextPolygonId();
   NavMeshEdgeId GetNextEdgeId();
 
+  /// Marks the polygon (and its neighbors, whose links depend on it) for the
+  /// next compile.
+  void MarkModified(NavMeshPolygon* polygon);
+  IntVec3 GetTileKey(Vec3Param position);
+  u32 GetOrCreateTileIndex(IntVec3Param tileKey);
+  void BuildTile(u32 tileIndex, Array<NavMeshPolygonId>& polygons);
+  bool PolygonContainsPoint(const NavMeshCompiledPolygon& polygon, NavMeshTile* tile, Vec3Param point);
+  const NavMeshLink* FindLink(NavMeshPolygonId from, NavMeshPolygonId to);
+
   uint mCurrentPolygonId;
   uint mCurrentEdgeId;
 
@@ -212,6 +309,14 @@ public:
   HashMap<u64, NavMeshEdge*> mEdgeConnections;
   HashMap<NavMeshPolygon*, CogId> mPolygonClientData;
   HashMap<NavMeshEdge*, CogId> mEdgeClientData;
+
+  // Compiled data
+  /// The size of a tile in the grid used for incremental compiles.
+  float mTileSize;
+  HashSet<NavMeshPolygonId> mModifiedPolygons;
+  Array<NavMeshCompiledPolygon> mCompiledPolygons;
+  Array<CopyOnWriteHandle<NavMeshTile>> mTiles;
+  HashMap<IntVec3, u32> mTileIndices;
 };
 
 // Path Finder Mesh
@@ -234,6 +339,7 @@ public:
   void FindPathGeneric(VariantParam start, VariantParam goal, Array<Variant>& pathOut) override;
   HandleOf<PathFinderRequest> FindPathGenericThreaded(VariantParam start, VariantParam goal) override;
   StringParam GetCustomEventName() override;
+  void FlushPendingQueries() override;
 
   // NavMesh Interface
   /// Builds a
@@ -251,6 +357,9 @@ public:
   NavMeshPolygonId AddPolygon(u32 vertex0, u32 vertex1, u32 vertex2);
   NavMeshPolygonId AddPolygon(u32 vertex0, u32 vertex1, u32 vertex2, u32 vertex3);
 
+  /// Removes the polygon with the given id (and all of its edges).
+  void RemovePolygon(NavMeshPolygonId polygonId);
+
   /// A higher cost of a polygon makes the A* algorithm less likely to traverse
   /// that polygon.
   void SetPolygonCost(NavMeshPolygonId polygonId, float cost);
@@ -268,6 +377,11 @@ public:
   /// Clear the grid of all collision and costs.
   void Clear();
 
+  /// Finds a path between world positions that has been straightened through
+  /// the polygons' shared edges, so it only turns at corners of the nav mesh
+  /// (or returns an empty array if no path could be found).
+  HandleOf<ArrayClass<Vec3>> FindSmoothPath(Vec3Param worldStart, Vec3Param worldGoal);
+
   /// Finds a path between cell indices (or returns an empty array if no path
   /// could be found).
   HandleOf<ArrayClass<Vec3>> FindPath(NavMeshPolygonId start, NavMeshPolygonId goal);
@@ -289,8 +403,12 @@ public:
   Vec3 PolygonToWorldPosition(NavMeshPolygonId polygonId);
 
   // Internals
+  /// Compiles any modified tiles of the mesh before it is searched.
+  void CompileMesh();
+
   Transform* mTransform;
   CopyOnWriteHandle<PathFinderAlgorithmMesh> mMesh;
+  PathFinderQueryBatch<NavMeshPolygonId, PathFinderAlgorithmMesh> mQueries;
 };
 
 } // namespace Plasma
@@ -4,7 +4,7 @@
 namespace Plasma
 {
 
-void LoadResourcePackageRelative(StringParam baseDirectory, StringParam libraryName)
+void LoadResourcePackageRelative(StringParam baseDirectory, StringParam libraryName, bool background)
 {
   String path = FilePath::Combine(baseDirectory, libraryName);
   String fileName = BuildString(libraryName, ".pack");
@@ -15,28 +15,33 @@ void LoadResourcePackageRelative(StringParam baseDirectory, StringParam libraryN
     FatalEngineError("Failed to find needed content package. %s", libraryName.c_str());
   }
 
-  PL::gResources->LoadPackageFile(packageFile);
+  if (background)
+    PL::gResources->LoadPackageFileAsync(packageFile);
+  else
+    PL::gResources->LoadPackageFile(packageFile);
 }
 
 void LoadGamePackages(StringParam projectFile, Cog* projectCog)
 {
   String projectDirectory = FilePath::GetDirectoryPath(projectFile);
-  LoadResourcePackageRelative(projectDirectory, "FragmentCore");
-  LoadResourcePackageRelative(projectDirectory, "Loading");
-  LoadResourcePackageRelative(projectDirectory, "PlasmaCore");
-  LoadResourcePackageRelative(projectDirectory, "UiWidget");
-  LoadResourcePackageRelative(projectDirectory, "EditorUi");
-  LoadResourcePackageRelative(projectDirectory, "Editor");
+  LoadResourcePackageRelative(projectDirectory, "FragmentCore", false);
+  LoadResourcePackageRelative(projectDirectory, "Loading", false);
+  LoadResourcePackageRelative(projectDirectory, "PlasmaCore", false);
+  LoadResourcePackageRelative(projectDirectory, "UiWidget", false);
+  LoadResourcePackageRelative(projectDirectory, "EditorUi", false);
+  LoadResourcePackageRelative(projectDirectory, "Editor", false);
 
 
+  // The project's own content is read and decoded on jobs while startup
+  // processes jobs, and the game is only created once it's all committed
   ProjectSettings* project = projectCog->has(ProjectSettings);
 
   forRange (String library, project->ExtraLibraries.All())
   {
-    LoadResourcePackageRelative(projectDirectory, library);
+    LoadResourcePackageRelative(projectDirectory, library, true);
   }
 
-  LoadResourcePackageRelative(projectDirectory, project->ProjectName);
+  LoadResourcePackageRelative(projectDirectory, project->ProjectName, true);
 }
 
 void CreateGame(OsWindow* mainWindow, StringParam projectFile, Cog* projectCog)
@@ -28,9 +28,15 @@ bool SupportShapeCollide(const Intersection::SupportShape& a,
                          const Intersection::SupportShape& b,
                          Intersection::Manifold* manifold)
 {
-  // Test for collision.
+  // Test for collision, starting from the pair's last result if the
+  // caller is keeping one
   Intersection::Gjk gjk;
-  Intersection::Type ret = gjk.Test(&a, &b, manifold);
+  Intersection::Type ret;
+  Intersection::GjkCache* cache = Intersection::GjkCacheScope::GetActive();
+  if (cache != nullptr)
+    ret = gjk.Test(&a, &b, *cache, manifold);
+  else
+    ret = gjk.Test(&a, &b, manifold);
   if (ret < (Intersection::Type)0)
     return false;
 
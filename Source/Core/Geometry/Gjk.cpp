@@ -6,6 +6,43 @@ namespace Intersection
 
 const float Gjk::sEpsilon = 0.00001f;
 
+namespace
+{
+PlasmaThreadLocal GjkCache* sActiveGjkCache = nullptr;
+} // namespace
+
+GjkCache::GjkCache()
+{
+  Clear();
+}
+
+void GjkCache::Clear()
+{
+  mSupportVector = Vec3::cZero;
+  mWitnessPoints[0] = Vec3::cZero;
+  mWitnessPoints[1] = Vec3::cZero;
+  mValid = false;
+  mSeparated = false;
+  mUsed = false;
+  mHit = false;
+}
+
+GjkCacheScope::GjkCacheScope(GjkCache* cache)
+{
+  mPrevious = sActiveGjkCache;
+  sActiveGjkCache = cache;
+}
+
+GjkCacheScope::~GjkCacheScope()
+{
+  sActiveGjkCache = mPrevious;
+}
+
+GjkCache* GjkCacheScope::GetActive()
+{
+  return sActiveGjkCache;
+}
+
 Type Gjk::Test(const SupportShape* shapeA, const SupportShape* shapeB, Manifold* manifold, unsigned maxIter)
 {
   // Get initial support vector
@@ -16,16 +53,53 @@ Type Gjk::Test(const SupportShape* shapeA, const SupportShape* shapeB, Manifold*
   if (mSupportVector.Length() < sEpsilon)
     mSupportVector.Set(1, 0, 0);
 
-  unsigned iter_count = 0;
-  while (iter_count < maxIter)
+  return Run(manifold, maxIter);
+}
+
+Type Gjk::Test(
+    const SupportShape* shapeA, const SupportShape* shapeB, GjkCache& cache, Manifold* manifold, unsigned maxIter)
+{
+  Initialize(shapeA, shapeB);
+
+  // Start along the last search direction. Any direction is a valid start,
+  // and if the shapes are still apart along the last separating axis the
+  // first support point rejects them.
+  bool seeded = cache.mValid && cache.mSupportVector.Length() >= sEpsilon;
+  if (seeded)
+    mSupportVector = cache.mSupportVector;
+  else if (mSupportVector.Length() < sEpsilon)
+    mSupportVector.Set(1, 0, 0);
+
+  Type result = Run(manifold, maxIter);
+
+  cache.mUsed = true;
+  cache.mHit = seeded && mSeparated && mIterations == 0;
+  cache.mValid = true;
+  cache.mSeparated = mSeparated;
+  cache.mSupportVector = mSupportVector;
+  cache.mWitnessPoints[0] = mLastSupport.objA;
+  cache.mWitnessPoints[1] = mLastSupport.objB;
+  return result;
+}
+
+Type Gjk::Run(Manifold* manifold, unsigned maxIter)
+{
+  mSeparated = false;
+  mIterations = 0;
+  while (mIterations < maxIter)
   {
     // Find support point on Minkowski Difference
     CSOVertex support = ComputeSupport(mSupportVector);
+    mLastSupport = support;
 
     // Check if point is valid
     float proj = mSupportVector.Dot(support.cso);
     if (proj <= 0.0f)
+    {
+      // The support vector is a separating axis
+      mSeparated = true;
       return Intersection::None;
+    }
 
     // Add point to simplex
     mSimplex.AddPoint(support);
@@ -42,7 +116,7 @@ Type Gjk::Test(const SupportShape* shapeA, const SupportShape* shapeB, Manifold*
 
     // Get new support vector
     mSupportVector = mSimplex.GetSupportVector();
-    ++iter_count;
+    ++mIterations;
   }
 
   return Intersection::None;
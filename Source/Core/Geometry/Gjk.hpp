@@ -5,6 +5,45 @@ namespace Intersection
 {
 class SupportShape;
 
+/// What a Gjk test learned about a pair of shapes. Kept with a pair between
+/// frames so the next test starts from the last answer. Shapes that are still
+/// apart along the last separating axis are rejected by one support query.
+struct GjkCache
+{
+  GjkCache();
+  void Clear();
+
+  /// The last search direction. When mSeparated is set the shapes were
+  /// proven to be apart along it.
+  Vec3 mSupportVector;
+  /// The support points on each shape along mSupportVector.
+  Vec3 mWitnessPoints[2];
+  /// Whether the above is from a previous test.
+  bool mValid;
+  bool mSeparated;
+
+  /// Set by each test: whether it used this cache and whether the cached
+  /// axis alone proved the shapes were apart.
+  bool mUsed;
+  bool mHit;
+};
+
+/// While alive, the Gjk tests run on this thread by SupportShapeCollide use
+/// the given cache. The collision functions only see shapes, so this is how a
+/// cache kept for a pair of objects reaches them.
+class GjkCacheScope
+{
+public:
+  GjkCacheScope(GjkCache* cache);
+  ~GjkCacheScope();
+
+  /// The cache of the innermost scope on this thread (nullptr if none).
+  static GjkCache* GetActive();
+
+private:
+  GjkCache* mPrevious;
+};
+
 class Gjk
 {
 public:
@@ -12,6 +51,13 @@ public:
 
   Type
   Test(const SupportShape* shapeA, const SupportShape* shapeB, Manifold* manifold = nullptr, unsigned maxIter = 20);
+  /// Same as Test, but starts from what the cache learned last time and
+  /// stores this test's results back into it.
+  Type Test(const SupportShape* shapeA,
+            const SupportShape* shapeB,
+            GjkCache& cache,
+            Manifold* manifold = nullptr,
+            unsigned maxIter = 20);
   Type TestDebug(const SupportShape* shapeA,
                  const SupportShape* shapeB,
                  Manifold* manifold = nullptr,
@@ -27,6 +73,8 @@ private:
   void DrawTriangle(Vec3 p0, Vec3 p1, Vec3 p2);
   void DrawCSO(void);
   void Initialize(const SupportShape* shapeA, const SupportShape* shapeB);
+  /// Searches from the current support vector.
+  Type Run(Manifold* manifold, unsigned maxIter);
   CSOVertex ComputeSupport(Vec3 supportVector);
   void ComputeCSO(void);
   bool ComputeContactData(Manifold* manifold, unsigned maxExpands = 20, bool debug = false);
@@ -37,6 +85,12 @@ private:
   Simplex mSimplex;
   Epa mEpa;
 
+  /// The last support point found by Run, how many iterations it took and
+  /// whether it ended by finding a separating axis.
+  CSOVertex mLastSupport;
+  unsigned mIterations;
+  bool mSeparated;
+
   Plasma::Array<Vec3> mCSO;
 };
 
@@ -70,7 +70,7 @@ public:
   typedef idType HandleIdType;                                                                                         \
   HandleIdData<HandleIdType> mPlasmaHandleId;                                                                            \
   static HandleIdType mPlasmaHandleCurrentId;                                                                            \
-  static HashMap<HandleIdType, LightningSelf*> mPlasmaHandleLiveObjects;
+  static FlatHashMap<HandleIdType, LightningSelf*> mPlasmaHandleLiveObjects;
 
 #define DeclareThreadSafeIdHandle(idType) DeclareSafeIdHandle(idType) static ThreadLock mPlasmaHandleLock;
 
@@ -82,7 +82,7 @@ public:
 // Define
 #define DefineSafeIdHandle(type)                                                                                       \
   type::HandleIdType type::mPlasmaHandleCurrentId = 1;                                                                   \
-  HashMap<type::HandleIdType, type*> type::mPlasmaHandleLiveObjects;
+  FlatHashMap<type::HandleIdType, type*> type::mPlasmaHandleLiveObjects;
 
 #define DefineThreadSafeIdHandle(type) DefineSafeIdHandle(type) ThreadLock type::mPlasmaHandleLock;
 
@@ -388,7 +388,7 @@ public:
 template <typename idType, typename Base>
 typename SafeId<idType, Base>::HandleIdType SafeId<idType, Base>::mPlasmaHandleCurrentId = 1;
 template <typename idType, typename Base>
-HashMap<typename SafeId<idType, Base>::HandleIdType, SafeId<idType, Base>*>
+FlatHashMap<typename SafeId<idType, Base>::HandleIdType, SafeId<idType, Base>*>
     SafeId<idType, Base>::mPlasmaHandleLiveObjects;
 
 template <typename idType, typename Base>
@@ -429,7 +429,7 @@ public:
 template <typename idType, typename Base>
 typename ThreadSafeId<idType, Base>::HandleIdType ThreadSafeId<idType, Base>::mPlasmaHandleCurrentId = 1;
 template <typename idType, typename Base>
-HashMap<typename ThreadSafeId<idType, Base>::HandleIdType, ThreadSafeId<idType, Base>*>
+FlatHashMap<typename ThreadSafeId<idType, Base>::HandleIdType, ThreadSafeId<idType, Base>*>
     ThreadSafeId<idType, Base>::mPlasmaHandleLiveObjects;
 template <typename idType, typename Base>
 ThreadLock ThreadSafeId<idType, Base>::mPlasmaHandleLock;
@@ -472,7 +472,7 @@ template <typename idType, typename Base>
 typename ReferenceCountedSafeId<idType, Base>::HandleIdType ReferenceCountedSafeId<idType, Base>::mPlasmaHandleCurrentId =
     1;
 template <typename idType, typename Base>
-HashMap<typename ReferenceCountedSafeId<idType, Base>::HandleIdType, ReferenceCountedSafeId<idType, Base>*>
+FlatHashMap<typename ReferenceCountedSafeId<idType, Base>::HandleIdType, ReferenceCountedSafeId<idType, Base>*>
     ReferenceCountedSafeId<idType, Base>::mPlasmaHandleLiveObjects;
 
 template <typename idType, typename Base>
@@ -513,7 +513,7 @@ template <typename idType, typename Base>
 typename ReferenceCountedThreadSafeId<idType, Base>::HandleIdType
     ReferenceCountedThreadSafeId<idType, Base>::mPlasmaHandleCurrentId = 1;
 template <typename idType, typename Base>
-HashMap<typename ReferenceCountedThreadSafeId<idType, Base>::HandleIdType, ReferenceCountedThreadSafeId<idType, Base>*>
+FlatHashMap<typename ReferenceCountedThreadSafeId<idType, Base>::HandleIdType, ReferenceCountedThreadSafeId<idType, Base>*>
     ReferenceCountedThreadSafeId<idType, Base>::mPlasmaHandleLiveObjects;
 template <typename idType, typename Base>
 ThreadLock ReferenceCountedThreadSafeId<idType, Base>::mPlasmaHandleLock;
@@ -4,6 +4,114 @@
 namespace Plasma
 {
 
+// Thread Safe Handle Slots
+ThreadSafeHandleSlots::ThreadSafeHandleSlots() : mSlotCount(0), mFreeHead(cInvalidSlot)
+{
+  memset((void*)mChunks, 0, sizeof(mChunks));
+}
+
+ThreadSafeHandleSlots::~ThreadSafeHandleSlots()
+{
+  // Objects destroyed after this (during static destruction) will fail to find
+  // their slot instead of touching freed memory
+  mSlotCount = 0;
+  for (u32 i = 0; i < cMaxChunks && mChunks[i] != nullptr; ++i)
+  {
+    delete[] mChunks[i];
+    mChunks[i] = nullptr;
+  }
+}
+
+u64 ThreadSafeHandleSlots::Allocate(void* object)
+{
+  mLock.Lock();
+
+  u32 index = mFreeHead;
+  if (index != cInvalidSlot)
+  {
+    mFreeHead = GetSlot(index).mNextFree;
+  }
+  else
+  {
+    index = mSlotCount.Load();
+    u32 chunkIndex = index >> cChunkShift;
+    ErrorIf(chunkIndex >= cMaxChunks, "Too many live thread safe handles.");
+
+    // The chunk must be fully initialized before the slot count says that
+    // readers may look at it
+    if (mChunks[chunkIndex] == nullptr)
+    {
+      Slot* chunk = new Slot[cChunkSize];
+      for (u32 i = 0; i < cChunkSize; ++i)
+      {
+        chunk[i].mObject = nullptr;
+        chunk[i].mGeneration = 1;
+        chunk[i].mNextFree = cInvalidSlot;
+      }
+      AtomicStore((void* volatile*)&mChunks[chunkIndex], chunk);
+    }
+
+    mSlotCount.Store(index + 1);
+  }
+
+  Slot& slot = GetSlot(index);
+  AtomicStore(&slot.mObject, object);
+  u32 generation = slot.mGeneration.Load();
+
+  mLock.Unlock();
+  return ((u64)generation << 32) | index;
+}
+
+bool ThreadSafeHandleSlots::Free(u64 id)
+{
+  u32 index = (u32)id;
+  u32 generation = (u32)(id >> 32);
+
+  mLock.Lock();
+
+  if (index >= mSlotCount.Load() || GetSlot(index).mGeneration.Load() != generation)
+  {
+    mLock.Unlock();
+    return false;
+  }
+
+  // Clear the object before invalidating the generation so a reader that
+  // already matched the old generation sees null rather than a reused slot
+  Slot& slot = GetSlot(index);
+  AtomicStore(&slot.mObject, nullptr);
+  u32 nextGeneration = generation + 1;
+  // Generation 0 is never handed out so that an id of 0 is always invalid
+  slot.mGeneration.Store(nextGeneration == 0 ? 1 : nextGeneration);
+
+  slot.mNextFree = mFreeHead;
+  mFreeHead = index;
+
+  mLock.Unlock();
+  return true;
+}
+
+void* ThreadSafeHandleSlots::Find(u64 id)
+{
+  u32 index = (u32)id;
+  u32 generation = (u32)(id >> 32);
+  if (index >= mSlotCount.Load())
+    return nullptr;
+
+  // Read the object before checking the generation. If the slot was freed (and
+  // possibly reused) after the read, the generation will no longer match
+  Slot& slot = GetSlot(index);
+  void* object = AtomicLoad(&slot.mObject);
+  if (slot.mGeneration.Load() != generation)
+    return nullptr;
+  return object;
+}
+
+ThreadSafeHandleSlots::Slot& ThreadSafeHandleSlots::GetSlot(u32 index)
+{
+  Slot* chunk = (Slot*)AtomicLoad((void* volatile*)&mChunks[index >> cChunkShift]);
+  return chunk[index & (cChunkSize - 1)];
+}
+
 DefineThreadSafeReferenceCountedHandle(ThreadSafeReferenceCounted);
 
 LightningDefineType(ThreadSafeReferenceCounted, builder, type)
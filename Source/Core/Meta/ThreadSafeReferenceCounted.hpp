@@ -11,6 +11,49 @@ public:
   u64 mId;
 };
 
+/// Generational slot table that maps handle ids to live objects. An id is the
+/// slot index in the low 32 bits and the slot's generation in the high 32 bits.
+/// The generation is incremented every time a slot is freed so ids of destroyed
+/// objects never resolve to whatever object reuses the slot. Slots live in
+/// fixed size chunks that are never moved, so Find is lock-free and can run
+/// while other threads are allocating and freeing slots.
+class ThreadSafeHandleSlots
+{
+public:
+  ThreadSafeHandleSlots();
+  ~ThreadSafeHandleSlots();
+
+  /// Returns the id that resolves to the given object until it is freed.
+  u64 Allocate(void* object);
+  /// Returns false if the id was not live.
+  bool Free(u64 id);
+  /// Returns null if the object for the id has been freed.
+  void* Find(u64 id);
+
+private:
+  static const u32 cChunkShift = 10;
+  static const u32 cChunkSize = 1 << cChunkShift;
+  static const u32 cMaxChunks = 4096;
+  static const u32 cInvalidSlot = (u32)-1;
+
+  struct Slot
+  {
+    void* volatile mObject;
+    Atomic<u32> mGeneration;
+    // Only used while the slot is on the free list
+    u32 mNextFree;
+  };
+
+  Slot& GetSlot(u32 index);
+
+  Slot* volatile mChunks[cMaxChunks];
+  /// How many slots have ever been used (published after the slot's chunk).
+  Atomic<u32> mSlotCount;
+  /// Guards the free list and chunk allocation (never taken by Find).
+  SpinLock mLock;
+  u32 mFreeHead;
+};
+
 // Reference counted handles that will go null if destroyed from C++
 template <typename T>
 class ThreadSafeReferenceCountedHandleManager : public HandleManager
@@ -48,9 +91,7 @@ public:
     if (data.mRawObject)
       return (::byte*)data.mRawObject;
 
-    T::mLock.Lock();
-    T* val = T::mLiveObjects.FindValue(data.mId, nullptr);
-    T::mLock.Unlock();
+    T* val = (T*)T::mLiveObjects.Find(data.mId);
     // METAREFACTOR - This manager is currently expected to be used on the base
     // class define below (ThreadSafeReferenceCounted) when getting the derived
     // object, I do not believe this will thunk correctly if required.
@@ -63,11 +104,7 @@ public:
 
     T* instance = (T*)data.mRawObject;
     if (instance == nullptr)
-    {
-      T::mLock.Lock();
-      instance = T::mLiveObjects.FindValue(data.mId, nullptr);
-      T::mLock.Unlock();
-    }
+      instance = (T*)T::mLiveObjects.Find(data.mId);
 
     ErrorIf(instance == nullptr, "Adding reference on a null handle.");
     instance->AddReference();
@@ -79,11 +116,7 @@ public:
 
     T* instance = (T*)data.mRawObject;
     if (instance == nullptr)
-    {
-      T::mLock.Lock();
-      instance = T::mLiveObjects.FindValue(data.mId, nullptr);
-      T::mLock.Unlock();
-    }
+      instance = (T*)T::mLiveObjects.Find(data.mId);
 
     ErrorIf(instance == nullptr, "Releasing reference on a null handle.");
     instance->Release();
@@ -93,9 +126,7 @@ public:
 
 // Call within the class definition
 #define DeclareThreadSafeReferenceCountedHandleNoData(type)                                                            \
-  static ThreadLock mLock;                                                                                             \
-  static u64 mCurrentId;                                                                                               \
-  static HashMap<u64, type*> mLiveObjects;                                                                             \
+  static ThreadSafeHandleSlots mLiveObjects;                                                                           \
   int GetReferenceCount()                                                                                              \
   {                                                                                                                    \
     return mReferenceCount.mCount;                                                                                     \
@@ -119,10 +150,7 @@ public:
   ReferenceCountData mReferenceCount;
 
 // Call in the cpp file next to the class implementation
-#define DefineThreadSafeReferenceCountedHandle(type)                                                                   \
-  ThreadLock type::mLock;                                                                                              \
-  u64 type::mCurrentId = 1;                                                                                            \
-  HashMap<u64, type*> type::mLiveObjects;
+#define DefineThreadSafeReferenceCountedHandle(type) ThreadSafeHandleSlots type::mLiveObjects;
 
 // Call in the constructor of the object
 #define ConstructThreadSafeReferenceCountedHandle()                                                                    \
@@ -131,17 +159,12 @@ public:
           "Set type->HandleManager = "                                                                                 \
           "LightningManagerId(ThreadSafeReferenceCountedHandleManager<LightningSelf>; in "                                     \
           "binding");                                                                                                  \
-  mLock.Lock();                                                                                                        \
-  mHandleId.mId = mCurrentId++;                                                                                        \
-  mLiveObjects.Insert(mHandleId.mId, this);                                                                            \
-  mLock.Unlock();                                                                                                      \
+  mHandleId.mId = mLiveObjects.Allocate(this);                                                                         \
   mReferenceCount.mCount = 1;
 
 // Call in the destructor of the object
 #define DestructThreadSafeReferenceCountedHandle()                                                                     \
-  mLock.Lock();                                                                                                        \
-  bool isErased = mLiveObjects.Erase(mHandleId.mId);                                                                   \
-  mLock.Unlock();                                                                                                      \
+  bool isErased = mLiveObjects.Free(mHandleId.mId);                                                                    \
   ErrorIf(!isErased, "The handle was not in the live objects map, but should have been");
 
 // Call in the meta definition of the object
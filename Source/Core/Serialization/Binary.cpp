@@ -119,12 +119,14 @@ bool BinaryBufferLoader::StringField(cstr typeName, cstr fieldName, StringRange&
 
 bool BinaryFileLoader::OpenFile(Status& status, cstr filename)
 {
-  return mFile.Open(filename, FileMode::Read, FileAccessPattern::Sequential);
+  mPosition = 0;
+  return mFile.Open(filename, FileAccessPattern::Sequential, &status);
 }
 
 void BinaryFileLoader::Close()
 {
   mFile.Close();
+  mPosition = 0;
 }
 
 bool BinaryFileLoader::TestForObjectEnd(BoundType** data)
@@ -132,18 +134,16 @@ bool BinaryFileLoader::TestForObjectEnd(BoundType** data)
   *data = nullptr;
 
   size_t bytesToRead = sizeof(u32);
-  FilePosition fp = mFile.Tell();
-  if (fp + bytesToRead < mFile.Size())
+  if (mPosition + bytesToRead < mFile.Size())
   {
     u32 end = BinaryEndSignature;
-    Data((::byte*)&end, bytesToRead);
+    memcpy(&end, mFile.Data() + mPosition, bytesToRead);
     if (end == BinaryEndSignature)
     {
-      // End of object
-      // Move back to prevent reading the end tag
-      mFile.Seek(-(int)bytesToRead, SeekOrigin::Current);
+      // End of object, leave the end tag to be read
       return false;
     }
+    mPosition += bytesToRead;
     return true;
   }
   else
@@ -155,22 +155,27 @@ bool BinaryFileLoader::TestForObjectEnd(BoundType** data)
 
 void BinaryFileLoader::Data(::byte* data, uint sizeInBytes)
 {
-  Status status;
-  mFile.Read(status, data, sizeInBytes);
+  const bool fileOverrun = mPosition + sizeInBytes > mFile.Size();
+  ErrorIf(fileOverrun, "Read past the end of the file.");
+
+  if (!fileOverrun)
+  {
+    memcpy(data, mFile.Data() + mPosition, sizeInBytes);
+    mPosition += sizeInBytes;
+  }
 }
 
 bool BinaryFileLoader::StringField(cstr typeName, cstr fieldName, StringRange& stringRange)
 {
-  Status status;
   u32 size = 0;
-  mFile.Read(status, (::byte*)&size, sizeof(size));
+  Data((::byte*)&size, sizeof(size));
 
-  if (size < 512)
-  {
-    mFile.Read(status, (::byte*)mTempSpace, size);
-    stringRange = StringRange(mTempSpace, mTempSpace, mTempSpace + size);
-  }
+  if (mPosition + size > mFile.Size())
+    return false;
 
+  cstr start = (cstr)mFile.Data() + mPosition;
+  mPosition += size;
+  stringRange = StringRange(start, start + size);
   return true;
 }
 
@@ -227,8 +227,9 @@ public:
   bool TestForObjectEnd(BoundType** runtimeType);
 
 private:
-  char mTempSpace[512];
-  File mFile;
+  // The file is read in place from the mapping, strings point directly into it
+  MappedFile mFile;
+  size_t mPosition;
 };
 
 class BinaryFileSaver : public BinarySaver<BinaryFileSaver>
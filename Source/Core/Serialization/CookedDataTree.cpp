@@ -0,0 +1,313 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+uint GetFileVersion(StringRange fileData);
+
+// Cooked Data Writer
+/// Flattens a data tree into the cooked layout.
+class CookedDataWriter
+{
+public:
+  CookedDataWriter()
+  {
+    // Reserve the empty string so that default strings never need a lookup
+    Intern(String());
+  }
+
+  u32 Intern(StringParam string)
+  {
+    if (u32* index = mStringIndices.FindPointer(string))
+      return *index;
+
+    u32 index = mStrings.Size();
+    mStrings.PushBack(string);
+    mStringIndices.Insert(string, index);
+    return index;
+  }
+
+  void AddNode(DataNode* node)
+  {
+    CookedDataNode& cooked = mNodes.PushBack();
+    cooked.mNodeType = (u8)node->mNodeType;
+    cooked.mPatchState = (u8)node->mPatchState;
+    cooked.mFlags = (u16)node->mFlags.U32Field;
+    cooked.mChildCount = node->mNumberOfChildren;
+    cooked.mPropertyName = Intern(node->mPropertyName);
+    cooked.mTypeName = Intern(node->mTypeName);
+    cooked.mTextValue = Intern(node->mTextValue);
+    cooked.mInheritedFromId = Intern(node->mInheritedFromId);
+    cooked.mAttributeCount = node->mAttributes.Size();
+    cooked.mReserved = 0;
+    cooked.mUniqueNodeId = node->mUniqueNodeId.mValue;
+
+    forRange (DataAttribute& attribute, node->mAttributes.All())
+    {
+      CookedDataAttribute& cookedAttribute = mAttributes.PushBack();
+      cookedAttribute.mName = Intern(attribute.mName);
+      cookedAttribute.mValue = Intern(attribute.mValue);
+    }
+
+    forRange (DataNode& child, node->GetChildren())
+      AddNode(&child);
+  }
+
+  template <typename T>
+  static void Append(Array<::byte>& output, const T* data, size_t count)
+  {
+    const ::byte* bytes = (const ::byte*)data;
+    output.Insert(output.End(), bytes, bytes + sizeof(T) * count);
+  }
+
+  void Write(uint dataVersion, bool patchRequired, uint rootCount, Array<::byte>& output)
+  {
+    Array<u32> stringOffsets;
+    stringOffsets.Reserve(mStrings.Size() + 1);
+    u32 stringBytes = 0;
+    forRange (String& string, mStrings.All())
+    {
+      stringOffsets.PushBack(stringBytes);
+      stringBytes += string.SizeInBytes();
+    }
+    stringOffsets.PushBack(stringBytes);
+
+    CookedDataHeader header;
+    header.mMagic = CookedData::cMagic;
+    header.mFormatVersion = CookedData::cFormatVersion;
+    header.mDataVersion = dataVersion;
+    header.mFlags = patchRequired ? CookedData::Flags::PatchRequired : 0;
+    header.mRootCount = rootCount;
+    header.mNodeCount = mNodes.Size();
+    header.mAttributeCount = mAttributes.Size();
+    header.mStringCount = mStrings.Size();
+    header.mStringBytes = stringBytes;
+    header.mReserved = 0;
+
+    output.Clear();
+    output.Reserve(sizeof(header) + mNodes.Size() * sizeof(CookedDataNode) +
+                   mAttributes.Size() * sizeof(CookedDataAttribute) + stringOffsets.Size() * sizeof(u32) +
+                   stringBytes);
+    Append(output, &header, 1);
+    Append(output, mNodes.Data(), mNodes.Size());
+    Append(output, mAttributes.Data(), mAttributes.Size());
+    Append(output, stringOffsets.Data(), stringOffsets.Size());
+    forRange (String& string, mStrings.All())
+      Append(output, string.Data(), string.SizeInBytes());
+  }
+
+  Array<String> mStrings;
+  HashMap<String, u32> mStringIndices;
+  Array<CookedDataNode> mNodes;
+  Array<CookedDataAttribute> mAttributes;
+};
+
+bool IsCookedDataSet(StringRange data)
+{
+  if (data.SizeInBytes() < sizeof(CookedDataHeader))
+    return false;
+
+  u32 magic;
+  memcpy(&magic, data.Data(), sizeof(magic));
+  return magic == CookedData::cMagic;
+}
+
+bool IsCookedDataFileCurrent(StringParam fileName)
+{
+  File file;
+  if (!file.Open(fileName, FileMode::Read, FileAccessPattern::Sequential))
+    return false;
+
+  Status status;
+  CookedDataHeader header;
+  size_t bytesRead = file.Read(status, (::byte*)&header, sizeof(header));
+  file.Close();
+
+  if (status.Failed() || bytesRead != sizeof(header))
+    return false;
+
+  return header.mMagic == CookedData::cMagic && header.mFormatVersion == CookedData::cFormatVersion;
+}
+
+void CookDataSet(DataNode* fileRoot, uint dataVersion, bool patchRequired, Array<::byte>& output)
+{
+  ZoneScoped;
+
+  CookedDataWriter writer;
+  forRange (DataNode& root, fileRoot->GetChildren())
+    writer.AddNode(&root);
+
+  writer.Write(dataVersion, patchRequired, fileRoot->mNumberOfChildren, output);
+}
+
+bool CookDataFile(Status& status, StringParam sourceFile, StringParam destFile)
+{
+  ZoneScoped;
+  ProfileScopeFunctionArgs(sourceFile);
+
+  MappedFile file;
+  if (!file.Open(sourceFile, FileAccessPattern::Sequential) || file.Size() == 0)
+  {
+    status.SetFailed(String::Format("Can not open '%s'", sourceFile.c_str()), FileSystemErrors::FileNotAccessible);
+    return false;
+  }
+
+  // Cook the tree exactly as it was parsed. Inheritance is resolved when the
+  // cooked file is loaded so that changes to the inherited data are still seen
+  DataTreeContext context;
+  context.Filename = sourceFile;
+
+  StringRange data = file.ToStringRange();
+  DataNode fileRoot(DataNodeType::Object, nullptr);
+  uint dataVersion = GetFileVersion(data);
+  if (dataVersion == DataVersion::Legacy)
+  {
+    if (DataNode* root = LegacyDataTreeParser::BuildTree(context, data))
+      root->AttachTo(&fileRoot);
+  }
+  else
+  {
+    DataTreeParser::BuildTree(context, data, &fileRoot);
+  }
+
+  if (context.Error || fileRoot.mChildren.Empty())
+  {
+    String message = context.Error ? context.Message : String("Failed to parse root element.");
+    status.SetFailed(String::Format("Failed to cook '%s': %s", sourceFile.c_str(), message.c_str()),
+                     ParseErrorCodes::ParsingError);
+    return false;
+  }
+
+  Array<::byte> cooked;
+  CookDataSet(&fileRoot, dataVersion, context.PatchRequired, cooked);
+
+  if (WriteToFile(destFile.c_str(), cooked.Data(), cooked.Size()) != cooked.Size())
+  {
+    status.SetFailed(String::Format("Failed to write cooked file '%s'", destFile.c_str()),
+                     FileSystemErrors::FileNotAccessible);
+    return false;
+  }
+
+  return true;
+}
+
+bool ReadCookedDataSet(Status& status, StringRange data, DataTreeContext& context, uint* fileVersion, DataNode* fileRoot)
+{
+  ZoneScoped;
+  ProfileScopeFunctionArgs(context.Filename);
+
+  const ::byte* begin = (const ::byte*)data.Data();
+  size_t size = data.SizeInBytes();
+
+  CookedDataHeader header;
+  memcpy(&header, begin, sizeof(header));
+
+  if (header.mFormatVersion != CookedData::cFormatVersion)
+  {
+    status.SetFailed(String::Format("Cooked data file '%s' was built with format version %u (expected %u)",
+                                    context.Filename.c_str(),
+                                    header.mFormatVersion,
+                                    CookedData::cFormatVersion),
+                     ParseErrorCodes::FileError);
+    return false;
+  }
+
+  // Validate the sections before touching any of them
+  size_t nodesOffset = sizeof(CookedDataHeader);
+  size_t attributesOffset = nodesOffset + (size_t)header.mNodeCount * sizeof(CookedDataNode);
+  size_t offsetsOffset = attributesOffset + (size_t)header.mAttributeCount * sizeof(CookedDataAttribute);
+  size_t stringsOffset = offsetsOffset + ((size_t)header.mStringCount + 1) * sizeof(u32);
+  if (header.mStringCount == 0 || stringsOffset + header.mStringBytes > size)
+  {
+    status.SetFailed(String::Format("Cooked data file '%s' is truncated", context.Filename.c_str()),
+                     ParseErrorCodes::FileError);
+    return false;
+  }
+
+  const CookedDataNode* nodes = (const CookedDataNode*)(begin + nodesOffset);
+  const CookedDataAttribute* attributes = (const CookedDataAttribute*)(begin + attributesOffset);
+  const u32* stringOffsets = (const u32*)(begin + offsetsOffset);
+  cstr stringBytes = (cstr)(begin + stringsOffset);
+
+  // Every unique string is only allocated once and shared by all nodes
+  Array<String> strings;
+  strings.Resize(header.mStringCount);
+  for (uint i = 0; i < header.mStringCount; ++i)
+  {
+    u32 start = stringOffsets[i];
+    u32 end = stringOffsets[i + 1];
+    if (start > end || end > header.mStringBytes)
+    {
+      status.SetFailed(String::Format("Cooked data file '%s' has an invalid string table", context.Filename.c_str()),
+                       ParseErrorCodes::FileError);
+      return false;
+    }
+
+    if (end != start)
+      strings[i] = String(stringBytes + start, end - start);
+  }
+
+  // Rebuild the tree using a stack of parents and the number of children each
+  // still expects
+  typedef Pair<DataNode*, u32> OpenNode;
+  Array<OpenNode> stack;
+  stack.PushBack(OpenNode(fileRoot, header.mRootCount));
+
+  uint attributeIndex = 0;
+  for (uint i = 0; i < header.mNodeCount; ++i)
+  {
+    while (!stack.Empty() && stack.Back().second == 0)
+      stack.PopBack();
+
+    const CookedDataNode& cooked = nodes[i];
+    bool validStrings = cooked.mPropertyName < header.mStringCount && cooked.mTypeName < header.mStringCount &&
+                        cooked.mTextValue < header.mStringCount && cooked.mInheritedFromId < header.mStringCount;
+    if (stack.Empty() || !validStrings || attributeIndex + cooked.mAttributeCount > header.mAttributeCount)
+    {
+      status.SetFailed(String::Format("Cooked data file '%s' is corrupt", context.Filename.c_str()),
+                       ParseErrorCodes::StructureError);
+      return false;
+    }
+
+    OpenNode& parent = stack.Back();
+    --parent.second;
+
+    DataNode* node = new DataNode((DataNodeType::Enum)cooked.mNodeType, parent.first);
+    node->mPatchState = (PatchState::Enum)cooked.mPatchState;
+    node->mFlags.U32Field = cooked.mFlags;
+    node->mPropertyName = strings[cooked.mPropertyName];
+    node->mTypeName = strings[cooked.mTypeName];
+    node->mTextValue = strings[cooked.mTextValue];
+    node->mInheritedFromId = strings[cooked.mInheritedFromId];
+    node->mUniqueNodeId = cooked.mUniqueNodeId;
+
+    if (cooked.mAttributeCount != 0)
+    {
+      node->mAttributes.Reserve(cooked.mAttributeCount);
+      for (uint a = 0; a < cooked.mAttributeCount; ++a, ++attributeIndex)
+      {
+        const CookedDataAttribute& attribute = attributes[attributeIndex];
+        if (attribute.mName >= header.mStringCount || attribute.mValue >= header.mStringCount)
+        {
+          status.SetFailed(String::Format("Cooked data file '%s' is corrupt", context.Filename.c_str()),
+                           ParseErrorCodes::StructureError);
+          return false;
+        }
+
+        DataAttribute& nodeAttribute = node->mAttributes.PushBack();
+        nodeAttribute.mName = strings[attribute.mName];
+        nodeAttribute.mValue = strings[attribute.mValue];
+      }
+    }
+
+    if (cooked.mChildCount != 0)
+      stack.PushBack(OpenNode(node, cooked.mChildCount));
+  }
+
+  *fileVersion = header.mDataVersion;
+  context.PatchRequired = (header.mFlags & CookedData::Flags::PatchRequired) != 0;
+  return true;
+}
+
+} // namespace Plasma
@@ -0,0 +1,95 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+class DataNode;
+class DataTreeLoader;
+struct DataTreeContext;
+
+// Cooked Data Tree
+/// The cooked data format is a binary image of a parsed (but not yet patched)
+/// data file. Every unique string (type names, property names, values,
+/// attributes) is stored once in an interned table and nodes reference them by
+/// index, so loading a cooked file skips the tokenizer and parser entirely and
+/// only allocates one String per unique string instead of three per node.
+///
+/// Layout (all values little endian):
+///   CookedDataHeader
+///   CookedDataNode[mNodeCount]          (pre-order, children follow parents)
+///   CookedDataAttribute[mAttributeCount] (in node order)
+///   u32[mStringCount + 1]                (offsets into the string bytes)
+///   char[mStringBytes]
+namespace CookedData
+{
+/// 'PLCD' when read as bytes.
+const u32 cMagic = 0x44434C50;
+/// Must be incremented any time the layout changes. Out of date cooked files
+/// fail to load and are rebuilt by the content system.
+const u32 cFormatVersion = 1;
+/// Index of the empty string in the string table.
+const u32 cEmptyString = 0;
+
+DeclareBitField1(Flags,
+                 // The file contains inheritance and must be patched after
+                 // being loaded.
+                 PatchRequired);
+} // namespace CookedData
+
+struct CookedDataHeader
+{
+  u32 mMagic;
+  u32 mFormatVersion;
+  /// The DataVersion of the text file that was cooked.
+  u32 mDataVersion;
+  u32 mFlags;
+  u32 mRootCount;
+  u32 mNodeCount;
+  u32 mAttributeCount;
+  u32 mStringCount;
+  u32 mStringBytes;
+  u32 mReserved;
+};
+
+struct CookedDataNode
+{
+  u8 mNodeType;
+  u8 mPatchState;
+  u16 mFlags;
+  u32 mChildCount;
+  u32 mPropertyName;
+  u32 mTypeName;
+  u32 mTextValue;
+  u32 mInheritedFromId;
+  u32 mAttributeCount;
+  u32 mReserved;
+  u64 mUniqueNodeId;
+};
+
+struct CookedDataAttribute
+{
+  u32 mName;
+  u32 mValue;
+};
+
+/// Returns whether or not the given file contents are in the cooked format.
+bool IsCookedDataSet(StringRange data);
+
+/// Returns whether or not the given file exists and was cooked with the current
+/// format version.
+bool IsCookedDataFileCurrent(StringParam fileName);
+
+/// Writes all children of the file root into the cooked format.
+void CookDataSet(DataNode* fileRoot, uint dataVersion, bool patchRequired, Array<::byte>& output);
+
+/// Parses the given text data file (without resolving inheritance) and writes
+/// it out in the cooked format.
+bool CookDataFile(Status& status, StringParam sourceFile, StringParam destFile);
+
+/// Builds the data tree from a cooked file under the given file root. The
+/// context's PatchRequired is set if the tree needs to be patched.
+bool ReadCookedDataSet(
+    Status& status, StringRange data, DataTreeContext& context, uint* fileVersion, DataNode* fileRoot);
+
+} // namespace Plasma
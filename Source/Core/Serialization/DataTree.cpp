@@ -54,17 +54,18 @@ bool DataTreeLoader::OpenFile(Status& status, StringParam fileName)
     return false;
   }
 
-  // Attempt to open the file
-  String fileRange = ReadFileIntoString(fileName);
+  // Attempt to open the file. The tree is parsed straight out of the mapping,
+  // every value it keeps is copied into its own string
+  MappedFile file;
 
   // Notify if we couldn't open the file
-  if (fileRange.Empty())
+  if (!file.Open(fileName, FileAccessPattern::Sequential) || file.Size() == 0)
   {
     status.SetFailed(String::Format("Can not open '%s'", fileName.c_str()), FileSystemErrors::FileNotAccessible);
     return false;
   }
 
-  return OpenBuffer(status, fileRange, fileName);
+  return OpenBuffer(status, file.ToStringRange(), fileName);
 }
 
 bool DataTreeLoader::OpenBuffer(Status& status, StringRange data, StringRange source)
@@ -877,23 +877,32 @@ bool ReadDataSet(
   parseContext.Filename = source;
   parseContext.Loader = loader;
 
-  // Load the data tree with the correct parser
-  *fileVersion = GetFileVersion(data);
-
-  if (*fileVersion == DataVersion::Legacy)
+  // Cooked files already contain the parsed tree
+  if (IsCookedDataSet(data))
   {
-    // Legacy format only supported a single root
-    DataNode* root = LegacyDataTreeParser::BuildTree(parseContext, data);
-    if (root == nullptr)
-    {
-      status.SetFailed("Failed to parse legacy file format");
+    if (!ReadCookedDataSet(status, data, parseContext, fileVersion, fileRoot))
       return false;
-    }
-    root->AttachTo(fileRoot);
   }
   else
   {
-    DataTreeParser::BuildTree(parseContext, data, fileRoot);
+    // Load the data tree with the correct parser
+    *fileVersion = GetFileVersion(data);
+
+    if (*fileVersion == DataVersion::Legacy)
+    {
+      // Legacy format only supported a single root
+      DataNode* root = LegacyDataTreeParser::BuildTree(parseContext, data);
+      if (root == nullptr)
+      {
+        status.SetFailed("Failed to parse legacy file format");
+        return false;
+      }
+      root->AttachTo(fileRoot);
+    }
+    else
+    {
+      DataTreeParser::BuildTree(parseContext, data, fileRoot);
+    }
   }
 
   // Failed to read file
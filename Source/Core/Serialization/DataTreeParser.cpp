@@ -11,7 +11,11 @@ bool DataTreeParser::BuildTree(DataTreeContext& context, StringRange data, DataN
   return parser.Parse(data, fileRoot);
 }
 
-DataTreeParser::DataTreeParser(DataTreeContext& context) : mLastPoppedNode(nullptr), mCurrentIndex(0), mContext(context)
+DataTreeParser::DataTreeParser(DataTreeContext& context) :
+    mLastPoppedNode(nullptr),
+    mTokenizer(nullptr),
+    mHasCurrentToken(false),
+    mContext(context)
 {
 }
 
@@ -19,24 +23,22 @@ bool DataTreeParser::Parse(StringRange text, DataNode* fileRoot)
 {
   mNodeStack.PushBack(fileRoot);
 
-  // Read all tokens into an array
+  // Tokens are read as they're accepted
   DataTreeTokenizer tokenizer(text);
-  Status status;
-  DataToken token;
-  while (tokenizer.ReadToken(token, status))
-    mTokens.PushBack(token);
+  mTokenizer = &tokenizer;
+  ReadNextToken();
 
   // Return if it failed
-  if (status.Failed())
+  if (mTokenizerStatus.Failed())
   {
-    mContext.Error = true;
-    mContext.Message = status.Message;
+    mTokenizer = nullptr;
     return false;
   }
 
   Start();
 
-  return true;
+  mTokenizer = nullptr;
+  return !mTokenizerStatus.Failed();
 }
 
 bool DataTreeParser::Start()
@@ -76,7 +78,7 @@ bool DataTreeParser::Object()
   DataNode* node = CreateNewNode(DataNodeType::Object);
 
   // Set the typename of the node
-  node->mTypeName = GetLastAcceptedToken().mText;
+  node->mTypeName = Intern(GetLastAcceptedToken().mText);
 
   // Any amount of attributes can follow the type name
   while (Attribute())
@@ -191,7 +193,7 @@ bool DataTreeParser::Property()
 
   Expect(DataTokenType::Identifier, "Incomplete property. An identifier must come after 'var' ");
 
-  String propertyName = GetLastAcceptedToken().mText;
+  String propertyName = Intern(GetLastAcceptedToken().mText);
 
   Expect(DataTokenType::Assignment, "A property must be assigned a value with '='");
 
@@ -222,16 +224,12 @@ bool DataTreeParser::Value(bool createNode)
 
 bool DataTreeParser::Accept(DataTokenType::Enum token)
 {
-  if (mCurrentIndex >= mTokens.Size())
+  if (!mHasCurrentToken || mCurrentToken.mType != token)
     return false;
 
-  if (mTokens[mCurrentIndex].mType == token)
-  {
-    ++mCurrentIndex;
-    return true;
-  }
-
-  return false;
+  mLastAcceptedToken = mCurrentToken;
+  ReadNextToken();
+  return true;
 }
 
 bool DataTreeParser::Expect(bool succeeded, cstr errorMessage)
@@ -240,7 +238,10 @@ bool DataTreeParser::Expect(bool succeeded, cstr errorMessage)
     return true;
 
   mContext.Error = true;
-  Error(BuildString("Parsing error: ", errorMessage).c_str());
+
+  // The tokenizer error was already stored on the context
+  if (mTokenizerStatus.Succeeded())
+    Error(BuildString("Parsing error: ", errorMessage).c_str());
   return false;
 }
 
@@ -260,35 +261,46 @@ bool DataTreeParser::AcceptValue(bool createNode, DataTokenType::Enum tokenType)
   DataNode* node = CreateNewNode(DataNodeType::Value);
   DataToken& token = GetLastAcceptedToken();
 
-  node->mTextValue = token.mText;
-
   // Integer
   if (token.mType == DataTokenType::Integer)
   {
     node->mTypeName = Serialization::Trait<int>::TypeName();
+    node->mTextValue = Intern(token.mText);
   }
   // Hex
   else if (token.mType == DataTokenType::Hex)
   {
     node->mTypeName = Serialization::Trait<u64>::TypeName();
+    node->mTextValue = Intern(token.mText);
   }
   // Float
   else if (token.mType == DataTokenType::Float)
   {
     node->mTypeName = Serialization::Trait<float>::TypeName();
+    node->mTextValue = Intern(token.mText);
   }
   // Boolean
   else if (token.mType == DataTokenType::True || token.mType == DataTokenType::False)
   {
     node->mTypeName = Serialization::Trait<bool>::TypeName();
+    node->mTextValue = Intern(token.mText);
   }
   else if (token.mType == DataTokenType::StringLiteral)
   {
     node->mTypeName = LightningTypeId(String)->Name;
 
-    StringBuilder builder;
     StringRange text = token.mText;
 
+    // Most strings have nothing escaped and can be used as is
+    if (text.FindFirstOf('\\').Empty())
+    {
+      node->mTextValue = Intern(text);
+      PopNode();
+      return true;
+    }
+
+    StringBuilder builder;
+
     // Remove all escaped slashes and quotes that were added when saved
     while (!text.Empty())
     {
@@ -326,9 +338,9 @@ bool DataTreeParser::AcceptValue(bool createNode, DataTokenType::Enum tokenType)
     // The enum comes in as 'Type.Value' (ie. 'LightType.PointLight'), so we
     // need to separate the type name from the value
     StringTokenRange r(token.mText, '.');
-    node->mTypeName = r.Front();
+    node->mTypeName = Intern(r.Front());
     r.PopFront();
-    node->mTextValue = r.Front();
+    node->mTextValue = Intern(r.Front());
     node->mFlags.SetFlag(DataNodeFlags::Enumeration);
   }
 
@@ -363,7 +375,29 @@ DataNode* DataTreeParser::GetCurrentNode()
 
 DataToken& DataTreeParser::GetLastAcceptedToken()
 {
-  return mTokens[mCurrentIndex - 1];
+  return mLastAcceptedToken;
+}
+
+void DataTreeParser::ReadNextToken()
+{
+  mHasCurrentToken = mTokenizer->ReadToken(mCurrentToken, mTokenizerStatus);
+
+  if (mTokenizerStatus.Failed())
+  {
+    mHasCurrentToken = false;
+    mContext.Error = true;
+    mContext.Message = mTokenizerStatus.Message;
+  }
+}
+
+String DataTreeParser::Intern(StringRangeParam text)
+{
+  if (String* string = mStrings.FindPointer(text))
+    return *string;
+
+  String string = text;
+  mStrings.Insert(text, string);
+  return string;
 }
 
 } // namespace Plasma
@@ -5,9 +5,14 @@ namespace Plasma
 {
 
 class DataNode;
+class DataTreeTokenizer;
 struct DataTreeContext;
 
 // Data Tree Parser
+/// Builds a data tree while tokenizing. Tokens are slices of the given text
+/// (nothing is copied up front) and only the current and last accepted tokens
+/// are kept. Repeated type names, property names, and values share the same
+/// String so most nodes don't touch the global string pool.
 class DataTreeParser
 {
 public:
@@ -28,6 +33,8 @@ private:
   bool Expect(bool succeeded, cstr errorMessage);
   bool Expect(DataTokenType::Enum token, cstr errorMessage);
   bool AcceptValue(bool createNode, DataTokenType::Enum tokenType);
+  void ReadNextToken();
+  String Intern(StringRangeParam text);
 
   DataNode* CreateNewNode(DataNodeType::Enum nodeType);
   void PopNode();
@@ -37,8 +44,14 @@ private:
   DataNode* mLastPoppedNode;
   Array<DataNode*> mNodeStack;
 
-  uint mCurrentIndex;
-  Array<DataToken> mTokens;
+  DataTreeTokenizer* mTokenizer;
+  Status mTokenizerStatus;
+  bool mHasCurrentToken;
+  DataToken mCurrentToken;
+  DataToken mLastAcceptedToken;
+
+  /// Strings created for each unique piece of text in this file.
+  HashMap<StringRange, String> mStrings;
   DataTreeContext& mContext;
 };
 
@@ -49,10 +49,8 @@ inline DataTokenType::Enum GetTokenFromState(TokenState::Enum currentState)
 }
 
 // Data Tree Tokenizer
-DataTreeTokenizer::DataTreeTokenizer(StringParam text) : mLineNumber(0)
+DataTreeTokenizer::DataTreeTokenizer(StringRange text) : mLineNumber(0), mText(text), mRange(text)
 {
-  mText = text;
-  mRange = mText.All();
 }
 
 bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
@@ -61,7 +59,7 @@ bool DataTreeTokenizer::ReadToken(DataToken& token, Status& status)
 
   // Reset token data
   token.mType = DataTokenType::None;
-  token.mText = String();
+  token.mText = StringRange();
   token.mLineNumber = mLineNumber;
 
   // Store where we started so we can get the full text of the token
@@ -38,14 +38,15 @@ struct DataToken
 class DataTreeTokenizer
 {
 public:
-  DataTreeTokenizer(StringParam text);
+  /// The text is not copied, so it must outlive the tokenizer and the tokens.
+  DataTreeTokenizer(StringRange text);
 
   bool ReadToken(DataToken& token, Status& status);
 
 private:
   void EatWhitespace();
   uint mLineNumber;
-  String mText;
+  StringRange mText;
   StringRange mRange;
 };
 
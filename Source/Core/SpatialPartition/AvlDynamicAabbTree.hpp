@@ -66,6 +66,9 @@ struct AvlDynamicTreePolicy : public BaseDynamicTreePolicy<AvlDynamicTreeNode<Cl
   static NodeType* Balance(NodeType*& root, NodeType* node);
   static NodeType* RotateUp(NodeType*& root, NodeType* oldParent, uint childIndex);
   static void FixAabbAndHeight(NodeType* node);
+  /// Avl trees keep themselves balanced by height, so moved nodes are only
+  /// refit and never rotated by surface area.
+  static void RotateNode(NodeType* node);
 };
 
 /// A Hierarchical AabbTree that is meant for dynamic objects. Used to have a
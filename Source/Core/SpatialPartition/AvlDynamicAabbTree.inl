@@ -206,6 +206,11 @@ void AvlDynamicTreePolicy<ClientDataType>::FixAabbAndHeight(NodeType* node)
   node->mAabb.Combine(child2->mAabb);
 }
 
+template <typename ClientDataType>
+void AvlDynamicTreePolicy<ClientDataType>::RotateNode(NodeType* node)
+{
+}
+
 template <typename ClientDataType>
 AvlDynamicAabbTree<ClientDataType>::AvlDynamicAabbTree()
 {
@@ -20,6 +20,18 @@ struct BaseDynamicTreePolicy
   /// Deletes just one node in the tree. Does nothing but unlinks the children
   /// from the node. The children must still have their parent pointers fixed.
   static void DeleteNode(NodeType* node);
+  /// Recomputes an internal node's aabb from its children.
+  static void RefitNode(NodeType* node);
+  /// Swaps one of the node's children with one of its grandchildren if that
+  /// shrinks the surface area of the child that changes (a local SAH rotation).
+  /// The node's own aabb stays the same.
+  static void RotateNode(NodeType* node);
+
+private:
+  /// Finds whether swapping child with one of sibling's children is cheaper
+  /// than the best rotation so far.
+  static void TestRotation(
+      NodeType* child, NodeType* sibling, real& bestCost, NodeType*& bestChild, NodeType*& bestGrandChild);
 };
 
 /// A Hierarchical AabbTree that is meant for dynamic objects. Used to have a
@@ -38,6 +50,8 @@ public:
   typedef typename PolicyType::ClientDataTypeDef ClientDataType;
   typedef BaseDynamicAabbTree<PolicyType> BaseTreeType;
   typedef BaseBroadPhaseData<ClientDataType> DataType;
+  typedef BaseBroadPhaseObject<ClientDataType> ObjectType;
+  typedef Array<ObjectType> ObjectArray;
 
   typedef typename PolicyType::NodeType NodeType;
   typedef Pair<NodeType*, NodeType*> NodePair;
@@ -87,6 +101,11 @@ public:
   void CreateProxy(BroadPhaseProxy& proxy, DataType& data);
   void RemoveProxy(BroadPhaseProxy& proxy);
   void UpdateProxy(BroadPhaseProxy& proxy, DataType& data);
+  /// Batch version of UpdateProxy. Leaves that left their fat aabb are
+  /// refit in place from the bottom up (rotating nodes on the way to keep the
+  /// tree from degrading) instead of being removed and reinserted one by one.
+  /// Leaves that jumped away from where they were are still reinserted.
+  void UpdateProxies(ObjectArray& objects);
 
   /// Returns the client data of a proxy.
   ClientDataType& GetClientData(BroadPhaseProxy& proxy);
@@ -153,9 +172,15 @@ public:
 protected:
   /// Updates the given leaf with the passed in aabb.
   void Update(NodeType* leafNode, Aabb& aabb);
+  /// Returns the aabb a leaf stores for the given object's aabb. The extra
+  /// room lets objects move a little without changing the tree.
+  static Aabb GetFattenedAabb(const Aabb& aabb);
 
   NodeType* mRoot;
   uint mProxyCount;
+
+  /// Leaves moved by UpdateProxies that still have to be refit.
+  NodeArray mRefitLeaves;
 };
 
 } // namespace Plasma
@@ -68,6 +68,73 @@ void BaseDynamicTreePolicy<NodeType>::DeleteNode(NodeType* node)
   delete node;
 }
 
+template <typename NodeType>
+void BaseDynamicTreePolicy<NodeType>::RefitNode(NodeType* node)
+{
+  node->mAabb = node->mChild1->mAabb.Combined(node->mChild2->mAabb);
+}
+
+template <typename NodeType>
+void BaseDynamicTreePolicy<NodeType>::RotateNode(NodeType* node)
+{
+  if (node->IsLeaf())
+    return;
+
+  real bestCost = real(0.0);
+  NodeType* bestChild = nullptr;
+  NodeType* bestGrandChild = nullptr;
+  TestRotation(node->mChild1, node->mChild2, bestCost, bestChild, bestGrandChild);
+  TestRotation(node->mChild2, node->mChild1, bestCost, bestChild, bestGrandChild);
+
+  // no rotation makes the tree any better
+  if (bestChild == nullptr)
+    return;
+
+  // put the grandchild where the child was and the child where the
+  // grandchild was, then fix the aabb of the sibling that changed
+  NodeType* sibling = bestGrandChild->mParent;
+  if (node->mChild1 == bestChild)
+    node->mChild1 = bestGrandChild;
+  else
+    node->mChild2 = bestGrandChild;
+  bestGrandChild->mParent = node;
+
+  if (sibling->mChild1 == bestGrandChild)
+    sibling->mChild1 = bestChild;
+  else
+    sibling->mChild2 = bestChild;
+  bestChild->mParent = sibling;
+
+  RefitNode(sibling);
+}
+
+template <typename NodeType>
+void BaseDynamicTreePolicy<NodeType>::TestRotation(
+    NodeType* child, NodeType* sibling, real& bestCost, NodeType*& bestChild, NodeType*& bestGrandChild)
+{
+  if (sibling->IsLeaf())
+    return;
+
+  // swapping child with one grandchild leaves the sibling holding child and
+  // the other grandchild, so only the sibling's surface area changes
+  real currentArea = sibling->mAabb.GetSurfaceArea();
+  real cost1 = child->mAabb.Combined(sibling->mChild2->mAabb).GetSurfaceArea() - currentArea;
+  real cost2 = child->mAabb.Combined(sibling->mChild1->mAabb).GetSurfaceArea() - currentArea;
+
+  if (cost1 < bestCost)
+  {
+    bestCost = cost1;
+    bestChild = child;
+    bestGrandChild = sibling->mChild1;
+  }
+  if (cost2 < bestCost)
+  {
+    bestCost = cost2;
+    bestChild = child;
+    bestGrandChild = sibling->mChild2;
+  }
+}
+
 template <typename PolicyType>
 BaseDynamicAabbTree<PolicyType>::BaseDynamicAabbTree()
 {
@@ -95,11 +162,7 @@ void BaseDynamicAabbTree<PolicyType>::CreateProxy(BroadPhaseProxy& proxy, DataTy
 
   NodeType* node = new NodeType();
   node->mClientData = data.mClientData;
-  node->mAabb = aabb;
-  Vec3 halfExtents = aabb.GetHalfExtents();
-  halfExtents = Math::Min(halfExtents + BaseDynamicTreeInternal::cAabbFatFactor,
-                          halfExtents * BaseDynamicTreeInternal::cAabbFatScaleFactor);
-  node->mAabb.SetCenterAndHalfExtents(aabb.GetCenter(), halfExtents);
+  node->mAabb = GetFattenedAabb(aabb);
 
   PolicyType::InsertNode(mRoot, node, mRoot);
   proxy = BroadPhaseProxy(node);
@@ -134,6 +197,66 @@ void BaseDynamicAabbTree<PolicyType>::UpdateProxy(BroadPhaseProxy& proxy, DataTy
   Update(node, aabb);
 }
 
+template <typename PolicyType>
+void BaseDynamicAabbTree<PolicyType>::UpdateProxies(ObjectArray& objects)
+{
+  mRefitLeaves.Clear();
+
+  for (uint i = 0; i < objects.Size(); ++i)
+  {
+    ObjectType& object = objects[i];
+    Aabb aabb = object.mData.mAabb;
+    if (!aabb.Valid())
+    {
+      Error("Invalid Aabb inserted");
+
+      // We got the assert (good) but we don't want to keep getting it every
+      // frame
+      aabb.AttemptToCorrectInvalid();
+    }
+
+    NodeType* node = static_cast<NodeType*>(object.mProxy->ToVoidPointer());
+    node->mClientData = object.mData.mClientData;
+
+    // our old Aabb contained our new one, so we don't have to do anything
+    if (node->mAabb.ContainsPoint(aabb.mMin) && node->mAabb.ContainsPoint(aabb.mMax))
+      continue;
+
+    // something that jumped away from where it was doesn't belong in the same
+    // part of the tree anymore, so reinsert it from the root
+    Aabb fatAabb = GetFattenedAabb(aabb);
+    if (!fatAabb.Overlap(node->mAabb))
+    {
+      Update(node, aabb);
+      continue;
+    }
+
+    node->mAabb = fatAabb;
+    mRefitLeaves.PushBack(node);
+  }
+
+  // walk up from each moved leaf fixing the aabbs. Once a node's aabb doesn't
+  // change, none above it will either (any other leaf that moved under them
+  // fixes them on its own walk)
+  for (uint i = 0; i < mRefitLeaves.Size(); ++i)
+  {
+    NodeType* node = mRefitLeaves[i]->mParent;
+    while (node != nullptr)
+    {
+      Aabb oldAabb = node->mAabb;
+      PolicyType::RefitNode(node);
+      PolicyType::RotateNode(node);
+
+      if (memcmp(&oldAabb, &node->mAabb, sizeof(Aabb)) == 0)
+        break;
+
+      node = node->mParent;
+    }
+  }
+
+  mRefitLeaves.Clear();
+}
+
 template <typename PolicyType>
 typename BaseDynamicAabbTree<PolicyType>::ClientDataType&
 BaseDynamicAabbTree<PolicyType>::GetClientData(BroadPhaseProxy& proxy)
@@ -293,11 +416,7 @@ void BaseDynamicAabbTree<PolicyType>::Update(NodeType* leafNode, Aabb& aabb)
     node = mRoot;
 
   // set the new fattened aabb
-  Vec3 center = aabb.GetCenter();
-  Vec3 halfExtents = aabb.GetHalfExtents();
-  halfExtents = Math::Min(halfExtents + BaseDynamicTreeInternal::cAabbFatFactor,
-                          halfExtents * BaseDynamicTreeInternal::cAabbFatScaleFactor);
-  leafNode->mAabb.SetCenterAndHalfExtents(center, halfExtents);
+  leafNode->mAabb = GetFattenedAabb(aabb);
 
   // we could update at the last unaffected node, but there is no guarantee that
   // the new node is contained within that. We could iterate back up and find
@@ -306,4 +425,16 @@ void BaseDynamicAabbTree<PolicyType>::Update(NodeType* leafNode, Aabb& aabb)
   PolicyType::InsertNode(mRoot, leafNode, mRoot);
 }
 
+template <typename PolicyType>
+Aabb BaseDynamicAabbTree<PolicyType>::GetFattenedAabb(const Aabb& aabb)
+{
+  Vec3 halfExtents = aabb.GetHalfExtents();
+  halfExtents = Math::Min(halfExtents + BaseDynamicTreeInternal::cAabbFatFactor,
+                          halfExtents * BaseDynamicTreeInternal::cAabbFatScaleFactor);
+
+  Aabb fatAabb;
+  fatAabb.SetCenterAndHalfExtents(aabb.GetCenter(), halfExtents);
+  return fatAabb;
+}
+
 } // namespace Plasma
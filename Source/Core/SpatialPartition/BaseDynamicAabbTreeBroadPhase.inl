@@ -98,12 +98,8 @@ void BaseDynamicAabbTreeBroadPhase<TreeType>::UpdateProxy(BroadPhaseProxy& proxy
 template <typename TreeType>
 void BaseDynamicAabbTreeBroadPhase<TreeType>::UpdateProxies(BroadPhaseObjectArray& objects)
 {
-  BroadPhaseObjectArray::range range = objects.All();
-  for (; !range.Empty(); range.PopFront())
-  {
-    BroadPhaseObject& obj = range.Front();
-    SelfType::UpdateProxy(*obj.mProxy, obj.mData);
-  }
+  // Refits every moved proxy in one pass instead of reinserting each one
+  mTree.UpdateProxies(objects);
 }
 
 template <typename TreeType>
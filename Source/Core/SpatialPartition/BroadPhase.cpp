@@ -82,6 +82,11 @@ void IBroadPhase::Construct()
   ErrorIf(true, "Construct function not implemented on BroadPhase %s", LightningGetDerivedType()->Name.c_str());
 }
 
+void IBroadPhase::PrepareForCasts()
+{
+  // Most BroadPhases never defer work to their casts
+}
+
 void IBroadPhase::CastRay(CastDataParam data, ProxyCastResults& results)
 {
   ErrorIf(true, "CastRay function not implemented on BroadPhase %s", LightningGetDerivedType()->Name.c_str());
@@ -60,6 +60,9 @@ public:
   /// Tells the structure that it has all of the data it will ever have. Used
   /// mainly for static BroadPhases.
   virtual void Construct();
+  /// Finishes any work that was deferred until the next cast so that casts
+  /// can then run from several threads at once without modifying anything.
+  virtual void PrepareForCasts();
 
   /// Determines where and when a ray hits what object(s).
   virtual void CastRay(CastDataParam data, ProxyCastResults& results);
@@ -114,6 +117,23 @@ public:
     mCastFrustumCallBack = callback;
   }
 
+  static RayCastCallBack GetCastRayCallBack()
+  {
+    return mCastRayCallBack;
+  }
+  static RayCastCallBack GetCastSegmentCallBack()
+  {
+    return mCastSegmentCallBack;
+  }
+  static VolumeCastCallBack GetCastAabbCallBack()
+  {
+    return mCastAabbCallBack;
+  }
+  static VolumeCastCallBack GetCastSphereCallBack()
+  {
+    return mCastSphereCallBack;
+  }
+
   uint GetType();
 
   /// Tests Ray against Aabb.
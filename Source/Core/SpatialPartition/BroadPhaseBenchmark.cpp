@@ -0,0 +1,489 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+namespace
+{
+
+/// How many results each replayed cast keeps.
+const uint cBenchmarkCastResultCount = 32;
+
+/// The proxies of the replay that is running. The broad phases refine casts
+/// through static callbacks that only get the client data, so this is how
+/// the callbacks below find the proxy's bounds.
+const Array<BroadPhaseData>* sReplayProxies = nullptr;
+
+/// Replayed proxies store their id + 1 as their client data (so none are null).
+void* IdToClientData(uint proxyId)
+{
+  return (void*)(uintptr_t)(proxyId + 1);
+}
+
+uint ClientDataToId(void* clientData)
+{
+  return (uint)((uintptr_t)clientData - 1);
+}
+
+u64 GetPairKey(uint idA, uint idB)
+{
+  if (idA > idB)
+    Swap(idA, idB);
+  return ((u64)idA << 32) | (u64)idB;
+}
+
+const BroadPhaseData& GetReplayData(void* clientData)
+{
+  return (*sReplayProxies)[ClientDataToId(clientData)];
+}
+
+/// Whether a pair has to be reported by every broad phase. Shapes can only
+/// touch when both their aabbs and their bounding spheres overlap.
+bool MustOverlap(const BroadPhaseData& a, const BroadPhaseData& b)
+{
+  if (!a.mAabb.Overlap(b.mAabb))
+    return false;
+
+  real radii = a.mBoundingSphere.mRadius + b.mBoundingSphere.mRadius;
+  return LengthSq(a.mBoundingSphere.mCenter - b.mBoundingSphere.mCenter) <= radii * radii;
+}
+
+void FillResult(ProxyResult& result, real time)
+{
+  result.mPoints[0] = Vec3::cZero;
+  result.mPoints[1] = Vec3::cZero;
+  result.mContactNormal = Vec3::cZero;
+  result.mTime = time;
+  result.ShapeIndex = 0;
+}
+
+bool ReplayCastRay(void* clientData, CastDataParam castData, ProxyResult& result, BaseCastFilter& filter)
+{
+  real time;
+  const Ray& ray = castData.GetRay();
+  if (!IBroadPhase::TestRayVsAabb(GetReplayData(clientData).mAabb, ray.Start, ray.Direction, time))
+    return false;
+
+  FillResult(result, time);
+  return true;
+}
+
+bool ReplayCastSegment(void* clientData, CastDataParam castData, ProxyResult& result, BaseCastFilter& filter)
+{
+  real time;
+  const Segment& segment = castData.GetSegment();
+  if (!IBroadPhase::TestSegmentVsAabb(GetReplayData(clientData).mAabb, segment.Start, segment.End, time))
+    return false;
+
+  FillResult(result, time);
+  return true;
+}
+
+bool ReplayCastAabb(void* clientData, CastDataParam castData, ProxyResult& result, BaseCastFilter& filter)
+{
+  const Aabb& aabb = GetReplayData(clientData).mAabb;
+  if (!aabb.Overlap(castData.GetAabb()))
+    return false;
+
+  FillResult(result, Length(aabb.GetCenter() - castData.GetAabb().GetCenter()));
+  return true;
+}
+
+bool ReplayCastSphere(void* clientData, CastDataParam castData, ProxyResult& result, BaseCastFilter& filter)
+{
+  const Aabb& aabb = GetReplayData(clientData).mAabb;
+  const Sphere& sphere = castData.GetSphere();
+  Vec3 closestPoint = Math::Clamp(sphere.mCenter, aabb.mMin, aabb.mMax);
+  if (LengthSq(closestPoint - sphere.mCenter) > sphere.mRadius * sphere.mRadius)
+    return false;
+
+  FillResult(result, Length(aabb.GetCenter() - sphere.mCenter));
+  return true;
+}
+
+/// Points the broad phase cast callbacks at the replayed proxies for as long
+/// as it's alive, then restores whatever was set before (normally physics).
+struct ScopedReplayCastCallbacks
+{
+  ScopedReplayCastCallbacks(const Array<BroadPhaseData>* proxies)
+  {
+    mRay = IBroadPhase::GetCastRayCallBack();
+    mSegment = IBroadPhase::GetCastSegmentCallBack();
+    mAabb = IBroadPhase::GetCastAabbCallBack();
+    mSphere = IBroadPhase::GetCastSphereCallBack();
+
+    sReplayProxies = proxies;
+    IBroadPhase::SetCastRayCallBack(&ReplayCastRay);
+    IBroadPhase::SetCastSegmentCallBack(&ReplayCastSegment);
+    IBroadPhase::SetCastAabbCallBack(&ReplayCastAabb);
+    IBroadPhase::SetCastSphereCallBack(&ReplayCastSphere);
+  }
+
+  ~ScopedReplayCastCallbacks()
+  {
+    IBroadPhase::SetCastRayCallBack(mRay);
+    IBroadPhase::SetCastSegmentCallBack(mSegment);
+    IBroadPhase::SetCastAabbCallBack(mAabb);
+    IBroadPhase::SetCastSphereCallBack(mSphere);
+    sReplayProxies = nullptr;
+  }
+
+  IBroadPhase::RayCastCallBack mRay;
+  IBroadPhase::RayCastCallBack mSegment;
+  IBroadPhase::VolumeCastCallBack mAabb;
+  IBroadPhase::VolumeCastCallBack mSphere;
+};
+
+/// Replayed casts accept every object.
+struct ReplayCastFilter : public BaseCastFilter
+{
+  bool IsValid(void* clientData) override
+  {
+    return true;
+  }
+};
+
+/// Sorts proxy ids by the minimum of their aabb on the x axis.
+struct ReplayProxySorter
+{
+  ReplayProxySorter(const Array<BroadPhaseData>& proxies) : mProxies(proxies)
+  {
+  }
+
+  bool operator()(uint lhs, uint rhs) const
+  {
+    return mProxies[lhs].mAabb.mMin.x < mProxies[rhs].mAabb.mMin.x;
+  }
+
+  const Array<BroadPhaseData>& mProxies;
+};
+
+void SetReplayData(BroadPhaseData& data, const BroadPhaseEvent& event)
+{
+  data.mAabb.mMin = event.mA;
+  data.mAabb.mMax = event.mB;
+  data.mBoundingSphere.mCenter = event.mCenter;
+  data.mBoundingSphere.mRadius = event.mRadius;
+}
+
+s64 GetHeapBytes()
+{
+  return (s64)Memory::GetGlobalHeap()->mData.BytesAllocated;
+}
+
+} // namespace
+
+BroadPhaseBenchmarkResult::BroadPhaseBenchmarkResult()
+{
+  mType = BroadPhase::Dynamic;
+  for (uint i = 0; i < BPStats::Size; ++i)
+    mTimes[i] = 0.0;
+  mPairsReturned = 0;
+  mPairsExpected = 0;
+  mPairsMissed = 0;
+  mCastResults = 0;
+  mPeakBytes = 0;
+  mRetainedBytes = 0;
+}
+
+BroadPhaseBenchmark::BroadPhaseBenchmark(const BroadPhaseRecording& recording) : mRecording(recording)
+{
+  mExpectedType = BroadPhase::Size;
+}
+
+void BroadPhaseBenchmark::RunAll()
+{
+  for (uint type = 0; type < BroadPhase::Size; ++type)
+  {
+    Array<String> names;
+    PL::gBroadPhaseLibrary->EnumerateNamesOfType((BroadPhase::Type)type, names);
+    for (uint i = 0; i < names.Size(); ++i)
+      Run(type, names[i]);
+  }
+}
+
+void BroadPhaseBenchmark::Run(uint type, StringParam name)
+{
+  IBroadPhase* broadPhase = PL::gBroadPhaseLibrary->CreateBroadPhase(name);
+  ErrorIf(broadPhase == nullptr, "Broad phase '%s' is not registered.", name.c_str());
+  if (broadPhase == nullptr)
+    return;
+
+  // Finding the expected pairs isn't part of the timing
+  ComputeExpectedPairs(type);
+
+  BroadPhaseBenchmarkResult& result = mResults.PushBack();
+  result.mName = name;
+  result.mType = type;
+
+  uint proxyCount = mRecording.GetProxyIdCount();
+  Array<BroadPhaseData> proxies;
+  proxies.Resize(proxyCount);
+  Array<BroadPhaseProxy> handles;
+  handles.Resize(proxyCount);
+
+  ClientPairArray pairs;
+  HashSet<u64> reportedPairs;
+  ProxyCastResultArray castArray;
+  castArray.Resize(cBenchmarkCastResultCount);
+  ReplayCastFilter filter;
+  ProxyCastResults castResults(castArray, filter);
+
+  ScopedReplayCastCallbacks castCallbacks(&proxies);
+
+  // Memory is measured from here, anything the benchmark itself allocates
+  // from now on is added to the scratch bytes so it can be taken back out
+  s64 startBytes = GetHeapBytes();
+  s64 scratchBytes = 0;
+
+  Timer timer;
+  timer.Reset();
+
+  uint queryIndex = 0;
+  uint expectedStart = 0;
+  const Array<BroadPhaseEvent>& events = mRecording.GetEvents();
+  for (uint i = 0; i < events.Size(); ++i)
+  {
+    const BroadPhaseEvent& event = events[i];
+    if (event.mBroadPhaseType != type)
+      continue;
+
+    BroadPhaseData queryData;
+    if (event.mEventType == BroadPhaseEventType::Query)
+      SetReplayData(queryData, event);
+
+    BPStats::Enum stat = BPStats::Cleanup;
+    timer.Update();
+    switch (event.mEventType)
+    {
+    case BroadPhaseEventType::CreateProxy:
+    {
+      BroadPhaseData& data = proxies[event.mProxyId];
+      SetReplayData(data, event);
+      data.mClientData = IdToClientData(event.mProxyId);
+      broadPhase->CreateProxy(handles[event.mProxyId], data);
+      stat = BPStats::Insertion;
+      break;
+    }
+    case BroadPhaseEventType::UpdateProxy:
+    {
+      BroadPhaseData& data = proxies[event.mProxyId];
+      SetReplayData(data, event);
+      broadPhase->UpdateProxy(handles[event.mProxyId], data);
+      stat = BPStats::Update;
+      break;
+    }
+    case BroadPhaseEventType::RemoveProxy:
+      broadPhase->RemoveProxy(handles[event.mProxyId]);
+      stat = BPStats::Removal;
+      break;
+    case BroadPhaseEventType::Construct:
+      broadPhase->Construct();
+      stat = BPStats::Construction;
+      break;
+    case BroadPhaseEventType::RegisterCollisions:
+      broadPhase->RegisterCollisions();
+      stat = BPStats::Collision;
+      break;
+    case BroadPhaseEventType::SelfQuery:
+      broadPhase->SelfQuery(pairs);
+      stat = BPStats::Collision;
+      break;
+    case BroadPhaseEventType::Query:
+      broadPhase->Query(queryData, pairs);
+      stat = BPStats::Collision;
+      break;
+    case BroadPhaseEventType::CastRay:
+      broadPhase->CastRay(CastData(Ray(event.mA, event.mB)), castResults);
+      stat = BPStats::RayCast;
+      break;
+    case BroadPhaseEventType::CastSegment:
+      broadPhase->CastSegment(CastData(Segment(event.mA, event.mB)), castResults);
+      stat = BPStats::RayCast;
+      break;
+    case BroadPhaseEventType::CastAabb:
+    {
+      Aabb aabb;
+      aabb.mMin = event.mA;
+      aabb.mMax = event.mB;
+      broadPhase->CastAabb(CastData(aabb), castResults);
+      stat = BPStats::VolumeCast;
+      break;
+    }
+    case BroadPhaseEventType::CastSphere:
+      broadPhase->CastSphere(CastData(Sphere(event.mCenter, event.mRadius)), castResults);
+      stat = BPStats::VolumeCast;
+      break;
+    case BroadPhaseEventType::Cleanup:
+      broadPhase->Cleanup();
+      stat = BPStats::Cleanup;
+      break;
+    }
+    timer.Update();
+    result.mTimes[stat] += timer.TimeDelta();
+
+    result.mPeakBytes = Math::Max(result.mPeakBytes, GetHeapBytes() - startBytes - scratchBytes);
+
+    s64 bytesBeforeCheck = GetHeapBytes();
+    if (event.mEventType == BroadPhaseEventType::SelfQuery || event.mEventType == BroadPhaseEventType::Query)
+    {
+      reportedPairs.Clear();
+      for (uint p = 0; p < pairs.Size(); ++p)
+      {
+        ClientPair& pair = pairs[p];
+        if (event.mEventType == BroadPhaseEventType::SelfQuery)
+        {
+          reportedPairs.Insert(GetPairKey(ClientDataToId(pair.mClientData[0]), ClientDataToId(pair.mClientData[1])));
+        }
+        else
+        {
+          // The query's own client data is null, the other side is the proxy
+          void* hit = pair.mClientData[0] != nullptr ? pair.mClientData[0] : pair.mClientData[1];
+          reportedPairs.Insert((u64)ClientDataToId(hit));
+        }
+      }
+
+      uint expectedCount = mExpectedPairCounts[queryIndex++];
+      for (uint p = 0; p < expectedCount; ++p)
+      {
+        if (!reportedPairs.Contains(mExpectedPairs[expectedStart + p]))
+          ++result.mPairsMissed;
+      }
+      expectedStart += expectedCount;
+
+      result.mPairsReturned += pairs.Size();
+      result.mPairsExpected += expectedCount;
+      pairs.Clear();
+    }
+    else if (stat == BPStats::RayCast || stat == BPStats::VolumeCast)
+    {
+      result.mCastResults += castResults.GetCurrentSize();
+      castResults.Clear();
+    }
+    scratchBytes += GetHeapBytes() - bytesBeforeCheck;
+  }
+
+  result.mRetainedBytes = GetHeapBytes() - startBytes - scratchBytes;
+
+  delete broadPhase;
+}
+
+void BroadPhaseBenchmark::PrintReport()
+{
+  for (uint i = 0; i < mResults.Size(); ++i)
+  {
+    BroadPhaseBenchmarkResult& result = mResults[i];
+
+    double totalTime = 0.0;
+    StringBuilder builder;
+    builder.Append(String::Format("%s (%s):", result.mName.c_str(), BroadPhase::Names[result.mType]));
+    for (uint stat = 0; stat < BPStats::Size; ++stat)
+    {
+      totalTime += result.mTimes[stat];
+      builder.Append(String::Format(" %s %.3fms", BPStats::Names[stat], result.mTimes[stat] * 1000.0));
+    }
+    builder.Append(String::Format(" | Total %.3fms", totalTime * 1000.0));
+    builder.Append(String::Format(" | Pairs %u (expected %u, missed %u)",
+                                  result.mPairsReturned,
+                                  result.mPairsExpected,
+                                  result.mPairsMissed));
+    builder.Append(String::Format(" | Cast results %u", result.mCastResults));
+    builder.Append(String::Format(" | Memory peak %lld bytes, retained %lld bytes",
+                                  (long long)result.mPeakBytes,
+                                  (long long)result.mRetainedBytes));
+
+    PlasmaPrint("%s\n", builder.ToString().c_str());
+  }
+}
+
+const Array<BroadPhaseBenchmarkResult>& BroadPhaseBenchmark::GetResults() const
+{
+  return mResults;
+}
+
+void BroadPhaseBenchmark::ComputeExpectedPairs(uint type)
+{
+  if (mExpectedType == type)
+    return;
+
+  mExpectedType = type;
+  mExpectedPairs.Clear();
+  mExpectedPairCounts.Clear();
+
+  uint proxyCount = mRecording.GetProxyIdCount();
+  Array<BroadPhaseData> proxies;
+  proxies.Resize(proxyCount);
+  Array<bool> alive;
+  alive.Resize(proxyCount, false);
+  Array<uint> liveIds;
+
+  const Array<BroadPhaseEvent>& events = mRecording.GetEvents();
+  for (uint i = 0; i < events.Size(); ++i)
+  {
+    const BroadPhaseEvent& event = events[i];
+    if (event.mBroadPhaseType != type)
+      continue;
+
+    switch (event.mEventType)
+    {
+    case BroadPhaseEventType::CreateProxy:
+    case BroadPhaseEventType::UpdateProxy:
+      SetReplayData(proxies[event.mProxyId], event);
+      alive[event.mProxyId] = true;
+      break;
+
+    case BroadPhaseEventType::RemoveProxy:
+      alive[event.mProxyId] = false;
+      break;
+
+    case BroadPhaseEventType::SelfQuery:
+    {
+      liveIds.Clear();
+      for (uint id = 0; id < proxyCount; ++id)
+      {
+        if (alive[id])
+          liveIds.PushBack(id);
+      }
+
+      // Sweep along the x axis so only proxies that overlap on it are tested
+      Sort(liveIds.All(), ReplayProxySorter(proxies));
+      uint start = mExpectedPairs.Size();
+      for (uint a = 0; a < liveIds.Size(); ++a)
+      {
+        const BroadPhaseData& dataA = proxies[liveIds[a]];
+        for (uint b = a + 1; b < liveIds.Size(); ++b)
+        {
+          const BroadPhaseData& dataB = proxies[liveIds[b]];
+          if (dataB.mAabb.mMin.x > dataA.mAabb.mMax.x)
+            break;
+          if (MustOverlap(dataA, dataB))
+            mExpectedPairs.PushBack(GetPairKey(liveIds[a], liveIds[b]));
+        }
+      }
+      mExpectedPairCounts.PushBack(mExpectedPairs.Size() - start);
+      break;
+    }
+
+    case BroadPhaseEventType::Query:
+    {
+      BroadPhaseData queryData;
+      SetReplayData(queryData, event);
+
+      uint start = mExpectedPairs.Size();
+      for (uint id = 0; id < proxyCount; ++id)
+      {
+        if (alive[id] && MustOverlap(queryData, proxies[id]))
+          mExpectedPairs.PushBack((u64)id);
+      }
+      mExpectedPairCounts.PushBack(mExpectedPairs.Size() - start);
+      break;
+    }
+
+    default:
+      break;
+    }
+  }
+}
+
+} // namespace Plasma
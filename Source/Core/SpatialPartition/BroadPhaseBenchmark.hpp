@@ -0,0 +1,69 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+/// The results of replaying a recording against one broad phase.
+struct BroadPhaseBenchmarkResult
+{
+  BroadPhaseBenchmarkResult();
+
+  String mName;
+  /// BroadPhase::Dynamic or Static.
+  uint mType;
+
+  /// Seconds spent in each kind of operation.
+  double mTimes[BPStats::Size];
+
+  /// How many pairs self queries and queries reported.
+  uint mPairsReturned;
+  /// How many pairs had both their aabbs and bounding spheres overlapping,
+  /// which every broad phase has to report.
+  uint mPairsExpected;
+  /// How many of the expected pairs weren't reported.
+  uint mPairsMissed;
+  /// How many objects the casts reported.
+  uint mCastResults;
+
+  /// Bytes allocated from the global heap while the recording was replayed,
+  /// at the highest point and what was still allocated at the end.
+  s64 mPeakBytes;
+  s64 mRetainedBytes;
+};
+
+/// Replays a BroadPhaseRecording against broad phases to compare how long
+/// each kind of operation takes, how much memory they use and whether they
+/// miss any pairs.
+class BroadPhaseBenchmark
+{
+public:
+  BroadPhaseBenchmark(const BroadPhaseRecording& recording);
+
+  /// Replays the recording against every broad phase that is registered for
+  /// each type.
+  void RunAll();
+  /// Replays the events of the given type (BroadPhase::Dynamic or Static)
+  /// against a new broad phase of the given name.
+  void Run(uint type, StringParam name);
+
+  /// Prints a line for each result.
+  void PrintReport();
+  const Array<BroadPhaseBenchmarkResult>& GetResults() const;
+
+private:
+  /// Finds the pairs each query of the given type has to report.
+  void ComputeExpectedPairs(uint type);
+
+  const BroadPhaseRecording& mRecording;
+  Array<BroadPhaseBenchmarkResult> mResults;
+
+  /// The expected pairs of every query event in the recording (in order),
+  /// each query's pairs start where the previous query's ended.
+  Array<u64> mExpectedPairs;
+  Array<uint> mExpectedPairCounts;
+  /// Which type the expected pairs were found for (BroadPhase::Size if none).
+  uint mExpectedType;
+};
+
+} // namespace Plasma
@@ -12,6 +12,7 @@ BroadPhasePackage::BroadPhasePackage()
   mBroadPhases[BroadPhase::Dynamic] = nullptr;
   mBroadPhases[BroadPhase::Static] = nullptr;
   mRefineRayCast = false;
+  mRecording = nullptr;
 }
 
 BroadPhasePackage::~BroadPhasePackage()
@@ -107,6 +108,21 @@ void BroadPhasePackage::AddBroadPhase(uint type, IBroadPhase* broadphase)
   mBroadPhases[type] = broadphase;
 }
 
+void BroadPhasePackage::StartRecording(BroadPhaseRecording* recording)
+{
+  mRecording = recording;
+}
+
+void BroadPhasePackage::StopRecording()
+{
+  mRecording = nullptr;
+}
+
+BroadPhaseRecording* BroadPhasePackage::GetRecording()
+{
+  return mRecording;
+}
+
 void BroadPhasePackage::Draw(int level, uint debugFlags)
 {
   mBroadPhases[BroadPhase::Dynamic]->Draw(level, debugFlags);
@@ -116,68 +132,133 @@ void BroadPhasePackage::Draw(int level, uint debugFlags)
 void BroadPhasePackage::CreateProxy(uint type, BroadPhaseProxy& proxy, BroadPhaseData& data)
 {
   mBroadPhases[type]->CreateProxy(proxy, data);
+
+  if (mRecording != nullptr)
+    mRecording->RecordCreateProxy(type, proxy, data);
 }
 
 void BroadPhasePackage::CreateProxies(uint type, BroadPhaseObjectArray& objects)
 {
   mBroadPhases[type]->CreateProxies(objects);
+
+  if (mRecording != nullptr)
+  {
+    for (uint i = 0; i < objects.Size(); ++i)
+      mRecording->RecordCreateProxy(type, *objects[i].mProxy, objects[i].mData);
+  }
 }
 
 void BroadPhasePackage::RemoveProxy(uint type, BroadPhaseProxy& proxy)
 {
+  // Record first since removing clears the proxy
+  if (mRecording != nullptr)
+    mRecording->RecordRemoveProxy(type, proxy);
+
   mBroadPhases[type]->RemoveProxy(proxy);
 }
 
 void BroadPhasePackage::RemoveProxies(uint type, ProxyHandleArray& proxies)
 {
+  if (mRecording != nullptr)
+  {
+    for (uint i = 0; i < proxies.Size(); ++i)
+      mRecording->RecordRemoveProxy(type, *proxies[i]);
+  }
+
   mBroadPhases[type]->RemoveProxies(proxies);
 }
 
 void BroadPhasePackage::UpdateProxy(uint type, BroadPhaseProxy& proxy, BroadPhaseData& data)
 {
   mBroadPhases[type]->UpdateProxy(proxy, data);
+
+  if (mRecording != nullptr)
+    mRecording->RecordUpdateProxy(type, proxy, data);
 }
 
 void BroadPhasePackage::UpdateProxies(uint type, BroadPhaseObjectArray& objects)
 {
   mBroadPhases[type]->UpdateProxies(objects);
+
+  if (mRecording != nullptr)
+  {
+    for (uint i = 0; i < objects.Size(); ++i)
+      mRecording->RecordUpdateProxy(type, *objects[i].mProxy, objects[i].mData);
+  }
 }
 
 void BroadPhasePackage::SelfQuery(ClientPairArray& results)
 {
   mBroadPhases[BroadPhase::Dynamic]->SelfQuery(results);
+
+  if (mRecording != nullptr)
+    mRecording->Record(BroadPhase::Dynamic, BroadPhaseEventType::SelfQuery);
 }
 
 void BroadPhasePackage::Query(BroadPhaseData& data, ClientPairArray& results)
 {
   mBroadPhases[BroadPhase::Static]->Query(data, results);
+
+  if (mRecording != nullptr)
+    mRecording->RecordQuery(BroadPhase::Static, data);
 }
 
 void BroadPhasePackage::BatchQuery(BroadPhaseDataArray& data, ClientPairArray& results)
 {
   mBroadPhases[BroadPhase::Static]->BatchQuery(data, results);
+
+  // Batches are replayed as individual queries
+  if (mRecording != nullptr)
+  {
+    for (uint i = 0; i < data.Size(); ++i)
+      mRecording->RecordQuery(BroadPhase::Static, data[i]);
+  }
 }
 
 void BroadPhasePackage::QueryBoth(BroadPhaseData& data, ClientPairArray& results)
 {
   mBroadPhases[BroadPhase::Static]->Query(data, results);
   mBroadPhases[BroadPhase::Dynamic]->Query(data, results);
+
+  if (mRecording != nullptr)
+  {
+    mRecording->RecordQuery(BroadPhase::Static, data);
+    mRecording->RecordQuery(BroadPhase::Dynamic, data);
+  }
 }
 
 void BroadPhasePackage::Construct()
 {
   mBroadPhases[BroadPhase::Static]->Construct();
+
+  if (mRecording != nullptr)
+    mRecording->Record(BroadPhase::Static, BroadPhaseEventType::Construct);
+}
+
+void BroadPhasePackage::PrepareForCasts()
+{
+  mBroadPhases[BroadPhase::Dynamic]->PrepareForCasts();
+  mBroadPhases[BroadPhase::Static]->PrepareForCasts();
 }
 
 void BroadPhasePackage::RegisterCollisions()
 {
   mBroadPhases[BroadPhase::Dynamic]->RegisterCollisions();
+
+  if (mRecording != nullptr)
+    mRecording->Record(BroadPhase::Dynamic, BroadPhaseEventType::RegisterCollisions);
 }
 
 void BroadPhasePackage::Cleanup()
 {
   mBroadPhases[BroadPhase::Dynamic]->Cleanup();
   mBroadPhases[BroadPhase::Static]->Cleanup();
+
+  if (mRecording != nullptr)
+  {
+    mRecording->Record(BroadPhase::Dynamic, BroadPhaseEventType::Cleanup);
+    mRecording->Record(BroadPhase::Static, BroadPhaseEventType::Cleanup);
+  }
 }
 
 void BroadPhasePackage::CastRay(Vec3Param startPos, Vec3Param direction, ProxyCastResults& results)
@@ -327,6 +408,19 @@ void BroadPhasePackage::CastIntoBroadphase(uint broadPhaseType,
                                            CastFunction func)
 {
   (mBroadPhases[broadPhaseType]->*func)(data, results);
+
+  // Frustum casts aren't recorded
+  if (mRecording != nullptr)
+  {
+    if (func == &IBroadPhase::CastRay)
+      mRecording->RecordCast(broadPhaseType, BroadPhaseEventType::CastRay, data);
+    else if (func == &IBroadPhase::CastSegment)
+      mRecording->RecordCast(broadPhaseType, BroadPhaseEventType::CastSegment, data);
+    else if (func == &IBroadPhase::CastAabb)
+      mRecording->RecordCast(broadPhaseType, BroadPhaseEventType::CastAabb, data);
+    else if (func == &IBroadPhase::CastSphere)
+      mRecording->RecordCast(broadPhaseType, BroadPhaseEventType::CastSphere, data);
+  }
 }
 
 bool BroadPhasePackage::GetFirstContactInStatic(CastDataParam rayData, Vec3& point, ProxyCastResults& results)
@@ -40,6 +40,12 @@ public:
     return false;
   }
 
+  /// Records every operation performed on the broad phases into the given
+  /// recording until StopRecording is called. The recording is not owned.
+  void StartRecording(BroadPhaseRecording* recording);
+  void StopRecording();
+  BroadPhaseRecording* GetRecording();
+
 public:
   /// Draws all broad phases (if they have something to draw).
   /// Not every algorithm will use the level.
@@ -73,6 +79,9 @@ public:
   /// Tells the structure that it has all of the data it will ever have. Used
   /// mainly for static BroadPhases.
   virtual void Construct();
+  /// Lets both broad phases finish any deferred work before casting into
+  /// them from several threads at once.
+  virtual void PrepareForCasts();
 
   /// Casts a ray into the broad phases.  If the results is set to only grab
   /// a single object, it will cast into the static first, then use the position
@@ -107,6 +116,9 @@ protected:
   // a segment, then cast into the dynamic.
   bool mRefineRayCast;
 
+  // Where operations are recorded to (if anywhere).
+  BroadPhaseRecording* mRecording;
+
   // A list of broad phases for each type of broad phase.
   IBroadPhase* mBroadPhases[BroadPhase::Size];
 };
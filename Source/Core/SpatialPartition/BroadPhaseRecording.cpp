@@ -0,0 +1,175 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+BroadPhaseRecording::BroadPhaseRecording()
+{
+  mProxyIdCount = 0;
+}
+
+void BroadPhaseRecording::Serialize(Serializer& stream)
+{
+  uint eventCount = mEvents.Size();
+
+  stream.SerializeField("ProxyIdCount", mProxyIdCount);
+  stream.SerializeField("EventCount", eventCount);
+
+  if (stream.GetMode() == SerializerMode::Loading)
+  {
+    mEvents.Resize(eventCount);
+    for (uint i = 0; i < BroadPhase::Size; ++i)
+      mProxyIds[i].Clear();
+  }
+
+  // The events are plain data so they're written as one block
+  if (eventCount != 0)
+  {
+    stream.ArrayField("Integer",
+                      "Events",
+                      (::byte*)mEvents.Data(),
+                      BasicArrayType::Integer,
+                      eventCount * sizeof(BroadPhaseEvent) / sizeof(u32),
+                      sizeof(u32));
+  }
+}
+
+bool BroadPhaseRecording::SaveToFile(Status& status, StringParam fileName)
+{
+  BinaryFileSaver saver;
+  if (!saver.Open(status, fileName.c_str()))
+    return false;
+
+  Serialize(saver);
+  saver.Close();
+  return true;
+}
+
+bool BroadPhaseRecording::LoadFromFile(Status& status, StringParam fileName)
+{
+  BinaryFileLoader loader;
+  if (!loader.OpenFile(status, fileName.c_str()))
+    return false;
+
+  Serialize(loader);
+  loader.Close();
+  return true;
+}
+
+void BroadPhaseRecording::Clear()
+{
+  mEvents.Clear();
+  mProxyIdCount = 0;
+  for (uint i = 0; i < BroadPhase::Size; ++i)
+    mProxyIds[i].Clear();
+}
+
+void BroadPhaseRecording::RecordCreateProxy(uint type, BroadPhaseProxy& proxy, BroadPhaseData& data)
+{
+  uint proxyId = mProxyIdCount++;
+  mProxyIds[type].Insert(proxy.ToVoidPointer(), proxyId);
+
+  BroadPhaseEvent& event = AddEvent(type, BroadPhaseEventType::CreateProxy);
+  event.mProxyId = proxyId;
+  SetProxyData(event, data);
+}
+
+void BroadPhaseRecording::RecordUpdateProxy(uint type, BroadPhaseProxy& proxy, BroadPhaseData& data)
+{
+  // Proxies created before recording started show up here first, so
+  // record them as being created to keep the stream replayable
+  uint* proxyId = mProxyIds[type].FindPointer(proxy.ToVoidPointer());
+  if (proxyId == nullptr)
+  {
+    RecordCreateProxy(type, proxy, data);
+    return;
+  }
+
+  BroadPhaseEvent& event = AddEvent(type, BroadPhaseEventType::UpdateProxy);
+  event.mProxyId = *proxyId;
+  SetProxyData(event, data);
+}
+
+void BroadPhaseRecording::RecordRemoveProxy(uint type, BroadPhaseProxy& proxy)
+{
+  void* key = proxy.ToVoidPointer();
+  uint* proxyId = mProxyIds[type].FindPointer(key);
+  if (proxyId == nullptr)
+    return;
+
+  BroadPhaseEvent& event = AddEvent(type, BroadPhaseEventType::RemoveProxy);
+  event.mProxyId = *proxyId;
+  mProxyIds[type].Erase(key);
+}
+
+void BroadPhaseRecording::RecordQuery(uint type, BroadPhaseData& data)
+{
+  BroadPhaseEvent& event = AddEvent(type, BroadPhaseEventType::Query);
+  SetProxyData(event, data);
+}
+
+void BroadPhaseRecording::RecordCast(uint type, BroadPhaseEventType::Enum eventType, CastDataParam data)
+{
+  BroadPhaseEvent& event = AddEvent(type, eventType);
+  switch (eventType)
+  {
+  case BroadPhaseEventType::CastRay:
+    event.mA = data.GetRay().Start;
+    event.mB = data.GetRay().Direction;
+    break;
+  case BroadPhaseEventType::CastSegment:
+    event.mA = data.GetSegment().Start;
+    event.mB = data.GetSegment().End;
+    break;
+  case BroadPhaseEventType::CastAabb:
+    event.mA = data.GetAabb().mMin;
+    event.mB = data.GetAabb().mMax;
+    break;
+  case BroadPhaseEventType::CastSphere:
+    event.mCenter = data.GetSphere().mCenter;
+    event.mRadius = data.GetSphere().mRadius;
+    break;
+  default:
+    ErrorIf(true, "Event type %s is not a cast.", BroadPhaseEventType::Names[eventType]);
+    break;
+  }
+}
+
+void BroadPhaseRecording::Record(uint type, BroadPhaseEventType::Enum eventType)
+{
+  AddEvent(type, eventType);
+}
+
+const Array<BroadPhaseEvent>& BroadPhaseRecording::GetEvents() const
+{
+  return mEvents;
+}
+
+uint BroadPhaseRecording::GetProxyIdCount() const
+{
+  return mProxyIdCount;
+}
+
+BroadPhaseEvent& BroadPhaseRecording::AddEvent(uint type, BroadPhaseEventType::Enum eventType)
+{
+  BroadPhaseEvent& event = mEvents.PushBack();
+  event.mEventType = eventType;
+  event.mBroadPhaseType = type;
+  event.mProxyId = uint(-1);
+  event.mA = Vec3::cZero;
+  event.mB = Vec3::cZero;
+  event.mCenter = Vec3::cZero;
+  event.mRadius = real(0.0);
+  return event;
+}
+
+void BroadPhaseRecording::SetProxyData(BroadPhaseEvent& event, BroadPhaseData& data)
+{
+  event.mA = data.mAabb.mMin;
+  event.mB = data.mAabb.mMax;
+  event.mCenter = data.mBoundingSphere.mCenter;
+  event.mRadius = data.mBoundingSphere.mRadius;
+}
+
+} // namespace Plasma
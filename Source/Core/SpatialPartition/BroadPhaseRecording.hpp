@@ -0,0 +1,81 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+DeclareEnum12(BroadPhaseEventType,
+              CreateProxy,
+              UpdateProxy,
+              RemoveProxy,
+              Construct,
+              RegisterCollisions,
+              SelfQuery,
+              Query,
+              CastRay,
+              CastSegment,
+              CastAabb,
+              CastSphere,
+              Cleanup);
+
+/// One operation that was performed on a broad phase. Only plain data is
+/// stored so that a whole recording can be saved and loaded as one block.
+struct BroadPhaseEvent
+{
+  /// A BroadPhaseEventType.
+  u32 mEventType;
+  /// Which broad phase (BroadPhase::Dynamic or Static) the event went to.
+  u32 mBroadPhaseType;
+  /// Proxies are numbered in the order they were created in the recording.
+  u32 mProxyId;
+
+  /// The proxy's or query's aabb (min and max), a ray's start and direction,
+  /// a segment's start and end or a cast aabb.
+  Vec3 mA;
+  Vec3 mB;
+  /// The proxy's bounding sphere or a cast sphere.
+  Vec3 mCenter;
+  real mRadius;
+};
+
+/// A stream of the operations performed on a BroadPhasePackage, captured by
+/// BroadPhasePackage::StartRecording. Recordings can be saved, loaded and
+/// replayed against any broad phase with a BroadPhaseBenchmark.
+class BroadPhaseRecording
+{
+public:
+  BroadPhaseRecording();
+
+  void Serialize(Serializer& stream);
+  bool SaveToFile(Status& status, StringParam fileName);
+  bool LoadFromFile(Status& status, StringParam fileName);
+
+  void Clear();
+
+  void RecordCreateProxy(uint type, BroadPhaseProxy& proxy, BroadPhaseData& data);
+  void RecordUpdateProxy(uint type, BroadPhaseProxy& proxy, BroadPhaseData& data);
+  void RecordRemoveProxy(uint type, BroadPhaseProxy& proxy);
+  void RecordQuery(uint type, BroadPhaseData& data);
+  void RecordCast(uint type, BroadPhaseEventType::Enum eventType, CastDataParam data);
+  /// Records an event that only has a type (Construct, RegisterCollisions,
+  /// SelfQuery and Cleanup).
+  void Record(uint type, BroadPhaseEventType::Enum eventType);
+
+  const Array<BroadPhaseEvent>& GetEvents() const;
+  /// How many proxies were created over the whole recording.
+  uint GetProxyIdCount() const;
+
+private:
+  BroadPhaseEvent& AddEvent(uint type, BroadPhaseEventType::Enum eventType);
+  void SetProxyData(BroadPhaseEvent& event, BroadPhaseData& data);
+
+  Array<BroadPhaseEvent> mEvents;
+  uint mProxyIdCount;
+
+  /// The recording's id for each live proxy, keyed by the proxy the broad
+  /// phase gave out. Only used while recording.
+  typedef HashMap<void*, uint> ProxyIdMap;
+  ProxyIdMap mProxyIds[BroadPhase::Size];
+};
+
+} // namespace Plasma
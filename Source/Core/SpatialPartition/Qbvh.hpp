@@ -0,0 +1,141 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+/// A bounding volume hierarchy with four children per node (QBVH) where every
+/// node lives in one contiguous array. A node stores the bounds of its four
+/// children one axis at a time so that all four can be tested against a query
+/// at once (with SSE when USESSE is defined). Proxies that move are refit in
+/// place by walking up the tree. Inserting or removing proxies, or refitting
+/// the nodes far past the size they were built with, causes a rebuild.
+template <typename ClientDataType>
+class Qbvh
+{
+public:
+  typedef BaseBroadPhaseData<ClientDataType> DataType;
+
+  /// A node of the tree. A child value >= 0 is the index of another node,
+  /// otherwise it is an encoded leaf index (see LeafToChild).
+  struct Node
+  {
+    Aabb GetAabb() const;
+    Aabb GetChildAabb(uint slot) const;
+    void SetChild(uint slot, int child, const Aabb& aabb);
+    void SetChildAabb(uint slot, const Aabb& aabb);
+
+    float mMinX[4];
+    float mMinY[4];
+    float mMinZ[4];
+    float mMaxX[4];
+    float mMaxY[4];
+    float mMaxZ[4];
+    int mChildren[4];
+    /// How many of the child slots are used. Used slots are always the first.
+    uint mCount;
+    int mParent;
+    uint mParentSlot;
+  };
+
+  struct Leaf
+  {
+    DataType mData;
+    /// The node and slot that reference this leaf, or -1 if the leaf has not
+    /// been put in the tree yet.
+    int mNode;
+    uint mSlot;
+    bool mValid;
+  };
+
+  Qbvh();
+
+  void Serialize(Serializer& stream);
+
+  /// Inserts the given data and fills out the proxy for future operations on
+  /// data. The tree is rebuilt before the next query.
+  void CreateProxy(BroadPhaseProxy& proxy, DataType& data);
+  /// Removes the object that the given proxy points to. The tree is rebuilt
+  /// before the next query.
+  void RemoveProxy(BroadPhaseProxy& proxy);
+  /// Updates the data that the proxy points to with the new data and refits
+  /// the nodes above it in place.
+  void UpdateProxy(BroadPhaseProxy& proxy, DataType& data);
+
+  ClientDataType& GetClientData(uint proxyIndex);
+  const Aabb& GetAabb(uint proxyIndex) const;
+  /// The largest proxy index that has been handed out plus one.
+  uint GetProxyIndexCount() const;
+  bool IsValid(uint proxyIndex) const;
+
+  /// Rebuilds the tree if proxies were inserted or removed, or if refitting
+  /// has grown the nodes too far past the size they were built with.
+  void Update();
+  /// Rebuilds the tree from every valid proxy.
+  void Build();
+
+  /// Draws the bounds of every node at the given depth (-1 for all nodes).
+  void Draw(int level);
+
+  /// Each query calls callback(proxyIndex) for every proxy whose Aabb passes
+  /// the test against the query shape.
+  template <typename CallbackType>
+  void QueryAabb(const Aabb& aabb, CallbackType& callback);
+  template <typename CallbackType>
+  void QueryRay(const Ray& ray, CallbackType& callback);
+  template <typename CallbackType>
+  void QuerySegment(const Segment& segment, CallbackType& callback);
+  template <typename CallbackType>
+  void QuerySphere(const Sphere& sphere, CallbackType& callback);
+  template <typename CallbackType>
+  void QueryFrustum(const Frustum& frustum, CallbackType& callback);
+
+private:
+  /// Pre-computed data to slab test a ray or segment against nodes.
+  struct RayQuery
+  {
+    RayQuery(Vec3Param start, Vec3Param direction, real maxT);
+
+    Vec3 mStart;
+    Vec3 mInverseDirection;
+    real mMaxT;
+  };
+
+  struct FrustumQuery
+  {
+    const Vec4* mPlanes;
+  };
+
+  /// Each test returns a bit mask of the child slots that passed.
+  static uint TestNode(const Node& node, const Aabb& aabb);
+  static uint TestNode(const Node& node, const RayQuery& ray);
+  static uint TestNode(const Node& node, const Sphere& sphere);
+  static uint TestNode(const Node& node, const FrustumQuery& frustum);
+
+  template <typename QueryType, typename CallbackType>
+  void Traverse(const QueryType& query, CallbackType& callback);
+
+  static int LeafToChild(uint leafIndex);
+  static uint ChildToLeaf(int child);
+
+  uint GetNewProxyIndex();
+  int BuildNode(uint start, uint count, int parent, uint parentSlot);
+  uint Split(uint start, uint count);
+  void DrawNode(int nodeIndex, int depth, int level);
+
+  Array<Node> mNodes;
+  Array<Leaf> mLeaves;
+  Array<uint> mFreeIndices;
+  /// Scratch space for the leaf indices while building.
+  Array<uint> mBuildIndices;
+
+  /// Sum of the surface areas of all internal nodes, kept up to date while
+  /// refitting and compared against the value at the last build.
+  real mSurfaceArea;
+  real mBuiltSurfaceArea;
+  bool mDirty;
+};
+
+} // namespace Plasma
+
+#include "Core/SpatialPartition/Qbvh.inl"
@@ -0,0 +1,575 @@
+// MIT Licensed (see LICENSE.md).
+
+namespace Plasma
+{
+
+/// Once refitting has grown the internal nodes' total surface area past this
+/// multiple of what it was at the last build, the tree is rebuilt.
+const real cQbvhRebuildRatio = real(2.0);
+
+/// The tree is built by median splits so its depth is log4 of the proxy count.
+/// Each node pops one entry and pushes at most four, so this is enough for far
+/// more proxies than a space will ever hold.
+const uint cQbvhStackSize = 64;
+
+/// Sorts leaf indices by the center of their Aabb on one axis.
+template <typename LeafType>
+struct QbvhCentroidSorter
+{
+  QbvhCentroidSorter(const LeafType* leaves, uint axis) : mLeaves(leaves), mAxis(axis)
+  {
+  }
+
+  bool operator()(uint lhs, uint rhs) const
+  {
+    const Aabb& lhsAabb = mLeaves[lhs].mData.mAabb;
+    const Aabb& rhsAabb = mLeaves[rhs].mData.mAabb;
+    return (lhsAabb.mMin[mAxis] + lhsAabb.mMax[mAxis]) < (rhsAabb.mMin[mAxis] + rhsAabb.mMax[mAxis]);
+  }
+
+  const LeafType* mLeaves;
+  uint mAxis;
+};
+
+template <typename ClientDataType>
+Aabb Qbvh<ClientDataType>::Node::GetAabb() const
+{
+  Aabb aabb = GetChildAabb(0);
+  for (uint i = 1; i < mCount; ++i)
+    aabb.Combine(GetChildAabb(i));
+  return aabb;
+}
+
+template <typename ClientDataType>
+Aabb Qbvh<ClientDataType>::Node::GetChildAabb(uint slot) const
+{
+  Aabb aabb;
+  aabb.mMin = Vec3(mMinX[slot], mMinY[slot], mMinZ[slot]);
+  aabb.mMax = Vec3(mMaxX[slot], mMaxY[slot], mMaxZ[slot]);
+  return aabb;
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::Node::SetChild(uint slot, int child, const Aabb& aabb)
+{
+  mChildren[slot] = child;
+  SetChildAabb(slot, aabb);
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::Node::SetChildAabb(uint slot, const Aabb& aabb)
+{
+  mMinX[slot] = aabb.mMin.x;
+  mMinY[slot] = aabb.mMin.y;
+  mMinZ[slot] = aabb.mMin.z;
+  mMaxX[slot] = aabb.mMax.x;
+  mMaxY[slot] = aabb.mMax.y;
+  mMaxZ[slot] = aabb.mMax.z;
+}
+
+template <typename ClientDataType>
+Qbvh<ClientDataType>::RayQuery::RayQuery(Vec3Param start, Vec3Param direction, real maxT)
+{
+  mStart = start;
+  mMaxT = maxT;
+
+  // A zero component would divide to infinity and turn the slab test into
+  // 0 * inf = NaN, so use the largest finite value instead
+  for (uint i = 0; i < 3; ++i)
+  {
+    if (direction[i] == real(0.0))
+      mInverseDirection[i] = Math::PositiveMax();
+    else
+      mInverseDirection[i] = real(1.0) / direction[i];
+  }
+}
+
+template <typename ClientDataType>
+Qbvh<ClientDataType>::Qbvh()
+{
+  mSurfaceArea = real(0.0);
+  mBuiltSurfaceArea = real(0.0);
+  mDirty = false;
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::Serialize(Serializer& stream)
+{
+  // nothing to serialize here...
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::CreateProxy(BroadPhaseProxy& proxy, DataType& data)
+{
+  uint index = GetNewProxyIndex();
+  Leaf& leaf = mLeaves[index];
+  leaf.mData = data;
+  leaf.mNode = -1;
+  leaf.mSlot = 0;
+  leaf.mValid = true;
+  proxy = BroadPhaseProxy((u32)index);
+
+  mDirty = true;
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::RemoveProxy(BroadPhaseProxy& proxy)
+{
+  uint index = proxy.ToU32();
+  ErrorIf(mLeaves[index].mValid == false, "Removing an invalid proxy.");
+  mLeaves[index].mValid = false;
+  mLeaves[index].mNode = -1;
+  mFreeIndices.PushBack(index);
+
+  mDirty = true;
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::UpdateProxy(BroadPhaseProxy& proxy, DataType& data)
+{
+  uint index = proxy.ToU32();
+  Leaf& leaf = mLeaves[index];
+  ErrorIf(leaf.mValid == false, "Updating an invalid proxy.");
+  leaf.mData = data;
+
+  // Not in the tree yet, it will be picked up by the next build
+  if (mDirty || leaf.mNode == -1)
+    return;
+
+  // Refit the leaf's slot and every node above it until a node's bounds
+  // come out unchanged
+  int nodeIndex = leaf.mNode;
+  uint slot = leaf.mSlot;
+  Aabb aabb = data.mAabb;
+  while (nodeIndex != -1)
+  {
+    Node& node = mNodes[nodeIndex];
+    Aabb oldAabb = node.GetChildAabb(slot);
+    if (oldAabb.mMin == aabb.mMin && oldAabb.mMax == aabb.mMax)
+      break;
+
+    node.SetChildAabb(slot, aabb);
+    if (node.mChildren[slot] >= 0)
+      mSurfaceArea += aabb.GetSurfaceArea() - oldAabb.GetSurfaceArea();
+
+    aabb = node.GetAabb();
+    slot = node.mParentSlot;
+    nodeIndex = node.mParent;
+  }
+}
+
+template <typename ClientDataType>
+ClientDataType& Qbvh<ClientDataType>::GetClientData(uint proxyIndex)
+{
+  return mLeaves[proxyIndex].mData.mClientData;
+}
+
+template <typename ClientDataType>
+const Aabb& Qbvh<ClientDataType>::GetAabb(uint proxyIndex) const
+{
+  return mLeaves[proxyIndex].mData.mAabb;
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::GetProxyIndexCount() const
+{
+  return mLeaves.Size();
+}
+
+template <typename ClientDataType>
+bool Qbvh<ClientDataType>::IsValid(uint proxyIndex) const
+{
+  return mLeaves[proxyIndex].mValid;
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::Update()
+{
+  if (mDirty || mSurfaceArea > mBuiltSurfaceArea * cQbvhRebuildRatio)
+    Build();
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::Build()
+{
+  mNodes.Clear();
+  mBuildIndices.Clear();
+  mSurfaceArea = real(0.0);
+  mDirty = false;
+
+  for (uint i = 0; i < mLeaves.Size(); ++i)
+  {
+    if (mLeaves[i].mValid)
+      mBuildIndices.PushBack(i);
+  }
+
+  if (!mBuildIndices.Empty())
+    BuildNode(0, mBuildIndices.Size(), -1, 0);
+
+  mBuiltSurfaceArea = mSurfaceArea;
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::Draw(int level)
+{
+  if (mNodes.Empty())
+    return;
+
+  DrawNode(0, 0, level);
+}
+
+template <typename ClientDataType>
+template <typename CallbackType>
+void Qbvh<ClientDataType>::QueryAabb(const Aabb& aabb, CallbackType& callback)
+{
+  Traverse(aabb, callback);
+}
+
+template <typename ClientDataType>
+template <typename CallbackType>
+void Qbvh<ClientDataType>::QueryRay(const Ray& ray, CallbackType& callback)
+{
+  RayQuery query(ray.Start, ray.Direction, Math::PositiveMax());
+  Traverse(query, callback);
+}
+
+template <typename ClientDataType>
+template <typename CallbackType>
+void Qbvh<ClientDataType>::QuerySegment(const Segment& segment, CallbackType& callback)
+{
+  RayQuery query(segment.Start, segment.End - segment.Start, real(1.0));
+  Traverse(query, callback);
+}
+
+template <typename ClientDataType>
+template <typename CallbackType>
+void Qbvh<ClientDataType>::QuerySphere(const Sphere& sphere, CallbackType& callback)
+{
+  Traverse(sphere, callback);
+}
+
+template <typename ClientDataType>
+template <typename CallbackType>
+void Qbvh<ClientDataType>::QueryFrustum(const Frustum& frustum, CallbackType& callback)
+{
+  FrustumQuery query;
+  query.mPlanes = frustum.GetIntersectionData();
+  Traverse(query, callback);
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::TestNode(const Node& node, const Aabb& aabb)
+{
+#if defined(USESSE)
+  using namespace Math::Simd;
+  SimVec x = AndVec(LessEqual(UnAlignedLoad(node.mMinX), Set(aabb.mMax.x)),
+                    GreaterEqual(UnAlignedLoad(node.mMaxX), Set(aabb.mMin.x)));
+  SimVec y = AndVec(LessEqual(UnAlignedLoad(node.mMinY), Set(aabb.mMax.y)),
+                    GreaterEqual(UnAlignedLoad(node.mMaxY), Set(aabb.mMin.y)));
+  SimVec z = AndVec(LessEqual(UnAlignedLoad(node.mMinZ), Set(aabb.mMax.z)),
+                    GreaterEqual(UnAlignedLoad(node.mMaxZ), Set(aabb.mMin.z)));
+  return (uint)_mm_movemask_ps(AndVec(AndVec(x, y), z));
+#else
+  uint mask = 0;
+  for (uint i = 0; i < node.mCount; ++i)
+  {
+    if (node.mMinX[i] <= aabb.mMax.x && node.mMaxX[i] >= aabb.mMin.x && node.mMinY[i] <= aabb.mMax.y &&
+        node.mMaxY[i] >= aabb.mMin.y && node.mMinZ[i] <= aabb.mMax.z && node.mMaxZ[i] >= aabb.mMin.z)
+      mask |= 1 << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::TestNode(const Node& node, const RayQuery& ray)
+{
+#if defined(USESSE)
+  using namespace Math::Simd;
+  SimVec startX = Set(ray.mStart.x);
+  SimVec startY = Set(ray.mStart.y);
+  SimVec startZ = Set(ray.mStart.z);
+  SimVec inverseX = Set(ray.mInverseDirection.x);
+  SimVec inverseY = Set(ray.mInverseDirection.y);
+  SimVec inverseZ = Set(ray.mInverseDirection.z);
+
+  SimVec x0 = Multiply(Subtract(UnAlignedLoad(node.mMinX), startX), inverseX);
+  SimVec x1 = Multiply(Subtract(UnAlignedLoad(node.mMaxX), startX), inverseX);
+  SimVec y0 = Multiply(Subtract(UnAlignedLoad(node.mMinY), startY), inverseY);
+  SimVec y1 = Multiply(Subtract(UnAlignedLoad(node.mMaxY), startY), inverseY);
+  SimVec z0 = Multiply(Subtract(UnAlignedLoad(node.mMinZ), startZ), inverseZ);
+  SimVec z1 = Multiply(Subtract(UnAlignedLoad(node.mMaxZ), startZ), inverseZ);
+
+  SimVec tMin = Max(Max(Min(x0, x1), Min(y0, y1)), Max(Min(z0, z1), Set(real(0.0))));
+  SimVec tMax = Min(Min(Max(x0, x1), Max(y0, y1)), Min(Max(z0, z1), Set(ray.mMaxT)));
+  return (uint)_mm_movemask_ps(LessEqual(tMin, tMax));
+#else
+  uint mask = 0;
+  for (uint i = 0; i < node.mCount; ++i)
+  {
+    const float* mins[3] = {node.mMinX, node.mMinY, node.mMinZ};
+    const float* maxs[3] = {node.mMaxX, node.mMaxY, node.mMaxZ};
+    real tMin = real(0.0);
+    real tMax = ray.mMaxT;
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+      real t0 = (mins[axis][i] - ray.mStart[axis]) * ray.mInverseDirection[axis];
+      real t1 = (maxs[axis][i] - ray.mStart[axis]) * ray.mInverseDirection[axis];
+      tMin = Math::Max(tMin, Math::Min(t0, t1));
+      tMax = Math::Min(tMax, Math::Max(t0, t1));
+    }
+
+    if (tMin <= tMax)
+      mask |= 1 << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::TestNode(const Node& node, const Sphere& sphere)
+{
+#if defined(USESSE)
+  using namespace Math::Simd;
+  SimVec centerX = Set(sphere.mCenter.x);
+  SimVec centerY = Set(sphere.mCenter.y);
+  SimVec centerZ = Set(sphere.mCenter.z);
+
+  // Distance from the center to the closest point on each child's box
+  SimVec dx = Subtract(centerX, Max(UnAlignedLoad(node.mMinX), Min(centerX, UnAlignedLoad(node.mMaxX))));
+  SimVec dy = Subtract(centerY, Max(UnAlignedLoad(node.mMinY), Min(centerY, UnAlignedLoad(node.mMaxY))));
+  SimVec dz = Subtract(centerZ, Max(UnAlignedLoad(node.mMinZ), Min(centerZ, UnAlignedLoad(node.mMaxZ))));
+  SimVec distanceSq = Add(Add(Multiply(dx, dx), Multiply(dy, dy)), Multiply(dz, dz));
+  return (uint)_mm_movemask_ps(LessEqual(distanceSq, Set(sphere.mRadius * sphere.mRadius)));
+#else
+  uint mask = 0;
+  for (uint i = 0; i < node.mCount; ++i)
+  {
+    Vec3 closest = Math::Clamp(sphere.mCenter,
+                               Vec3(node.mMinX[i], node.mMinY[i], node.mMinZ[i]),
+                               Vec3(node.mMaxX[i], node.mMaxY[i], node.mMaxZ[i]));
+    if (LengthSq(sphere.mCenter - closest) <= sphere.mRadius * sphere.mRadius)
+      mask |= 1 << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::TestNode(const Node& node, const FrustumQuery& frustum)
+{
+  // The planes point inwards, so a child is rejected once the corner of its
+  // box furthest along a plane's normal is still behind that plane
+#if defined(USESSE)
+  using namespace Math::Simd;
+  SimVec minX = UnAlignedLoad(node.mMinX);
+  SimVec minY = UnAlignedLoad(node.mMinY);
+  SimVec minZ = UnAlignedLoad(node.mMinZ);
+  SimVec maxX = UnAlignedLoad(node.mMaxX);
+  SimVec maxY = UnAlignedLoad(node.mMaxY);
+  SimVec maxZ = UnAlignedLoad(node.mMaxZ);
+
+  uint mask = 0xF;
+  for (uint i = 0; i < 6 && mask != 0; ++i)
+  {
+    const Vec4& plane = frustum.mPlanes[i];
+    SimVec x = Multiply(plane.x >= real(0.0) ? maxX : minX, Set(plane.x));
+    SimVec y = Multiply(plane.y >= real(0.0) ? maxY : minY, Set(plane.y));
+    SimVec z = Multiply(plane.z >= real(0.0) ? maxZ : minZ, Set(plane.z));
+    SimVec distance = Subtract(Add(Add(x, y), z), Set(plane.w));
+    mask &= (uint)_mm_movemask_ps(GreaterEqual(distance, Set(real(0.0))));
+  }
+  return mask;
+#else
+  uint mask = 0;
+  for (uint i = 0; i < node.mCount; ++i)
+  {
+    bool inside = true;
+    for (uint p = 0; p < 6 && inside; ++p)
+    {
+      const Vec4& plane = frustum.mPlanes[p];
+      Vec3 corner(plane.x >= real(0.0) ? node.mMaxX[i] : node.mMinX[i],
+                  plane.y >= real(0.0) ? node.mMaxY[i] : node.mMinY[i],
+                  plane.z >= real(0.0) ? node.mMaxZ[i] : node.mMinZ[i]);
+      inside = Dot(corner, Vec3(plane.x, plane.y, plane.z)) - plane.w >= real(0.0);
+    }
+
+    if (inside)
+      mask |= 1 << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename ClientDataType>
+template <typename QueryType, typename CallbackType>
+void Qbvh<ClientDataType>::Traverse(const QueryType& query, CallbackType& callback)
+{
+  if (mDirty)
+    Build();
+
+  if (mNodes.Empty())
+    return;
+
+  int stack[cQbvhStackSize];
+  uint stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize != 0)
+  {
+    const Node& node = mNodes[stack[--stackSize]];
+
+    // Unused slots hold stale bounds, so only keep the bits of used slots
+    uint mask = TestNode(node, query) & ((1 << node.mCount) - 1);
+    for (uint i = 0; mask != 0; ++i, mask >>= 1)
+    {
+      if ((mask & 1) == 0)
+        continue;
+
+      int child = node.mChildren[i];
+      if (child >= 0)
+      {
+        ErrorIf(stackSize == cQbvhStackSize, "Qbvh traversal stack overflow.");
+        stack[stackSize++] = child;
+      }
+      else
+      {
+        callback(ChildToLeaf(child));
+      }
+    }
+  }
+}
+
+template <typename ClientDataType>
+int Qbvh<ClientDataType>::LeafToChild(uint leafIndex)
+{
+  return -(int)leafIndex - 1;
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::ChildToLeaf(int child)
+{
+  return (uint)(-child - 1);
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::GetNewProxyIndex()
+{
+  // if there were no free indices already, add a new item to the back
+  // and return that index
+  if (mFreeIndices.Empty())
+  {
+    mLeaves.PushBack();
+    return mLeaves.Size() - 1;
+  }
+
+  // otherwise, take the last free index
+  uint index = mFreeIndices.Back();
+  mFreeIndices.PopBack();
+  return index;
+}
+
+template <typename ClientDataType>
+int Qbvh<ClientDataType>::BuildNode(uint start, uint count, int parent, uint parentSlot)
+{
+  // Children push onto mNodes while recursing, so always access this node by
+  // index rather than holding a reference to it
+  int nodeIndex = (int)mNodes.Size();
+  mNodes.PushBack();
+  mNodes[nodeIndex].mParent = parent;
+  mNodes[nodeIndex].mParentSlot = parentSlot;
+
+  uint groupStarts[4];
+  uint groupCounts[4];
+  uint groupCount = 0;
+
+  if (count <= 4)
+  {
+    for (uint i = 0; i < count; ++i)
+    {
+      groupStarts[i] = start + i;
+      groupCounts[i] = 1;
+    }
+    groupCount = count;
+  }
+  else
+  {
+    // Split in half and then split each half again to get four groups.
+    // With more than 4 items every group ends up with at least one.
+    uint half = Split(start, count);
+    uint firstQuarter = Split(start, half);
+    uint thirdQuarter = Split(start + half, count - half);
+
+    groupStarts[0] = start;
+    groupCounts[0] = firstQuarter;
+    groupStarts[1] = start + firstQuarter;
+    groupCounts[1] = half - firstQuarter;
+    groupStarts[2] = start + half;
+    groupCounts[2] = thirdQuarter;
+    groupStarts[3] = start + half + thirdQuarter;
+    groupCounts[3] = count - half - thirdQuarter;
+    groupCount = 4;
+  }
+
+  mNodes[nodeIndex].mCount = groupCount;
+  for (uint slot = 0; slot < groupCount; ++slot)
+  {
+    if (groupCounts[slot] == 1)
+    {
+      uint leafIndex = mBuildIndices[groupStarts[slot]];
+      Leaf& leaf = mLeaves[leafIndex];
+      leaf.mNode = nodeIndex;
+      leaf.mSlot = slot;
+      mNodes[nodeIndex].SetChild(slot, LeafToChild(leafIndex), leaf.mData.mAabb);
+    }
+    else
+    {
+      int childIndex = BuildNode(groupStarts[slot], groupCounts[slot], nodeIndex, slot);
+      Aabb childAabb = mNodes[childIndex].GetAabb();
+      mNodes[nodeIndex].SetChild(slot, childIndex, childAabb);
+      mSurfaceArea += childAabb.GetSurfaceArea();
+    }
+  }
+
+  return nodeIndex;
+}
+
+template <typename ClientDataType>
+uint Qbvh<ClientDataType>::Split(uint start, uint count)
+{
+  // Split at the median along the axis the centers are most spread out on
+  Aabb centers;
+  centers.SetInvalid();
+  for (uint i = 0; i < count; ++i)
+    centers.Expand(mLeaves[mBuildIndices[start + i]].mData.mAabb.GetCenter());
+
+  Vec3 extents = centers.mMax - centers.mMin;
+  uint axis = 0;
+  if (extents.y > extents[axis])
+    axis = 1;
+  if (extents.z > extents[axis])
+    axis = 2;
+
+  QbvhCentroidSorter<Leaf> sorter(mLeaves.Data(), axis);
+  Sort(mBuildIndices.SubRange(start, count), sorter);
+  return count / 2;
+}
+
+template <typename ClientDataType>
+void Qbvh<ClientDataType>::DrawNode(int nodeIndex, int depth, int level)
+{
+  const Node& node = mNodes[nodeIndex];
+  if (level == -1 || depth == level)
+    gDebugDraw->Add(Debug::Obb(node.GetAabb()).Color(Color::MintCream));
+
+  if (depth == level)
+    return;
+
+  for (uint i = 0; i < node.mCount; ++i)
+  {
+    if (node.mChildren[i] >= 0)
+      DrawNode(node.mChildren[i], depth + 1, level);
+  }
+}
+
+} // namespace Plasma
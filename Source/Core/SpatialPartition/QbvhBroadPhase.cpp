@@ -0,0 +1,196 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+namespace
+{
+
+/// Adds a pair for every proxy the tree reports. When querying with a proxy
+/// that is in the tree, only proxies with a larger index are paired so that
+/// each pair is only reported once (and never with itself).
+struct QbvhPairCallback
+{
+  QbvhPairCallback(QbvhBroadPhase::TreeType& tree, void* clientData, int selfIndex, ClientPairArray& results) :
+      mTree(tree),
+      mClientData(clientData),
+      mSelfIndex(selfIndex),
+      mResults(results)
+  {
+  }
+
+  void operator()(uint proxyIndex)
+  {
+    if ((int)proxyIndex > mSelfIndex)
+      mResults.PushBack(ClientPair(mClientData, mTree.GetClientData(proxyIndex)));
+  }
+
+  QbvhBroadPhase::TreeType& mTree;
+  void* mClientData;
+  int mSelfIndex;
+  ClientPairArray& mResults;
+};
+
+/// Refines every proxy the tree reports with one of the simple cast callbacks.
+template <typename RefineCallbackType>
+struct QbvhCastCallback
+{
+  QbvhCastCallback(QbvhBroadPhase::TreeType& tree, RefineCallbackType& refine, CastDataParam castData) :
+      mTree(tree),
+      mRefine(refine),
+      mCastData(castData)
+  {
+  }
+
+  void operator()(uint proxyIndex)
+  {
+    mRefine.Refine(mTree.GetClientData(proxyIndex), mCastData);
+  }
+
+  QbvhBroadPhase::TreeType& mTree;
+  RefineCallbackType& mRefine;
+  CastDataParam mCastData;
+};
+
+} // namespace
+
+LightningDefineType(QbvhBroadPhase, builder, type)
+{
+}
+
+void QbvhBroadPhase::Serialize(Serializer& stream)
+{
+  IBroadPhase::Serialize(stream);
+  mTree.Serialize(stream);
+}
+
+void QbvhBroadPhase::Draw(int level, uint debugDrawFlags)
+{
+  mTree.Draw(level);
+}
+
+void QbvhBroadPhase::CreateProxy(BroadPhaseProxy& proxy, BroadPhaseData& data)
+{
+  mTree.CreateProxy(proxy, data);
+}
+
+void QbvhBroadPhase::CreateProxies(BroadPhaseObjectArray& objects)
+{
+  BroadPhaseObjectArray::range range = objects.All();
+  for (; !range.Empty(); range.PopFront())
+  {
+    BroadPhaseObject& obj = range.Front();
+    mTree.CreateProxy(*obj.mProxy, obj.mData);
+  }
+}
+
+void QbvhBroadPhase::RemoveProxy(BroadPhaseProxy& proxy)
+{
+  mTree.RemoveProxy(proxy);
+}
+
+void QbvhBroadPhase::RemoveProxies(ProxyHandleArray& proxies)
+{
+  ProxyHandleArray::range range = proxies.All();
+  for (; !range.Empty(); range.PopFront())
+    mTree.RemoveProxy(*range.Front());
+}
+
+void QbvhBroadPhase::UpdateProxy(BroadPhaseProxy& proxy, BroadPhaseData& data)
+{
+  mTree.UpdateProxy(proxy, data);
+}
+
+void QbvhBroadPhase::UpdateProxies(BroadPhaseObjectArray& objects)
+{
+  BroadPhaseObjectArray::range range = objects.All();
+  for (; !range.Empty(); range.PopFront())
+  {
+    BroadPhaseObject& obj = range.Front();
+    mTree.UpdateProxy(*obj.mProxy, obj.mData);
+  }
+}
+
+void QbvhBroadPhase::SelfQuery(ClientPairArray& results)
+{
+  results.Insert(results.End(), mDataPairs.All());
+}
+
+void QbvhBroadPhase::Query(BroadPhaseData& data, ClientPairArray& results)
+{
+  QbvhPairCallback callback(mTree, data.mClientData, -1, results);
+  mTree.QueryAabb(data.mAabb, callback);
+}
+
+void QbvhBroadPhase::BatchQuery(BroadPhaseDataArray& data, ClientPairArray& results)
+{
+  for (uint i = 0; i < data.Size(); ++i)
+    Query(data[i], results);
+}
+
+void QbvhBroadPhase::Construct()
+{
+  mTree.Build();
+}
+
+void QbvhBroadPhase::PrepareForCasts()
+{
+  // The tree is otherwise rebuilt by the first cast after proxies change
+  mTree.Update();
+}
+
+void QbvhBroadPhase::CastRay(CastDataParam castData, ProxyCastResults& results)
+{
+  SimpleRayCallback refine(mCastRayCallBack, &results);
+  QbvhCastCallback<SimpleRayCallback> callback(mTree, refine, castData);
+  mTree.QueryRay(castData.GetRay(), callback);
+}
+
+void QbvhBroadPhase::CastSegment(CastDataParam castData, ProxyCastResults& results)
+{
+  SimpleSegmentCallback refine(mCastSegmentCallBack, &results);
+  QbvhCastCallback<SimpleSegmentCallback> callback(mTree, refine, castData);
+  mTree.QuerySegment(castData.GetSegment(), callback);
+}
+
+void QbvhBroadPhase::CastAabb(CastDataParam castData, ProxyCastResults& results)
+{
+  SimpleAabbCallback refine(mCastAabbCallBack, &results);
+  QbvhCastCallback<SimpleAabbCallback> callback(mTree, refine, castData);
+  mTree.QueryAabb(castData.GetAabb(), callback);
+}
+
+void QbvhBroadPhase::CastSphere(CastDataParam castData, ProxyCastResults& results)
+{
+  SimpleSphereCallback refine(mCastSphereCallBack, &results);
+  QbvhCastCallback<SimpleSphereCallback> callback(mTree, refine, castData);
+  mTree.QuerySphere(castData.GetSphere(), callback);
+}
+
+void QbvhBroadPhase::CastFrustum(CastDataParam castData, ProxyCastResults& results)
+{
+  SimpleFrustumCallback refine(mCastFrustumCallBack, &results);
+  QbvhCastCallback<SimpleFrustumCallback> callback(mTree, refine, castData);
+  mTree.QueryFrustum(castData.GetFrustum(), callback);
+}
+
+void QbvhBroadPhase::RegisterCollisions()
+{
+  mDataPairs.Clear();
+
+  // Rebuild if proxies came or went or refitting has let the tree degrade
+  mTree.Update();
+
+  uint proxyCount = mTree.GetProxyIndexCount();
+  for (uint i = 0; i < proxyCount; ++i)
+  {
+    if (!mTree.IsValid(i))
+      continue;
+
+    QbvhPairCallback callback(mTree, mTree.GetClientData(i), (int)i, mDataPairs);
+    mTree.QueryAabb(mTree.GetAabb(i), callback);
+  }
+}
+
+} // namespace Plasma
@@ -0,0 +1,49 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+/// The BroadPhase interface for the Qbvh. Moving proxies are refit in place
+/// and the self pairs are gathered once per frame in RegisterCollisions.
+class QbvhBroadPhase : public IBroadPhase
+{
+public:
+  LightningDeclareType(QbvhBroadPhase, TypeCopyMode::ReferenceType);
+
+  typedef Qbvh<void*> TreeType;
+
+  virtual void Serialize(Serializer& stream);
+  virtual void Draw(int level, uint debugDrawFlags);
+
+  virtual void CreateProxy(BroadPhaseProxy& proxy, BroadPhaseData& data);
+  virtual void CreateProxies(BroadPhaseObjectArray& objects);
+  virtual void RemoveProxy(BroadPhaseProxy& proxy);
+  virtual void RemoveProxies(ProxyHandleArray& proxies);
+  virtual void UpdateProxy(BroadPhaseProxy& proxy, BroadPhaseData& data);
+  virtual void UpdateProxies(BroadPhaseObjectArray& objects);
+
+  virtual void SelfQuery(ClientPairArray& results);
+  virtual void Query(BroadPhaseData& data, ClientPairArray& results);
+  virtual void BatchQuery(BroadPhaseDataArray& data, ClientPairArray& results);
+
+  virtual void Construct();
+  virtual void PrepareForCasts();
+
+  virtual void CastRay(CastDataParam data, ProxyCastResults& results);
+  virtual void CastSegment(CastDataParam data, ProxyCastResults& results);
+  virtual void CastAabb(CastDataParam data, ProxyCastResults& results);
+  virtual void CastSphere(CastDataParam data, ProxyCastResults& results);
+  virtual void CastFrustum(CastDataParam data, ProxyCastResults& results);
+
+  virtual void RegisterCollisions();
+
+  virtual void Cleanup(){};
+
+private:
+  TreeType mTree;
+
+  ClientPairArray mDataPairs;
+};
+
+} // namespace Plasma
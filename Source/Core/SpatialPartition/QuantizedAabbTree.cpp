@@ -0,0 +1,297 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+namespace
+{
+
+/// Written at the start of a saved tree so that anything else stored in its
+/// place (trees cooked before this one existed) is recognized and skipped.
+const u32 cQuantizedAabbTreeFormat = 0x48564251;
+
+const real cQuantizedMax = real(65535.0);
+
+/// Sorts item indices by the center of their Aabb on one axis.
+struct QuantizedCentroidSorter
+{
+  QuantizedCentroidSorter(const Array<Aabb>& aabbs, uint axis) : mAabbs(aabbs), mAxis(axis)
+  {
+  }
+
+  bool operator()(uint lhs, uint rhs) const
+  {
+    const Aabb& lhsAabb = mAabbs[lhs];
+    const Aabb& rhsAabb = mAabbs[rhs];
+    return (lhsAabb.mMin[mAxis] + lhsAabb.mMax[mAxis]) < (rhsAabb.mMin[mAxis] + rhsAabb.mMax[mAxis]);
+  }
+
+  const Array<Aabb>& mAabbs;
+  uint mAxis;
+};
+
+void DeleteAabbNodes(AabbNode<uint>* node)
+{
+  if (node == nullptr)
+    return;
+
+  DeleteAabbNodes(node->mChild1);
+  DeleteAabbNodes(node->mChild2);
+  delete node;
+}
+
+/// Reads the rest of a StaticAabbTree's root node after its start was read.
+void SkipStaticAabbTreeRoot(Serializer& stream)
+{
+  AabbNode<uint> root;
+  SerializeNode(stream, root);
+  DeleteAabbNodes(SerializeAabbTree<uint>(stream));
+  DeleteAabbNodes(SerializeAabbTree<uint>(stream));
+  stream.EndPolymorphic();
+}
+
+} // namespace
+
+bool QuantizedAabbNode::IsLeaf() const
+{
+  return (mData & cLeafBit) != 0;
+}
+
+uint QuantizedAabbNode::GetItemIndex() const
+{
+  return mData & ~cLeafBit;
+}
+
+uint QuantizedAabbNode::GetSubtreeSize() const
+{
+  return mData;
+}
+
+QuantizedAabbTree::QuantizedAabbTree()
+{
+  Clear();
+}
+
+void QuantizedAabbTree::Serialize(Serializer& stream)
+{
+  if (stream.GetMode() == SerializerMode::Saving)
+  {
+    u32 format = cQuantizedAabbTreeFormat;
+    uint nodeCount = mNodes.Size();
+
+    stream.StartPolymorphic("QuantizedAabbTree");
+    stream.SerializeField("Format", format);
+    stream.SerializeField("AabbMin", mAabb.mMin);
+    stream.SerializeField("AabbMax", mAabb.mMax);
+    stream.SerializeField("ItemCount", mItemCount);
+    stream.SerializeField("NodeCount", nodeCount);
+    if (nodeCount != 0)
+    {
+      stream.ArrayField("Integer",
+                        "Nodes",
+                        (::byte*)mNodes.Data(),
+                        BasicArrayType::Integer,
+                        nodeCount * sizeof(QuantizedAabbNode) / sizeof(u32),
+                        sizeof(u32));
+    }
+    stream.EndPolymorphic();
+    return;
+  }
+
+  Clear();
+
+  PolymorphicNode node;
+  if (!stream.GetPolymorphic(node))
+    return;
+
+  // Text formats know what was stored, binary ones are checked by the format
+  if (!node.TypeName.Empty() && node.TypeName != "QuantizedAabbTree")
+  {
+    stream.EndPolymorphic();
+    return;
+  }
+
+  // Binary streams don't store type names, so an older StaticAabbTree is
+  // recognized by what's in place of the format. Its first word is either the
+  // start of its root node or the end of the (empty) tree
+  u32 format = 0;
+  stream.SerializeField("Format", format);
+  if (format == BinaryEndSignature)
+    return;
+  if (format != cQuantizedAabbTreeFormat)
+  {
+    SkipStaticAabbTreeRoot(stream);
+    stream.EndPolymorphic();
+    return;
+  }
+
+  uint nodeCount = 0;
+  stream.SerializeField("AabbMin", mAabb.mMin);
+  stream.SerializeField("AabbMax", mAabb.mMax);
+  stream.SerializeField("ItemCount", mItemCount);
+  stream.SerializeField("NodeCount", nodeCount);
+
+  // The nodes are plain data so they're read straight into place
+  mNodes.Resize(nodeCount);
+  if (nodeCount != 0)
+  {
+    bool read = stream.ArrayField("Integer",
+                                  "Nodes",
+                                  (::byte*)mNodes.Data(),
+                                  BasicArrayType::Integer,
+                                  nodeCount * sizeof(QuantizedAabbNode) / sizeof(u32),
+                                  sizeof(u32));
+    if (!read)
+    {
+      stream.EndPolymorphic();
+      Clear();
+      return;
+    }
+  }
+  stream.EndPolymorphic();
+
+  Vec3 extents = mAabb.mMax - mAabb.mMin;
+  for (uint i = 0; i < 3; ++i)
+  {
+    mQuantizeScale[i] = cQuantizedMax / extents[i];
+    mDequantizeScale[i] = extents[i] / cQuantizedMax;
+  }
+}
+
+void QuantizedAabbTree::Build(const Array<Aabb>& aabbs)
+{
+  Clear();
+
+  mItemCount = aabbs.Size();
+  if (mItemCount == 0)
+    return;
+
+  mAabb = aabbs[0];
+  for (uint i = 1; i < mItemCount; ++i)
+    mAabb.Combine(aabbs[i]);
+
+  // Pad the bounds so that no item ends up on the clamped edge of the range
+  // and so that a flat axis still has a size to divide by
+  Vec3 padding = (mAabb.mMax - mAabb.mMin) * real(0.0001) + Vec3(real(0.0001));
+  mAabb.mMin -= padding;
+  mAabb.mMax += padding;
+
+  Vec3 extents = mAabb.mMax - mAabb.mMin;
+  for (uint i = 0; i < 3; ++i)
+  {
+    mQuantizeScale[i] = cQuantizedMax / extents[i];
+    mDequantizeScale[i] = extents[i] / cQuantizedMax;
+  }
+
+  mBuildIndices.Resize(mItemCount);
+  for (uint i = 0; i < mItemCount; ++i)
+    mBuildIndices[i] = i;
+
+  // A binary tree with n leaves always has 2n - 1 nodes
+  mNodes.Reserve(mItemCount * 2 - 1);
+  BuildNode(aabbs, 0, mItemCount);
+
+  mBuildIndices.Clear();
+}
+
+void QuantizedAabbTree::Clear()
+{
+  mNodes.Clear();
+  mBuildIndices.Clear();
+  mAabb.Zero();
+  mQuantizeScale = Vec3::cZero;
+  mDequantizeScale = Vec3::cZero;
+  mItemCount = 0;
+}
+
+bool QuantizedAabbTree::Empty() const
+{
+  return mNodes.Empty();
+}
+
+uint QuantizedAabbTree::GetItemCount() const
+{
+  return mItemCount;
+}
+
+const Aabb& QuantizedAabbTree::GetAabb() const
+{
+  return mAabb;
+}
+
+Aabb QuantizedAabbTree::Dequantize(const QuantizedAabbNode& node) const
+{
+  Aabb aabb;
+  for (uint i = 0; i < 3; ++i)
+  {
+    aabb.mMin[i] = mAabb.mMin[i] + real(node.mMin[i]) * mDequantizeScale[i];
+    aabb.mMax[i] = mAabb.mMin[i] + real(node.mMax[i]) * mDequantizeScale[i];
+  }
+  return aabb;
+}
+
+void QuantizedAabbTree::Draw(int level) const
+{
+  // The depth of each node isn't stored, so only leaves or everything can be drawn
+  for (uint i = 0; i < mNodes.Size(); ++i)
+  {
+    const QuantizedAabbNode& node = mNodes[i];
+    if (level == -1 || node.IsLeaf())
+      gDebugDraw->Add(Debug::Obb(Dequantize(node)).Color(Color::MintCream));
+  }
+}
+
+void QuantizedAabbTree::Quantize(Vec3Param point, u16 result[3], bool roundUp) const
+{
+  for (uint i = 0; i < 3; ++i)
+  {
+    real value = (point[i] - mAabb.mMin[i]) * mQuantizeScale[i];
+    value = roundUp ? Math::Ceil(value) + real(1.0) : Math::Floor(value) - real(1.0);
+    result[i] = (u16)Math::Clamp(value, real(0.0), cQuantizedMax);
+  }
+}
+
+void QuantizedAabbTree::BuildNode(const Array<Aabb>& aabbs, uint start, uint count)
+{
+  uint nodeIndex = mNodes.Size();
+  mNodes.PushBack();
+
+  Aabb aabb = aabbs[mBuildIndices[start]];
+  for (uint i = 1; i < count; ++i)
+    aabb.Combine(aabbs[mBuildIndices[start + i]]);
+
+  QuantizedAabbNode& node = mNodes[nodeIndex];
+  Quantize(aabb.mMin, node.mMin, false);
+  Quantize(aabb.mMax, node.mMax, true);
+
+  if (count == 1)
+  {
+    node.mData = mBuildIndices[start] | QuantizedAabbNode::cLeafBit;
+    return;
+  }
+
+  // Split at the median of the centers on the axis they're most spread along
+  Aabb centers;
+  centers.Compute(aabbs[mBuildIndices[start]].GetCenter());
+  for (uint i = 1; i < count; ++i)
+    centers.Expand(aabbs[mBuildIndices[start + i]].GetCenter());
+
+  Vec3 spread = centers.mMax - centers.mMin;
+  uint axis = 0;
+  if (spread[1] > spread[axis])
+    axis = 1;
+  if (spread[2] > spread[axis])
+    axis = 2;
+
+  Sort(mBuildIndices.SubRange(start, count), QuantizedCentroidSorter(aabbs, axis));
+
+  uint leftCount = count / 2;
+  BuildNode(aabbs, start, leftCount);
+  BuildNode(aabbs, start + leftCount, count - leftCount);
+
+  // Pushing the children may have moved the nodes
+  mNodes[nodeIndex].mData = mNodes.Size() - nodeIndex;
+}
+
+} // namespace Plasma
@@ -0,0 +1,83 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+/// A node of a QuantizedAabbTree. The bounds are stored as 16-bit offsets
+/// within the tree's bounds so that a node only takes 16 bytes.
+struct QuantizedAabbNode
+{
+  static const u32 cLeafBit = 0x80000000;
+
+  bool IsLeaf() const;
+  /// The index of the item a leaf was built from.
+  uint GetItemIndex() const;
+  /// How many nodes an internal node's subtree (including itself) takes up.
+  uint GetSubtreeSize() const;
+
+  u16 mMin[3];
+  u16 mMax[3];
+  /// Leaves store their item index with cLeafBit set, internal nodes store
+  /// the size of their subtree.
+  u32 mData;
+};
+
+/// A static bounding volume hierarchy stored as one flat array of nodes in
+/// depth first order. Every node's bounds are quantized to 16 bits relative to
+/// the bounds of the whole tree, and instead of child pointers each internal
+/// node stores the size of its subtree so traversal can skip past it without
+/// a stack. Since the nodes are plain data, a built tree can be cooked into a
+/// file and read back in one block without rebuilding it.
+class QuantizedAabbTree
+{
+public:
+  QuantizedAabbTree();
+
+  /// Saves the tree or loads a tree that was saved. Loading anything else
+  /// (such as a StaticAabbTree cooked by an older version) leaves this tree
+  /// empty so that the owner knows to build it again.
+  void Serialize(Serializer& stream);
+
+  /// Builds the tree over the given aabbs. Queries return the index of each
+  /// aabb that passes.
+  void Build(const Array<Aabb>& aabbs);
+  void Clear();
+
+  bool Empty() const;
+  /// How many items the tree was built over.
+  uint GetItemCount() const;
+  /// The bounds of the whole tree.
+  const Aabb& GetAabb() const;
+
+  /// Calls callback(itemIndex) for every item whose aabb overlaps the given aabb.
+  template <typename CallbackType>
+  void QueryAabb(const Aabb& aabb, CallbackType& callback) const;
+  /// Calls callback(itemIndex) for every item whose aabb the ray hits.
+  template <typename CallbackType>
+  void QueryRay(const Ray& ray, CallbackType& callback) const;
+
+  /// Converts a node's bounds back to (slightly larger) world bounds.
+  Aabb Dequantize(const QuantizedAabbNode& node) const;
+
+  void Draw(int level) const;
+
+private:
+  /// Quantizes a point rounding either down (for mins) or up (for maxes).
+  void Quantize(Vec3Param point, u16 result[3], bool roundUp) const;
+  void BuildNode(const Array<Aabb>& aabbs, uint start, uint count);
+
+  Array<QuantizedAabbNode> mNodes;
+  /// Item indices while building.
+  Array<uint> mBuildIndices;
+
+  Aabb mAabb;
+  /// Quantized units per world unit on each axis (and the inverse).
+  Vec3 mQuantizeScale;
+  Vec3 mDequantizeScale;
+  uint mItemCount;
+};
+
+} // namespace Plasma
+
+#include "Core/SpatialPartition/QuantizedAabbTree.inl"
@@ -0,0 +1,87 @@
+// MIT Licensed (see LICENSE.md).
+
+namespace Plasma
+{
+
+template <typename CallbackType>
+void QuantizedAabbTree::QueryAabb(const Aabb& aabb, CallbackType& callback) const
+{
+  if (mNodes.Empty() || !mAabb.Overlap(aabb))
+    return;
+
+  u16 queryMin[3];
+  u16 queryMax[3];
+  Quantize(aabb.mMin, queryMin, false);
+  Quantize(aabb.mMax, queryMax, true);
+
+  uint nodeCount = mNodes.Size();
+  uint index = 0;
+  while (index < nodeCount)
+  {
+    const QuantizedAabbNode& node = mNodes[index];
+    bool overlaps = node.mMin[0] <= queryMax[0] && node.mMax[0] >= queryMin[0] && node.mMin[1] <= queryMax[1] &&
+                    node.mMax[1] >= queryMin[1] && node.mMin[2] <= queryMax[2] && node.mMax[2] >= queryMin[2];
+
+    if (node.IsLeaf())
+    {
+      if (overlaps)
+        callback(node.GetItemIndex());
+      ++index;
+    }
+    else
+    {
+      // The children directly follow their parent, otherwise skip the subtree
+      index += overlaps ? 1 : node.GetSubtreeSize();
+    }
+  }
+}
+
+template <typename CallbackType>
+void QuantizedAabbTree::QueryRay(const Ray& ray, CallbackType& callback) const
+{
+  if (mNodes.Empty())
+    return;
+
+  // A zero component would divide to infinity and turn the slab test into
+  // 0 * inf = NaN, so use the largest finite value instead
+  Vec3 inverseDirection;
+  for (uint i = 0; i < 3; ++i)
+  {
+    if (ray.Direction[i] == real(0.0))
+      inverseDirection[i] = Math::PositiveMax();
+    else
+      inverseDirection[i] = real(1.0) / ray.Direction[i];
+  }
+
+  uint nodeCount = mNodes.Size();
+  uint index = 0;
+  while (index < nodeCount)
+  {
+    const QuantizedAabbNode& node = mNodes[index];
+    Aabb nodeAabb = Dequantize(node);
+
+    real tMin = real(0.0);
+    real tMax = Math::PositiveMax();
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+      real t0 = (nodeAabb.mMin[axis] - ray.Start[axis]) * inverseDirection[axis];
+      real t1 = (nodeAabb.mMax[axis] - ray.Start[axis]) * inverseDirection[axis];
+      tMin = Math::Max(tMin, Math::Min(t0, t1));
+      tMax = Math::Min(tMax, Math::Max(t0, t1));
+    }
+    bool hit = tMin <= tMax;
+
+    if (node.IsLeaf())
+    {
+      if (hit)
+        callback(node.GetItemIndex());
+      ++index;
+    }
+    else
+    {
+      index += hit ? 1 : node.GetSubtreeSize();
+    }
+  }
+}
+
+} // namespace Plasma
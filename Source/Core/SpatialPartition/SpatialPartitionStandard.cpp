@@ -16,6 +16,7 @@ LightningDefineStaticLibrary(SpatialPartitionLibrary)
   LightningInitializeType(SapBroadPhase);
   LightningInitializeType(DynamicAabbTreeBroadPhase);
   LightningInitializeType(AvlDynamicAabbTreeBroadPhase);
+  LightningInitializeType(QbvhBroadPhase);
   LightningInitializeType(DynamicBroadphasePropertyExtension);
   LightningInitializeType(StaticBroadphasePropertyExtension);
 
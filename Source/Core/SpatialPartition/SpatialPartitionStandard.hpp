@@ -47,6 +47,11 @@ public:
 #include "AabbTreeMethods.hpp"
 #include "StaticAabbTree.hpp"
 #include "StaticAabbTreeBroadPhase.hpp"
+#include "Qbvh.hpp"
+#include "QbvhBroadPhase.hpp"
+#include "QuantizedAabbTree.hpp"
+#include "BroadPhaseRecording.hpp"
 #include "BroadPhasePackage.hpp"
 #include "BroadPhaseCreator.hpp"
 #include "BroadPhaseTracker.hpp"
+#include "BroadPhaseBenchmark.hpp"
@@ -342,7 +342,17 @@ void PlasmaStartup::ProcessJobs()
 {
   PL::gJobs->RunJobsTimeSliced();
 
-  if (PL::gJobs->AreAllJobsCompleted())
+  // Commit packages that user startup loads in the background (nothing else is
+  // running yet, so this can take a bigger slice than during engine updates)
+  ResourceSystem* resources = PL::gResources;
+  resources->UpdateLoading(0.05);
+
+  if (resources->IsLoading(nullptr))
+  {
+    ResourceLoadProgress progress = resources->GetLoadProgress(nullptr);
+    PL::gEngine->LoadingUpdate("Loading", "Content", String(), ProgressType::Normal, progress.GetPercentage());
+  }
+  else if (PL::gJobs->AreAllJobsCompleted())
   {
     NextPhase();
   }
@@ -38,6 +38,12 @@ public:
     file.SetBlock(dataBlock);
   }
 
+  // Read straight out of a mapped file (the mapping must outlive the reader)
+  void Open(MappedFile& mappedFile)
+  {
+    file.SetData(const_cast<::byte*>(mappedFile.Data()), mappedFile.Size(), false);
+  }
+
   void Close()
   {
     file.Close();
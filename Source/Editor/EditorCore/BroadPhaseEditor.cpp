@@ -125,6 +125,18 @@ BroadPhaseEditor::BroadPhaseEditor(Editor* parent) : Composite(parent)
   button1->SetToolTip("Run the test");
   button1->SetSize(Pixels(90, 24));
   ConnectThisTo(button1, Events::ButtonPressed, RunTest);
+
+  TextButton* recordButton = new TextButton(this);
+  recordButton->SetText("Record");
+  recordButton->SetToolTip("Play the game and record every broad phase operation");
+  recordButton->SetSize(Pixels(90, 24));
+  ConnectThisTo(recordButton, Events::ButtonPressed, RecordTest);
+
+  TextButton* benchmarkButton = new TextButton(this);
+  benchmarkButton->SetText("Benchmark Recording");
+  benchmarkButton->SetToolTip("Replay the recording against every broad phase and print the results");
+  benchmarkButton->SetSize(Pixels(90, 24));
+  ConnectThisTo(benchmarkButton, Events::ButtonPressed, BenchmarkRecording);
 }
 
 void BroadPhaseEditor::RunTest(ObjectEvent* event)
@@ -143,13 +155,7 @@ void BroadPhaseEditor::RunTest(ObjectEvent* event)
     return;
   }
 
-  // stop the old game if it was running (and close the old ui)
-  GameSession* oldGame = mActiveGame;
-  if (oldGame != NULL)
-  {
-    mEditor->StopGame();
-    GameSpaceDestroyed(NULL);
-  }
+  StopActiveGame();
 
   // Run the game
   GameSession* game = mEditor->PlayGame(PlayGameOptions::MultipleInstances);
@@ -171,6 +177,74 @@ void BroadPhaseEditor::RunTest(ObjectEvent* event)
   // CreateGraphs(BroadPhase::Static, tracker);
 }
 
+void BroadPhaseEditor::RecordTest(ObjectEvent* event)
+{
+  StopActiveGame();
+
+  // Run the game
+  GameSession* game = mEditor->PlayGame(PlayGameOptions::MultipleInstances);
+  mActiveGame = game;
+
+  Space* gameSpace = game->GetAllSpaces().Front();
+  ConnectThisTo(gameSpace, Events::SpaceDestroyed, GameSpaceDestroyed);
+
+  PhysicsSpace* physicsSpace = gameSpace->has(PhysicsSpace);
+  if (physicsSpace == nullptr)
+  {
+    DoNotifyWarning("Cannot Record", "The game space has no PhysicsSpace.");
+    return;
+  }
+
+  // Record with the same broad phases the space is using
+  BroadPhaseLibrary* library = PL::gBroadPhaseLibrary;
+  BroadPhasePackage* package = new BroadPhasePackage();
+  package->AddBroadPhase(BroadPhase::Static, library->CreateBroadPhase(physicsSpace->mStaticBroadphaseType));
+  package->AddBroadPhase(BroadPhase::Dynamic, library->CreateBroadPhase(physicsSpace->mDynamicBroadphaseType));
+  package->Initialize();
+
+  mRecording.Clear();
+  package->StartRecording(&mRecording);
+
+  // Replace and delete the old broad phase
+  BroadPhasePackage* oldBroadPhase = physicsSpace->ReplaceBroadPhase(package);
+  delete oldBroadPhase;
+}
+
+void BroadPhaseEditor::BenchmarkRecording(ObjectEvent* event)
+{
+  // Stop recording before replaying
+  StopActiveGame();
+
+  if (mRecording.GetEvents().Empty())
+  {
+    DoNotifyWarning("Cannot Benchmark", "Record a game first.");
+    return;
+  }
+
+  // Save the recording so it can also be replayed by the BroadPhaseBenchmark tool
+  String fileName = FilePath::Combine(GetTemporaryDirectory(), "BroadPhaseRecording.bin");
+  Status status;
+  if (mRecording.SaveToFile(status, fileName))
+    PlasmaPrint("Saved broad phase recording to %s\n", fileName.c_str());
+  else
+    DoNotifyWarning("Cannot Save Recording", status.Message);
+
+  BroadPhaseBenchmark benchmark(mRecording);
+  benchmark.RunAll();
+  benchmark.PrintReport();
+}
+
+void BroadPhaseEditor::StopActiveGame()
+{
+  // stop the old game if it was running (and close the old ui)
+  GameSession* oldGame = mActiveGame;
+  if (oldGame != NULL)
+  {
+    mEditor->StopGame();
+    GameSpaceDestroyed(NULL);
+  }
+}
+
 BroadPhaseTracker* BroadPhaseEditor::CreateTracker()
 {
   // Allocate the tracker
@@ -22,6 +22,13 @@ public:
 
 private:
   void RunTest(ObjectEvent* event);
+  /// Plays the game with the space's broad phases recording everything
+  /// that is done to them.
+  void RecordTest(ObjectEvent* event);
+  /// Replays the last recording against every registered broad phase.
+  void BenchmarkRecording(ObjectEvent* event);
+  /// Stops the game started by the editor if it's still running.
+  void StopActiveGame();
   BroadPhaseTracker* CreateTracker();
   void AddBroadPhasesToTracker(BroadPhase::Type type, BroadPhaseTracker* tracker);
   void CreateGraphs(BroadPhase::Type type, BroadPhaseTracker* tracker);
@@ -54,6 +61,7 @@ private:
   StringSource mBroadPhaseNames[BroadPhase::Size];
   StringSource mActiveBroadPhases[BroadPhase::Size];
   Array<HandleOf<Widget>> mActiveWindows;
+  BroadPhaseRecording mRecording;
 };
 
 } // namespace Plasma
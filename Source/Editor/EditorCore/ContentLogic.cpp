@@ -43,6 +43,11 @@ void LoadContentConfig()
 
 	contentSystem->mHistoryEnabled = contentConfig->HistoryEnabled;
 
+	// Build machines can point at a shared cache without editing their config
+	contentSystem->BuildCache.Directory = Environment::GetValue<String>("contentcache", contentConfig->BuildCache);
+	if (contentSystem->BuildCache.IsEnabled())
+		PlasmaPrint("Content build cache directory '%s'\n", contentSystem->BuildCache.Directory.c_str());
+
 	String version = Environment::GetValue<String>("versionoverride", BuildString(GetRevisionNumberString(), "-", GetChangeSetString()));
 
 	// To avoid conflicts of assets of different versions(especially when the
@@ -81,6 +81,19 @@ void GraphicsEngine::Initialize(SystemInitializer& initializer)
   // Need to get translator or mode from Renderer
   mShaderGenerator = CreateLightningShaderGenerator();
 
+  // Translated shaders are kept between runs. The browser file system doesn't
+  // persist, so there is nothing to gain there.
+#if !defined(PlasmaTargetOsEmscripten)
+  ShaderCache& shaderCache = mShaderGenerator->mShaderCache;
+  shaderCache.Directory = Environment::GetValue<String>(
+      "shadercache", FilePath::Combine(GetUserApplicationDirectory(), "ShaderCache"));
+  shaderCache.Prune();
+#endif
+
+  // Allows comparing shader compile times with different numbers of threads
+  mShaderGenerator->mTranslationJobs =
+      Environment::GetValue<uint>("shaderjobs", mShaderGenerator->mTranslationJobs);
+
   ConnectThisTo(PL::gEngine, Events::EngineShutdown, OnEngineShutdown);
 
   ConnectThisTo(PL::gEngine, Events::LoadingStart, StartProgress);
@@ -1288,8 +1301,13 @@ void GraphicsEngine::ForceCompileAllShaders()
     return;
 
   AddShadersJob* addShadersJob = new AddShadersJob(mRendererJobQueue);
+  Timer timer;
   bool compiled = mShaderGenerator->BuildShaders(allShaders, mUniqueComposites, addShadersJob->mShaders);
   ErrorIf(!compiled, "Shaders did not compile after composition.");
+  PlasmaPrint("Compiled %u shaders in %.3fs with %u translation jobs\n",
+              (uint)allShaders.Size(),
+              timer.UpdateAndGetTime(),
+              mShaderGenerator->mTranslationJobs);
 
   // Blocking task is ended in the return exectute of the job,
   // mForceCompileBatchCount cannot be 0 here.
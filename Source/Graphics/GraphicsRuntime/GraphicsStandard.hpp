@@ -57,6 +57,7 @@ public:
 #include "VisibilityFlag.hpp"
 #include "LightningFragment.hpp"
 #include "PlasmaLightningShaderGlslBackend.hpp"
+#include "ShaderCache.hpp"
 #include "LightningShaderGenerator.hpp"
 
 // Some Dependencies
@@ -4,6 +4,55 @@
 
 namespace Plasma
 {
+    // Incremented if the compositor or translation changes in a way that isn't
+    // covered by the build version.
+    const uint cShaderCacheKeyVersion = 1;
+    // Job threads translating shaders while the main thread helps. Translation
+    // jobs never wait on other jobs, but some job threads are left free for
+    // resource loading.
+    const uint cDefaultShaderTranslationJobs = 6;
+
+    // Shader Translation Queue
+    ShaderTranslationQueue::ShaderTranslationQueue(LightningShaderGenerator* generator) :
+        mGenerator(generator),
+        mNext(0)
+    {
+    }
+
+    ShaderTranslationTask* ShaderTranslationQueue::TakeNext()
+    {
+        ShaderTranslationTask* task = nullptr;
+        mLock.Lock();
+        if (mNext < mTasks.Size())
+            task = &mTasks[mNext++];
+        mLock.Unlock();
+        return task;
+    }
+
+    void ShaderTranslationQueue::TranslateAll()
+    {
+        // The passes hold state for the shader being translated, so they can't be
+        // shared between threads
+        ShaderPipelineDescription pipeline;
+        mGenerator->CreatePipelineDescription(pipeline);
+
+        while (ShaderTranslationTask* task = TakeNext())
+            task->mSuccess = mGenerator->TranslateEntry(*task, pipeline);
+    }
+
+    // Shader Translation Job
+    ShaderTranslationJob::ShaderTranslationJob(ShaderTranslationQueue* queue) : mQueue(queue)
+    {
+    }
+
+    void ShaderTranslationJob::Execute()
+    {
+        ZoneScoped;
+        mQueue->TranslateAll();
+        mQueue->mJobsRunning.DecrementCount();
+    }
+
+    // Lightning Shader Generator
     LightningShaderGenerator* CreateLightningShaderGenerator()
     {
         LightningShaderGenerator* shaderGenerator = new LightningShaderGenerator();
@@ -11,7 +60,9 @@ namespace Plasma
         return shaderGenerator;
     }
 
-    LightningShaderGenerator::LightningShaderGenerator() : mFragmentsProject("Fragments")
+    LightningShaderGenerator::LightningShaderGenerator() :
+        mFragmentsProject("Fragments"),
+        mTranslationJobs(cDefaultShaderTranslationJobs)
     {
     }
 
@@ -410,6 +461,11 @@ namespace Plasma
         mFragmentsProject.Clear();
         mFragmentsProject.mProjectName = libraryName;
 
+        // Hash of every fragment source this library is built from (including the
+        // libraries it depends on). Used to key the shader cache.
+        Lightning::Sha1Builder sourceHash;
+        sourceHash.Append(libraryName);
+
         // Add all fragments
         forRange(Resource* resource, fragments.All())
         {
@@ -421,6 +477,8 @@ namespace Plasma
 
             LightningFragment* fragment = static_cast<LightningFragment*>(resource);
             mFragmentsProject.AddCodeFromString(fragment->mText, fragment->GetOrigin(), resource);
+            sourceHash.Append(BuildString(":", fragment->GetOrigin(), ":"));
+            sourceHash.Append(fragment->mText);
         }
 
         // Internal dependencies used to build the internal library
@@ -435,6 +493,7 @@ namespace Plasma
         {
             LightningShaderIRLibraryRef internalDependency = GetInternalLibrary(dependentLibrary);
             internalDependencies->Append(internalDependency);
+            sourceHash.Append(mFragmentSourceHashes.FindValue(internalDependency, String()));
         }
 
         LightningShaderIRLibraryRef fragmentsLibrary =
@@ -474,12 +533,14 @@ namespace Plasma
         {
             if (pendingLib->Name == library->Name)
             {
+                mFragmentSourceHashes.Erase(mPendingToPendingInternal[pendingLib]);
                 mPendingToPendingInternal.Erase(pendingLib);
                 break;
             }
         }
 
         mPendingToPendingInternal.Insert(library, fragmentsLibrary);
+        mFragmentSourceHashes.Insert(fragmentsLibrary, sourceHash.OutputHashString());
 
         LightningFragmentTypeMap& fragmentTypes = mPendingFragmentTypes[library];
         fragmentTypes.Clear();
@@ -519,6 +580,10 @@ namespace Plasma
                     pendingLibrary, nullptr);
                 ErrorIf(internalPendingLibrary == nullptr, "Invalid pending library");
 
+                LightningShaderIRLibraryRef internalCurrentLibrary = GetCurrentInternalLibrary(
+                    library->mSwapFragment.mCurrentLibrary);
+                if (internalCurrentLibrary != nullptr)
+                    mFragmentSourceHashes.Erase(internalCurrentLibrary);
                 mCurrentToInternal.Erase(library->mSwapFragment.mCurrentLibrary);
                 mCurrentToInternal.Insert(pendingLibrary, internalPendingLibrary);
                 mPendingToPendingInternal.Erase(pendingLibrary);
@@ -584,29 +649,56 @@ namespace Plasma
     {
 	    ZoneScoped;
         ProfileScopeFunction();
-        // @Nate: Build a description of the pipeline tools to run.
-        // This could be cached and down the line should probably be
-        // split up to deal with multiple libraries and caching.
+        // Only used here for the settings, every translation worker creates its own.
         ShaderPipelineDescription pipelineDescription;
-#if !defined(PlasmaDebug)
-        pipelineDescription.mToolPasses.PushBack(new SpirVSpecializationConstantPass());
-        pipelineDescription.mToolPasses.PushBack(new SpirVOptimizerPass());
-#endif
-        pipelineDescription.mDebugPasses.PushBack(new SpirVValidatorPass());
-        PlasmaLightningShaderGlslBackend* backend = new PlasmaLightningShaderGlslBackend();
-        pipelineDescription.mBackend = backend;
-
-#ifdef PlasmaTargetOsEmscripten
-  backend->mTargetVersion = 300;
-  backend->mTargetGlslEs = true;
-#endif
+        CreatePipelineDescription(pipelineDescription);
+        LightningShaderIRBackend* pipelineBackend = pipelineDescription.mBackend;
+        PlasmaLightningShaderGlslBackend* backend = static_cast<PlasmaLightningShaderGlslBackend*>(pipelineBackend);
 
         LightningShaderIRCompositor compositor;
 
         LightningShaderIRLibraryRef fragmentsLibrary = GetCurrentInternalProjectLibrary();
 
+        // Shaders found in the shader cache skip compositing and translation.
+        // Composite definitions are only requested for debugging, so nothing
+        // is cached then.
+        bool useCache = mShaderCache.IsEnabled() && compositeShaderDefs == nullptr;
+        String settingsKey;
+        if (useCache)
+        {
+            bool optimized = !pipelineDescription.mToolPasses.Empty();
+            settingsKey = String::Format("%u:%s:%s:%d:%d:%d:%s",
+                                         cShaderCacheKeyVersion,
+                                         GetRevisionNumberString(),
+                                         GetChangeSetString(),
+                                         backend->mTargetVersion,
+                                         (int)backend->mTargetGlslEs,
+                                         (int)optimized,
+                                         mFragmentSourceHashes.FindValue(fragmentsLibrary, String()).c_str());
+        }
+
         Array<Shader*> shaderArray;
-        shaderArray.Append(shaders.All());
+        Array<String> cacheKeys;
+        uint cacheHits = 0;
+        forRange(Shader* shader, shaders.All())
+        {
+            String cacheKey;
+            if (useCache)
+            {
+                cacheKey = GetShaderCacheKey(shader, composites, settingsKey);
+                ShaderEntry entry(shader);
+                if (mShaderCache.Load(cacheKey, entry))
+                {
+                    shaderEntries.PushBack(entry);
+                    shader->mSentToRenderer = true;
+                    ++cacheHits;
+                    continue;
+                }
+            }
+
+            shaderArray.PushBack(shader);
+            cacheKeys.PushBack(cacheKey);
+        }
 
         // Value should not be very large to prevent unnecessary memory consumption to
         // compile.
@@ -712,36 +804,118 @@ namespace Plasma
                 return false;
             }
 
+            // Translating to the backend only reads the shader library, so the
+            // entries are translated in parallel
+            ShaderTranslationQueue queue(this);
             for (size_t i = entryStartIndex; i < shaderEntries.Size(); ++i)
             {
                 ShaderEntry& entry = shaderEntries[i];
 
-                LightningShaderIRType* vertexShader = shaderLibrary->FindType(entry.mVertexShader);
-                LightningShaderIRType* geometryShader = shaderLibrary->FindType(entry.mGeometryShader);
-                LightningShaderIRType* pixelShader = shaderLibrary->FindType(entry.mPixelShader);
-                ErrorIf(vertexShader == nullptr || pixelShader == nullptr, "Invalid shader entry");
-
-                bool success = true;
-                Array<TranslationPassResultRef> vertexPipelineResults;
-                success &= CompilePipeline(vertexShader, pipelineDescription, vertexPipelineResults);
+                ShaderTranslationTask& task = queue.mTasks.PushBack();
+                task.mEntry = &entry;
+                task.mVertexShader = shaderLibrary->FindType(entry.mVertexShader);
+                task.mGeometryShader = shaderLibrary->FindType(entry.mGeometryShader);
+                task.mPixelShader = shaderLibrary->FindType(entry.mPixelShader);
+                ErrorIf(task.mVertexShader == nullptr || task.mPixelShader == nullptr, "Invalid shader entry");
+            }
 
-                Array<TranslationPassResultRef> geometryPipelineResults;
-                if (geometryShader != nullptr)
-                    success &= CompilePipeline(geometryShader, pipelineDescription, geometryPipelineResults);
+            uint jobCount = 0;
+            if (ThreadingEnabled)
+                jobCount = Math::Min(mTranslationJobs, (uint)queue.mTasks.Size() - 1);
+            for (uint i = 0; i < jobCount; ++i)
+            {
+                queue.mJobsRunning.IncrementCount();
+                PL::gJobs->AddJob(new ShaderTranslationJob(&queue));
+            }
 
-                Array<TranslationPassResultRef> pixelPipelineResults;
-                success &= CompilePipeline(pixelShader, pipelineDescription, pixelPipelineResults);
+            // Help translate, then wait for the jobs to finish before the shader
+            // library is released
+            queue.TranslateAll();
+            queue.mJobsRunning.Wait();
 
-                if (!success)
+            forRange(ShaderTranslationTask& task, queue.mTasks.All())
+            {
+                if (!task.mSuccess)
                     return false;
+            }
 
-                entry.mVertexShader = vertexPipelineResults.Back()->mByteStream.ToString();
-                if (geometryShader != nullptr)
-                    entry.mGeometryShader = geometryPipelineResults.Back()->mByteStream.ToString();
-                entry.mPixelShader = pixelPipelineResults.Back()->mByteStream.ToString();
+            if (useCache)
+            {
+                for (size_t i = entryStartIndex; i < shaderEntries.Size(); ++i)
+                    mShaderCache.Store(cacheKeys[startIndex + (i - entryStartIndex)], shaderEntries[i]);
             }
         }
 
+        if (cacheHits != 0)
+            PlasmaPrint("Loaded %u of %u shaders from the shader cache\n", cacheHits, (uint)shaders.Size());
+
+        return true;
+    }
+
+    String LightningShaderGenerator::GetShaderCacheKey(Shader* shader,
+                                                       HashMap<String, UniqueComposite>& composites,
+                                                       StringParam settingsKey)
+    {
+        Lightning::Sha1Builder builder;
+        builder.Append(settingsKey);
+        builder.Append(BuildString(":", shader->mName, ":", shader->mCoreVertex, ":", shader->mRenderPass, ":"));
+
+        // Same fragments the compositor is given
+        if (composites.ContainsKey(shader->mComposite))
+        {
+            forRange(String fragmentName, composites[shader->mComposite].mFragmentNames.All())
+                builder.Append(BuildString(fragmentName, ","));
+        }
+        else
+        {
+            builder.Append(shader->mComposite);
+        }
+
+        return builder.OutputHashString();
+    }
+
+    void LightningShaderGenerator::CreatePipelineDescription(ShaderPipelineDescription& pipeline)
+    {
+        // @Nate: Build a description of the pipeline tools to run.
+        // This could be cached and down the line should probably be
+        // split up to deal with multiple libraries and caching.
+#if !defined(PlasmaDebug)
+        pipeline.mToolPasses.PushBack(new SpirVSpecializationConstantPass());
+        pipeline.mToolPasses.PushBack(new SpirVOptimizerPass());
+#endif
+        pipeline.mDebugPasses.PushBack(new SpirVValidatorPass());
+        PlasmaLightningShaderGlslBackend* backend = new PlasmaLightningShaderGlslBackend();
+        pipeline.mBackend = backend;
+
+#ifdef PlasmaTargetOsEmscripten
+  backend->mTargetVersion = 300;
+  backend->mTargetGlslEs = true;
+#endif
+    }
+
+    bool LightningShaderGenerator::TranslateEntry(ShaderTranslationTask& task, ShaderPipelineDescription& pipeline)
+    {
+        ZoneScoped;
+        ShaderEntry& entry = *task.mEntry;
+
+        bool success = true;
+        Array<TranslationPassResultRef> vertexPipelineResults;
+        success &= CompilePipeline(task.mVertexShader, pipeline, vertexPipelineResults);
+
+        Array<TranslationPassResultRef> geometryPipelineResults;
+        if (task.mGeometryShader != nullptr)
+            success &= CompilePipeline(task.mGeometryShader, pipeline, geometryPipelineResults);
+
+        Array<TranslationPassResultRef> pixelPipelineResults;
+        success &= CompilePipeline(task.mPixelShader, pipeline, pixelPipelineResults);
+
+        if (!success)
+            return false;
+
+        entry.mVertexShader = vertexPipelineResults.Back()->mByteStream.ToString();
+        if (task.mGeometryShader != nullptr)
+            entry.mGeometryShader = geometryPipelineResults.Back()->mByteStream.ToString();
+        entry.mPixelShader = pixelPipelineResults.Back()->mByteStream.ToString();
         return true;
     }
 
@@ -20,6 +20,48 @@ public:
   String mResourceName;
 };
 
+class LightningShaderGenerator;
+
+// A composited shader being translated to the backend.
+struct ShaderTranslationTask
+{
+  ShaderEntry* mEntry;
+  LightningShaderIRType* mVertexShader;
+  LightningShaderIRType* mGeometryShader;
+  LightningShaderIRType* mPixelShader;
+  bool mSuccess;
+};
+
+// Shader entries of a batch translated by the main thread and any number of
+// shader translation jobs.
+class ShaderTranslationQueue
+{
+public:
+  ShaderTranslationQueue(LightningShaderGenerator* generator);
+
+  // Returns null if every task has been taken.
+  ShaderTranslationTask* TakeNext();
+  // Translates tasks until none are left.
+  void TranslateAll();
+
+  LightningShaderGenerator* mGenerator;
+  // Never resized once translation starts.
+  Array<ShaderTranslationTask> mTasks;
+  size_t mNext;
+  ThreadLock mLock;
+  CountdownEvent mJobsRunning;
+};
+
+class ShaderTranslationJob : public Job
+{
+public:
+  ShaderTranslationJob(ShaderTranslationQueue* queue);
+
+  void Execute() override;
+
+  ShaderTranslationQueue* mQueue;
+};
+
 class LightningShaderGenerator : public Lightning::EventHandler
 {
 public:
@@ -46,9 +88,16 @@ public:
                     HashMap<String, UniqueComposite>& composites,
                     Array<ShaderEntry>& shaderEntries,
                     Array<ShaderDefinition>* compositeShaderDefs = nullptr);
+  // Creates the passes that turn a shader type into backend source.
+  void CreatePipelineDescription(ShaderPipelineDescription& pipeline);
+  // Safe to call from multiple threads with different pipelines as long as the
+  // shader library isn't modified.
+  bool TranslateEntry(ShaderTranslationTask& task, ShaderPipelineDescription& pipeline);
   bool CompilePipeline(LightningShaderIRType* shaderType,
                        ShaderPipelineDescription& pipeline,
                        Array<TranslationPassResultRef>& pipelineResults);
+  // Hash of everything a shader's translated source depends on.
+  String GetShaderCacheKey(Shader* shader, HashMap<String, UniqueComposite>& composites, StringParam settingsKey);
 
   ShaderInput
   CreateShaderInput(StringParam fragmentName, StringParam inputName, ShaderInputType::Enum type, AnyParam value);
@@ -88,6 +137,15 @@ public:
   HashMap<Library*, LightningFragmentTypeMap> mPendingFragmentTypes;
 
   HashMap<String, u32> mSamplerAttributeValues;
+
+  // Job threads used to translate composited shaders (0 translates everything
+  // on the calling thread).
+  uint mTranslationJobs;
+
+  // Translated shaders from previous runs. Disabled unless a directory is set.
+  ShaderCache mShaderCache;
+  // Hash of the fragment sources each internal fragment library was built from.
+  HashMap<LightningShaderIRLibrary*, String> mFragmentSourceHashes;
 };
 
 } // namespace Plasma
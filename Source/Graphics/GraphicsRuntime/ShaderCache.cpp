@@ -0,0 +1,206 @@
+// MIT Licensed (see LICENSE.md).
+
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+namespace
+{
+const uint ShaderCacheFileId = 'pshc';
+// Incremented if the layout of an entry changes.
+const uint cShaderCacheFileVersion = 1;
+const u64 cDefaultShaderCacheSize = 256 * 1024 * 1024;
+
+struct ShaderCacheFile
+{
+  String mPath;
+  TimeType mLastUsed;
+  u64 mSize;
+};
+
+struct SortByLeastRecentlyUsed
+{
+  bool operator()(const ShaderCacheFile& left, const ShaderCacheFile& right)
+  {
+    return left.mLastUsed < right.mLastUsed;
+  }
+};
+
+void WriteSized(Array<::byte>& buffer, StringParam value)
+{
+  uint size = (uint)value.SizeInBytes();
+  size_t offset = buffer.Size();
+  buffer.Resize(offset + sizeof(size) + size);
+  memcpy(buffer.Data() + offset, &size, sizeof(size));
+  memcpy(buffer.Data() + offset + sizeof(size), value.Data(), size);
+}
+
+bool ReadSized(const ::byte* data, size_t size, size_t& offset, String& value)
+{
+  uint valueSize = 0;
+  if (offset + sizeof(valueSize) > size)
+    return false;
+  memcpy(&valueSize, data + offset, sizeof(valueSize));
+  offset += sizeof(valueSize);
+
+  if (offset + valueSize > size)
+    return false;
+  value = String((cstr)data + offset, valueSize);
+  offset += valueSize;
+  return true;
+}
+} // namespace
+
+ShaderCache::ShaderCache() : MaxSizeInBytes(cDefaultShaderCacheSize), mHits(0), mMisses(0)
+{
+}
+
+bool ShaderCache::IsEnabled()
+{
+  return !Directory.Empty();
+}
+
+bool ShaderCache::Load(StringParam key, ShaderEntry& entry)
+{
+  if (!IsEnabled() || key.Empty())
+    return false;
+
+  String entryPath = GetEntryPath(key);
+  MappedFile file;
+  if (!FileExists(entryPath) || !file.Open(entryPath, FileAccessPattern::Sequential))
+  {
+    ++mMisses;
+    return false;
+  }
+
+  const ::byte* data = file.Data();
+  size_t size = file.Size();
+  size_t checkedSize = size - Lightning::Sha1Builder::Sha1ByteSize;
+  size_t offset = 0;
+
+  uint header[2];
+  String storedKey, vertexShader, geometryShader, pixelShader;
+  bool valid = size > sizeof(header) + Lightning::Sha1Builder::Sha1ByteSize;
+  if (valid)
+  {
+    memcpy(header, data, sizeof(header));
+    offset += sizeof(header);
+    valid = header[0] == ShaderCacheFileId && header[1] == cShaderCacheFileVersion &&
+            ReadSized(data, checkedSize, offset, storedKey) && storedKey == key &&
+            ReadSized(data, checkedSize, offset, vertexShader) &&
+            ReadSized(data, checkedSize, offset, geometryShader) &&
+            ReadSized(data, checkedSize, offset, pixelShader) && offset == checkedSize;
+  }
+
+  if (valid)
+  {
+    ::byte checksum[Lightning::Sha1Builder::Sha1ByteSize];
+    Lightning::Sha1Builder builder;
+    builder.Append(data, checkedSize);
+    builder.OutputHash(checksum);
+    valid = memcmp(checksum, data + checkedSize, sizeof(checksum)) == 0;
+  }
+
+  file.Close();
+
+  if (!valid)
+  {
+    PlasmaPrint("Discarding invalid shader cache entry '%s'\n", entryPath.c_str());
+    DeleteFile(entryPath);
+    ++mMisses;
+    return false;
+  }
+
+  entry.mVertexShader = vertexShader;
+  entry.mGeometryShader = geometryShader;
+  entry.mPixelShader = pixelShader;
+
+  // The modified time is used as the last time the entry was used for pruning
+  SetFileToCurrentTime(entryPath);
+  ++mHits;
+  return true;
+}
+
+void ShaderCache::Store(StringParam key, ShaderEntry& entry)
+{
+  if (!IsEnabled() || key.Empty())
+    return;
+
+  Array<::byte> buffer;
+  uint header[2] = {ShaderCacheFileId, cShaderCacheFileVersion};
+  buffer.Resize(sizeof(header));
+  memcpy(buffer.Data(), header, sizeof(header));
+  WriteSized(buffer, key);
+  WriteSized(buffer, entry.mVertexShader);
+  WriteSized(buffer, entry.mGeometryShader);
+  WriteSized(buffer, entry.mPixelShader);
+
+  size_t checkedSize = buffer.Size();
+  buffer.Resize(checkedSize + Lightning::Sha1Builder::Sha1ByteSize);
+  Lightning::Sha1Builder builder;
+  builder.Append(buffer.Data(), checkedSize);
+  builder.OutputHash(buffer.Data() + checkedSize);
+
+  String entryPath = GetEntryPath(key);
+  CreateDirectoryAndParents(FilePath::GetDirectoryPath(entryPath));
+
+  // Written to a unique file and moved into place so another running instance
+  // never reads a partial entry
+  String tempFile = String::Format("%s.%llx", entryPath.c_str(), (unsigned long long)GenerateUniqueId64());
+  if (WriteToFile(tempFile.c_str(), buffer.Data(), buffer.Size()) != buffer.Size() || !MoveFile(entryPath, tempFile))
+    DeleteFile(tempFile);
+}
+
+void ShaderCache::Prune()
+{
+  if (!IsEnabled() || !DirectoryExists(Directory))
+    return;
+
+  ZoneScoped;
+  ProfileScopeFunction();
+
+  Array<ShaderCacheFile> files;
+  u64 totalSize = 0;
+  for (FileRange folders(Directory); !folders.Empty(); folders.PopFront())
+  {
+    String folder = folders.FrontEntry().GetFullPath();
+    if (!DirectoryExists(folder))
+      continue;
+
+    for (FileRange entries(folder); !entries.Empty(); entries.PopFront())
+    {
+      ShaderCacheFile& file = files.PushBack();
+      file.mPath = entries.FrontEntry().GetFullPath();
+      file.mLastUsed = GetFileModifiedTime(file.mPath);
+      file.mSize = GetFileSize(file.mPath);
+      totalSize += file.mSize;
+    }
+  }
+
+  if (totalSize <= MaxSizeInBytes)
+    return;
+
+  Sort(files.All(), SortByLeastRecentlyUsed());
+
+  uint deleted = 0;
+  for (uint i = 0; i < files.Size() && totalSize > MaxSizeInBytes; ++i)
+  {
+    if (DeleteFile(files[i].mPath))
+    {
+      totalSize -= files[i].mSize;
+      ++deleted;
+    }
+  }
+
+  PlasmaPrint("Pruned %u shader cache entries from '%s'\n", deleted, Directory.c_str());
+}
+
+String ShaderCache::GetEntryPath(StringParam key)
+{
+  // Spread the entries over sub folders so no one folder gets too large
+  String prefix = key.SubStringFromByteIndices(0, 2);
+  return FilePath::Combine(Directory, prefix, BuildString(key, ".shader"));
+}
+
+} // namespace Plasma
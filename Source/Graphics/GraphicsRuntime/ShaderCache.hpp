@@ -0,0 +1,47 @@
+// MIT Licensed (see LICENSE.md).
+
+#pragma once
+
+namespace Plasma
+{
+
+/// Stores the translated source of composited shaders on disk so that they
+/// don't have to be composited, translated to spir-v, optimized and cross
+/// compiled again the next time the engine starts. Entries are keyed by a hash
+/// of everything the output depends on (see
+/// LightningShaderGenerator::GetShaderCacheKey).
+///
+/// Each entry is one file holding the key and a checksum of the stored shaders
+/// so that a corrupt or truncated entry is never used. An entry's modified time
+/// is updated every time it's used and the least recently used entries are
+/// deleted by Prune once the cache is larger than MaxSizeInBytes.
+class ShaderCache
+{
+public:
+  ShaderCache();
+
+  /// Where entries are stored. The cache is disabled while this is empty.
+  String Directory;
+  u64 MaxSizeInBytes;
+
+  bool IsEnabled();
+
+  /// Fills out the translated shaders of the entry. Returns false if there is
+  /// no valid entry for the key.
+  bool Load(StringParam key, ShaderEntry& entry);
+
+  /// Writes the translated shaders of the entry.
+  void Store(StringParam key, ShaderEntry& entry);
+
+  /// Deletes the least recently used entries until the cache fits in
+  /// MaxSizeInBytes.
+  void Prune();
+
+  uint mHits;
+  uint mMisses;
+
+private:
+  String GetEntryPath(StringParam key);
+};
+
+} // namespace Plasma
@@ -12,10 +12,10 @@ public:
   {
     SpriteSource* source = new SpriteSource();
     source->Name = entry.Name;
-    DataBlock dataBlock = ReadFileIntoDataBlock(entry.FullPath.c_str());
-    LoadSprite(source, entry, dataBlock);
+    MappedFile mappedFile;
+    mappedFile.Open(entry.FullPath, FileAccessPattern::Sequential);
+    LoadSprite(source, entry, GetMappedBlock(mappedFile));
     SpriteSourceManager::GetInstance()->AddResource(entry, source);
-    FreeBlock(dataBlock);
     return source;
   }
 
@@ -33,9 +33,15 @@ public:
   {
     SpriteSource* source = (SpriteSource*)resource;
     source->Unload();
-    DataBlock dataBlock = ReadFileIntoDataBlock(entry.FullPath.c_str());
-    LoadSprite(source, entry, dataBlock);
-    FreeBlock(dataBlock);
+    MappedFile mappedFile;
+    mappedFile.Open(entry.FullPath, FileAccessPattern::Sequential);
+    LoadSprite(source, entry, GetMappedBlock(mappedFile));
+  }
+
+  // The image is decoded straight out of the mapped file
+  DataBlock GetMappedBlock(MappedFile& mappedFile)
+  {
+    return DataBlock(const_cast<::byte*>(mappedFile.Data()), mappedFile.Size());
   }
 
   void LoadSprite(SpriteSource* source, ResourceEntry& entry, DataBlock block)
@@ -139,11 +145,11 @@ void SpriteSource::LoadSourceImage(Status& status, Image* image)
     return;
   }
 
-  DataBlock block = ReadFileIntoDataBlock(fullPath.c_str());
-
-  LoadImage(status, block.Data, block.Size, image);
+  MappedFile mappedFile;
+  if (!mappedFile.Open(fullPath, FileAccessPattern::Sequential, &status))
+    return;
 
-  FreeBlock(block);
+  LoadImage(status, const_cast<::byte*>(mappedFile.Data()), mappedFile.Size(), image);
 }
 
 HandleOf<Texture> SpriteSource::GetAtlasTexture()
@@ -12,15 +12,20 @@ void LoadTexture(StringParam filename, Texture* texture)
   texture->mImageData = nullptr;
   texture->mTotalDataSize = 0;
 
-  File file;
-  file.Open(filename.c_str(), FileMode::Read, FileAccessPattern::Sequential);
+  MappedFile file;
+  if (!file.Open(filename, FileAccessPattern::Sequential))
+    return;
+
+  const ::byte* data = file.Data();
+  size_t size = file.Size();
+  size_t offset = 0;
 
-  if (!file.IsOpen())
+  if (size < sizeof(TextureHeader))
     return;
 
   TextureHeader header;
-  header.mFileId = 0;
-  Read(file, header);
+  memcpy(&header, data, sizeof(header));
+  offset += sizeof(header);
 
   if (header.mFileId != TextureFileId)
     return;
@@ -31,30 +36,28 @@ void LoadTexture(StringParam filename, Texture* texture)
     // If a texture is compressed, the data file will have an uncompressed
     // version of the texture after the compressed data, including a separate
     // file header
-    uint dataSizeToSkip = header.mMipCount * sizeof(MipHeader) + header.mTotalDataSize;
-    file.Seek(dataSizeToSkip, SeekOrigin::Current);
+    offset += (size_t)header.mMipCount * sizeof(MipHeader) + header.mTotalDataSize;
+    if (offset + sizeof(TextureHeader) > size)
+      return;
 
     // Read new header
-    header.mFileId = 0;
-    Read(file, header);
+    memcpy(&header, data + offset, sizeof(header));
+    offset += sizeof(header);
 
     if (header.mFileId != TextureFileId)
       return;
   }
 
+  size_t mipHeadersSize = (size_t)header.mMipCount * sizeof(MipHeader);
+  if (header.mMipCount == 0 || offset + mipHeadersSize + header.mTotalDataSize > size)
+    return;
+
+  // The renderer takes ownership of the mip headers and image data when the
+  // texture is uploaded, so they are copied straight out of the mapping once
   MipHeader* mipHeaders = new MipHeader[header.mMipCount];
   ::byte* imageData = new ::byte[header.mTotalDataSize];
-
-  Status status;
-  file.Read(status, (::byte*)mipHeaders, header.mMipCount * sizeof(MipHeader));
-  file.Read(status, imageData, header.mTotalDataSize);
-
-  if (status.Failed())
-  {
-    delete[] mipHeaders;
-    delete[] imageData;
-    return;
-  }
+  memcpy(mipHeaders, data + offset, mipHeadersSize);
+  memcpy(imageData, data + offset + mipHeadersSize, header.mTotalDataSize);
 
   // Pull size off of top level
   texture->mWidth = mipHeaders->mWidth;
@@ -95,4 +98,27 @@ HandleOf<Resource> TextureLoader::LoadFromBlock(ResourceEntry& entry)
   return nullptr;
 }
 
+bool TextureLoader::SupportsThreadedLoad()
+{
+  return true;
+}
+
+Resource* TextureLoader::PrepareFromFile(ResourceEntry& entry)
+{
+  // Only reads the file, the renderer upload happens when the texture is added
+  Texture* texture = new Texture();
+  LoadTexture(entry.FullPath, texture);
+  return texture;
+}
+
+HandleOf<Resource> TextureLoader::CommitFromFile(ResourceEntry& entry, Resource* prepared)
+{
+  if (prepared == nullptr)
+    return nullptr;
+
+  Texture* texture = (Texture*)prepared;
+  TextureManager::GetInstance()->AddResource(entry, texture);
+  return texture;
+}
+
 } // namespace Plasma
@@ -11,6 +11,9 @@ public:
   HandleOf<Resource> LoadFromFile(ResourceEntry& entry) override;
   void ReloadFromFile(Resource* resource, ResourceEntry& entry) override;
   HandleOf<Resource> LoadFromBlock(ResourceEntry& entry) override;
+  bool SupportsThreadedLoad() override;
+  Resource* PrepareFromFile(ResourceEntry& entry) override;
+  HandleOf<Resource> CommitFromFile(ResourceEntry& entry, Resource* prepared) override;
 };
 
 } // namespace Plasma
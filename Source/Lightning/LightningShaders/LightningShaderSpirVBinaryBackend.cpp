@@ -94,6 +94,10 @@ void LightningShaderToSpirVContext::BuildTypeIdentifierName(ILightningShaderIR*
     builder.Append(" ");
 }
 
+LightningShaderSpirVBinaryBackend::LightningShaderSpirVBinaryBackend() : mLastLibrary(nullptr)
+{
+}
+
 LightningShaderSpirVBinaryBackend::~LightningShaderSpirVBinaryBackend()
 {
   Clear();
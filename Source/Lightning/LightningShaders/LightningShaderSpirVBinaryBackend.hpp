@@ -34,6 +34,7 @@ public:
 class LightningShaderSpirVBinaryBackend
 {
 public:
+  LightningShaderSpirVBinaryBackend();
   ~LightningShaderSpirVBinaryBackend();
 
   void TranslateType(LightningShaderIRType* type, ShaderStreamWriter& writer);
@@ -127,7 +128,9 @@ private:
   Array<ILightningShaderIR*> mOwnedInstructions;
   Array<EntryPointInfo*> mOwnedEntryPoints;
   LateBoundFunctionMap mExtraLateBoundFunctions;
-  LightningShaderIRLibraryRef mLastLibrary;
+  // Not a reference so that translating types from the same library on
+  // multiple threads never modifies the library.
+  LightningShaderIRLibrary* mLastLibrary;
 };
 
 } // namespace Plasma
@@ -465,6 +465,7 @@ LightningDefineType(NetChannelType, builder, type)
   LightningBindGetterSetterProperty(ReliabilityMode);
   LightningBindGetterSetterProperty(TransferMode);
   LightningBindGetterSetterProperty(AccurateTimestampOnChange);
+  LightningBindGetterSetterProperty(BaselineDelta);
 }
 
 NetChannelType::NetChannelType(const String& name) : ReplicaChannelType(name)
@@ -503,6 +504,7 @@ void NetChannelType::ResetConfig()
     SetReplicateOnOffline();
     SetSerializationMode();
     SetTransferMode();
+    SetBaselineDelta();
   }
 
   // Set runtime config options
@@ -533,6 +535,7 @@ void NetChannelType::SetConfig(NetChannelConfig* netChannelConfig)
     SetReplicateOnOffline(netChannelConfig->mReplicateOnOffline);
     SetSerializationMode(netChannelConfig->mSerializationMode);
     SetTransferMode(netChannelConfig->mTransferMode);
+    SetBaselineDelta(netChannelConfig->mBaselineDelta);
   }
 
   // Set runtime config options
@@ -819,6 +822,25 @@ bool NetChannelType::GetAccurateTimestampOnChange() const
   return ReplicaChannelType::GetAccurateTimestampOnChange();
 }
 
+void NetChannelType::SetBaselineDelta(bool baselineDelta)
+{
+  // Already valid?
+  if (ReplicaChannelType::IsValid())
+  {
+    // Unable to modify configuration
+    DoNotifyError("NetChannelType",
+                  "Unable to modify this NetChannelType configuration option "
+                  "at game runtime");
+    return;
+  }
+
+  ReplicaChannelType::SetBaselineDelta(baselineDelta);
+}
+bool NetChannelType::GetBaselineDelta() const
+{
+  return ReplicaChannelType::GetBaselineDelta();
+}
+
 //                              NetChannelConfig //
 
 LightningDefineType(NetChannelConfig, builder, type)
@@ -852,6 +874,7 @@ LightningDefineType(NetChannelConfig, builder, type)
   LightningBindFieldProperty(mReliabilityMode);
   LightningBindFieldProperty(mTransferMode);
   LightningBindFieldProperty(mAccurateTimestampOnChange);
+  LightningBindFieldProperty(mBaselineDelta);
 }
 
 void NetChannelConfig::Serialize(Serializer& stream)
@@ -876,6 +899,7 @@ void NetChannelConfig::Serialize(Serializer& stream)
   SerializeEnumNameDefault(ReliabilityMode, mReliabilityMode, ReliabilityMode::Reliable);
   SerializeEnumNameDefault(TransferMode, mTransferMode, TransferMode::Ordered);
   SerializeNameDefault(mAccurateTimestampOnChange, false);
+  SerializeNameDefault(mBaselineDelta, false);
 }
 
 //
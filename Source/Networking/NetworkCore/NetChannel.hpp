@@ -294,6 +294,14 @@ public:
   /// object setting)
   void SetAccurateTimestampOnChange(bool accurateTimestampOnChange = false);
   bool GetAccurateTimestampOnChange() const;
+
+  /// Controls whether or not net channel changes are sent as a snapshot of all
+  /// net properties, encoded against the latest snapshot each peer has
+  /// acknowledged. Sends a full snapshot until a peer acknowledges one, then
+  /// only the bytes that differ, which suits frequently changing channels
+  /// sent unreliably. (Cannot be modified at game runtime)
+  void SetBaselineDelta(bool baselineDelta = false);
+  bool GetBaselineDelta() const;
 };
 
 //                              NetChannelConfig //
@@ -429,6 +437,13 @@ public:
   /// belonging to a specific net object by enabling the corresponding net
   /// object setting)
   bool mAccurateTimestampOnChange;
+
+  /// Controls whether or not net channel changes are sent as a snapshot of all
+  /// net properties, encoded against the latest snapshot each peer has
+  /// acknowledged. Sends a full snapshot until a peer acknowledges one, then
+  /// only the bytes that differ, which suits frequently changing channels
+  /// sent unreliably.
+  bool mBaselineDelta;
 };
 
 //                           NetChannelConfigManager //
@@ -13,6 +13,28 @@ static const String cPeerClosed = "[Peer Closed]";
 namespace Plasma
 {
 
+/// Fewest replica channel observations given to a replica observation job.
+static const size_t cReplicaObservationsPerJob = 256;
+/// Most replica observation jobs run at once.
+static const size_t cMaxReplicaObservationJobs = 7;
+
+/// Observes part of the sampled replica channels of a replica channel type.
+class ReplicaObservationJob : public Job
+{
+public:
+  void Execute() override
+  {
+    ZoneScoped;
+    mNetPeer->ObserveReplicaChannels(mObservations, mTimestamp);
+    mJobsRunning->DecrementCount();
+  }
+
+  NetPeer* mNetPeer;
+  ReplicaChannelObservations::range mObservations;
+  TimeMs mTimestamp;
+  CountdownEvent* mJobsRunning;
+};
+
 //                                   NetPeer //
 
 LightningDefineType(NetPeer, builder, type)
@@ -4685,6 +4707,44 @@ void NetPeer::OnReplicaChannelPropertyChange(TimeMs timestamp,
   }
 }
 
+void NetPeer::OnObserveReplicaChannels(ReplicaChannelObservations& observations, TimeMs timestamp)
+{
+  // Divide observations among jobs, with this thread observing the first part.
+  // (Observations only read sampled property values and write their own
+  // replica channel, so parts can be observed at the same time)
+  size_t partCount = (observations.Size() + cReplicaObservationsPerJob - 1) / cReplicaObservationsPerJob;
+  size_t jobCount = (ThreadingEnabled && partCount > 1) ? Math::Min(partCount, cMaxReplicaObservationJobs + 1) - 1 : 0;
+
+  // Too few observations to be worth dividing?
+  if (jobCount == 0)
+  {
+    ObserveReplicaChannels(observations.All(), timestamp);
+    return;
+  }
+
+  // Spread observations evenly across every part
+  size_t partSize = (observations.Size() + jobCount) / (jobCount + 1);
+
+  CountdownEvent jobsRunning;
+  for (size_t i = 1; i <= jobCount; ++i)
+  {
+    size_t start = i * partSize;
+    size_t length = Math::Min(partSize, observations.Size() - start);
+
+    ReplicaObservationJob* job = new ReplicaObservationJob();
+    job->mNetPeer = this;
+    job->mObservations = observations.SubRange(start, length);
+    job->mTimestamp = timestamp;
+    job->mJobsRunning = &jobsRunning;
+
+    jobsRunning.IncrementCount();
+    PL::gJobs->AddJob(job);
+  }
+
+  ObserveReplicaChannels(observations.SubRange(0, partSize), timestamp);
+  jobsRunning.Wait();
+}
+
 //
 // Replicator Link Interface
 //
@@ -745,6 +745,9 @@ public:
                                       ReplicaProperty* replicaProperty,
                                       TransmissionDirection::Enum direction) override;
 
+  /// Observes the sampled replica channels for changes, divided among jobs.
+  void OnObserveReplicaChannels(ReplicaChannelObservations& observations, TimeMs timestamp) override;
+
   //
   // Replicator Link Interface
   //
@@ -131,6 +131,20 @@ public:
     return mReceivedPacketBytesMax;
   }
 
+  /// Returns the average number of bytes saved per second by sending replica
+  /// channel changes encoded against acknowledged snapshots, instead of whole
+  /// snapshots
+  double GetAvgDeltaBytesSaved() const
+  {
+    return mDeltaBytesSavedAvg;
+  }
+  /// Returns the total number of bytes ever saved by sending replica channel
+  /// changes encoded against acknowledged snapshots (unaffected by ResetStats)
+  uintmax GetTotalDeltaBytesSaved() const
+  {
+    return uintmax(mDeltaBitsSaved) / 8;
+  }
+
   /// Returns the total number of packets ever sent (unaffected by ResetStats)
   uintmax GetTotalPacketsSent() const
   {
@@ -192,6 +206,9 @@ protected:
     mReceivedPacketBytesMin = 0;
     mReceivedPacketBytesAvg = 0;
     mReceivedPacketBytesMax = 0;
+
+    mDeltaBytesSavedUpdated = false;
+    mDeltaBytesSavedAvg = 0;
   }
 
   /// Initializes all bandwidth statistics
@@ -201,6 +218,9 @@ protected:
 
     mPacketsSent = 0;
     mPacketsReceived = 0;
+
+    mPendingDeltaBitsSaved = 0;
+    mDeltaBitsSaved = 0;
   }
 
   /// Updates the outgoing bandwidth usage statistics
@@ -305,6 +325,29 @@ protected:
       mReceivedPacketBytesUpdated = true;
     }
   }
+  /// Adds to the bits saved by delta encoding since the last packet was sent
+  void AddDeltaBitsSaved(Bits bitsSaved)
+  {
+    mPendingDeltaBitsSaved += bitsSaved;
+    mDeltaBitsSaved += uintmax(bitsSaved);
+  }
+  /// Updates the delta bytes saved statistics with the bits saved since the
+  /// last packet was sent, given the current packet send rate
+  void UpdateDeltaBytesSaved(double sendRate)
+  {
+    double sample = double(Bits(mPendingDeltaBitsSaved)) / double(8) * sendRate;
+    mPendingDeltaBitsSaved = 0;
+
+    if (mDeltaBytesSavedUpdated)
+    {
+      mDeltaBytesSavedAvg = Average(double(mDeltaBytesSavedAvg), sample, 0.1);
+    }
+    else
+    {
+      mDeltaBytesSavedAvg = sample;
+      mDeltaBytesSavedUpdated = true;
+    }
+  }
   /// Updates the packets sent statistics
   void UpdatePacketsSent()
   {
@@ -323,6 +366,7 @@ private:
   typedef typename conditional<UseAtomicStats, Atomic<Kbps>, Kbps>::type Kbps_type;
   typedef typename conditional<UseAtomicStats, Atomic<uint32>, uint32>::type uint32_type;
   typedef typename conditional<UseAtomicStats, Atomic<Bytes>, Bytes>::type Bytes_type;
+  typedef typename conditional<UseAtomicStats, Atomic<Bits>, Bits>::type Bits_type;
   typedef typename conditional<UseAtomicStats, Atomic<uintmax>, uintmax>::type uintmax_type;
 
   /// Statistics
@@ -360,8 +404,13 @@ private:
   double_type mReceivedPacketBytesAvg;   /// Average received packet bytes
   Bytes_type mReceivedPacketBytesMax;    /// Maximum received packet bytes
 
-  uintmax_type mPacketsSent;     /// Packets sent
-  uintmax_type mPacketsReceived; /// Packets received
+  bool_type mDeltaBytesSavedUpdated; /// Delta bytes saved updated?
+  double_type mDeltaBytesSavedAvg;   /// Average delta bytes saved per second
+
+  uintmax_type mPacketsSent;        /// Packets sent
+  uintmax_type mPacketsReceived;    /// Packets received
+  Bits_type mPendingDeltaBitsSaved; /// Delta bits saved since the last packet was sent
+  uintmax_type mDeltaBitsSaved;     /// Delta bits saved
 };
 
 } // namespace Plasma
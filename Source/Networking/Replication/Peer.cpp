@@ -835,6 +835,7 @@ void Peer::UpdateSendStats(Bytes sentPacketBytes)
                                double(cOneSecondTimeMs));
   UpdateSendRate(uint(cOneSecondTimeMs / sendDt));
   UpdateSentPacketBytes(sentPacketBytes);
+  UpdateDeltaBytesSaved(double(cOneSecondTimeMs) / sendDt);
 }
 void Peer::UpdateReceiveStats(Bytes receivedPacketBytes)
 {
@@ -706,6 +706,13 @@ void PeerLink::InitializeStats()
   mInternalRoundTripTimeMax = GetPreconnectionRoundTripTime();
 }
 
+void PeerLink::RecordDeltaBitsSaved(Bits bitsSaved)
+{
+  // Update link and peer stats
+  AddDeltaBitsSaved(bitsSaved);
+  GetPeer()->AddDeltaBitsSaved(bitsSaved);
+}
+
 void PeerLink::UpdateRoundTripTime(TimeMs sample, TimeMs floor)
 {
   if (mRoundTripTimeUpdated)
@@ -837,6 +844,7 @@ void PeerLink::SendPacket(OutPacket& outPacket)
                                (double(cOneSecondTimeMs) / double(lastSendDuration)));
   UpdateSendRate(uint(cOneSecondTimeMs / lastSendDuration));
   UpdateSentPacketBytes(BITS_TO_BYTES(outPacketBits));
+  UpdateDeltaBytesSaved(double(cOneSecondTimeMs) / double(lastSendDuration));
 
   // Add sent packet size to our outstanding frame size
   Bits currentFrameSize = GetOutgoingFrameSize();
@@ -397,6 +397,10 @@ public:
   /// Updates the round trip time statistics
   void UpdateRoundTripTime(TimeMs sample, TimeMs floor);
 
+  /// Records bits saved by sending a replica channel change encoded against an
+  /// acknowledged snapshot (updates both link and peer stats)
+  void RecordDeltaBitsSaved(Bits bitsSaved);
+
   /// Sends a protocol or custom message on the link
   MessageReceiptId SendInternal(Status& status,
                                 MoveReference<Message> message,
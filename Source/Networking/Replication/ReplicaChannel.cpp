@@ -4,6 +4,23 @@
 namespace Plasma
 {
 
+//                            ReplicaChannelChange //
+
+ReplicaChannelChange::ReplicaChannelChange() : mMessage(ReplicatorMessageType::Change), mSnapshot(nullptr)
+{
+}
+
+//                          ReplicaChannelObservation //
+
+ReplicaChannelObservation::ReplicaChannelObservation() :
+    mReplicaChannel(nullptr),
+    mIsSampled(false),
+    mChangeDetected(false),
+    mIsPrepared(false),
+    mChange()
+{
+}
+
 //                               ReplicaChannel //
 
 ReplicaChannel::ReplicaChannel(const String& name, ReplicaChannelType* replicaChannelType) :
@@ -17,7 +34,8 @@ ReplicaChannel::ReplicaChannel(const String& name, ReplicaChannelType* replicaCh
     mLastChangeTimestamp(cInvalidMessageTimestamp),
     mLastChangeFrameId(0),
     mAuthority(Authority::Server),
-    mReplicaProperties()
+    mReplicaProperties(),
+    mSnapshots()
 {
   // Replica channel type provided?
   if (replicaChannelType)
@@ -178,107 +196,17 @@ bool ReplicaChannel::ObserveAndReplicateChanges(bool forceObservation, bool forc
 bool ReplicaChannel::ObserveAndReplicateChanges(
     TimeMs timestamp, uint64 frameId, bool forceObservation, bool forceReplication, bool isRelay)
 {
-  // Get replica channel type
-  ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
-
-  // Get replica
-  Replica* replica = GetReplica();
-
-  // Get replicator
-  Replicator* replicator = GetReplicator();
-
-  // Don't force observation?
-  if (!forceObservation)
-  {
-    // Don't detect outgoing changes for this replica?
-    if (!replica->GetDetectOutgoingChanges())
-      return true; // Success
-  }
-
-  // Is not being relayed?
-  if (!isRelay)
-  {
-    // Replica channel authority does not match our role?
-    if (uint(GetAuthority()) != uint(replicator->GetRole()))
-    {
-      // (Sanity check: We should only get here if our replica channel type's
-      // authority mode is dynamic, otherwise this replica channel should not
-      // have even been scheduled for change observation in the first place)
-      Assert(forceObservation ? true : (replicaChannelType->GetAuthorityMode() == AuthorityMode::Dynamic));
+  // Should not observe this replica channel?
+  if (!ShouldObserveChanges(forceObservation, isRelay))
+    return true; // Success
 
-      // Success
-      return true;
-    }
+  // Observe replica channel
+  ReplicaChannelObservation observation;
+  observation.mReplicaChannel = this;
+  observation.mChangeDetected = ObserveForChange();
 
-    // Is client?
-    if (replicator->GetRole() == Role::Client)
-    {
-      // Not this replica's change authority client?
-      if (replicator->GetReplicatorId() != replica->GetAuthorityClientReplicatorId())
-        return true; // Success
-    }
-  }
-
-  // Change detected?
-  if (ObserveForChange())
-  {
-    //    Replica channel type configured to serialize on change?
-    // OR Force replication?
-    if ((replicaChannelType->GetSerializationFlags() & SerializationFlags::OnChange) || forceReplication)
-    {
-      // Create change route (route changes to everyone except the change
-      // authority client)
-      Route changeRoute = isRelay ? Route(RouteMode::Exclude, replica->GetAuthorityClientReplicatorId()) : Route::All;
-
-      // Route replica channel change
-      if (!replicator->RouteChange(this, changeRoute, timestamp)) // Unable?
-      {
-        // Failure
-        Assert(false);
-        return false;
-      }
-    }
-
-    // Is napping?
-    if (IsNapping())
-    {
-      // Wake up (we just detected a change)
-      WakeUp();
-    }
-
-    // Set last change detected frame ID
-    SetLastChangeFrameId(frameId);
-
-    // Handle changed replica channel property values
-    ReactToPropertyChanges(timestamp, ReplicationPhase::Change, TransmissionDirection::Outgoing);
-  }
-  // No change detected?
-  else
-  {
-    // Is awake?
-    if (IsAwake())
-    {
-      // Get frame duration since the last change was detected
-      uint64 frameDurationSinceLastChange = (frameId - GetLastChangeFrameId());
-
-      // Awake frame duration has elapsed since the last change was detected?
-      if (frameDurationSinceLastChange >= replicaChannelType->GetAwakeDuration())
-      {
-        // Determine if this replica channel is allowed to nap
-        bool allowedToNap = (replica->GetAllowNapping() && replicaChannelType->GetAllowNapping());
-
-        // Allowed to nap?
-        if (allowedToNap)
-        {
-          // Take nap (we have not detected a change in a while)
-          TakeNap();
-        }
-      }
-    }
-  }
-
-  // Success
-  return true;
+  // Replicate observed changes
+  return ReplicateObservedChanges(observation, timestamp, frameId, forceReplication, isRelay);
 }
 
 void ReplicaChannel::SetLastChangeTimestamp(TimeMs lastChangeTimestamp)
@@ -468,14 +396,183 @@ bool ReplicaChannel::ObserveForChange()
   }
 }
 
-bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const
+bool ReplicaChannel::ShouldObserveChanges(bool forceObservation, bool isRelay) const
+{
+  // Get replica channel type
+  ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
+
+  // Get replica
+  Replica* replica = GetReplica();
+
+  // Get replicator
+  Replicator* replicator = GetReplicator();
+
+  // Don't force observation?
+  if (!forceObservation)
+  {
+    // Don't detect outgoing changes for this replica?
+    if (!replica->GetDetectOutgoingChanges())
+      return false;
+  }
+
+  // Is not being relayed?
+  if (!isRelay)
+  {
+    // Replica channel authority does not match our role?
+    if (uint(GetAuthority()) != uint(replicator->GetRole()))
+    {
+      // (Sanity check: We should only get here if our replica channel type's
+      // authority mode is dynamic, otherwise this replica channel should not
+      // have even been scheduled for change observation in the first place)
+      Assert(forceObservation ? true : (replicaChannelType->GetAuthorityMode() == AuthorityMode::Dynamic));
+
+      // Don't observe
+      return false;
+    }
+
+    // Is client?
+    if (replicator->GetRole() == Role::Client)
+    {
+      // Not this replica's change authority client?
+      if (replicator->GetReplicatorId() != replica->GetAuthorityClientReplicatorId())
+        return false;
+    }
+  }
+
+  // Observe
+  return true;
+}
+
+bool ReplicaChannel::CanObserveOffMainThread() const
+{
+  // For all replica properties
+  forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
+  {
+    // Replica property cannot be observed off the main thread?
+    if (!replicaProperty->CanObserveOffMainThread())
+      return false;
+  }
+
+  return true;
+}
+
+void ReplicaChannel::SampleValues()
+{
+  forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
+    replicaProperty->SampleValue();
+}
+void ReplicaChannel::ClearSampledValues()
+{
+  forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
+    replicaProperty->ClearSampledValue();
+}
+
+void ReplicaChannel::ObserveChanges(ReplicaChannelObservation& observation, TimeMs timestamp)
+{
+  Assert(observation.mReplicaChannel == this);
+
+  // Observe replica channel
+  observation.mChangeDetected = ObserveForChange();
+
+  //     Change detected?
+  // AND Replica channel type configured to serialize on change?
+  if (observation.mChangeDetected && (GetReplicaChannelType()->GetSerializationFlags() & SerializationFlags::OnChange))
+  {
+    // Serialize replica channel change
+    // (If unable, the change is serialized again when routed)
+    observation.mIsPrepared = GetReplicator()->PrepareChange(this, observation.mChange, timestamp);
+  }
+}
+
+bool ReplicaChannel::ReplicateObservedChanges(
+    ReplicaChannelObservation& observation, TimeMs timestamp, uint64 frameId, bool forceReplication, bool isRelay)
+{
+  // Get replica channel type
+  ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
+
+  // Get replica
+  Replica* replica = GetReplica();
+
+  // Get replicator
+  Replicator* replicator = GetReplicator();
+
+  // Change detected?
+  if (observation.mChangeDetected)
+  {
+    //    Replica channel type configured to serialize on change?
+    // OR Force replication?
+    if ((replicaChannelType->GetSerializationFlags() & SerializationFlags::OnChange) || forceReplication)
+    {
+      // Create change route (route changes to everyone except the change
+      // authority client)
+      Route changeRoute = isRelay ? Route(RouteMode::Exclude, replica->GetAuthorityClientReplicatorId()) : Route::All;
+
+      // Route replica channel change
+      // (Using the change serialized ahead of time, if any)
+      bool result = observation.mIsPrepared ? replicator->RouteChange(this, changeRoute, observation.mChange)
+                                            : replicator->RouteChange(this, changeRoute, timestamp);
+      if (!result) // Unable?
+      {
+        // Failure
+        Assert(false);
+        return false;
+      }
+    }
+
+    // Is napping?
+    if (IsNapping())
+    {
+      // Wake up (we just detected a change)
+      WakeUp();
+    }
+
+    // Set last change detected frame ID
+    SetLastChangeFrameId(frameId);
+
+    // Handle changed replica channel property values
+    ReactToPropertyChanges(timestamp, ReplicationPhase::Change, TransmissionDirection::Outgoing);
+  }
+  // No change detected?
+  else
+  {
+    // Is awake?
+    if (IsAwake())
+    {
+      // Get frame duration since the last change was detected
+      uint64 frameDurationSinceLastChange = (frameId - GetLastChangeFrameId());
+
+      // Awake frame duration has elapsed since the last change was detected?
+      if (frameDurationSinceLastChange >= replicaChannelType->GetAwakeDuration())
+      {
+        // Determine if this replica channel is allowed to nap
+        bool allowedToNap = (replica->GetAllowNapping() && replicaChannelType->GetAllowNapping());
+
+        // Allowed to nap?
+        if (allowedToNap)
+        {
+          // Take nap (we have not detected a change in a while)
+          TakeNap();
+        }
+      }
+    }
+  }
+
+  // Success
+  return true;
+}
+
+
+bool ReplicaChannel::Serialize(BitStream& bitStream,
+                               ReplicationPhase::Enum replicationPhase,
+                               TimeMs timestamp,
+                               bool forceAll) const
 {
   // Get replica channel type
   ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
 
   // (For the initialization replication phase we want to forcefully serialize
   // all replica properties to ensure a valid initial value state)
-  bool forceAll = (replicationPhase == ReplicationPhase::Initialization);
+  forceAll = forceAll || (replicationPhase == ReplicationPhase::Initialization);
 
   //    Serialize all replica properties?
   // OR There is only a single replica property?
@@ -487,7 +584,7 @@ bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum repl
     forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
     {
       // Write replica property
-      bool result = replicaProperty->Serialize(bitStream, replicationPhase, timestamp);
+      bool result = replicaProperty->Serialize(bitStream, replicationPhase, timestamp, forceAll);
       if (!result) // Unable?
       {
         Assert(false);
@@ -509,7 +606,7 @@ bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum repl
       if (hasChanged) // Has changed?
       {
         // Write replica property
-        bool result = replicaProperty->Serialize(bitStream, replicationPhase, timestamp);
+        bool result = replicaProperty->Serialize(bitStream, replicationPhase, timestamp, forceAll);
         if (!result) // Unable?
         {
           Assert(false);
@@ -522,14 +619,17 @@ bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum repl
   // Success
   return true;
 }
-bool ReplicaChannel::Deserialize(const BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp)
+bool ReplicaChannel::Deserialize(const BitStream& bitStream,
+                                 ReplicationPhase::Enum replicationPhase,
+                                 TimeMs timestamp,
+                                 bool forceAll)
 {
   // Get replica channel type
   ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
 
   // (For the initialization replication phase we want to forcefully deserialize
   // all replica properties to ensure a valid initial value state)
-  bool forceAll = (replicationPhase == ReplicationPhase::Initialization);
+  forceAll = forceAll || (replicationPhase == ReplicationPhase::Initialization);
 
   //    Serialize all replica properties?
   // OR There is only a single replica property?
@@ -541,7 +641,7 @@ bool ReplicaChannel::Deserialize(const BitStream& bitStream, ReplicationPhase::E
     forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
     {
       // Read replica property
-      bool result = replicaProperty->Deserialize(bitStream, replicationPhase, timestamp);
+      bool result = replicaProperty->Deserialize(bitStream, replicationPhase, timestamp, forceAll);
       if (!result) // Unable?
       {
         // Assert(false);
@@ -567,7 +667,7 @@ bool ReplicaChannel::Deserialize(const BitStream& bitStream, ReplicationPhase::E
       if (hasChanged) // Has changed?
       {
         // Read replica property
-        bool result = replicaProperty->Deserialize(bitStream, replicationPhase, timestamp);
+        bool result = replicaProperty->Deserialize(bitStream, replicationPhase, timestamp, forceAll);
         if (!result) // Unable?
         {
           // Assert(false);
@@ -581,6 +681,34 @@ bool ReplicaChannel::Deserialize(const BitStream& bitStream, ReplicationPhase::E
   return true;
 }
 
+const ReplicaSnapshot* ReplicaChannel::TakeSnapshot(TimeMs timestamp)
+{
+  // First snapshot?
+  if (!mSnapshots)
+    mSnapshots = new ReplicaSnapshotHistory();
+
+  // Write all replica properties
+  ReplicaSnapshot& snapshot = mSnapshots->Store(mSnapshots->mNextSequence++);
+  bool result = Serialize(snapshot.mData, ReplicationPhase::Change, timestamp, true);
+  if (!result) // Unable?
+  {
+    snapshot.mIsValid = false;
+    Assert(false);
+    return nullptr;
+  }
+
+  // Success
+  return &snapshot;
+}
+const ReplicaSnapshot* ReplicaChannel::GetSnapshot(ReplicaSnapshotSequence sequence) const
+{
+  // No snapshots taken?
+  if (!mSnapshots)
+    return nullptr;
+
+  return mSnapshots->Find(sequence);
+}
+
 //                             ReplicaChannelIndex //
 
 ReplicaChannelIndex::ReplicaChannelIndex() : mChannelLists(), mChannelCount(0)
@@ -803,21 +931,59 @@ void ReplicaChannelType::ObserveAndReplicateChanges(ReplicaChannelIndex& replica
   // Get scheduled replica channel list from index
   ReplicaChannelList* scheduledList = replicaChannelIndex.GetList(size_t(frameId % listCount));
 
+  // Get replicator
+  Replicator* replicator = GetReplicator();
+
+  // Serialize changes ahead of time?
+  // (Only worthwhile if there are links to route changes to)
+  bool observeAhead = (replicator->GetPeer()->GetLinkCount() != 0);
+
   // For all scheduled replica channels in the list
-  ReplicaChannelList::range scheduledChannels = scheduledList->All();
-  while (!scheduledChannels.Empty())
+  // (We gather these first because replicating the scheduled replica channels
+  // below may cause their nodes to be removed and invalidate our list traversal)
+  mObservations.Clear();
+  forRange (ReplicaChannel& scheduledChannel, scheduledList->All())
   {
-    // Get scheduled replica channel
-    ReplicaChannel& scheduledChannel = scheduledChannels.Front();
+    // Add observation
+    ReplicaChannelObservation& observation = mObservations.PushBack();
+    observation.mReplicaChannel = &scheduledChannel;
+
+    //     Serializing changes ahead of time?
+    // AND Should observe the scheduled replica channel?
+    // AND Its replica properties can be observed off the main thread?
+    if (observeAhead && scheduledChannel.ShouldObserveChanges() && scheduledChannel.CanObserveOffMainThread())
+    {
+      // Sample replica property values
+      // (Property getters are only called on the main thread)
+      scheduledChannel.SampleValues();
+      observation.mIsSampled = true;
+    }
+  }
+
+  // Observe the sampled replica channels (possibly on other threads)
+  replicator->OnObserveReplicaChannels(mObservations, timestamp);
 
-    // Advance
-    // (We do this here because observing the scheduled replica channel below
-    // may cause it's node to be removed and invalidate our list traversal)
-    scheduledChannels.PopFront();
+  // For all scheduled replica channels (in scheduled order)
+  forRange (ReplicaChannelObservation& observation, mObservations.All())
+  {
+    // Get scheduled replica channel
+    ReplicaChannel* scheduledChannel = observation.mReplicaChannel;
 
-    // Observe the scheduled replica channel
-    scheduledChannel.ObserveAndReplicateChanges(timestamp, frameId);
+    // Observed ahead of time?
+    if (observation.mIsSampled)
+    {
+      // Replicate the observed changes
+      scheduledChannel->ReplicateObservedChanges(observation, timestamp, frameId);
+      scheduledChannel->ClearSampledValues();
+    }
+    // Not observed yet?
+    else
+    {
+      // Observe the scheduled replica channel
+      scheduledChannel->ObserveAndReplicateChanges(timestamp, frameId);
+    }
   }
+  mObservations.Clear();
 }
 
 void ReplicaChannelType::ScheduleChannel(ReplicaChannel* channel)
@@ -924,6 +1090,7 @@ void ReplicaChannelType::ResetConfig()
   SetReliabilityMode();
   SetTransferMode();
   SetAccurateTimestampOnChange();
+  SetBaselineDelta();
 }
 
 void ReplicaChannelType::SetDetectOutgoingChanges(bool detectOutgoingChanges)
@@ -1130,4 +1297,21 @@ bool ReplicaChannelType::GetAccurateTimestampOnChange() const
   return mAccurateTimestampOnChange;
 }
 
+void ReplicaChannelType::SetBaselineDelta(bool baselineDelta)
+{
+  // Already valid?
+  if (IsValid())
+  {
+    // Unable to modify configuration
+    Error("ReplicaChannelType is already valid, unable to modify configuration");
+    return;
+  }
+
+  mBaselineDelta = baselineDelta;
+}
+bool ReplicaChannelType::GetBaselineDelta() const
+{
+  return mBaselineDelta;
+}
+
 } // namespace Plasma
@@ -4,6 +4,46 @@
 namespace Plasma
 {
 
+//                            ReplicaChannelChange //
+
+/// Replica Channel Change
+/// A replica channel change, serialized once and sent to every link in its
+/// route
+struct ReplicaChannelChange
+{
+  /// Constructor
+  ReplicaChannelChange();
+
+  /// Data
+  Message mMessage;                 /// Change message (contains the serialized change,
+                                    /// unless sent as a snapshot)
+  const ReplicaSnapshot* mSnapshot; /// Snapshot to encode against each link's baseline
+                                    /// (may be null, see ReplicaChannelType::SetBaselineDelta)
+};
+
+//                          ReplicaChannelObservation //
+
+/// Replica Channel Observation
+/// The result of observing a replica channel for changes, found ahead of
+/// replicating them (possibly on another thread, see
+/// Replicator::OnObserveReplicaChannels)
+struct ReplicaChannelObservation
+{
+  /// Constructor
+  ReplicaChannelObservation();
+
+  /// Data
+  ReplicaChannel* mReplicaChannel; /// Observed replica channel
+  bool mIsSampled;                 /// Property values sampled to be observed ahead of time?
+                                   /// (Else observed when replicated)
+  bool mChangeDetected;            /// Change detected?
+  bool mIsPrepared;                /// Change serialized ahead of time?
+  ReplicaChannelChange mChange;    /// Serialized change (if prepared)
+};
+
+/// Typedefs
+typedef Array<ReplicaChannelObservation> ReplicaChannelObservations;
+
 //                               ReplicaChannel //
 
 /// Replica Channel
@@ -161,12 +201,58 @@ public:
   /// Returns true if a change was detected, else false
   bool ObserveForChange();
 
-  /// Serializes the replica channel
+  /// Returns true if the replica channel should be observed for outgoing
+  /// changes by this replicator, else false
+  bool ShouldObserveChanges(bool forceObservation = false, bool isRelay = false) const;
+
+  /// Returns true if every replica property can be observed off the main thread
+  /// once sampled, else false
+  bool CanObserveOffMainThread() const;
+
+  /// Samples the current value of every replica property, used by all
+  /// observations until cleared
+  /// (Must be called on the main thread, as property getters may run script)
+  void SampleValues();
+  /// Clears the sampled value of every replica property
+  void ClearSampledValues();
+
+  /// Observes the replica channel for changes using the sampled property values
+  /// and serializes any detected change ahead of replicating it
+  /// (Safe to call off the main thread if CanObserveOffMainThread, with no
+  /// other thread observing the same replica channel)
+  void ObserveChanges(ReplicaChannelObservation& observation, TimeMs timestamp);
+
+  /// Replicates the changes found by the observation (if configured to do so),
+  /// and wakes up or naps the replica channel accordingly
   /// Returns true if successful, else false
-  bool Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const;
+  bool ReplicateObservedChanges(ReplicaChannelObservation& observation,
+                                TimeMs timestamp,
+                                uint64 frameId,
+                                bool forceReplication = false,
+                                bool isRelay = false);
+
+  /// Serializes the replica channel
+  /// (All replica properties are serialized if forceAll is set, regardless of
+  /// the replication phase) Returns true if successful, else false
+  bool Serialize(BitStream& bitStream,
+                 ReplicationPhase::Enum replicationPhase,
+                 TimeMs timestamp,
+                 bool forceAll = false) const;
   /// Deserializes the replica channel
-  /// Returns true if successful, else false
-  bool Deserialize(const BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp);
+  /// (All replica properties are deserialized if forceAll is set, regardless of
+  /// the replication phase) Returns true if successful, else false
+  bool Deserialize(const BitStream& bitStream,
+                   ReplicationPhase::Enum replicationPhase,
+                   TimeMs timestamp,
+                   bool forceAll = false);
+
+  /// Serializes all replica properties into a new snapshot, kept so that later
+  /// changes may be encoded against it once acknowledged (see
+  /// ReplicaChannelType::SetBaselineDelta) Returns the snapshot if successful,
+  /// else nullptr
+  const ReplicaSnapshot* TakeSnapshot(TimeMs timestamp);
+  /// Returns the specified snapshot if it is still kept, else nullptr
+  const ReplicaSnapshot* GetSnapshot(ReplicaSnapshotSequence sequence) const;
 
   /// Data
   String mName;                            /// Replica channel name
@@ -181,6 +267,7 @@ public:
   uint64 mLastChangeFrameId;               /// Frame ID of the last detected change
   Authority::Enum mAuthority;              /// Change authority
   ReplicaPropertySet mReplicaProperties;   /// Replica properties
+  ReplicaSnapshotHistoryPtr mSnapshots;    /// Recently taken snapshots (created on first use)
 };
 
 /// Typedefs
@@ -387,6 +474,15 @@ public:
   void SetAccurateTimestampOnChange(bool accurateTimestampOnChange = false);
   bool GetAccurateTimestampOnChange() const;
 
+  /// Controls whether or not replica channel changes are sent as a snapshot of
+  /// all replica properties, encoded against the latest snapshot each peer has
+  /// acknowledged receiving (Costs a full snapshot until a peer acknowledges
+  /// one, but sends only the bytes that differ from then on, regardless of
+  /// changes lost along the way) (Cannot be modified after the replica channel
+  /// type has been made valid)
+  void SetBaselineDelta(bool baselineDelta = false);
+  bool GetBaselineDelta() const;
+
   /// Data
   String mName;                                 /// Replica channel type name
   Replicator* mReplicator;                      /// Operating replicator
@@ -409,6 +505,9 @@ public:
   ReliabilityMode::Enum mReliabilityMode;       /// Change message reliability mode
   TransferMode::Enum mTransferMode;             /// Change message transfer mode
   bool mAccurateTimestampOnChange;              /// Accurate timestamp when changed?
+  bool mBaselineDelta;                          /// Encode changes against acknowledged snapshots?
+  ReplicaChannelObservations mObservations;     /// Scheduled replica channel observations
+                                                /// (reused each observation)
 };
 
 /// Typedefs
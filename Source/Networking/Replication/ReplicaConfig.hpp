@@ -222,7 +222,7 @@ DeclareEnum2(AuthorityMode,
                       /// replica is made valid
 
 /// Replicator Plugin Message Types
-DeclareEnum11(ReplicatorMessageType,
+DeclareEnum12(ReplicatorMessageType,
               ConnectConfirmation,     /// Connect confirmation
               CreateContextItems,      /// Creation context cache items
               ReplicaTypeItems,        /// Replica type cache items
@@ -233,7 +233,8 @@ DeclareEnum11(ReplicatorMessageType,
               Destroy,                 /// Destroy command
               Change,                  /// Replica channel change
               Interrupt,               /// Interrupt step command
-              ReverseReplicaChannels); /// Reverse replica channel mappings
+              ReverseReplicaChannels,  /// Reverse replica channel mappings
+              SnapshotAcks);           /// Replica channel snapshot acknowledgements
 
 // Replica Stream Serialization Mode
 DeclareEnum5(ReplicaStreamMode,
@@ -72,6 +72,8 @@ ReplicaProperty::ReplicaProperty(const String& name,
     mIndexListSize(nullptr),
     mPropertyData(propertyData),
     mLastValue(),
+    mSampledValue(),
+    mIsSampled(false),
     mLastChangeTimestamp(cInvalidMessageTimestamp),
     mLastReceivedChangeValue(),
     mLastReceivedChangeTimestamp(cInvalidMessageTimestamp),
@@ -244,19 +246,17 @@ bool HasChangedArithmetic(const ReplicaProperty* replicaProperty, const ReplicaP
   // Do not use delta threshold?
   else
   {
-    // For each primitive member
-    for (size_t i = 0; i < PrimitiveCount; ++i)
-    {
-      // Get primitive members
-      PrimitiveType& currentValuePrimitiveMember = currentValue.GetPrimitiveMemberOrError<PropertyType>(i);
-      const PrimitiveType& lastValuePrimitiveMember = lastValue.GetPrimitiveMemberOrError<PropertyType>(i);
+    // (Values are made up of tightly packed primitive members)
+    static_assert(sizeof(PropertyType) == sizeof(PrimitiveType) * PrimitiveCount,
+                  "Arithmetic property types should not contain padding");
 
-      // Current value and last value primitive members differ?
-      if (currentValuePrimitiveMember != lastValuePrimitiveMember)
-      {
-        // Has changed
-        return true;
-      }
+    // Current value and last value differ?
+    // (Compared bitwise, so a NaN primitive member that hasn't changed is not
+    // considered a change every observation)
+    if (memcmp(currentValue.GetData(), lastValue.GetData(), sizeof(PropertyType)) != 0)
+    {
+      // Has changed
+      return true;
     }
   }
 
@@ -302,6 +302,10 @@ void ReplicaProperty::SetValue(const Variant& value)
 }
 Variant ReplicaProperty::GetValue() const
 {
+  // Holds a sampled property value?
+  if (mIsSampled)
+    return mSampledValue;
+
   // Get current property value
   Variant value = mReplicaPropertyType->GetGetValueFn()(mPropertyData);
   if (value.IsEmpty()) // Unable?
@@ -314,6 +318,33 @@ Variant ReplicaProperty::GetValue() const
   return PlasmaMove(value);
 }
 
+void ReplicaProperty::SampleValue()
+{
+  // Get current property value (not any previously sampled value)
+  mIsSampled = false;
+  mSampledValue = GetValue();
+  mIsSampled = true;
+}
+void ReplicaProperty::ClearSampledValue()
+{
+  mSampledValue.Clear();
+  mIsSampled = false;
+}
+bool ReplicaProperty::IsSampled() const
+{
+  return mIsSampled;
+}
+
+bool ReplicaProperty::CanObserveOffMainThread() const
+{
+  // Get property's native type
+  NativeType* nativeType = GetReplicaPropertyType()->GetNativeType();
+
+  // Non-boolean arithmetic type?
+  // (Compared and serialized by value, without calling into user code)
+  return nativeType->mIsBasicNativeTypeArithmetic && nativeType != NativeTypeOf(bool);
+}
+
 const Variant& ReplicaProperty::GetPropertyData() const
 {
   return mPropertyData;
@@ -1579,11 +1610,14 @@ bool DeserializeQuantizedArithmetic(Variant& newValue,
   return true;
 }
 
-bool ReplicaProperty::Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const
+bool ReplicaProperty::Serialize(BitStream& bitStream,
+                                ReplicationPhase::Enum replicationPhase,
+                                TimeMs timestamp,
+                                bool forceAll) const
 {
   // (For the initialization replication phase we want to forcefully serialize
   // all primitive-components to ensure a valid initial value state)
-  bool forceAll = (replicationPhase == ReplicationPhase::Initialization);
+  forceAll = forceAll || (replicationPhase == ReplicationPhase::Initialization);
 
   // Get replica property type
   ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
@@ -1641,11 +1675,14 @@ bool ReplicaProperty::Serialize(BitStream& bitStream, ReplicationPhase::Enum rep
     }
   }
 }
-bool ReplicaProperty::Deserialize(const BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp)
+bool ReplicaProperty::Deserialize(const BitStream& bitStream,
+                                  ReplicationPhase::Enum replicationPhase,
+                                  TimeMs timestamp,
+                                  bool forceAll)
 {
   // (For the initialization replication phase we want to forcefully deserialize
   // all primitive-components to ensure a valid initial value state)
-  bool forceAll = (replicationPhase == ReplicationPhase::Initialization);
+  forceAll = forceAll || (replicationPhase == ReplicationPhase::Initialization);
 
   // Get replica property type
   ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
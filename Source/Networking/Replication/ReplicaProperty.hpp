@@ -68,8 +68,24 @@ public:
   /// Sets the current property value
   void SetValue(const Variant& value);
   /// Returns the current property value
+  /// (Returns the sampled property value instead while one is held)
   Variant GetValue() const;
 
+  /// Samples the current property value, returned by GetValue until cleared
+  /// (Lets an observation call the getter once for its comparisons,
+  /// serialization and last value update)
+  void SampleValue();
+  /// Clears the sampled property value
+  void ClearSampledValue();
+  /// Returns true if a sampled property value is held, else false
+  bool IsSampled() const;
+
+  /// Returns true if this replica property can be compared and serialized
+  /// off the main thread once sampled, else false
+  /// (Only true for non-boolean arithmetic types, other types use user provided
+  /// comparison and serialization functions)
+  bool CanObserveOffMainThread() const;
+
   /// Internal property data passed to our getter and setter functions
   const Variant& GetPropertyData() const;
 
@@ -147,11 +163,19 @@ public:
   //
 
   /// Serializes the replica property
-  /// Returns true if successful, else false
-  bool Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const;
+  /// (All primitive-components are serialized if forceAll is set, regardless of
+  /// the replication phase) Returns true if successful, else false
+  bool Serialize(BitStream& bitStream,
+                 ReplicationPhase::Enum replicationPhase,
+                 TimeMs timestamp,
+                 bool forceAll = false) const;
   /// Deserializes the replica property
-  /// Returns true if successful, else false
-  bool Deserialize(const BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp);
+  /// (All primitive-components are deserialized if forceAll is set, regardless of
+  /// the replication phase) Returns true if successful, else false
+  bool Deserialize(const BitStream& bitStream,
+                   ReplicationPhase::Enum replicationPhase,
+                   TimeMs timestamp,
+                   bool forceAll = false);
 
   /// Data
   String mName;                              /// Replica property name
@@ -161,6 +185,8 @@ public:
   size_t* mIndexListSize;                    /// Replica property index list size (may be null)
   Variant mPropertyData;                     /// Property data interpreted by the user
   Variant mLastValue;                        /// Last observed property value
+  Variant mSampledValue;                     /// Sampled property value (if sampled)
+  bool mIsSampled;                           /// Holds a sampled property value?
   TimeMs mLastChangeTimestamp;               /// Timestamp indicating when this replica property
                                              /// was last changed (on any primitive member)
   Variant mLastReceivedChangeValue;          /// Last received property change value
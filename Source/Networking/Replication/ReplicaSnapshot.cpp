@@ -0,0 +1,98 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+//                               Replica Snapshot //
+
+ReplicaSnapshot::ReplicaSnapshot() : mSequence(0), mIsValid(false), mData()
+{
+}
+
+//                           ReplicaSnapshotHistory //
+
+ReplicaSnapshotHistory::ReplicaSnapshotHistory() : mNextSequence(0)
+{
+}
+
+ReplicaSnapshot& ReplicaSnapshotHistory::Store(ReplicaSnapshotSequence sequence)
+{
+  // Replace the oldest snapshot in this slot
+  ReplicaSnapshot& snapshot = mSnapshots[sequence % ReplicaSnapshotHistorySize];
+  snapshot.mSequence = sequence;
+  snapshot.mIsValid = true;
+  snapshot.mData.Clear(false);
+  return snapshot;
+}
+
+const ReplicaSnapshot* ReplicaSnapshotHistory::Find(ReplicaSnapshotSequence sequence) const
+{
+  // Snapshot still stored?
+  const ReplicaSnapshot& snapshot = mSnapshots[sequence % ReplicaSnapshotHistorySize];
+  if (snapshot.mIsValid && snapshot.mSequence == sequence)
+    return &snapshot;
+
+  return nullptr;
+}
+
+//                          Replica Snapshot Helpers //
+
+bool IsMoreRecentSnapshot(ReplicaSnapshotSequence left, ReplicaSnapshotSequence right)
+{
+  return int16(ReplicaSnapshotSequence(left - right)) > 0;
+}
+
+void WriteSnapshotDelta(BitStream& bitStream, const BitStream& snapshot, const BitStream& baseline)
+{
+  Assert(snapshot.GetBitsWritten() == baseline.GetBitsWritten());
+
+  const ::byte* snapshotData = snapshot.GetData();
+  const ::byte* baselineData = baseline.GetData();
+  Bytes bytes = snapshot.GetBytesWritten();
+
+  // Most properties are unchanged from the baseline, leaving mostly zero bytes
+  // (Bits past the end of the last byte are never read back, so whatever is
+  // written for them doesn't matter)
+  for (Bytes i = 0; i < bytes; ++i)
+  {
+    uint8 difference = uint8(snapshotData[i] ^ baselineData[i]);
+
+    // Write 'Has Changed?' Flag
+    bool hasChanged = (difference != 0);
+    bitStream.Write(hasChanged);
+    if (hasChanged) // Has changed?
+      bitStream.Write(difference);
+  }
+}
+
+bool ReadSnapshotDelta(const BitStream& bitStream, const BitStream& baseline, BitStream& snapshot)
+{
+  const ::byte* baselineData = baseline.GetData();
+  Bytes bytes = baseline.GetBytesWritten();
+
+  snapshot.Clear(false);
+  snapshot.Reserve(bytes);
+  for (Bytes i = 0; i < bytes; ++i)
+  {
+    // Read 'Has Changed?' Flag
+    bool hasChanged = false;
+    if (!bitStream.Read(hasChanged)) // Unable?
+      return false;
+
+    uint8 difference = 0;
+    if (hasChanged) // Has changed?
+    {
+      if (!bitStream.Read(difference)) // Unable?
+        return false;
+    }
+
+    snapshot.Write(uint8(baselineData[i] ^ difference));
+  }
+
+  // Trim to the baseline's exact size
+  snapshot.SetBitsWritten(baseline.GetBitsWritten());
+  return true;
+}
+
+} // namespace Plasma
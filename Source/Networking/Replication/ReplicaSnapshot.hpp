@@ -0,0 +1,78 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Plasma
+{
+
+//                               Replica Snapshot //
+
+/// Replica Snapshot Sequence ID
+/// Identifies a snapshot taken of a replica channel (wraps around)
+typedef uint16 ReplicaSnapshotSequence;
+
+/// Number of snapshots kept per replica channel, and per incoming message
+/// channel (Baselines older than this can no longer be referenced)
+static const uint ReplicaSnapshotHistorySize = 16;
+
+/// Replica Snapshot Offset
+/// Distance from a snapshot back to the baseline it was encoded against
+/// (serialized in place of the baseline's sequence ID to conserve bandwidth)
+static const Bits ReplicaSnapshotOffsetBits = 4;
+typedef UintN<ReplicaSnapshotOffsetBits> ReplicaSnapshotOffset;
+
+/// Replica Snapshot
+/// Every replica property of a replica channel, serialized in full
+struct ReplicaSnapshot
+{
+  /// Constructor
+  ReplicaSnapshot();
+
+  /// Data
+  ReplicaSnapshotSequence mSequence; /// Snapshot sequence ID
+  bool mIsValid;                     /// Holds a snapshot?
+  BitStream mData;                   /// Serialized replica properties
+};
+
+//                           ReplicaSnapshotHistory //
+
+/// Replica Snapshot History
+/// The most recent snapshots of a replica channel, by sequence ID
+class ReplicaSnapshotHistory
+{
+public:
+  /// Constructor
+  ReplicaSnapshotHistory();
+
+  /// Returns a cleared snapshot for the specified sequence ID, replacing the
+  /// snapshot stored ReplicaSnapshotHistorySize sequence IDs before it
+  ReplicaSnapshot& Store(ReplicaSnapshotSequence sequence);
+
+  /// Returns the specified snapshot if it is still stored, else nullptr
+  const ReplicaSnapshot* Find(ReplicaSnapshotSequence sequence) const;
+
+  /// Data
+  ReplicaSnapshot mSnapshots[ReplicaSnapshotHistorySize]; /// Snapshots (indexed by sequence ID)
+  ReplicaSnapshotSequence mNextSequence;                  /// Next sequence ID to take
+};
+
+/// Typedefs
+typedef UniquePointer<ReplicaSnapshotHistory> ReplicaSnapshotHistoryPtr;
+typedef ArrayMap<MessageChannelId, ReplicaSnapshotHistoryPtr> InReplicaSnapshots;
+typedef ArrayMap<MessageChannelId, ReplicaSnapshotSequence> ReplicaSnapshotAcks;
+
+//                          Replica Snapshot Helpers //
+
+/// Returns true if the left sequence ID is more recent than the right sequence
+/// ID, else false
+bool IsMoreRecentSnapshot(ReplicaSnapshotSequence left, ReplicaSnapshotSequence right);
+
+/// Writes the snapshot as its difference from the baseline, one flag bit per
+/// unchanged byte and nine bits per changed byte
+/// (Both bitstreams must contain the same number of bits)
+void WriteSnapshotDelta(BitStream& bitStream, const BitStream& snapshot, const BitStream& baseline);
+
+/// Reads a snapshot written by WriteSnapshotDelta against the same baseline
+/// Returns true if successful, else false
+bool ReadSnapshotDelta(const BitStream& bitStream, const BitStream& baseline, BitStream& snapshot);
+
+} // namespace Plasma
@@ -73,6 +73,7 @@ class Route;
 
 // Replicator Includes
 #include "ReplicaConfig.hpp"
+#include "ReplicaSnapshot.hpp"
 #include "Route.hpp"
 #include "ReplicaProperty.hpp"
 #include "ReplicaChannel.hpp"
@@ -766,6 +766,20 @@ void Replicator::InvalidReplica(Replica* replica, bool isForget)
   replica->SetUninitializationTimestamp(cInvalidMessageTimestamp);
 }
 
+void Replicator::ObserveReplicaChannels(ReplicaChannelObservations::range observations, TimeMs timestamp)
+{
+  // For all observations in range
+  forRange (ReplicaChannelObservation& observation, observations)
+  {
+    // Property values sampled to be observed ahead of time?
+    if (observation.mIsSampled)
+    {
+      // Observe replica channel
+      observation.mReplicaChannel->ObserveChanges(observation, timestamp);
+    }
+  }
+}
+
 //
 // Replica Helpers
 //
@@ -1793,42 +1807,82 @@ bool Replicator::RouteDestroy(const ReplicaArray& replicas, const Route& route,
 
 bool Replicator::RouteChange(ReplicaChannel* replicaChannel, const Route& route, TimeMs timestamp)
 {
-  // Get replica
-  Replica* replica = replicaChannel->GetReplica();
-  ReplicaId::value_type replicaId = replica->GetReplicaId().value();
-  Assert(replica && replicaId);
-
   // Route replica channel change
   PeerLinkSet links = GetLinks(route);
   if (!links.Empty()) // Links in route?
   {
     // Serialize replica channel change
-    Message message(ReplicatorMessageType::Change);
-    if (!SerializeChange(replicaChannel, message, timestamp)) // Unable?
+    ReplicaChannelChange change;
+    if (!PrepareChange(replicaChannel, change, timestamp)) // Unable?
       return false;
 
-    // Should include an accurate timestamp with this message?
-    if (Replicator::ShouldIncludeAccurateTimestampOnChange(replicaChannel))
-    {
-      // Set accurate timestamp
-      message.SetTimestamp(timestamp);
-    }
+    // Send replica channel change
+    SendChange(replicaChannel, links, change);
+  }
 
-    // For all replicator links in route
-    forRange (PeerLink* link, links.All())
-    {
-      // Get replicator link
-      ReplicatorLink* replicatorLink = link->GetPlugin<ReplicatorLink>("ReplicatorLink");
+  // Success
+  return true;
+}
+bool Replicator::RouteChange(ReplicaChannel* replicaChannel, const Route& route, ReplicaChannelChange& change)
+{
+  // Route replica channel change
+  PeerLinkSet links = GetLinks(route);
+  if (!links.Empty()) // Links in route?
+  {
+    // Send replica channel change
+    SendChange(replicaChannel, links, change);
+  }
 
-      // Should skip change replication?
-      if (replicatorLink->ShouldSkipChangeReplication())
-        continue; // Skip link
+  // Success
+  return true;
+}
+void Replicator::SendChange(ReplicaChannel* replicaChannel, const PeerLinkSet& links, ReplicaChannelChange& change)
+{
+  // Get replica
+  Replica* replica = replicaChannel->GetReplica();
+  ReplicaId::value_type replicaId = replica->GetReplicaId().value();
+  Assert(replica && replicaId);
 
-      // Has replica remotely?
-      if (replicatorLink->HasReplica(replica))
-        replicatorLink->SendChange(replicaChannel,
-                                   message); // Send replica channel change
-    }
+  // For all replicator links
+  forRange (PeerLink* link, links.All())
+  {
+    // Get replicator link
+    ReplicatorLink* replicatorLink = link->GetPlugin<ReplicatorLink>("ReplicatorLink");
+
+    // Should skip change replication?
+    if (replicatorLink->ShouldSkipChangeReplication())
+      continue; // Skip link
+
+    // Doesn't have replica remotely?
+    if (!replicatorLink->HasReplica(replica))
+      continue; // Skip link
+
+    // Send replica channel change
+    if (change.mSnapshot)
+      replicatorLink->SendChangeSnapshot(replicaChannel, change.mMessage, *change.mSnapshot);
+    else
+      replicatorLink->SendChange(replicaChannel, change.mMessage);
+  }
+}
+bool Replicator::PrepareChange(ReplicaChannel* replicaChannel, ReplicaChannelChange& change, TimeMs timestamp)
+{
+  // Send changes as snapshots encoded against acknowledged baselines?
+  if (replicaChannel->GetReplicaChannelType()->GetBaselineDelta())
+  {
+    // Take snapshot (once, encoded for each link as it's sent)
+    change.mSnapshot = replicaChannel->TakeSnapshot(timestamp);
+    if (!change.mSnapshot) // Unable?
+      return false;
+  }
+  // Serialize replica channel change
+  else if (!SerializeChange(replicaChannel, change.mMessage, timestamp)) // Unable?
+    return false;
+
+  // Should include an accurate timestamp with this message?
+  if (Replicator::ShouldIncludeAccurateTimestampOnChange(replicaChannel))
+  {
+    // Set accurate timestamp
+    change.mMessage.SetTimestamp(timestamp);
   }
 
   // Success
@@ -321,6 +321,19 @@ public:
   {
   }
 
+  /// Observes the sampled replica channels for changes, serializing them ahead
+  /// of replication
+  /// (Override to divide the observations among worker threads, calling
+  /// ObserveReplicaChannels on each part and returning once every part is
+  /// done. The default observes them all on the calling thread)
+  virtual void OnObserveReplicaChannels(ReplicaChannelObservations& observations, TimeMs timestamp)
+  {
+    ObserveReplicaChannels(observations.All(), timestamp);
+  }
+  /// Observes the sampled replica channels in the range
+  /// (Safe to call from multiple threads at once on separate ranges)
+  void ObserveReplicaChannels(ReplicaChannelObservations::range observations, TimeMs timestamp);
+
   //
   // Link Interface
   //
@@ -500,6 +513,15 @@ public:
   /// Routes a replica channel change
   /// Returns true if successful, else false
   bool RouteChange(ReplicaChannel* replicaChannel, const Route& route, TimeMs timestamp);
+  /// Routes a replica channel change already serialized by PrepareChange
+  /// Returns true if successful, else false
+  bool RouteChange(ReplicaChannel* replicaChannel, const Route& route, ReplicaChannelChange& change);
+  /// Serializes a replica channel change to be routed, either as a change
+  /// message or a snapshot (see ReplicaChannelType::SetBaselineDelta)
+  /// Returns true if successful, else false
+  bool PrepareChange(ReplicaChannel* replicaChannel, ReplicaChannelChange& change, TimeMs timestamp);
+  /// Sends a serialized replica channel change to the specified links
+  void SendChange(ReplicaChannel* replicaChannel, const PeerLinkSet& links, ReplicaChannelChange& change);
   /// Serializes a replica channel change
   /// Returns true if successful, else false
   bool SerializeChange(ReplicaChannel* replicaChannel, Message& message, TimeMs timestamp);
@@ -17,6 +17,9 @@ ReplicatorLink::ReplicatorLink(Replicator* replicator) :
     mOutReplicaChannels(),
     mInReplicaChannels(),
     mInReplicaChannelsFlipped(),
+    mSnapshotAcks(),
+    mInReplicaSnapshots(),
+    mPendingSnapshotAcks(),
     mLastConnectRequestData(),
     mLastConnectResponseData(),
     mShouldSkipChangeReplication(false),
@@ -227,6 +230,9 @@ void ReplicatorLink::UpdateStart(TimeMs now)
 }
 void ReplicatorLink::UpdateEnd(TimeMs now)
 {
+  // Acknowledge snapshots received this update (as applicable)
+  SendSnapshotAcks();
+
   // See if we should warn the user about their outgoing bandwidth utilization
   // this frame
   {
@@ -1190,7 +1196,23 @@ bool ReplicatorLink::DeserializeChange(const Message& message, TimeMs timestamp)
   }
 
   // Read replica channel
-  bool result = replicaChannel->Deserialize(bitStream, ReplicationPhase::Change, timestamp);
+  bool result = false;
+  if (replicaChannelType->GetBaselineDelta()) // Sent as a snapshot?
+  {
+    // Read snapshot
+    const ReplicaSnapshot* snapshot = ReadChangeSnapshot(message.GetChannelId(), bitStream);
+    if (!snapshot) // Unable?
+    {
+      // Assert(false);
+      return false;
+    }
+
+    // Read all replica properties from the snapshot
+    snapshot->mData.ClearBitsRead();
+    result = replicaChannel->Deserialize(snapshot->mData, ReplicationPhase::Change, timestamp, true);
+  }
+  else
+    result = replicaChannel->Deserialize(bitStream, ReplicationPhase::Change, timestamp);
   if (!result) // Unable?
   {
     // Assert(false);
@@ -1272,6 +1294,177 @@ bool ReplicatorLink::ReceiveChange(const Message& message)
   return DeserializeChange(message, timestamp);
 }
 
+bool ReplicatorLink::SendChangeSnapshot(ReplicaChannel* replicaChannel,
+                                        const Message& change,
+                                        const ReplicaSnapshot& snapshot)
+{
+  // Get message channel
+  MessageChannelId channelId = GetOutgoingReplicaChannel(replicaChannel);
+  if (channelId == 0) // Unable?
+  {
+    Assert(false);
+    return false;
+  }
+
+  // Get the latest snapshot they've acknowledged (if we still have it)
+  const ReplicaSnapshot* baseline = nullptr;
+  if (const ReplicaSnapshotSequence* ackSequence = mSnapshotAcks.FindPointer(channelId))
+    baseline = replicaChannel->GetSnapshot(*ackSequence);
+
+  // Encode snapshot against the baseline
+  // (Only possible if the snapshot is the same size, otherwise some variable
+  // sized property has changed size)
+  const BitStream& snapshotData = snapshot.mData;
+  BitStream delta;
+  if (baseline && baseline->mData.GetBitsWritten() == snapshotData.GetBitsWritten())
+  {
+    WriteSnapshotDelta(delta, snapshotData, baseline->mData);
+
+    // Larger than the snapshot itself?
+    if (delta.GetBitsWritten() >= snapshotData.GetBitsWritten())
+      baseline = nullptr;
+  }
+  else
+    baseline = nullptr;
+
+  // Write snapshot header
+  Message message(change, true);
+  BitStream& bitStream = message.GetData();
+  bitStream.Write(snapshot.mSequence);
+  bitStream.Write(baseline != nullptr);
+
+  // Write snapshot
+  if (baseline) // Encoded against the baseline?
+  {
+    bitStream.Write(ReplicaSnapshotOffset(ReplicaSnapshotSequence(snapshot.mSequence - baseline->mSequence)));
+    bitStream.AppendAll(delta);
+
+    // Update stats
+    GetLink()->RecordDeltaBitsSaved(snapshotData.GetBitsWritten() - delta.GetBitsWritten());
+  }
+  else
+    bitStream.AppendAll(snapshotData);
+
+  // Send change message
+  return SendChange(replicaChannel, message);
+}
+const ReplicaSnapshot* ReplicatorLink::ReadChangeSnapshot(MessageChannelId channelId, const BitStream& bitStream)
+{
+  // Read snapshot header
+  ReplicaSnapshotSequence sequence = 0;
+  bool hasBaseline = false;
+  if (!bitStream.Read(sequence) || !bitStream.Read(hasBaseline)) // Unable?
+    return nullptr;
+
+  // Get snapshots received on this message channel
+  ReplicaSnapshotHistoryPtr& history = mInReplicaSnapshots.FindOrInsert(channelId);
+  if (!history)
+    history = new ReplicaSnapshotHistory();
+
+  // Encoded against a baseline?
+  const ReplicaSnapshot* baseline = nullptr;
+  if (hasBaseline)
+  {
+    // Read baseline
+    ReplicaSnapshotOffset offset = 0;
+    if (!bitStream.Read(offset)) // Unable?
+      return nullptr;
+
+    // (The baseline can only be missing if a snapshot sent long after it
+    // arrived first and replaced it)
+    baseline = history->Find(ReplicaSnapshotSequence(sequence - offset.value()));
+    if (!baseline) // Unable?
+      return nullptr;
+  }
+
+  // Read snapshot
+  // (The baseline is never in the slot being replaced, it's always fewer than
+  // ReplicaSnapshotHistorySize sequence IDs older)
+  ReplicaSnapshot& snapshot = history->Store(sequence);
+  if (baseline)
+  {
+    if (!ReadSnapshotDelta(bitStream, baseline->mData, snapshot.mData)) // Unable?
+    {
+      snapshot.mIsValid = false;
+      return nullptr;
+    }
+  }
+  else
+    snapshot.mData.Append(bitStream, bitStream.GetBitsUnread());
+
+  // Acknowledge the snapshot at the end of the update (if it's the latest)
+  ReplicaSnapshotSequence& ackSequence = mPendingSnapshotAcks.FindOrInsert(channelId, sequence).first->second;
+  if (IsMoreRecentSnapshot(sequence, ackSequence))
+    ackSequence = sequence;
+
+  // Success
+  return &snapshot;
+}
+
+bool ReplicatorLink::SendSnapshotAcks()
+{
+  // No snapshots to acknowledge?
+  if (mPendingSnapshotAcks.Empty())
+    return true;
+
+  // Write snapshot acknowledgements
+  Message message(ReplicatorMessageType::SnapshotAcks);
+  BitStream& bitStream = message.GetData();
+  forRange (ReplicaSnapshotAcks::value_type& ack, mPendingSnapshotAcks.All())
+  {
+    bitStream.Write(true);
+    bitStream.Write(ack.first);
+    bitStream.Write(ack.second);
+  }
+  bitStream.Write(false);
+  mPendingSnapshotAcks.Clear();
+
+  // Send snapshot acknowledgements message
+  // (Unreliable, a lost acknowledgement is superseded by the next one)
+  Status status;
+  LinkPlugin::Send(status, message, false);
+  if (status.Failed()) // Unable?
+    return false;
+
+  // Success
+  return true;
+}
+bool ReplicatorLink::ReceiveSnapshotAcks(const Message& message)
+{
+  Assert(message.GetType() == ReplicatorMessageType::SnapshotAcks);
+
+  // Read snapshot acknowledgements
+  const BitStream& bitStream = message.GetData();
+  for (;;)
+  {
+    // Read 'Has Acknowledgement?' Flag
+    bool hasAck = false;
+    if (!bitStream.Read(hasAck)) // Unable?
+      return false;
+    if (!hasAck) // Done?
+      break;
+
+    // Read acknowledgement
+    MessageChannelId channelId = 0;
+    ReplicaSnapshotSequence sequence = 0;
+    if (!bitStream.Read(channelId) || !bitStream.Read(sequence)) // Unable?
+      return false;
+
+    // Message channel no longer open?
+    if (!GetLink()->GetOutgoingChannel(channelId))
+      continue;
+
+    // Keep only the latest acknowledgement
+    // (Acknowledgements are unreliable and may arrive out of order)
+    ReplicaSnapshotSequence& ackSequence = mSnapshotAcks.FindOrInsert(channelId, sequence).first->second;
+    if (IsMoreRecentSnapshot(sequence, ackSequence))
+      ackSequence = sequence;
+  }
+
+  // Success
+  return true;
+}
+
 bool ReplicatorLink::SendInterrupt(Message& message)
 {
   Assert(GetReplicator()->GetRole() == Role::Server);
@@ -1471,6 +1664,9 @@ void ReplicatorLink::CloseOutgoingReplicaChannel(ReplicaChannel* replicaChannel)
   // Close outgoing message channel
   LinkPlugin::GetLink()->CloseOutgoingChannel(iter->second);
 
+  // Forget acknowledged snapshots (if any)
+  mSnapshotAcks.EraseValue(iter->second);
+
   // Remove outgoing message channel
   mOutReplicaChannels.Erase(iter);
 }
@@ -1523,6 +1719,10 @@ void ReplicatorLink::ClearIncomingReplicaChannel(ReplicaChannel* replicaChannel)
 
   // Remove incoming message channel (in regular map)
   mInReplicaChannels.EraseValue(channelId);
+
+  // Forget received snapshots (if any)
+  mInReplicaSnapshots.EraseValue(channelId);
+  mPendingSnapshotAcks.EraseValue(channelId);
 }
 ReplicaChannel* ReplicatorLink::GetIncomingReplicaChannel(MessageChannelId channelId) const
 {
@@ -1849,6 +2049,10 @@ void ReplicatorLink::OnPluginMessageReceive(MoveReference<Message> message, bool
       ReceiveChange(message);
       break;
 
+    case ReplicatorMessageType::SnapshotAcks:
+      ReceiveSnapshotAcks(message);
+      break;
+
     case ReplicatorMessageType::ReverseReplicaChannels:
       ReceiveReverseReplicaChannels(message);
       break;
@@ -1900,6 +2104,10 @@ void ReplicatorLink::OnPluginMessageReceive(MoveReference<Message> message, bool
       ReceiveChange(message);
       break;
 
+    case ReplicatorMessageType::SnapshotAcks:
+      ReceiveSnapshotAcks(message);
+      break;
+
     case ReplicatorMessageType::Interrupt:
       continueProcessingCustomMessages = false;
       break;
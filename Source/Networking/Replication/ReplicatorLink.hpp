@@ -231,6 +231,22 @@ public:
   /// Returns true if successful, else false
   bool ReceiveChange(const Message& message);
 
+  /// Sends a replica channel change as the given snapshot, encoded against the
+  /// latest snapshot they've acknowledged (if it is still kept)
+  /// Returns true if successful, else false
+  bool SendChangeSnapshot(ReplicaChannel* replicaChannel, const Message& change, const ReplicaSnapshot& snapshot);
+  /// Reads and stores a replica channel change snapshot sent on the specified
+  /// incoming message channel, to be acknowledged at the end of the update
+  /// Returns the snapshot if successful, else nullptr
+  const ReplicaSnapshot* ReadChangeSnapshot(MessageChannelId channelId, const BitStream& bitStream);
+
+  /// Sends acknowledgements for the latest snapshots received this update (if
+  /// any) Returns true if successful, else false
+  bool SendSnapshotAcks();
+  /// Receives snapshot acknowledgements
+  /// Returns true if successful, else false
+  bool ReceiveSnapshotAcks(const Message& message);
+
   /// [Server] Sends an interrupt command
   /// Returns true if successful, else false
   bool SendInterrupt(Message& message);
@@ -325,6 +341,12 @@ public:
                                                       /// to replica channel)
   InReplicaChannelsFlipped mInReplicaChannelsFlipped; /// Incoming replica channel map flipped
                                                       /// (replica channel to message channel ID)
+  ReplicaSnapshotAcks mSnapshotAcks;                  /// Latest snapshots they've acknowledged
+                                                      /// (outgoing message channel ID to sequence ID)
+  InReplicaSnapshots mInReplicaSnapshots;             /// Received snapshots (incoming message channel ID
+                                                      /// to snapshot history)
+  ReplicaSnapshotAcks mPendingSnapshotAcks;           /// Latest snapshots received this update
+                                                      /// (incoming message channel ID to sequence ID)
   ConnectRequestData mLastConnectRequestData;         /// Last connect request data sent/received
   ConnectResponseData mLastConnectResponseData;       /// Last connect response data sent/received
   bool mShouldSkipChangeReplication;                  /// Should skip change replication?
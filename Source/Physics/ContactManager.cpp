@@ -13,6 +13,9 @@ ContactManager::ContactManager()
     sContactPool = new Memory::Pool("Contacts", Memory::GetNamedHeap("Physics"), sizeof(Contact), 1000);
   mContactPool = sContactPool;
   mSpace = nullptr;
+  mGjkTests = 0;
+  mGjkCacheHits = 0;
+  mNarrowPhaseCount = 0;
 }
 
 ContactManager::~ContactManager()
@@ -107,6 +110,67 @@ void ContactManager::DestroyContacts()
   }
 }
 
+void ContactManager::BeginNarrowPhase()
+{
+  ++mNarrowPhaseCount;
+  mGjkTests = 0;
+  mGjkCacheHits = 0;
+}
+
+void ContactManager::EndNarrowPhase()
+{
+  // Drop the caches of pairs the broad phase no longer reports
+  Array<u64> stalePairs;
+  GjkCacheMap::range range = mGjkCaches.All();
+  for(; !range.Empty(); range.PopFront())
+  {
+    if(range.Front().second.mNarrowPhase != mNarrowPhaseCount)
+      stalePairs.PushBack(range.Front().first);
+  }
+  for(size_t i = 0; i < stalePairs.Size(); ++i)
+    mGjkCaches.Erase(stalePairs[i]);
+}
+
+Intersection::GjkCache* ContactManager::GetGjkCache(const ColliderPair& pair)
+{
+  if(pair.A->mType >= Collider::cMultiConvexMesh || pair.B->mType >= Collider::cMultiConvexMesh)
+    return nullptr;
+
+  u64 pairId = pair.GetId();
+  GjkCacheEntry* entry = mGjkCaches.FindPointer(pairId);
+  if(entry == nullptr)
+  {
+    GjkCacheEntry newEntry;
+    newEntry.mFirstId = pair.A->mId;
+    entry = &mGjkCaches.Insert(pairId, newEntry).mValue->second;
+  }
+
+  // The shapes are tested in the pair's order, so a swapped pair sees the
+  // separating axis from the other side
+  Intersection::GjkCache& cache = entry->mCache;
+  if(entry->mFirstId != pair.A->mId)
+  {
+    cache.mSupportVector = -cache.mSupportVector;
+    Math::Swap(cache.mWitnessPoints[0], cache.mWitnessPoints[1]);
+    entry->mFirstId = pair.A->mId;
+  }
+
+  entry->mNarrowPhase = mNarrowPhaseCount;
+  cache.mUsed = false;
+  cache.mHit = false;
+  return &cache;
+}
+
+void ContactManager::RecordGjkCacheUse(Intersection::GjkCache* cache)
+{
+  if(cache == nullptr || !cache->mUsed)
+    return;
+
+  ++mGjkTests;
+  if(cache->mHit)
+    ++mGjkCacheHits;
+}
+
 Contact* ContactAlreadyExistsNew(Manifold* manifold)
 {
   Collider* collider1 = manifold->Objects[0];
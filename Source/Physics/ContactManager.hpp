@@ -27,8 +27,37 @@ public:
   /// Delete contacts that had been queued for delay destruction.
   void DestroyContacts();
 
+  /// Called around each narrow phase. Pairs that were given a Gjk cache in
+  /// between keep it for the next narrow phase, all other caches are dropped.
+  void BeginNarrowPhase();
+  void EndNarrowPhase();
+  /// Returns the Gjk cache kept for this pair, creating it if needed. Returns
+  /// nullptr for pairs with a complex collider since they run a test for
+  /// each of their sub-shapes.
+  Intersection::GjkCache* GetGjkCache(const ColliderPair& pair);
+  /// Counts whether the pair's last test used and hit its cache.
+  void RecordGjkCacheUse(Intersection::GjkCache* cache);
+
   PhysicsSpace* mSpace;
+
+  /// How many pairs ran Gjk in the last narrow phase and how many of those
+  /// were rejected by their cached separating axis alone.
+  uint mGjkTests;
+  uint mGjkCacheHits;
+
 private:
+  struct GjkCacheEntry
+  {
+    Intersection::GjkCache mCache;
+    /// The id of the collider that was first when the cache was filled
+    /// (the cached axis flips when the pair comes in the other order).
+    u32 mFirstId;
+    /// The narrow phase that last used this entry.
+    uint mNarrowPhase;
+  };
+  typedef HashMap<u64, GjkCacheEntry> GjkCacheMap;
+  GjkCacheMap mGjkCaches;
+  uint mNarrowPhaseCount;
   
   typedef InList<Contact, &Contact::SolverLink> ContactList;
   ContactList mContactsToDestroy;
@@ -198,12 +198,36 @@ void GenerateInternalEdgeInfo(GenericPhysicsMesh* mesh, TriangleInfoMap* infoMap
   }
 }
 
+/// Computes the edge info of a triangle against each triangle the tree reports.
+struct InternalEdgePairCallback
+{
+  InternalEdgePairCallback(PhysicsMesh* mesh, Triangle& triA, uint indexA, TriangleInfoMap* infoMap)
+    : mMesh(mesh), mTriA(triA), mIndexA(indexA), mInfoMap(infoMap)
+  {
+  }
+
+  void operator()(uint indexB)
+  {
+    //if not the same triangle, try to compute the voronoi edge info for the pair.
+    if(mIndexA != indexB)
+    {
+      Triangle triB = mMesh->GetTriangle(indexB);
+      ComputeEdgeInfoForTriangleA(mTriA, mIndexA, triB, mInfoMap);
+    }
+  }
+
+  PhysicsMesh* mMesh;
+  Triangle& mTriA;
+  uint mIndexA;
+  TriangleInfoMap* mInfoMap;
+};
+
 void GenerateInternalEdgeInfo(PhysicsMesh* mesh, TriangleInfoMap* infoMap)
 {
   infoMap->Clear();
 
   //get the tree and make sure it exists
-  typedef StaticAabbTree<uint> TreeType;
+  typedef PhysicsMesh::AabbTree TreeType;
   TreeType* treePointer = mesh->GetAabbTree();
   if(treePointer == nullptr)
   {
@@ -211,8 +235,6 @@ void GenerateInternalEdgeInfo(PhysicsMesh* mesh, TriangleInfoMap* infoMap)
                   "tree must not have been constructed yet.");
     return;
   }
-  //i believe the range macro below doesn't like pointers, so convert to a reference
-  TreeType& tree = *treePointer;
 
   //loop over all of the triangles in the mesh, for each triangle send it through
   //the tree to determine which triangles should be checked for the more
@@ -223,20 +245,8 @@ void GenerateInternalEdgeInfo(PhysicsMesh* mesh, TriangleInfoMap* infoMap)
     Triangle triA = mesh->GetTriangle(indexA);
     Aabb triAabb = ToAabb(triA);
 
-    Array<TreeType::NodeType*> scratchData;
-    AutoDeclare(range, tree.Query(triAabb,scratchData));
-    for(; !range.Empty(); range.PopFront())
-    //forRangeBroadphaseTree(StaticAabbTree<uint>, tree, Aabb, triAabb)
-    {
-      //Get the triangle index
-      uint indexB = range.Front();
-      //if not the same triangle, try to compute the voronoi edge info for the pair.
-      if(indexA != indexB)
-      {
-        Triangle triB = mesh->GetTriangle(indexB);
-        ComputeEdgeInfoForTriangleA(triA, indexA, triB, infoMap);
-      }
-    }
+    InternalEdgePairCallback callback(mesh, triA, indexA, infoMap);
+    treePointer->QueryAabb(triAabb, callback);
   }
 }
 
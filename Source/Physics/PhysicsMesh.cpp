@@ -3,6 +3,169 @@
 namespace Plasma
 {
 
+namespace
+{
+
+/// How far outside of a triangle (in barycentric coordinates) or past the
+/// current best time a ray may be and still be handed to the exact test.
+/// Candidates are only filtered with this so it can be generous.
+const real cRayTrianglePrefilterTolerance = real(0.001);
+
+/// Collects the triangles the tree reports for a ray cast and tests them four
+/// at a time. A batch first goes through a conservative ray vs. triangle test
+/// (four lanes at once with SSE) that drops any triangle that clearly misses or
+/// is further away than the current best hit, only the rest get the exact test.
+struct PhysicsMeshRayCallback
+{
+  PhysicsMeshRayCallback(PhysicsMesh* mesh, const Ray& localRay, ProxyResult& result, BaseCastFilter& filter) :
+      mMesh(mesh),
+      mRay(localRay),
+      mResult(result),
+      mFilter(filter),
+      mCount(0),
+      mHit(false)
+  {
+  }
+
+  void operator()(uint triIndex)
+  {
+    mIndices[mCount] = triIndex;
+    mTriangles[mCount] = mMesh->GetTriangle(triIndex);
+    ++mCount;
+
+    if(mCount == 4)
+      Flush();
+  }
+
+  void Flush()
+  {
+    uint mask = Prefilter();
+    for(uint i = 0; i < mCount; ++i)
+    {
+      if(mask & (1 << i))
+        mHit |= mMesh->CastRayTriangle(mRay, mTriangles[i], mIndices[i], mResult, mFilter);
+    }
+    mCount = 0;
+  }
+
+  /// Returns a bit for every triangle in the batch the ray might hit.
+  uint Prefilter()
+  {
+    real maxT = mResult.mDistance * (real(1.0) + cRayTrianglePrefilterTolerance) + cRayTrianglePrefilterTolerance;
+
+#if defined(USESSE)
+    using namespace Math::Simd;
+    // Unused lanes repeat the first triangle and are masked off at the end
+    float p0[3][4], e1[3][4], e2[3][4];
+    for(uint lane = 0; lane < 4; ++lane)
+    {
+      const Triangle& tri = mTriangles[lane < mCount ? lane : 0];
+      for(uint axis = 0; axis < 3; ++axis)
+      {
+        p0[axis][lane] = tri.p0[axis];
+        e1[axis][lane] = tri.p1[axis] - tri.p0[axis];
+        e2[axis][lane] = tri.p2[axis] - tri.p0[axis];
+      }
+    }
+
+    SimVec e1x = UnAlignedLoad(e1[0]), e1y = UnAlignedLoad(e1[1]), e1z = UnAlignedLoad(e1[2]);
+    SimVec e2x = UnAlignedLoad(e2[0]), e2y = UnAlignedLoad(e2[1]), e2z = UnAlignedLoad(e2[2]);
+    SimVec dx = Set(mRay.Direction.x), dy = Set(mRay.Direction.y), dz = Set(mRay.Direction.z);
+
+    // p = d x e2, det = e1 . p
+    SimVec px = Subtract(Multiply(dy, e2z), Multiply(dz, e2y));
+    SimVec py = Subtract(Multiply(dz, e2x), Multiply(dx, e2z));
+    SimVec pz = Subtract(Multiply(dx, e2y), Multiply(dy, e2x));
+    SimVec det = Add(Add(Multiply(e1x, px), Multiply(e1y, py)), Multiply(e1z, pz));
+
+    // s = start - p0, q = s x e1
+    SimVec sx = Subtract(Set(mRay.Start.x), UnAlignedLoad(p0[0]));
+    SimVec sy = Subtract(Set(mRay.Start.y), UnAlignedLoad(p0[1]));
+    SimVec sz = Subtract(Set(mRay.Start.z), UnAlignedLoad(p0[2]));
+    SimVec qx = Subtract(Multiply(sy, e1z), Multiply(sz, e1y));
+    SimVec qy = Subtract(Multiply(sz, e1x), Multiply(sx, e1z));
+    SimVec qz = Subtract(Multiply(sx, e1y), Multiply(sy, e1x));
+
+    // Parallel (or degenerate) triangles are left for the exact test to decide
+    SimVec parallel = Less(Abs(det), Set(Math::Epsilon()));
+    SimVec inverseDet = Divide(Set(real(1.0)), Select(det, Set(real(1.0)), parallel));
+
+    SimVec u = Multiply(Add(Add(Multiply(sx, px), Multiply(sy, py)), Multiply(sz, pz)), inverseDet);
+    SimVec v = Multiply(Add(Add(Multiply(dx, qx), Multiply(dy, qy)), Multiply(dz, qz)), inverseDet);
+    SimVec t = Multiply(Add(Add(Multiply(e2x, qx), Multiply(e2y, qy)), Multiply(e2z, qz)), inverseDet);
+
+    SimVec lower = Set(-cRayTrianglePrefilterTolerance);
+    SimVec inside = AndVec(GreaterEqual(u, lower), GreaterEqual(v, lower));
+    inside = AndVec(inside, LessEqual(Add(u, v), Set(real(1.0) + cRayTrianglePrefilterTolerance)));
+    inside = AndVec(inside, AndVec(GreaterEqual(t, lower), LessEqual(t, Set(maxT))));
+
+    uint mask = (uint)_mm_movemask_ps(OrVec(inside, parallel));
+    return mask & ((1 << mCount) - 1);
+#else
+    uint mask = 0;
+    for(uint i = 0; i < mCount; ++i)
+    {
+      const Triangle& tri = mTriangles[i];
+      Vec3 e1 = tri.p1 - tri.p0;
+      Vec3 e2 = tri.p2 - tri.p0;
+      Vec3 p = Math::Cross(mRay.Direction, e2);
+      real det = Math::Dot(e1, p);
+
+      if(Math::Abs(det) < Math::Epsilon())
+      {
+        mask |= 1 << i;
+        continue;
+      }
+
+      real inverseDet = real(1.0) / det;
+      Vec3 s = mRay.Start - tri.p0;
+      Vec3 q = Math::Cross(s, e1);
+      real u = Math::Dot(s, p) * inverseDet;
+      real v = Math::Dot(mRay.Direction, q) * inverseDet;
+      real t = Math::Dot(e2, q) * inverseDet;
+
+      real lower = -cRayTrianglePrefilterTolerance;
+      if(u >= lower && v >= lower && u + v <= real(1.0) + cRayTrianglePrefilterTolerance && t >= lower && t <= maxT)
+        mask |= 1 << i;
+    }
+    return mask;
+#endif
+  }
+
+  PhysicsMesh* mMesh;
+  const Ray& mRay;
+  ProxyResult& mResult;
+  BaseCastFilter& mFilter;
+
+  Triangle mTriangles[4];
+  uint mIndices[4];
+  uint mCount;
+  bool mHit;
+};
+
+/// Gathers every triangle whose aabb overlaps the query.
+struct PhysicsMeshOverlapCallback
+{
+  PhysicsMeshOverlapCallback(PhysicsMesh* mesh, TriangleArray& triangles, Array<uint>& triangleIds) :
+      mMesh(mesh),
+      mTriangles(triangles),
+      mTriangleIds(triangleIds)
+  {
+  }
+
+  void operator()(uint triIndex)
+  {
+    mTriangles.PushBack(mMesh->GetTriangle(triIndex));
+    mTriangleIds.PushBack(triIndex);
+  }
+
+  PhysicsMesh* mMesh;
+  TriangleArray& mTriangles;
+  Array<uint>& mTriangleIds;
+};
+
+}//namespace
+
 //-------------------------------------------------------------------PhysicsMesh
 DefinePhysicsRuntimeClone(PhysicsMesh);
 
@@ -17,10 +180,18 @@ LightningDefineType(PhysicsMesh, builder, type)
   LightningBindMethod(RuntimeClone);
 }
 
+PhysicsMesh::PhysicsMesh()
+{
+  mTreeLoaded = false;
+}
+
 void PhysicsMesh::Serialize(Serializer& stream)
 {
   GenericPhysicsMesh::Serialize(stream);
-  SerializeAabbTree(stream, mTree);
+  mTree.Serialize(stream);
+
+  if(stream.GetMode() == SerializerMode::Loading)
+    mTreeLoaded = !mTree.Empty();
 }
 
 void PhysicsMesh::Initialize()
@@ -31,7 +202,7 @@ void PhysicsMesh::Initialize()
 void PhysicsMesh::Unload()
 {
   GenericPhysicsMesh::Unload();
-  mTree.DeleteTree();
+  mTree.Clear();
 }
 
 void PhysicsMesh::OnResourceModified()
@@ -52,6 +223,13 @@ void PhysicsMesh::ForceRebuild()
 
 void PhysicsMesh::RebuildMidPhase()
 {
+  // A tree cooked for exactly these triangles doesn't need to be built again
+  // (any later modification has to though)
+  bool useLoadedTree = mTreeLoaded && mTree.GetItemCount() == GetTriangleCount();
+  mTreeLoaded = false;
+  if(useLoadedTree)
+    return;
+
   GenerateTree();
 }
 
@@ -62,29 +240,20 @@ void PhysicsMesh::GenerateInternalEdgeData()
 
 bool PhysicsMesh::CastRay(const Ray& localRay, ProxyResult& result, BaseCastFilter& filter)
 {
-  bool triangleHit = false;
   result.mTime = Math::PositiveMax();
 
   // Query the aabb tree for possible triangles. Test all triangles whose aabbs we hit.
-  forRangeBroadphaseTree(StaticAabbTree<uint>, mTree, Ray, localRay)
-  {
-    uint triIndex = range.Front();
-    Triangle tri = GetTriangle(triIndex);
-    triangleHit |= CastRayTriangle(localRay, tri, triIndex, result, filter);
-  }
+  PhysicsMeshRayCallback callback(this, localRay, result, filter);
+  mTree.QueryRay(localRay, callback);
+  callback.Flush();
 
-  return triangleHit;
+  return callback.mHit;
 }
 
 void PhysicsMesh::GetOverlappingTriangles(Aabb& aabb, TriangleArray& triangles, Array<uint>& triangleIds)
 {
-  forRangeBroadphaseTree(StaticAabbTree<uint>, mTree, Aabb, aabb)
-  {
-    // Get the triangle index
-    uint triIndex = range.Front();
-    triangles.PushBack(GetTriangle(triIndex));
-    triangleIds.PushBack(triIndex);
-  }
+  PhysicsMeshOverlapCallback callback(this, triangles, triangleIds);
+  mTree.QueryAabb(aabb, callback);
 }
 
 void PhysicsMesh::CopyTo(PhysicsMesh* destination)
@@ -93,38 +262,21 @@ void PhysicsMesh::CopyTo(PhysicsMesh* destination)
   ForceRebuild();
 }
 
-StaticAabbTree<uint>* PhysicsMesh::GetAabbTree()
+PhysicsMesh::AabbTree* PhysicsMesh::GetAabbTree()
 {
   return &mTree;
 }
 
 void PhysicsMesh::GenerateTree()
 {
-  // Clear the old tree
-  mTree.DeleteTree();
-
-  // Build the Aabb-Tree
-  mTree.SetPartitionMethod(PartitionMethods::MinimizeVolumeSum);
-
-  // Dummy proxy. They will not be needed.
-  BroadPhaseProxy proxy;
-
   size_t triangleCount = GetTriangleCount();
+  Array<Aabb> triangleAabbs;
+  triangleAabbs.Resize(triangleCount);
   for(size_t triIndex = 0; triIndex < triangleCount; ++triIndex)
-  {
-    Triangle tri = GetTriangle(triIndex);
-    
-    // Create the broad phase data.
-    BaseBroadPhaseData<uint> data;
-    data.mClientData = (uint)triIndex;
-    data.mAabb = ToAabb(tri);
-
-    // Insert it into the tree
-    mTree.CreateProxy(proxy, data);
-  }
+    triangleAabbs[triIndex] = ToAabb(GetTriangle(triIndex));
 
-  // Construct the tree
-  mTree.Construct();
+  // The tree reports the index of each aabb, which is the triangle index
+  mTree.Build(triangleAabbs);
 }
 
 //-------------------------------------------------------------------PhysicsMeshManager
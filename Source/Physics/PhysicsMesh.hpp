@@ -10,7 +10,9 @@ class PhysicsMesh : public GenericPhysicsMesh
 {
 public:
   LightningDeclareType(PhysicsMesh, TypeCopyMode::ReferenceType);
-  typedef StaticAabbTree<uint> AabbTree;
+  typedef QuantizedAabbTree AabbTree;
+
+  PhysicsMesh();
 
   //-------------------------------------------------------------------Resource Interface
   void Serialize(Serializer& stream) override;
@@ -39,13 +41,16 @@ public:
   /// Copy all relevant info for runtime clone.
   void CopyTo(PhysicsMesh* destination);
   /// Returns the mesh's Aabb tree.
-  StaticAabbTree<uint>* GetAabbTree();
+  AabbTree* GetAabbTree();
   
 private:
   void GenerateTree();
 
   /// Aabb Tree used for fast ray casts and triangle lookups.
-  StaticAabbTree<uint> mTree;
+  AabbTree mTree;
+  /// Set when the tree was cooked into the file that was just loaded so the
+  /// first rebuild can use it instead of building it again.
+  bool mTreeLoaded;
 };
 
 //-------------------------------------------------------------------PhysicsMeshManager
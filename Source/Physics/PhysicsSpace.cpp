@@ -112,6 +112,57 @@ bool ClientPairSorter(ClientPair& a, ClientPair& b)
   return pairA > pairB;
 }
 
+//-------------------------------------------------------------------BatchCastJob
+/// Fewer casts than this are not worth handing to another thread.
+static const uint cBatchCastsPerJob = 64;
+/// The most jobs a BatchCast is split into (the calling thread casts one more part).
+static const uint cMaxBatchCastJobs = 7;
+
+/// Performs part of the casts in a BatchCast.
+class BatchCastJob : public Job
+{
+public:
+  void Execute() override
+  {
+    ZoneScoped;
+    mSpace->CastBatchRange(*mBatch, mStart, mCount, *mRayFilter, *mVolumeFilter, *mResults);
+    mJobsRunning->DecrementCount();
+  }
+
+  PhysicsSpace* mSpace;
+  BatchCast* mBatch;
+  uint mStart;
+  uint mCount;
+  CastFilter* mRayFilter;
+  CastFilter* mVolumeFilter;
+  CastResultArray* mResults;
+  CountdownEvent* mJobsRunning;
+};
+
+//-------------------------------------------------------------------IntegrateVelocityJob
+/// Fewer bodies than this are not worth handing to another thread.
+static const uint cBodiesPerIntegrationJob = 128;
+/// The most jobs velocity integration is split into (the calling thread integrates one more part).
+static const uint cMaxIntegrationJobs = 7;
+
+/// Integrates the velocity of part of the awake bodies.
+class IntegrateVelocityJob : public Job
+{
+public:
+  void Execute() override
+  {
+    ZoneScoped;
+    mSpace->IntegrateVelocityRange(mStart, mCount, mDt);
+    mJobsRunning->DecrementCount();
+  }
+
+  PhysicsSpace* mSpace;
+  uint mStart;
+  uint mCount;
+  real mDt;
+  CountdownEvent* mJobsRunning;
+};
+
 //-------------------------------------------------------------------PhysicsSpace
 LightningDefineType(PhysicsSpace, builder, type)
 {
@@ -158,6 +209,9 @@ LightningDefineType(PhysicsSpace, builder, type)
   LightningBindOverloadedMethod(CastSphere, LightningInstanceOverload(CastResultsRange, const Sphere&, uint, CastFilter&));
   LightningBindOverloadedMethod(CastFrustum, LightningInstanceOverload(CastResultsRange, const Frustum&, uint, CastFilter&));
   LightningBindOverloadedMethod(CastCollider, LightningInstanceOverload(CastResultsRange, Vec3Param, Collider*, CastFilter&));
+  // Batch Cast
+  LightningBindOverloadedMethod(CastBatch, LightningInstanceOverload(void, BatchCast&));
+  LightningBindOverloadedMethod(CastBatch, LightningInstanceOverload(void, BatchCast&, CastFilter&));
   // Event Dispatching in Region
   LightningBindOverloadedMethod(DispatchWithinSphere, LightningInstanceOverload(void, const Sphere&, StringParam, Event*));
   LightningBindOverloadedMethod(DispatchWithinSphere, LightningInstanceOverload(void, const Sphere&, CastFilter&, StringParam, Event*));
@@ -710,33 +764,98 @@ void PhysicsSpace::IterateTimestep(real dt)
 void PhysicsSpace::IntegrateBodiesVelocity(real dt)
 {
   ZoneScoped;
-  RigidBodyList::range range = mRigidBodies.All();
 
-  while(!range.Empty())
+  // Only the active list is walked, bodies in the inactive list cost nothing
+  mIntegrationBodies.Clear();
+  RigidBodyList::range range = mRigidBodies.All();
+  for(; !range.Empty(); range.PopFront())
   {
     RigidBody& body = range.Front();
-    range.PopFront();
 
     bool isKinematic = body.GetKinematic();
     ErrorIf(isKinematic, "Kinematic object should not be in the rigid body list.");
-    
-    ApplyGlobalEffects(&body, dt);
-    body.UpdateBodyEffects(dt);
+
+    mIntegrationBodies.PushBack(&body);
+  }
+
+  ApplyGlobalEffects(mIntegrationBodies, dt);
+
+  // Body effects can send events and bodies that fell asleep change lists,
+  // so both of those stay on this thread. Only the bodies that still have
+  // to be integrated are kept in the array.
+  uint integrationCount = 0;
+  for(uint i = 0; i < mIntegrationBodies.Size(); ++i)
+  {
+    RigidBody* body = mIntegrationBodies[i];
+    body->UpdateBodyEffects(dt);
 
     // Check for asleep bodies
-    if(body.mState.IsSet(RigidBodyStates::Asleep))
+    if(body->mState.IsSet(RigidBodyStates::Asleep))
     {
       // Change to the inactive list
-      mRigidBodies.Erase(&body);
-      mInactiveRigidBodies.PushBack(&body);
+      mRigidBodies.Erase(body);
+      mInactiveRigidBodies.PushBack(body);
       continue;
     }
 
-    if(!body.GetStatic())
-      Physics::Integration::IntegrateVelocity(&body, dt);
+    if(body->GetStatic())
+    {
+      body->mForceAccumulator.ZeroOut();
+      body->mTorqueAccumulator.ZeroOut();
+      continue;
+    }
 
-    body.mForceAccumulator.ZeroOut();
-    body.mTorqueAccumulator.ZeroOut();
+    mIntegrationBodies[integrationCount] = body;
+    ++integrationCount;
+  }
+  mIntegrationBodies.Resize(integrationCount);
+
+  // Integrating velocity only touches the body being integrated, so divide
+  // the bodies among jobs with this thread integrating the first part
+  uint partCount = (integrationCount + cBodiesPerIntegrationJob - 1) / cBodiesPerIntegrationJob;
+  uint jobCount = 0;
+  if(ThreadingEnabled && partCount > 1)
+    jobCount = Math::Min(partCount, cMaxIntegrationJobs + 1) - 1;
+
+  if(jobCount == 0)
+  {
+    IntegrateVelocityRange(0, integrationCount, dt);
+    return;
+  }
+
+  // Spread the bodies evenly across every part
+  uint partSize = (integrationCount + jobCount) / (jobCount + 1);
+
+  CountdownEvent jobsRunning;
+  for(uint i = 1; i <= jobCount; ++i)
+  {
+    uint start = i * partSize;
+
+    IntegrateVelocityJob* job = new IntegrateVelocityJob();
+    job->mSpace = this;
+    job->mStart = start;
+    job->mCount = Math::Min(partSize, integrationCount - start);
+    job->mDt = dt;
+    job->mJobsRunning = &jobsRunning;
+
+    jobsRunning.IncrementCount();
+    PL::gJobs->AddJob(job);
+  }
+
+  IntegrateVelocityRange(0, partSize, dt);
+  jobsRunning.Wait();
+}
+
+void PhysicsSpace::IntegrateVelocityRange(uint start, uint count, real dt)
+{
+  uint end = start + count;
+  for(uint i = start; i < end; ++i)
+  {
+    RigidBody* body = mIntegrationBodies[i];
+    Physics::Integration::IntegrateVelocity(body, dt);
+
+    body->mForceAccumulator.ZeroOut();
+    body->mTorqueAccumulator.ZeroOut();
   }
 }
 
@@ -812,6 +931,8 @@ void PhysicsSpace::NarrowPhase()
   Array<NodePointerPair> Collisions;
   Collisions.SetAllocator(allocator);
 
+  mContactManager->BeginNarrowPhase();
+
   size_t size = mPossiblePairs.Size();
   for(size_t pairIndex = 0; pairIndex < size; ++pairIndex)
   {
@@ -821,8 +942,16 @@ void PhysicsSpace::NarrowPhase()
     // Convert the proxy to a collider
     ColliderPair pair(collider1, collider2);
 
-    // Test for collision
-    if(!mCollisionManager->TestCollision(pair, tempManifolds))
+    // Test for collision, letting Gjk start from this pair's last result
+    Intersection::GjkCache* gjkCache = mContactManager->GetGjkCache(pair);
+    bool collided;
+    {
+      Intersection::GjkCacheScope gjkCacheScope(gjkCache);
+      collided = mCollisionManager->TestCollision(pair, tempManifolds);
+    }
+    mContactManager->RecordGjkCacheUse(gjkCache);
+
+    if(!collided)
     {
       tempManifolds.Clear();
       continue;
@@ -847,6 +976,10 @@ void PhysicsSpace::NarrowPhase()
     tempManifolds.Clear();
   }
 
+  mContactManager->EndNarrowPhase();
+  TracyPlot("Gjk Tests", (int64_t)mContactManager->mGjkTests);
+  TracyPlot("Gjk Cache Hits", (int64_t)mContactManager->mGjkCacheHits);
+
   mBroadPhase->RecordFrameResults(Collisions);
 
   // We have all connections for the frame so build the islands.
@@ -1159,6 +1292,144 @@ CastResultsRange PhysicsSpace::CastCollider(Vec3Param offset, Collider* testColl
   return CastResultsRange(results);
 }
 
+void PhysicsSpace::CastBatch(BatchCast& batch)
+{
+  CastFilter filter;
+  CastBatch(batch, filter);
+}
+
+void PhysicsSpace::CastBatch(BatchCast& batch, CastFilter& filter)
+{
+  // Push any changes made to objects once for the whole batch
+  PushBroadPhaseQueue();
+
+  uint castCount = batch.mCasts.Size();
+  batch.mResults.Clear();
+  batch.mResultStarts.Resize(castCount);
+  batch.mResultCounts.Resize(castCount);
+
+  // Rays cast with the filter as given while every other cast ignores
+  // IgnoreInternalCasts (same as the single casts). Copies are made here so
+  // the casting threads never modify a shared filter.
+  CastFilter rayFilter = filter;
+  CastFilter volumeFilter = filter;
+  volumeFilter.ClearFlag(BaseCastFilterFlags::IgnoreInternalCasts);
+
+  // Divide the casts among jobs with this thread casting the first part.
+  // Filter callbacks dispatch events into script, the tracker records
+  // timings for every cast and a recording appends every cast to its stream,
+  // so all of those have to stay on this thread.
+  uint partCount = (castCount + cBatchCastsPerJob - 1) / cBatchCastsPerJob;
+  uint jobCount = 0;
+  if(ThreadingEnabled && partCount > 1 && filter.mCallbackObject == nullptr && !mBroadPhase->IsTracking() &&
+     mBroadPhase->GetRecording() == nullptr)
+    jobCount = Math::Min(partCount, cMaxBatchCastJobs + 1) - 1;
+
+  if(jobCount == 0)
+  {
+    CastBatchRange(batch, 0, castCount, rayFilter, volumeFilter, batch.mResults);
+    return;
+  }
+
+  // Nothing may be modified while the casts run
+  mBroadPhase->PrepareForCasts();
+
+  // Spread the casts evenly across every part
+  uint partSize = (castCount + jobCount) / (jobCount + 1);
+
+  // Each job appends its results to its own array (only as many as were
+  // actually hit) and they're joined in order once every part is done. This
+  // thread's part goes straight into the batch.
+  Array<CastResultArray> partResults;
+  partResults.Resize(jobCount + 1);
+
+  CountdownEvent jobsRunning;
+  for(uint i = 1; i <= jobCount; ++i)
+  {
+    uint start = i * partSize;
+
+    BatchCastJob* job = new BatchCastJob();
+    job->mSpace = this;
+    job->mBatch = &batch;
+    job->mStart = start;
+    job->mCount = Math::Min(partSize, castCount - start);
+    job->mRayFilter = &rayFilter;
+    job->mVolumeFilter = &volumeFilter;
+    job->mResults = &partResults[i];
+    job->mJobsRunning = &jobsRunning;
+
+    jobsRunning.IncrementCount();
+    PL::gJobs->AddJob(job);
+  }
+
+  CastBatchRange(batch, 0, partSize, rayFilter, volumeFilter, batch.mResults);
+  jobsRunning.Wait();
+
+  for(uint i = 1; i <= jobCount; ++i)
+  {
+    // Starts were recorded relative to the part's own array
+    uint start = i * partSize;
+    uint end = Math::Min(start + partSize, castCount);
+    uint offset = batch.mResults.Size();
+    for(uint castIndex = start; castIndex < end; ++castIndex)
+      batch.mResultStarts[castIndex] += offset;
+
+    batch.mResults.Append(partResults[i].All());
+  }
+}
+
+void PhysicsSpace::CastBatchRange(BatchCast& batch, uint start, uint count,
+                                  CastFilter& rayFilter, CastFilter& volumeFilter,
+                                  CastResultArray& resultsOut)
+{
+  // Reuse the same results for every cast in this part
+  uint maxResults = batch.mMaxResultsPerCast;
+  CastResults rayResults(maxResults, rayFilter);
+  CastResults volumeResults(maxResults, volumeFilter);
+
+  for(uint i = start; i < start + count; ++i)
+  {
+    BatchCast::Cast& cast = batch.mCasts[i];
+    CastResults& results = (cast.mType == BatchCastType::Ray) ? rayResults : volumeResults;
+    results.Clear();
+
+    switch(cast.mType)
+    {
+      case BatchCastType::Ray:
+      {
+        mBroadPhase->CastRay(cast.mA, cast.mB.AttemptNormalized(), results.mResults);
+        break;
+      }
+      case BatchCastType::Segment:
+      {
+        mBroadPhase->CastSegment(cast.mA, cast.mB, results.mResults);
+        break;
+      }
+      case BatchCastType::Aabb:
+      {
+        Aabb aabb;
+        aabb.mMin = cast.mA;
+        aabb.mMax = cast.mB;
+        mBroadPhase->CastAabb(aabb, results.mResults);
+        break;
+      }
+      case BatchCastType::Sphere:
+      {
+        mBroadPhase->CastSphere(Sphere(cast.mA, cast.mB.x), results.mResults);
+        break;
+      }
+    }
+    results.ConvertToColliders();
+
+    // Only the results that were hit are kept
+    uint resultCount = (uint)results.Size();
+    batch.mResultStarts[i] = resultsOut.Size();
+    batch.mResultCounts[i] = resultCount;
+    for(uint r = 0; r < resultCount; ++r)
+      resultsOut.PushBack(results[r]);
+  }
+}
+
 SweepResultRange PhysicsSpace::SweepCollider(Collider* collider, Vec3Param velocity, real dt, CastFilter& filter)
 {
   // No Collider, return an empty range
@@ -1388,35 +1659,28 @@ void PhysicsSpace::ApplyHierarchyEffects(real dt)
   }
 }
 
-void PhysicsSpace::ApplyGlobalEffects(RigidBody* body, real dt)
+void PhysicsSpace::ApplyGlobalEffects(RigidBodyArray& bodies, real dt)
 {
+  // Apply each effect to every body before moving on to the next effect so
+  // the effect's data stays in cache and inactive effects are only checked once
   PhysicsEffectList::range range = mGlobalEffects.All();
-
-  // Deal with IgnoreSpaceEffects
-  IgnoreSpaceEffects* effectsToIgnore = body->mSpaceEffectsToIgnore;
-  if(effectsToIgnore)
+  for(; !range.Empty(); range.PopFront())
   {
-    while(!range.Empty())
-    {
-      PhysicsEffect& effect = range.Front();
-
-      // Skip if this effect type is ignored or not active
-      if(!effectsToIgnore->IsIgnored(&effect) && effect.GetActive())
-        effect.ApplyEffect(body, dt);
+    PhysicsEffect& effect = range.Front();
+    if(!effect.GetActive())
+      continue;
 
-      range.PopFront();
-    }
-    return;
-  }
+    for(uint i = 0; i < bodies.Size(); ++i)
+    {
+      RigidBody* body = bodies[i];
 
-  while(!range.Empty())
-  {
-    PhysicsEffect& effect = range.Front();
+      // Deal with IgnoreSpaceEffects
+      IgnoreSpaceEffects* effectsToIgnore = body->mSpaceEffectsToIgnore;
+      if(effectsToIgnore != nullptr && effectsToIgnore->IsIgnored(&effect))
+        continue;
 
-    if(effect.GetActive())
       effect.ApplyEffect(body, dt);
-
-    range.PopFront();
+    }
   }
 }
 
@@ -5,6 +5,7 @@ namespace Plasma
 
 class BroadPhasePackage;
 typedef Array<Collider*> ColliderArray;
+typedef Array<RigidBody*> RigidBodyArray;
 
 DeclareBitField3(PhysicsSpaceFlags, AllowSleep, Mode2D, Deterministic);
 
@@ -233,6 +234,15 @@ public:
   /// This returns up to maxCount number of objects.
   CastResultsRange CastCollider(Vec3Param offset, Collider* testCollider, CastFilter& filter);
 
+  //------------------------------------------------------------- Batch Casting
+  /// Performs every cast in the batch at once using a default CastFilter.
+  /// The results are stored in the batch.
+  void CastBatch(BatchCast& batch);
+  /// Performs every cast in the batch at once using the given filter. The
+  /// casts are spread across worker threads unless the filter has a callback
+  /// object (the callback event has to be sent on the calling thread).
+  void CastBatch(BatchCast& batch, CastFilter& filter);
+
   //------------------------------------------------------------- Collider Sweeping
   /// Performs a swept cast with a collider's shape and a given velocity.
   /// Returns a range of all objects the collider could've hit within 'dt' time.
@@ -309,6 +319,18 @@ public:
 
 private:
   friend class PhysicsEngine;
+  friend class BatchCastJob;
+  friend class IntegrateVelocityJob;
+
+  /// Performs casts [start, start + count) of the batch without pushing the
+  /// broad phase queue, so several threads can cast parts of one batch. The
+  /// results are appended to resultsOut and each cast's start is relative to it.
+  void CastBatchRange(BatchCast& batch, uint start, uint count,
+                      CastFilter& rayFilter, CastFilter& volumeFilter,
+                      CastResultArray& resultsOut);
+  /// Integrates the velocity of bodies [start, start + count) of the
+  /// integration bodies, so several threads can integrate parts of them.
+  void IntegrateVelocityRange(uint start, uint count, real dt);
 
   /// Serializes the broad phase information.
   void SerializeBroadPhases(Serializer& stream);
@@ -324,8 +346,9 @@ private:
   void UpdateRegions(real dt);
   /// Apply misc. effects sitting in the middle of a hierarchy
   void ApplyHierarchyEffects(real dt);
-  /// Apply global effects (PhysicsSpace/LevelSettings) to the given body
-  void ApplyGlobalEffects(RigidBody* body, real dt);
+  /// Apply global effects (PhysicsSpace/LevelSettings) to the given bodies,
+  /// one effect at a time.
+  void ApplyGlobalEffects(RigidBodyArray& bodies, real dt);
 
   /// Checks all inactive objects to see if they should be woken up.
   void WakeInactiveMovingBodies();
@@ -371,6 +394,9 @@ private:
   RigidBodyList  mRigidBodies;
   /// Asleep bodies.
   RigidBodyList  mInactiveRigidBodies;
+  /// The awake bodies whose velocity is being integrated this step. Kept
+  /// around to avoid allocating every step.
+  RigidBodyArray mIntegrationBodies;
   /// Kinematic bodies that have had a transform update called in the last frame.
   RigidBodyList  mMovingKinematicBodies;
   /// Kinematic bodies that had a transform update called two frames ago.
@@ -190,6 +190,7 @@ LightningDefineStaticLibrary(PhysicsLibrary)
   LightningInitializeType(CastFilter);
   LightningInitializeType(CastResult);
   LightningInitializeType(CastResults);
+  LightningInitializeType(BatchCast);
   LightningInitializeType(SweepResult);
 
   // Misc
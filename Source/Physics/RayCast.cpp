@@ -349,9 +349,135 @@ void CastResultsRange::PopFront()
   mRange.PopFront();
 }
 
+CastResultsRange::CastResultsRange(CastResultArray::range results)
+{
+  size_t count = results.Size();
+  mArray.Resize(count);
+  for(size_t i = 0; i < count; ++i)
+    mArray[i] = results[i];
+  mRange = mArray.All();
+}
+
 uint CastResultsRange::Size()
 {
   return (uint)mRange.Size();
 }
 
+//-------------------------------------------------------------------BatchCast
+LightningDefineType(BatchCast, builder, type)
+{
+  type->CreatableInScript = true;
+
+  PlasmaBindDocumented();
+
+  LightningBindDefaultCopyDestructor();
+
+  LightningBindMethod(AddRay);
+  LightningBindMethod(AddSegment);
+  LightningBindMethod(AddAabb);
+  LightningBindMethod(AddSphere);
+  LightningBindMethod(Clear);
+  LightningBindGetterProperty(CastCount);
+  LightningBindGetterSetterProperty(MaxResultsPerCast);
+  LightningBindMethod(HasHit);
+  LightningBindMethod(GetFirstResult);
+  LightningBindMethod(GetResults);
+}
+
+BatchCast::BatchCast()
+{
+  mMaxResultsPerCast = 1;
+}
+
+uint BatchCast::AddRay(const Ray& ray)
+{
+  return AddCast(BatchCastType::Ray, ray.Start, ray.Direction);
+}
+
+uint BatchCast::AddSegment(const Segment& segment)
+{
+  return AddCast(BatchCastType::Segment, segment.Start, segment.End);
+}
+
+uint BatchCast::AddAabb(const Aabb& aabb)
+{
+  return AddCast(BatchCastType::Aabb, aabb.mMin, aabb.mMax);
+}
+
+uint BatchCast::AddSphere(const Sphere& sphere)
+{
+  return AddCast(BatchCastType::Sphere, sphere.mCenter, Vec3(sphere.mRadius, 0, 0));
+}
+
+void BatchCast::Clear()
+{
+  mCasts.Clear();
+  mResults.Clear();
+  mResultStarts.Clear();
+  mResultCounts.Clear();
+}
+
+uint BatchCast::GetCastCount() const
+{
+  return mCasts.Size();
+}
+
+uint BatchCast::GetMaxResultsPerCast() const
+{
+  return mMaxResultsPerCast;
+}
+
+void BatchCast::SetMaxResultsPerCast(uint maxResults)
+{
+  // Same limits as CastResults
+  const uint maxAllowedResults = 100000;
+  mMaxResultsPerCast = Math::Clamp(maxResults, 1u, maxAllowedResults);
+}
+
+bool BatchCast::HasHit(uint castIndex)
+{
+  if(!ValidateIndex(castIndex))
+    return false;
+
+  return mResultCounts[castIndex] != 0;
+}
+
+CastResult BatchCast::GetFirstResult(uint castIndex)
+{
+  if(!ValidateIndex(castIndex) || mResultCounts[castIndex] == 0)
+    return CastResult();
+
+  return mResults[mResultStarts[castIndex]];
+}
+
+CastResultsRange BatchCast::GetResults(uint castIndex)
+{
+  if(!ValidateIndex(castIndex))
+    return CastResultsRange();
+
+  return CastResultsRange(mResults.SubRange(mResultStarts[castIndex], mResultCounts[castIndex]));
+}
+
+uint BatchCast::AddCast(BatchCastType::Enum type, Vec3Param a, Vec3Param b)
+{
+  Cast& cast = mCasts.PushBack();
+  cast.mType = type;
+  cast.mA = a;
+  cast.mB = b;
+  return mCasts.Size() - 1;
+}
+
+bool BatchCast::ValidateIndex(uint castIndex)
+{
+  // Results only exist once the batch has been cast
+  if(castIndex >= mResultCounts.Size())
+  {
+    String msg = String::Format("Index %d is invalid. There are only results for %d casts",
+                                castIndex, mResultCounts.Size());
+    DoNotifyException("Invalid index", msg);
+    return false;
+  }
+  return true;
+}
+
 }//namespace Plasma
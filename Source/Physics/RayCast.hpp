@@ -171,6 +171,7 @@ struct CastResultsRange
   CastResultsRange(){}
   CastResultsRange(const CastResults& castResults);
   CastResultsRange(const CastResultsRange& rhs);
+  CastResultsRange(CastResultArray::range results);
 
   bool Empty();
   CastResult& Front();
@@ -181,4 +182,67 @@ struct CastResultsRange
   CastResultArray mArray;
 };
 
+//-------------------------------------------------------------------BatchCast
+/// The kinds of casts that can be performed together in a BatchCast.
+DeclareEnum4(BatchCastType, Ray, Segment, Aabb, Sphere);
+
+/// A list of casts that a PhysicsSpace performs all at once (see
+/// PhysicsSpace.CastBatch). Every cast uses the same filter and the casts are
+/// spread across worker threads. The results of all casts are stored back to
+/// back and looked up by the index that adding the cast returned.
+class BatchCast
+{
+public:
+  LightningDeclareType(BatchCast, TypeCopyMode::ReferenceType);
+
+  BatchCast();
+
+  /// Adds a ray cast and returns its index.
+  uint AddRay(const Ray& ray);
+  /// Adds a segment cast and returns its index.
+  uint AddSegment(const Segment& segment);
+  /// Adds an aabb cast and returns its index.
+  uint AddAabb(const Aabb& aabb);
+  /// Adds a sphere cast and returns its index.
+  uint AddSphere(const Sphere& sphere);
+  /// Removes all casts and their results.
+  void Clear();
+
+  /// How many casts have been added.
+  uint GetCastCount() const;
+  /// The most objects that each cast can return, sorted by distance.
+  uint GetMaxResultsPerCast() const;
+  void SetMaxResultsPerCast(uint maxResults);
+
+  /// Whether the cast at the given index hit anything.
+  bool HasHit(uint castIndex);
+  /// The closest object hit by the cast at the given index (if any).
+  CastResult GetFirstResult(uint castIndex);
+  /// All objects hit by the cast at the given index.
+  CastResultsRange GetResults(uint castIndex);
+
+private:
+  friend class PhysicsSpace;
+
+  struct Cast
+  {
+    BatchCastType::Enum mType;
+    /// Start and direction for rays, start and end for segments, min and max
+    /// for aabbs, and center and radius (in the x of mB) for spheres.
+    Vec3 mA;
+    Vec3 mB;
+  };
+
+  uint AddCast(BatchCastType::Enum type, Vec3Param a, Vec3Param b);
+  bool ValidateIndex(uint castIndex);
+
+  Array<Cast> mCasts;
+  /// Results of every cast stored back to back. The results of cast i
+  /// start at mResultStarts[i] and there are mResultCounts[i] of them.
+  CastResultArray mResults;
+  Array<uint> mResultStarts;
+  Array<uint> mResultCounts;
+  uint mMaxResultsPerCast;
+};
+
 }//namespace Plasma
@@ -0,0 +1,72 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+// Without memory mapping the whole file is read into memory when opened.
+struct MappedFilePrivateData
+{
+  MappedFilePrivateData()
+  {
+    mBuffer = nullptr;
+  }
+
+  ::byte* mBuffer;
+};
+
+MappedFile::MappedFile()
+{
+  PlasmaConstructPrivateData(MappedFilePrivateData);
+  mData = nullptr;
+  mSize = 0;
+  mOpen = false;
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+  PlasmaDestructPrivateData(MappedFilePrivateData);
+}
+
+bool MappedFile::Open(StringParam filePath, FileAccessPattern::Enum accessPattern, Status* status)
+{
+  PlasmaGetPrivateData(MappedFilePrivateData);
+  Close();
+
+  if (!FileExists(filePath))
+  {
+    if (status)
+      status->SetFailed(String::Format("File '%s' does not exist", filePath.c_str()), FileSystemErrors::FileNotFound);
+    return false;
+  }
+
+  size_t size = 0;
+  self->mBuffer = ReadFileIntoMemory(filePath.c_str(), size);
+  if (self->mBuffer == nullptr && size != 0)
+  {
+    if (status)
+      status->SetFailed(String::Format("Failed to read file '%s'", filePath.c_str()),
+                        FileSystemErrors::FileNotAccessible);
+    return false;
+  }
+
+  mData = self->mBuffer;
+  mSize = size;
+  mOpen = true;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  PlasmaGetPrivateData(MappedFilePrivateData);
+  if (self->mBuffer)
+    plDeallocate(self->mBuffer);
+
+  self->mBuffer = nullptr;
+  mData = nullptr;
+  mSize = 0;
+  mOpen = false;
+}
+
+} // namespace Plasma
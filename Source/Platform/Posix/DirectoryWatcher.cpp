@@ -0,0 +1,445 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+#include <sys/inotify.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+
+namespace Plasma
+{
+
+namespace
+{
+// How long a file must go without events before its change is reported.
+// Programs commonly write a file in many chunks or save to a temporary file
+// and rename it over the original, which would otherwise be many changes.
+const TimeMs cCoalesceMs = 100;
+// How often the watcher checks for shutdown while nothing is happening
+const int cPollMs = 50;
+const uint32_t cWatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+struct PendingChange
+{
+  DirectoryWatcher::FileOperation mOperation;
+  String mOldFileName;
+  TimeMs mLastEvent;
+};
+
+struct PendingMove
+{
+  String mFileName;
+  TimeMs mTime;
+  bool mIsDirectory;
+};
+
+// Watches a directory tree with one inotify watch per directory and collects
+// the events into at most one change per file.
+class InotifyWatcher
+{
+public:
+  InotifyWatcher(StringParam root) : mRoot(root), mFd(-1), mWatchLimitReached(false)
+  {
+  }
+
+  ~InotifyWatcher()
+  {
+    if (mFd != -1)
+      close(mFd);
+  }
+
+  bool Open()
+  {
+    mFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (mFd == -1)
+    {
+      PlasmaPrint("Failed to watch directory '%s': %s\n", mRoot.c_str(), strerror(errno));
+      return false;
+    }
+
+    AddWatches(String(), false);
+    return !mDirectories.Empty();
+  }
+
+  // Waits up to the timeout for events and records them
+  void Read(int timeoutMs)
+  {
+    pollfd descriptor = {mFd, POLLIN, 0};
+    if (poll(&descriptor, 1, timeoutMs) <= 0)
+      return;
+
+    alignas(inotify_event) ::byte buffer[4096];
+    for (;;)
+    {
+      ssize_t size = read(mFd, buffer, sizeof(buffer));
+      if (size <= 0)
+        return;
+
+      TimeMs now = mTimer.UpdateAndGetTimeMilliseconds();
+      for (ssize_t offset = 0; offset < size;)
+      {
+        inotify_event* event = (inotify_event*)(buffer + offset);
+        offset += sizeof(inotify_event) + event->len;
+        HandleEvent(event, now);
+      }
+    }
+  }
+
+  // Reports every change that has settled
+  void Flush(DirectoryWatcher::CallbackFunction callback, void* callbackInstance)
+  {
+    TimeMs now = mTimer.UpdateAndGetTimeMilliseconds();
+
+    // A file or directory moved out of the watched directory never gets a
+    // moved to event
+    Array<uint> expiredMoves;
+    forRange (auto& entry, mMoves.All())
+    {
+      if (now - entry.second.mTime >= cCoalesceMs)
+        expiredMoves.PushBack(entry.first);
+    }
+    forRange (uint cookie, expiredMoves.All())
+    {
+      PendingMove move = mMoves[cookie];
+      mMoves.Erase(cookie);
+
+      if (move.mIsDirectory)
+      {
+        RemoveDirectory(move.mFileName, now);
+      }
+      else
+      {
+        mFiles.Erase(move.mFileName);
+        Record(move.mFileName, DirectoryWatcher::Removed, now);
+      }
+    }
+
+    Array<String> settled;
+    forRange (auto& entry, mPending.All())
+    {
+      if (now - entry.second.mLastEvent >= cCoalesceMs)
+        settled.PushBack(entry.first);
+    }
+
+    forRange (String& fileName, settled.All())
+    {
+      PendingChange& change = mPending[fileName];
+      DirectoryWatcher::FileOperationInfo info;
+      info.Operation = change.mOperation;
+      info.FileName = fileName;
+      info.OldFileName = change.mOldFileName;
+      mPending.Erase(fileName);
+      (*callback)(callbackInstance, info);
+    }
+  }
+
+private:
+  void HandleEvent(inotify_event* event, TimeMs now)
+  {
+    if (event->mask & IN_Q_OVERFLOW)
+    {
+      PlasmaPrint("Too many changes in '%s', some were not reported\n", mRoot.c_str());
+      return;
+    }
+
+    if (event->mask & IN_IGNORED)
+    {
+      mDirectories.Erase(event->wd);
+      return;
+    }
+
+    String* directory = mDirectories.FindPointer(event->wd);
+    if (directory == nullptr || event->len == 0)
+      return;
+
+    String fileName = GetRelativePath(*directory, event->name);
+
+    bool isDirectory = (event->mask & IN_ISDIR) != 0;
+
+    // Moves are paired by their cookie the same way for files and directories.
+    // The watches of a moved directory stay in place until the move is known
+    // to have left the watched tree.
+    if (event->mask & IN_MOVED_FROM)
+    {
+      mMoves[event->cookie] = PendingMove{fileName, now, isDirectory};
+      return;
+    }
+
+    if (event->mask & IN_MOVED_TO)
+    {
+      PendingMove* move = mMoves.FindPointer(event->cookie);
+      if (move == nullptr)
+      {
+        // Moved in from outside the watched directory
+        if (isDirectory)
+        {
+          AddWatches(fileName, true);
+        }
+        else
+        {
+          mFiles.Insert(fileName);
+          Record(fileName, DirectoryWatcher::Added, now);
+        }
+        return;
+      }
+
+      String oldFileName = move->mFileName;
+      mMoves.Erase(event->cookie);
+      if (isDirectory)
+        RenameDirectory(oldFileName, fileName, now);
+      else
+        Rename(oldFileName, fileName, now);
+      return;
+    }
+
+    if (isDirectory)
+    {
+      // Directories aren't reported themselves, only the files in them (files
+      // in a deleted directory get their own delete events first)
+      if (event->mask & IN_CREATE)
+        AddWatches(fileName, true);
+      return;
+    }
+
+    if (event->mask & IN_CREATE)
+    {
+      mFiles.Insert(fileName);
+      Record(fileName, DirectoryWatcher::Added, now);
+    }
+    else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+    {
+      Record(fileName, DirectoryWatcher::Modified, now);
+    }
+    else if (event->mask & IN_DELETE)
+    {
+      mFiles.Erase(fileName);
+      Record(fileName, DirectoryWatcher::Removed, now);
+    }
+  }
+
+  // Merges an operation on a file with any change already waiting to be
+  // reported for it
+  void Record(StringParam fileName, DirectoryWatcher::FileOperation operation, TimeMs now)
+  {
+    PendingChange* change = mPending.FindPointer(fileName);
+    if (change == nullptr)
+    {
+      PendingChange& added = mPending[fileName];
+      added.mOperation = operation;
+      added.mLastEvent = now;
+      return;
+    }
+
+    DirectoryWatcher::FileOperation previous = change->mOperation;
+    change->mLastEvent = now;
+
+    if (operation == DirectoryWatcher::Modified)
+    {
+      // Still added, renamed or modified. A removed file can't be modified.
+      return;
+    }
+
+    if (operation == DirectoryWatcher::Removed)
+    {
+      if (previous == DirectoryWatcher::Added)
+      {
+        // Created and deleted within the burst (e.g. a temporary file)
+        mPending.Erase(fileName);
+      }
+      else if (previous == DirectoryWatcher::Renamed)
+      {
+        // Only the original name was ever known to have existed
+        String oldFileName = change->mOldFileName;
+        mPending.Erase(fileName);
+        Record(oldFileName, DirectoryWatcher::Removed, now);
+      }
+      else
+      {
+        change->mOperation = DirectoryWatcher::Removed;
+      }
+      return;
+    }
+
+    if (operation == DirectoryWatcher::Added && previous == DirectoryWatcher::Removed)
+    {
+      // Deleted and written again
+      change->mOperation = DirectoryWatcher::Modified;
+      return;
+    }
+
+    change->mOperation = operation;
+  }
+
+  void Rename(StringParam oldFileName, StringParam newFileName, TimeMs now)
+  {
+    mFiles.Erase(oldFileName);
+    bool replacedFile = !mFiles.Insert(newFileName);
+
+    PendingChange* previous = mPending.FindPointer(oldFileName);
+    DirectoryWatcher::FileOperation previousOperation = previous ? previous->mOperation : DirectoryWatcher::Modified;
+    String originalFileName = oldFileName;
+    if (previous && previousOperation == DirectoryWatcher::Renamed)
+      originalFileName = previous->mOldFileName;
+    mPending.Erase(oldFileName);
+
+    // A file written under a temporary name and moved over the real one is a
+    // modification of the real file, otherwise it's just a new file
+    if (previousOperation == DirectoryWatcher::Added)
+    {
+      mPending.Erase(newFileName);
+      Record(newFileName, replacedFile ? DirectoryWatcher::Modified : DirectoryWatcher::Added, now);
+      return;
+    }
+
+    PendingChange& change = mPending[newFileName];
+    change.mOperation = DirectoryWatcher::Renamed;
+    change.mOldFileName = originalFileName;
+    change.mLastEvent = now;
+  }
+
+  // Watches the directory and every directory under it. Files found are
+  // reported as added when the directory is new to the watched tree.
+  void AddWatches(StringParam relativePath, bool reportFiles)
+  {
+    String fullPath = relativePath.Empty() ? mRoot : FilePath::Combine(mRoot, relativePath);
+    int wd = inotify_add_watch(mFd, fullPath.c_str(), cWatchMask);
+    if (wd == -1)
+    {
+      if (errno == ENOSPC && !mWatchLimitReached)
+      {
+        mWatchLimitReached = true;
+        PlasmaPrint("Reached the inotify watch limit while watching '%s', changes to some "
+                    "directories won't be detected (see fs.inotify.max_user_watches)\n",
+                    mRoot.c_str());
+      }
+      return;
+    }
+
+    // Adding a watch to a directory that is already watched returns the same
+    // watch descriptor, so this also updates the path
+    mDirectories[wd] = relativePath;
+
+    for (FileRange files(fullPath); !files.Empty(); files.PopFront())
+    {
+      FileEntry entry = files.FrontEntry();
+      String fileName = GetRelativePath(relativePath, entry.mFileName);
+      if (DirectoryExists(entry.GetFullPath()))
+      {
+        AddWatches(fileName, reportFiles);
+      }
+      else
+      {
+        mFiles.Insert(fileName);
+        if (reportFiles)
+          Record(fileName, DirectoryWatcher::Added, mTimer.UpdateAndGetTimeMilliseconds());
+      }
+    }
+  }
+
+  // A directory moved within the watched tree keeps its watches (watches
+  // follow the directory, not the path), so only the paths are updated and
+  // every file under it is reported as renamed
+  void RenameDirectory(StringParam oldPath, StringParam newPath, TimeMs now)
+  {
+    forRange (auto& entry, mDirectories.All())
+    {
+      if (IsSameOrUnder(entry.second, oldPath))
+        entry.second = ReplaceDirectory(entry.second, oldPath, newPath);
+    }
+
+    Array<String> movedFiles;
+    GetFilesUnder(oldPath, movedFiles);
+    forRange (String& oldFileName, movedFiles.All())
+    {
+      Rename(oldFileName, ReplaceDirectory(oldFileName, oldPath, newPath), now);
+    }
+  }
+
+  // A directory moved out of the watched tree: every file that was under it
+  // is reported as removed and its watches are dropped
+  void RemoveDirectory(StringParam relativePath, TimeMs now)
+  {
+    Array<String> removedFiles;
+    GetFilesUnder(relativePath, removedFiles);
+    forRange (String& fileName, removedFiles.All())
+    {
+      mFiles.Erase(fileName);
+      Record(fileName, DirectoryWatcher::Removed, now);
+    }
+
+    Array<int> removed;
+    forRange (auto& entry, mDirectories.All())
+    {
+      if (IsSameOrUnder(entry.second, relativePath))
+        removed.PushBack(entry.first);
+    }
+
+    forRange (int wd, removed.All())
+    {
+      inotify_rm_watch(mFd, wd);
+      mDirectories.Erase(wd);
+    }
+  }
+
+  void GetFilesUnder(StringParam relativePath, Array<String>& filesOut)
+  {
+    forRange (const String& fileName, mFiles.All())
+    {
+      if (IsSameOrUnder(fileName, relativePath))
+        filesOut.PushBack(fileName);
+    }
+  }
+
+  bool IsSameOrUnder(StringParam path, StringParam directory)
+  {
+    if (path == directory)
+      return true;
+    return path.StartsWith(BuildString(directory, cDirectorySeparatorCstr));
+  }
+
+  // Moves a path that is the same as or under oldDirectory to newDirectory
+  String ReplaceDirectory(StringParam path, StringParam oldDirectory, StringParam newDirectory)
+  {
+    return BuildString(newDirectory, path.SubStringFromByteIndices(oldDirectory.SizeInBytes(), path.SizeInBytes()));
+  }
+
+  String GetRelativePath(StringParam directory, StringParam fileName)
+  {
+    if (directory.Empty())
+      return fileName;
+    return FilePath::Combine(directory, fileName);
+  }
+
+  String mRoot;
+  int mFd;
+  bool mWatchLimitReached;
+  Timer mTimer;
+  // Watch descriptor to the directory's path relative to the root
+  HashMap<int, String> mDirectories;
+  // Every file in the watched tree, relative to the root. Moving a directory
+  // only produces an event for the directory, so this is what finds the
+  // files that moved with it.
+  HashSet<String> mFiles;
+  // Changes waiting for their file to settle, by path relative to the root
+  HashMap<String, PendingChange> mPending;
+  // Files moved from a watched directory, by the cookie of the move
+  HashMap<uint, PendingMove> mMoves;
+};
+} // namespace
+
+OsInt DirectoryWatcher::RunThreadEntryPoint()
+{
+  InotifyWatcher watcher(mDirectoryToWatch);
+  if (!watcher.Open())
+    return (OsInt)-1;
+
+  // Loop until cancel
+  while (!mCancelled.Load())
+  {
+    watcher.Read(cPollMs);
+    watcher.Flush(mCallback, mCallbackInstance);
+  }
+
+  return 0;
+}
+
+} // namespace Plasma
@@ -0,0 +1,105 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+
+namespace Plasma
+{
+
+struct MappedFilePrivateData
+{
+  MappedFilePrivateData()
+  {
+    mMapping = nullptr;
+    mMappingSize = 0;
+  }
+
+  void* mMapping;
+  size_t mMappingSize;
+};
+
+static bool FailMappedFile(Status* status, StringParam filePath, cstr operation)
+{
+  String message = String::Format("Failed to %s file '%s': %s", operation, filePath.c_str(), strerror(errno));
+  if (status)
+    status->SetFailed(message, FileSystemErrors::FileNotAccessible);
+  return false;
+}
+
+MappedFile::MappedFile()
+{
+  PlasmaConstructPrivateData(MappedFilePrivateData);
+  mData = nullptr;
+  mSize = 0;
+  mOpen = false;
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+  PlasmaDestructPrivateData(MappedFilePrivateData);
+}
+
+bool MappedFile::Open(StringParam filePath, FileAccessPattern::Enum accessPattern, Status* status)
+{
+  PlasmaGetPrivateData(MappedFilePrivateData);
+  Close();
+
+  int descriptor = open(filePath.c_str(), O_RDONLY);
+  if (descriptor == -1)
+    return FailMappedFile(status, filePath, "open");
+
+  struct stat fileStat;
+  if (fstat(descriptor, &fileStat) != 0)
+  {
+    close(descriptor);
+    return FailMappedFile(status, filePath, "stat");
+  }
+
+  size_t size = (size_t)fileStat.st_size;
+
+  // Mapping zero bytes is an error, an empty file just has no data
+  if (size != 0)
+  {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+      close(descriptor);
+      return FailMappedFile(status, filePath, "map");
+    }
+
+    // Sequential readers want aggressive read ahead, random readers (seeking
+    // through an archive) would only waste it
+    int advice = accessPattern == FileAccessPattern::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM;
+    madvise(mapping, size, advice);
+
+    self->mMapping = mapping;
+    self->mMappingSize = size;
+  }
+
+  // The mapping keeps its own reference to the file
+  close(descriptor);
+
+  mData = (const ::byte*)self->mMapping;
+  mSize = size;
+  mOpen = true;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  PlasmaGetPrivateData(MappedFilePrivateData);
+  if (self->mMapping)
+    munmap(self->mMapping, self->mMappingSize);
+
+  self->mMapping = nullptr;
+  self->mMappingSize = 0;
+  mData = nullptr;
+  mSize = 0;
+  mOpen = false;
+}
+
+} // namespace Plasma
@@ -0,0 +1,99 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+
+struct MappedFilePrivateData
+{
+  MappedFilePrivateData()
+  {
+    mFile = INVALID_HANDLE_VALUE;
+    mMapping = NULL;
+    mView = nullptr;
+  }
+
+  HANDLE mFile;
+  HANDLE mMapping;
+  void* mView;
+};
+
+MappedFile::MappedFile()
+{
+  PlasmaConstructPrivateData(MappedFilePrivateData);
+  mData = nullptr;
+  mSize = 0;
+  mOpen = false;
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+  PlasmaDestructPrivateData(MappedFilePrivateData);
+}
+
+bool MappedFile::Open(StringParam filePath, FileAccessPattern::Enum accessPattern, Status* status)
+{
+  PlasmaGetPrivateData(MappedFilePrivateData);
+  Close();
+
+  DWORD flags = accessPattern == FileAccessPattern::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+  self->mFile = ::CreateFileW(
+      Widen(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+  if (self->mFile == INVALID_HANDLE_VALUE)
+  {
+    if (status)
+      FillWindowsErrorStatus(*status);
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!::GetFileSizeEx(self->mFile, &size))
+  {
+    if (status)
+      FillWindowsErrorStatus(*status);
+    Close();
+    return false;
+  }
+
+  // Mapping an empty file is an error, an empty file just has no data
+  if (size.QuadPart != 0)
+  {
+    self->mMapping = ::CreateFileMappingW(self->mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (self->mMapping != NULL)
+      self->mView = ::MapViewOfFile(self->mMapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (self->mView == nullptr)
+    {
+      if (status)
+        FillWindowsErrorStatus(*status);
+      Close();
+      return false;
+    }
+  }
+
+  mData = (const ::byte*)self->mView;
+  mSize = (size_t)size.QuadPart;
+  mOpen = true;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  PlasmaGetPrivateData(MappedFilePrivateData);
+  if (self->mView)
+    ::UnmapViewOfFile(self->mView);
+  if (self->mMapping != NULL)
+    ::CloseHandle(self->mMapping);
+  if (self->mFile != INVALID_HANDLE_VALUE)
+    ::CloseHandle(self->mFile);
+
+  self->mView = nullptr;
+  self->mMapping = NULL;
+  self->mFile = INVALID_HANDLE_VALUE;
+  mData = nullptr;
+  mSize = 0;
+  mOpen = false;
+}
+
+} // namespace Plasma
@@ -0,0 +1,449 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+using namespace Plasma;
+
+// Checks BitStream::WriteBits and ReadBits bit for bit against the original
+// bit at a time routines, then times them and the Measure/Serialize entry
+// points built on them. Exits with 1 if any check fails.
+// Usage: BitStreamBenchmark [<check trials>] [<records>]
+
+namespace
+{
+const uint cDefaultTrials = 100000;
+const uint cDefaultRecords = 200000;
+const uint cRepetitions = 5;
+// Largest write or read checked, so a single call spans several 56 bit chunks
+const Bits cMaxCheckBits = 700;
+
+//                               Reference Codec //
+
+// The bit at a time WriteBits from before data was moved a word at a time.
+// Writes dataBits of data starting bitOffset bits into stream.
+void ReferenceWriteBits(::byte* stream, Bits bitOffset, const ::byte* data, Bits dataBits)
+{
+  Bits remBitsWritten = MOD8(bitOffset);
+  Bytes fullDataBytes = DIV8(dataBits);
+  Bits remDataBits = MOD8(dataBits);
+  ::byte* writeCursor = stream + DIV8(bitOffset);
+  const ::byte* dataCursor = data;
+
+  if (!remBitsWritten && fullDataBytes)
+  {
+    memcpy(writeCursor, dataCursor, fullDataBytes);
+    dataCursor += fullDataBytes;
+    writeCursor += fullDataBytes;
+  }
+  else
+  {
+    for (Bytes k = 0; k < fullDataBytes; ++k)
+    {
+      for (Bits i = 0; i < 8; ++i)
+      {
+        ASSIGN_LBIT(*dataCursor & LBIT(i), writeCursor, remBitsWritten);
+        if (++remBitsWritten == 8)
+        {
+          remBitsWritten = 0;
+          ++writeCursor;
+        }
+      }
+      ++dataCursor;
+    }
+  }
+
+  for (Bits i = 0; i < remDataBits; ++i)
+  {
+    ASSIGN_LBIT(*dataCursor & LBIT(i), writeCursor, remBitsWritten);
+    if (++remBitsWritten == 8)
+    {
+      remBitsWritten = 0;
+      ++writeCursor;
+    }
+  }
+}
+
+// The bit at a time ReadBits from before data was moved a word at a time.
+// Reads dataBits into data starting bitOffset bits into stream.
+void ReferenceReadBits(const ::byte* stream, Bits bitOffset, ::byte* data, Bits dataBits)
+{
+  memset(data, 0, BITS_TO_BYTES(dataBits));
+
+  Bits remBitsRead = MOD8(bitOffset);
+  Bytes fullDataBytes = DIV8(dataBits);
+  Bits remDataBits = MOD8(dataBits);
+  const ::byte* readCursor = stream + DIV8(bitOffset);
+  ::byte* dataCursor = data;
+
+  if (!remBitsRead && fullDataBytes)
+  {
+    memcpy(dataCursor, readCursor, fullDataBytes);
+    dataCursor += fullDataBytes;
+    readCursor += fullDataBytes;
+  }
+  else
+  {
+    for (Bytes k = 0; k < fullDataBytes; ++k)
+    {
+      for (Bits i = 0; i < 8; ++i)
+      {
+        ASSIGN_LBIT(*readCursor & LBIT(remBitsRead), dataCursor, i);
+        if (++remBitsRead == 8)
+        {
+          remBitsRead = 0;
+          ++readCursor;
+        }
+      }
+      ++dataCursor;
+    }
+  }
+
+  for (Bits i = 0; i < remDataBits; ++i)
+  {
+    ASSIGN_LBIT(*readCursor & LBIT(remBitsRead), dataCursor, i);
+    if (++remBitsRead == 8)
+    {
+      remBitsRead = 0;
+      ++readCursor;
+    }
+  }
+}
+
+// The original WriteUntilByteAligned wrote cleared pad bits one at a time
+void ReferencePadBits(::byte* stream, Bits bitOffset)
+{
+  for (Bits bit = bitOffset; MOD8(bit); ++bit)
+    ASSIGN_LBIT(false, stream + DIV8(bit), MOD8(bit));
+}
+
+void FillRandom(Array<::byte>& bytes, Math::Random& random)
+{
+  for (uint i = 0; i < bytes.Size(); ++i)
+    bytes[i] = ::byte(random.Uint32());
+}
+
+//                                 Equivalence //
+
+// Writes random data at a random bit offset into a stream of random bytes
+// with both codecs. The whole buffer is compared, so the bits around the
+// written range (and the pad bits) have to be preserved the same way.
+bool CheckWriteBits(Math::Random& random)
+{
+  Bits bitOffset = (Bits)random.IntRangeInEx(0, 64);
+  Bits dataBits = (Bits)random.IntRangeInIn(1, cMaxCheckBits);
+  Bytes streamBytes = BITS_TO_BYTES(bitOffset + dataBits) + 8;
+
+  Array<::byte> initial(streamBytes);
+  Array<::byte> data(BITS_TO_BYTES(dataBits));
+  FillRandom(initial, random);
+  FillRandom(data, random);
+
+  Array<::byte> expected = initial;
+  ReferenceWriteBits(expected.Data(), bitOffset, data.Data(), dataBits);
+  ReferencePadBits(expected.Data(), bitOffset + dataBits);
+
+  BitStream stream;
+  stream.Reserve(streamBytes);
+  memcpy(stream.GetDataExposed(), initial.Data(), streamBytes);
+  stream.SetBitsWritten(bitOffset);
+  stream.WriteBits(data.Data(), dataBits);
+  stream.WriteUntilByteAligned();
+
+  if (memcmp(stream.GetData(), expected.Data(), streamBytes) == 0)
+    return true;
+
+  PlasmaPrint("WriteBits mismatch: offset %u, %u bits\n", bitOffset, dataBits);
+  return false;
+}
+
+// Reads a random range of a stream of random bytes with both codecs into
+// buffers filled with the same garbage, so the unused bits of the last data
+// byte have to be cleared and nothing past it may be touched.
+bool CheckReadBits(Math::Random& random)
+{
+  Bits bitOffset = (Bits)random.IntRangeInEx(0, 64);
+  Bits dataBits = (Bits)random.IntRangeInIn(1, cMaxCheckBits);
+  Bytes streamBytes = BITS_TO_BYTES(bitOffset + dataBits);
+  Bytes dataBytes = BITS_TO_BYTES(dataBits) + 8;
+
+  Array<::byte> source(streamBytes);
+  Array<::byte> garbage(dataBytes);
+  FillRandom(source, random);
+  FillRandom(garbage, random);
+
+  Array<::byte> expected = garbage;
+  ReferenceReadBits(source.Data(), bitOffset, expected.Data(), dataBits);
+
+  BitStream stream;
+  stream.WriteBytes(source.Data(), streamBytes);
+  stream.SetBitsRead(bitOffset);
+
+  Array<::byte> actual = garbage;
+  Bits bitsRead = stream.ReadBits(actual.Data(), dataBits);
+  bool padded = stream.ReadUntilByteAligned() != 0 || !MOD8(bitOffset + dataBits);
+
+  if (bitsRead == dataBits && padded && stream.GetBitsUnread() == 0 &&
+      memcmp(actual.Data(), expected.Data(), dataBytes) == 0)
+    return true;
+
+  PlasmaPrint("ReadBits mismatch: offset %u, %u bits\n", bitOffset, dataBits);
+  return false;
+}
+
+uint RunChecks(uint trials)
+{
+  Math::Random random((int)trials);
+  uint failures = 0;
+  for (uint i = 0; i < trials; ++i)
+  {
+    failures += !CheckWriteBits(random);
+    failures += !CheckReadBits(random);
+  }
+
+  PlasmaPrint("Equivalence: %u trials of WriteBits and ReadBits, %u mismatches\n", trials, failures);
+  return failures;
+}
+
+//                                  Raw Codec //
+
+// Best of the repetitions, in seconds
+template <typename Function>
+double TimeBest(Function function)
+{
+  double best = Math::DoublePositiveMax();
+  for (uint repetition = 0; repetition < cRepetitions; ++repetition)
+  {
+    Timer timer;
+    timer.Reset();
+    function();
+    best = Math::Min(best, timer.UpdateAndGetTime());
+  }
+  return best;
+}
+
+// Writes or reads the same unaligned chunk over and over through either codec
+struct RawCodec
+{
+  RawCodec(Bits chunkBits, uint chunks, bool reference, bool write) :
+      mChunkBits(chunkBits),
+      mChunks(chunks),
+      mReference(reference),
+      mWrite(write)
+  {
+    Math::Random random((int)chunkBits);
+    mData.Resize(BITS_TO_BYTES(chunkBits));
+    FillRandom(mData, random);
+
+    // One extra bit in front so every chunk is unaligned to start with
+    mStream.Reserve(BITS_TO_BYTES(1 + chunkBits * chunks));
+    mStream.WriteBit(true);
+    for (uint i = 0; i < chunks; ++i)
+      mStream.WriteBits(mData.Data(), chunkBits);
+  }
+
+  void operator()()
+  {
+    ::byte* stream = mStream.GetDataExposed();
+    Bits offset = 1;
+    for (uint i = 0; i < mChunks; ++i, offset += mChunkBits)
+    {
+      if (mReference && mWrite)
+        ReferenceWriteBits(stream, offset, mData.Data(), mChunkBits);
+      else if (mReference)
+        ReferenceReadBits(stream, offset, mData.Data(), mChunkBits);
+      else if (mWrite)
+      {
+        mStream.SetBitsWritten(offset);
+        mStream.WriteBits(mData.Data(), mChunkBits);
+      }
+      else
+      {
+        mStream.SetBitsRead(offset);
+        mStream.ReadBits(mData.Data(), mChunkBits);
+      }
+    }
+  }
+
+  Bits mChunkBits;
+  uint mChunks;
+  bool mReference;
+  bool mWrite;
+  Array<::byte> mData;
+  BitStream mStream;
+};
+
+void RunRawCodec()
+{
+  static const Bits cChunkBits[] = {13, 64, 250, 4001};
+  const Bits cTotalBits = 64 * 1024 * 1024;
+
+  PlasmaPrint("Unaligned WriteBits/ReadBits (best of %u)\n", cRepetitions);
+  PlasmaPrint("  %-6s %12s %12s %12s %12s\n", "Bits", "Old write", "New write", "Old read", "New read");
+  for (uint i = 0; i < sizeof(cChunkBits) / sizeof(cChunkBits[0]); ++i)
+  {
+    Bits chunkBits = cChunkBits[i];
+    uint chunks = cTotalBits / chunkBits;
+    double megabytes = (double)chunkBits * chunks / BYTES_TO_BITS(1024.0 * 1024.0);
+
+    RawCodec oldWrite(chunkBits, chunks, true, true);
+    RawCodec newWrite(chunkBits, chunks, false, true);
+    RawCodec oldRead(chunkBits, chunks, true, false);
+    RawCodec newRead(chunkBits, chunks, false, false);
+
+    PlasmaPrint("  %-6u %9.1fMB/s %9.1fMB/s %9.1fMB/s %9.1fMB/s\n",
+                chunkBits,
+                megabytes / TimeBest(oldWrite),
+                megabytes / TimeBest(newWrite),
+                megabytes / TimeBest(oldRead),
+                megabytes / TimeBest(newRead));
+  }
+}
+
+//                                 Serialize //
+
+// A typical replicated property update: a few flags, ids and quantized
+// values plus a name and an odd sized blob, so almost every field lands
+// unaligned
+struct Record
+{
+  bool mActive;
+  u32 mId;
+  float mHealth;
+  float mAngle;
+  u8 mTeam;
+  String mName;
+  ::byte mBlob[12];
+};
+
+const Bits cBlobBits = 90;
+
+Bits MeasureRecord(Record& record)
+{
+  return BitStream::Measure(record.mActive) + BitStream::Measure(record.mId) + BitStream::Measure(record.mHealth) +
+         BitStream::MeasureQuantized(0.0f, 360.0f, 0.01f) + BitStream::MeasureQuantized(u8(0), u8(15)) +
+         BitStream::Measure(record.mName) + cBlobBits;
+}
+
+Bits SerializeRecord(SerializeDirection::Enum direction, BitStream& stream, Record& record)
+{
+  Bits bits = 0;
+  bits += stream.Serialize(direction, record.mActive);
+  bits += stream.Serialize(direction, record.mId);
+  bits += stream.Serialize(direction, record.mHealth);
+  bits += stream.SerializeQuantized(direction, record.mAngle, 0.0f, 360.0f, 0.01f);
+  bits += stream.SerializeQuantized(direction, record.mTeam, u8(0), u8(15));
+  bits += stream.Serialize(direction, record.mName);
+  bits += stream.SerializeBits(direction, record.mBlob, cBlobBits);
+  return bits;
+}
+
+struct SerializeRecords
+{
+  SerializeRecords(Array<Record>& records, BitStream& stream, SerializeDirection::Enum direction) :
+      mRecords(records),
+      mStream(stream),
+      mDirection(direction)
+  {
+  }
+
+  void operator()()
+  {
+    if (mDirection == SerializeDirection::Write)
+    {
+      Bits bits = 0;
+      for (uint i = 0; i < mRecords.Size(); ++i)
+        bits += MeasureRecord(mRecords[i]);
+
+      mStream.Clear(false);
+      mStream.Reserve(BITS_TO_BYTES(bits));
+    }
+    else
+    {
+      mStream.ClearBitsRead();
+    }
+
+    for (uint i = 0; i < mRecords.Size(); ++i)
+      SerializeRecord(mDirection, mStream, mRecords[i]);
+  }
+
+  Array<Record>& mRecords;
+  BitStream& mStream;
+  SerializeDirection::Enum mDirection;
+};
+
+uint RunSerialize(uint recordCount)
+{
+  Math::Random random((int)recordCount);
+  Array<Record> records(recordCount);
+  for (uint i = 0; i < recordCount; ++i)
+  {
+    Record& record = records[i];
+    record.mActive = random.Bool();
+    record.mId = random.Uint32();
+    record.mHealth = random.FloatRange(0.0f, 100.0f);
+    record.mAngle = (float)random.IntRangeInEx(0, 36000) * 0.01f;
+    record.mTeam = (u8)random.IntRangeInIn(0, 15);
+    record.mName = String::Format("Player%u", random.Uint32());
+    for (uint j = 0; j < sizeof(record.mBlob); ++j)
+      record.mBlob[j] = ::byte(random.Uint32());
+    // Only the used bits of the blob come back from a read
+    record.mBlob[DIV8(cBlobBits)] &= ::byte(0xFF << (8 - MOD8(cBlobBits)));
+    memset(record.mBlob + BITS_TO_BYTES(cBlobBits), 0, sizeof(record.mBlob) - BITS_TO_BYTES(cBlobBits));
+  }
+
+  BitStream stream;
+  double writeSeconds = TimeBest(SerializeRecords(records, stream, SerializeDirection::Write));
+
+  Array<Record> readRecords(recordCount);
+  double readSeconds = TimeBest(SerializeRecords(readRecords, stream, SerializeDirection::Read));
+
+  // The round trip has to give back what was written
+  uint failures = 0;
+  for (uint i = 0; i < recordCount; ++i)
+  {
+    Record& expected = records[i];
+    Record& actual = readRecords[i];
+    if (expected.mActive != actual.mActive || expected.mId != actual.mId || expected.mHealth != actual.mHealth ||
+        Math::Abs(expected.mAngle - actual.mAngle) > 0.01f || expected.mTeam != actual.mTeam ||
+        expected.mName != actual.mName || memcmp(expected.mBlob, actual.mBlob, sizeof(expected.mBlob)) != 0)
+      ++failures;
+  }
+
+  PlasmaPrint("Serialize: %u records, %u bytes (best of %u)\n", recordCount, stream.GetBytesWritten(), cRepetitions);
+  PlasmaPrint("  Write %8.2fms %8.1fns/record\n", writeSeconds * 1000.0, writeSeconds * 1e9 / recordCount);
+  PlasmaPrint("  Read  %8.2fms %8.1fns/record\n", readSeconds * 1000.0, readSeconds * 1e9 / recordCount);
+  PlasmaPrint("  %u round trip mismatches\n", failures);
+  return failures;
+}
+} // namespace
+
+extern "C" int main(int argc, char* argv[])
+{
+  CommandLineToStringArray(gCommandLineArguments, argv, argc);
+
+  // First parameter is exe path
+  uint trials = cDefaultTrials;
+  uint records = cDefaultRecords;
+  if (gCommandLineArguments.Size() > 1)
+    ToValue(gCommandLineArguments[1], trials);
+  if (gCommandLineArguments.Size() > 2)
+    ToValue(gCommandLineArguments[2], records);
+
+  if (trials == 0 || records == 0)
+  {
+    printf("Usage: BitStreamBenchmark [<check trials>] [<records>]\n");
+    return 1;
+  }
+
+  CommonLibrary::Initialize();
+
+  StdOutListener stdoutListener;
+  Console::Add(&stdoutListener);
+
+  uint failures = RunChecks(trials);
+  RunRawCodec();
+  failures += RunSerialize(records);
+
+  Console::Remove(&stdoutListener);
+  CommonLibrary::Shutdown();
+  return failures == 0 ? 0 : 1;
+}
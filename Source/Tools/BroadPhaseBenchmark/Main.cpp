@@ -0,0 +1,83 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+using namespace Plasma;
+
+// Replays broad phase recordings (saved from the BroadPhaseEditor) against
+// every registered broad phase and prints the timings, memory and pair counts.
+// Usage: BroadPhaseBenchmark <recording> [<recording> ...]
+extern "C" int main(int argc, char* argv[])
+{
+  CommandLineToStringArray(gCommandLineArguments, argv, argc);
+
+  // First parameter is exe path
+  if (gCommandLineArguments.Size() < 2)
+  {
+    printf("Usage: BroadPhaseBenchmark <recording> [<recording> ...]\n");
+    return 1;
+  }
+
+  CommonLibrary::Initialize();
+
+  StdOutListener stdoutListener;
+  Console::Add(&stdoutListener);
+
+  // Broad phases are registered by their meta type, so only the libraries
+  // the SpatialPartition library depends on have to be set up
+  LightningSetup* lightningSetup = new LightningSetup(SetupFlags::DoNotShutdownMemory);
+  MetaDatabase::Initialize();
+  MetaDatabase::GetInstance()->AddNativeLibrary(Core::GetInstance().GetLibrary());
+
+  GeometryLibrary::Initialize();
+  MetaDatabase::GetInstance()->AddNativeLibrary(GeometryLibrary::GetLibrary());
+  MetaLibrary::Initialize();
+  SerializationLibrary::Initialize();
+  SpatialPartitionLibrary::Initialize();
+
+  int result = 0;
+  {
+    BroadPhaseLibrary broadPhaseLibrary;
+
+    for (uint i = 1; i < gCommandLineArguments.Size(); ++i)
+    {
+      String& fileName = gCommandLineArguments[i];
+
+      Status status;
+      BroadPhaseRecording recording;
+      if (!recording.LoadFromFile(status, fileName))
+      {
+        PlasmaPrint("Failed to load recording '%s': %s\n", fileName.c_str(), status.Message.c_str());
+        result = 1;
+        continue;
+      }
+
+      PlasmaPrint("%s (%u events)\n", fileName.c_str(), recording.GetEvents().Size());
+      BroadPhaseBenchmark benchmark(recording);
+      benchmark.RunAll();
+      benchmark.PrintReport();
+    }
+  }
+
+  // Shutdown in reverse order
+  SpatialPartitionLibrary::Shutdown();
+  SerializationLibrary::Shutdown();
+  MetaLibrary::Shutdown();
+  GeometryLibrary::Shutdown();
+
+  SpatialPartitionLibrary::GetInstance().ClearLibrary();
+  SerializationLibrary::GetInstance().ClearLibrary();
+  MetaLibrary::GetInstance().ClearLibrary();
+  GeometryLibrary::GetInstance().ClearLibrary();
+
+  SpatialPartitionLibrary::Destroy();
+  SerializationLibrary::Destroy();
+  MetaLibrary::Destroy();
+  GeometryLibrary::Destroy();
+
+  MetaDatabase::Destroy();
+  delete lightningSetup;
+
+  Console::Remove(&stdoutListener);
+  CommonLibrary::Shutdown();
+  return result;
+}
@@ -0,0 +1,2 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
@@ -0,0 +1,5 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+#include "Core/Meta/MetaStandard.hpp"
+#include "Core/SpatialPartition/SpatialPartitionStandard.hpp"
@@ -0,0 +1,195 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+using namespace Plasma;
+
+// Times the chained HashedContainer against the open addressing
+// FlatHashedContainer (through HashMap and FlatHashMap) for the operations the
+// engine's maps do the most: insert, find of present and missing keys, erase
+// and iteration.
+// Usage: ContainerBenchmark [<element count>] [<repetitions>]
+
+namespace
+{
+const uint cDefaultCount = 1000000;
+const uint cDefaultRepetitions = 5;
+
+// Keys the benchmark inserts (mHits) and keys that are never inserted
+// (mMisses), each in a random order for the searches.
+template <typename KeyType>
+struct KeySet
+{
+  Array<KeyType> mInserts;
+  Array<KeyType> mHits;
+  Array<KeyType> mMisses;
+};
+
+// Odd multipliers are bijections on 32 bits, so this gives unique keys that
+// aren't in insertion order.
+u32 ScrambleKey(u32 index)
+{
+  return index * 2654435761u;
+}
+
+template <typename KeyType>
+void Shuffle(Array<KeyType>& keys, Math::Random& random)
+{
+  for (uint i = keys.Size(); i > 1; --i)
+  {
+    uint j = (uint)random.IntRangeInEx(0, (int)i);
+    Plasma::Swap(keys[i - 1], keys[j]);
+  }
+}
+
+template <typename KeyType, typename MakeKey>
+void BuildKeys(KeySet<KeyType>& keys, uint count, MakeKey makeKey)
+{
+  Math::Random random((int)count);
+  keys.mInserts.Reserve(count);
+  keys.mMisses.Reserve(count);
+  for (uint i = 0; i < count; ++i)
+  {
+    keys.mInserts.PushBack(makeKey(ScrambleKey(i)));
+    keys.mMisses.PushBack(makeKey(ScrambleKey(i + count)));
+  }
+
+  keys.mHits = keys.mInserts;
+  Shuffle(keys.mHits, random);
+  Shuffle(keys.mMisses, random);
+}
+
+struct MakeIntegerKey
+{
+  u32 operator()(u32 key)
+  {
+    return key;
+  }
+};
+
+struct MakeStringKey
+{
+  String operator()(u32 key)
+  {
+    return String::Format("Resource%08x", key);
+  }
+};
+
+// Best time of each operation over all repetitions, in seconds.
+struct OperationTimes
+{
+  OperationTimes()
+  {
+    mInsert = mFindHit = mFindMiss = mIterate = mErase = Math::DoublePositiveMax();
+  }
+
+  double mInsert;
+  double mFindHit;
+  double mFindMiss;
+  double mIterate;
+  double mErase;
+};
+
+template <typename MapType, typename KeyType>
+void RunMap(const KeySet<KeyType>& keys, uint repetitions, OperationTimes& times, size_t& checksum)
+{
+  uint count = keys.mInserts.Size();
+  for (uint repetition = 0; repetition < repetitions; ++repetition)
+  {
+    MapType map;
+    Timer timer;
+
+    timer.Reset();
+    for (uint i = 0; i < count; ++i)
+      map.Insert(keys.mInserts[i], i);
+    times.mInsert = Math::Min(times.mInsert, timer.UpdateAndGetTime());
+
+    timer.Reset();
+    for (uint i = 0; i < count; ++i)
+      checksum += *map.FindPointer(keys.mHits[i]);
+    times.mFindHit = Math::Min(times.mFindHit, timer.UpdateAndGetTime());
+
+    timer.Reset();
+    for (uint i = 0; i < count; ++i)
+      checksum += map.FindPointer(keys.mMisses[i]) == nullptr;
+    times.mFindMiss = Math::Min(times.mFindMiss, timer.UpdateAndGetTime());
+
+    timer.Reset();
+    forRange (uint value, map.Values())
+      checksum += value;
+    times.mIterate = Math::Min(times.mIterate, timer.UpdateAndGetTime());
+
+    timer.Reset();
+    for (uint i = 0; i < count; ++i)
+      checksum += map.Erase(keys.mHits[i]);
+    times.mErase = Math::Min(times.mErase, timer.UpdateAndGetTime());
+
+    ErrorIf(!map.Empty(), "Every key should have been erased.");
+  }
+}
+
+void PrintRow(cstr operation, uint count, double chained, double flat)
+{
+  PlasmaPrint("  %-10s %10.2f %10.2f %10.2f %8.2fx\n",
+              operation,
+              chained * 1000.0,
+              flat * 1000.0,
+              flat * 1e9 / count,
+              chained / flat);
+}
+
+template <typename KeyType, typename MakeKey>
+size_t RunKeyType(cstr keyTypeName, uint count, uint repetitions, MakeKey makeKey)
+{
+  KeySet<KeyType> keys;
+  BuildKeys(keys, count, makeKey);
+
+  size_t checksum = 0;
+  OperationTimes chained;
+  OperationTimes flat;
+  RunMap<HashMap<KeyType, uint>>(keys, repetitions, chained, checksum);
+  RunMap<FlatHashMap<KeyType, uint>>(keys, repetitions, flat, checksum);
+
+  PlasmaPrint("%s keys, %u elements (best of %u)\n", keyTypeName, count, repetitions);
+  PlasmaPrint("  %-10s %10s %10s %10s %9s\n", "Operation", "Chained ms", "Flat ms", "Flat ns/op", "Speedup");
+  PrintRow("Insert", count, chained.mInsert, flat.mInsert);
+  PrintRow("FindHit", count, chained.mFindHit, flat.mFindHit);
+  PrintRow("FindMiss", count, chained.mFindMiss, flat.mFindMiss);
+  PrintRow("Iterate", count, chained.mIterate, flat.mIterate);
+  PrintRow("Erase", count, chained.mErase, flat.mErase);
+  return checksum;
+}
+} // namespace
+
+extern "C" int main(int argc, char* argv[])
+{
+  CommandLineToStringArray(gCommandLineArguments, argv, argc);
+
+  // First parameter is exe path
+  uint count = cDefaultCount;
+  uint repetitions = cDefaultRepetitions;
+  if (gCommandLineArguments.Size() > 1)
+    ToValue(gCommandLineArguments[1], count);
+  if (gCommandLineArguments.Size() > 2)
+    ToValue(gCommandLineArguments[2], repetitions);
+
+  if (count == 0 || repetitions == 0)
+  {
+    printf("Usage: ContainerBenchmark [<element count>] [<repetitions>]\n");
+    return 1;
+  }
+
+  CommonLibrary::Initialize();
+
+  StdOutListener stdoutListener;
+  Console::Add(&stdoutListener);
+
+  // The checksum is printed so the searches can't be optimized out
+  size_t checksum = 0;
+  checksum += RunKeyType<u32>("u32", count, repetitions, MakeIntegerKey());
+  checksum += RunKeyType<String>("String", count, repetitions, MakeStringKey());
+  PlasmaPrint("Checksum %llu\n", (u64)checksum);
+
+  Console::Remove(&stdoutListener);
+  CommonLibrary::Shutdown();
+  return 0;
+}
@@ -0,0 +1,4 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+#include "Core/Common/CommonStandard.hpp"
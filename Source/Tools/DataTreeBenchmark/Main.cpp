@@ -0,0 +1,233 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Plasma
+{
+uint GetFileVersion(StringRange fileData);
+}
+
+using namespace Plasma;
+
+// Times parsing text data files (levels, archetypes and other .data files)
+// into data trees, and loading the same trees from the cooked format, then
+// prints the throughput of each file and of all of them together.
+// Usage: DataTreeBenchmark <data file> [<data file> ...]
+
+namespace
+{
+const uint cRepetitions = 10;
+
+uint CountNodes(DataNode* node)
+{
+  uint count = 1;
+  forRange (DataNode& child, node->GetChildren())
+    count += CountNodes(&child);
+  return count;
+}
+
+// Parses the text the same way ReadDataSet does (without patching). Returns
+// the number of nodes parsed, or 0 if the file couldn't be parsed.
+uint ParseText(StringRange data, uint dataVersion, StringParam fileName)
+{
+  DataTreeContext context;
+  context.Filename = fileName;
+
+  DataNode fileRoot(DataNodeType::Object, nullptr);
+  if (dataVersion == DataVersion::Legacy)
+  {
+    if (DataNode* root = LegacyDataTreeParser::BuildTree(context, data))
+      root->AttachTo(&fileRoot);
+  }
+  else
+  {
+    DataTreeParser::BuildTree(context, data, &fileRoot);
+  }
+
+  if (context.Error || fileRoot.mChildren.Empty())
+    return 0;
+
+  // The file root itself isn't in the file
+  return CountNodes(&fileRoot) - 1;
+}
+
+uint LoadCooked(StringRange data, StringParam fileName)
+{
+  Status status;
+  DataTreeContext context;
+  context.Filename = fileName;
+
+  uint fileVersion = 0;
+  DataNode fileRoot(DataNodeType::Object, nullptr);
+  if (!ReadCookedDataSet(status, data, context, &fileVersion, &fileRoot))
+    return 0;
+  return CountNodes(&fileRoot) - 1;
+}
+
+struct Throughput
+{
+  Throughput() : mBytes(0), mNodes(0), mParseSeconds(0.0), mCookedBytes(0), mCookedSeconds(0.0)
+  {
+  }
+
+  void Print(cstr name)
+  {
+    double megabytes = mBytes / (1024.0 * 1024.0);
+    PlasmaPrint("%s: %.2fMB, %u nodes\n", name, megabytes, mNodes);
+    PlasmaPrint("  Parse  %8.2fms %8.1fMB/s %8.2fM nodes/s\n",
+                mParseSeconds * 1000.0,
+                megabytes / mParseSeconds,
+                mNodes / mParseSeconds / 1e6);
+    PlasmaPrint("  Cooked %8.2fms %8.1fMB/s %8.2fM nodes/s (%.2fMB)\n",
+                mCookedSeconds * 1000.0,
+                megabytes / mCookedSeconds,
+                mNodes / mCookedSeconds / 1e6,
+                mCookedBytes / (1024.0 * 1024.0));
+  }
+
+  size_t mBytes;
+  uint mNodes;
+  double mParseSeconds;
+  size_t mCookedBytes;
+  double mCookedSeconds;
+};
+
+// Best times of the file over all repetitions. Returns false if the file
+// couldn't be read or parsed.
+bool BenchmarkFile(StringParam fileName, Throughput& throughput)
+{
+  String text = ReadFileIntoString(fileName);
+  if (text.Empty())
+  {
+    PlasmaPrint("Failed to read '%s'\n", fileName.c_str());
+    return false;
+  }
+
+  StringRange data = text.All();
+  if (IsCookedDataSet(data))
+  {
+    PlasmaPrint("Skipping '%s', it's already cooked\n", fileName.c_str());
+    return false;
+  }
+
+  uint dataVersion = GetFileVersion(data);
+  throughput.mBytes = text.SizeInBytes();
+  throughput.mParseSeconds = Math::DoublePositiveMax();
+  throughput.mCookedSeconds = Math::DoublePositiveMax();
+
+  Timer timer;
+  for (uint i = 0; i < cRepetitions; ++i)
+  {
+    timer.Reset();
+    throughput.mNodes = ParseText(data, dataVersion, fileName);
+    throughput.mParseSeconds = Math::Min(throughput.mParseSeconds, timer.UpdateAndGetTime());
+
+    if (throughput.mNodes == 0)
+    {
+      PlasmaPrint("Failed to parse '%s'\n", fileName.c_str());
+      return false;
+    }
+  }
+
+  // Cook the tree once to compare against skipping the parser entirely
+  Array<::byte> cooked;
+  {
+    DataTreeContext context;
+    DataNode fileRoot(DataNodeType::Object, nullptr);
+    if (dataVersion == DataVersion::Legacy)
+      LegacyDataTreeParser::BuildTree(context, data)->AttachTo(&fileRoot);
+    else
+      DataTreeParser::BuildTree(context, data, &fileRoot);
+    CookDataSet(&fileRoot, dataVersion, context.PatchRequired, cooked);
+  }
+
+  StringRange cookedData((cstr)cooked.Data(), (cstr)cooked.Data() + cooked.Size());
+  throughput.mCookedBytes = cooked.Size();
+  for (uint i = 0; i < cRepetitions; ++i)
+  {
+    timer.Reset();
+    uint nodes = LoadCooked(cookedData, fileName);
+    throughput.mCookedSeconds = Math::Min(throughput.mCookedSeconds, timer.UpdateAndGetTime());
+
+    ErrorIf(nodes != throughput.mNodes, "The cooked tree should match the parsed tree.");
+  }
+
+  return true;
+}
+} // namespace
+
+extern "C" int main(int argc, char* argv[])
+{
+  CommandLineToStringArray(gCommandLineArguments, argv, argc);
+
+  // First parameter is exe path
+  if (gCommandLineArguments.Size() < 2)
+  {
+    printf("Usage: DataTreeBenchmark <data file> [<data file> ...]\n");
+    return 1;
+  }
+
+  CommonLibrary::Initialize();
+
+  StdOutListener stdoutListener;
+  Console::Add(&stdoutListener);
+
+  // Only the libraries the Serialization library depends on have to be set up
+  LightningSetup* lightningSetup = new LightningSetup(SetupFlags::DoNotShutdownMemory);
+  MetaDatabase::Initialize();
+  MetaDatabase::GetInstance()->AddNativeLibrary(Core::GetInstance().GetLibrary());
+
+  GeometryLibrary::Initialize();
+  MetaDatabase::GetInstance()->AddNativeLibrary(GeometryLibrary::GetLibrary());
+  MetaLibrary::Initialize();
+  SerializationLibrary::Initialize();
+
+  int result = 0;
+  {
+    Throughput total;
+    uint fileCount = 0;
+
+    PlasmaPrint("Best of %u parses\n", cRepetitions);
+    for (uint i = 1; i < gCommandLineArguments.Size(); ++i)
+    {
+      String& fileName = gCommandLineArguments[i];
+
+      Throughput throughput;
+      if (!BenchmarkFile(fileName, throughput))
+      {
+        result = 1;
+        continue;
+      }
+
+      throughput.Print(fileName.c_str());
+      total.mBytes += throughput.mBytes;
+      total.mNodes += throughput.mNodes;
+      total.mParseSeconds += throughput.mParseSeconds;
+      total.mCookedBytes += throughput.mCookedBytes;
+      total.mCookedSeconds += throughput.mCookedSeconds;
+      ++fileCount;
+    }
+
+    if (fileCount > 1)
+      total.Print(String::Format("Total (%u files)", fileCount).c_str());
+  }
+
+  // Shutdown in reverse order
+  SerializationLibrary::Shutdown();
+  MetaLibrary::Shutdown();
+  GeometryLibrary::Shutdown();
+
+  SerializationLibrary::GetInstance().ClearLibrary();
+  MetaLibrary::GetInstance().ClearLibrary();
+  GeometryLibrary::GetInstance().ClearLibrary();
+
+  SerializationLibrary::Destroy();
+  MetaLibrary::Destroy();
+  GeometryLibrary::Destroy();
+
+  MetaDatabase::Destroy();
+  delete lightningSetup;
+
+  Console::Remove(&stdoutListener);
+  CommonLibrary::Shutdown();
+  return result;
+}
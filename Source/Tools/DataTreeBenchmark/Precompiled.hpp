@@ -0,0 +1,7 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+#include "Core/Serialization/SerializationStandard.hpp"
+#include "Core/Serialization/LegacyDataTreeParser.hpp"
+#include "Core/Serialization/DataTreeTokenizer.hpp"
+#include "Core/Serialization/DataTreeParser.hpp"
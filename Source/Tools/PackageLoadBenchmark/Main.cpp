@@ -0,0 +1,199 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+using namespace Plasma;
+
+// Times reading every file of resource packages the way loaders did before
+// MappedFile (read into a heap buffer) against reading them in place from a
+// MappedFile. Each file's contents are read once after being opened, as a
+// loader decoding it would.
+//
+// The OS file cache can't be dropped portably, so cold loads are measured by
+// passing -cold with the path to time after dropping the cache (for example
+// with "echo 3 > /proc/sys/vm/drop_caches" on Linux or RAMMap on Windows).
+// The first pass of that path is then reported as cold. Warm loads are always
+// reported as the best of several passes once every file is cached.
+// Usage: PackageLoadBenchmark [-cold <read|mapped>] <package> [<package> ...]
+// where a package is either the .pack file or its directory.
+
+namespace
+{
+const uint cWarmRepetitions = 5;
+
+DeclareEnum2(LoadPath, Read, Mapped);
+
+// Reads all of the contents so the pages of a mapping are actually faulted
+// in (and the comparison includes the cost of touching the data)
+u64 Checksum(const ::byte* data, size_t size)
+{
+  u64 sum = 0;
+  size_t i = 0;
+  for (; i + sizeof(u64) <= size; i += sizeof(u64))
+  {
+    u64 word;
+    memcpy(&word, data + i, sizeof(u64));
+    sum += word;
+  }
+  for (; i < size; ++i)
+    sum += data[i];
+  return sum;
+}
+
+u64 LoadFile(LoadPath::Enum path, StringParam fileName)
+{
+  if (path == LoadPath::Read)
+  {
+    size_t size = 0;
+    ::byte* data = ReadFileIntoMemory(fileName.c_str(), size);
+    if (data == nullptr)
+      return 0;
+
+    u64 sum = Checksum(data, size);
+    plDeallocate(data);
+    return sum;
+  }
+
+  MappedFile file;
+  if (!file.Open(fileName, FileAccessPattern::Sequential))
+    return 0;
+  return Checksum(file.Data(), file.Size());
+}
+
+// One pass over every file, in seconds
+double LoadAll(LoadPath::Enum path, Array<String>& files, u64& checksum)
+{
+  Timer timer;
+  timer.Reset();
+  for (uint i = 0; i < files.Size(); ++i)
+    checksum += LoadFile(path, files[i]);
+  return timer.UpdateAndGetTime();
+}
+
+// Best of several passes. The checksum is of a single pass.
+double LoadBest(LoadPath::Enum path, Array<String>& files, u64& checksum)
+{
+  double best = Math::DoublePositiveMax();
+  for (uint i = 0; i < cWarmRepetitions; ++i)
+  {
+    checksum = 0;
+    best = Math::Min(best, LoadAll(path, files, checksum));
+  }
+  return best;
+}
+
+// Adds every file in the package's directory (a package's resources are
+// stored next to its .pack file)
+void AddPackageFiles(StringParam package, Array<String>& files, u64& totalBytes)
+{
+  String directory = package;
+  if (!DirectoryExists(directory))
+    directory = FilePath::GetDirectoryPath(package);
+
+  for (FileRange range(directory); !range.Empty(); range.PopFront())
+  {
+    FileEntry entry = range.FrontEntry();
+    String fullPath = FilePath::Combine(directory, entry.mFileName);
+    if (DirectoryExists(fullPath))
+      continue;
+
+    files.PushBack(fullPath);
+    totalBytes += GetFileSize(fullPath);
+  }
+}
+
+void PrintRow(cstr name, double seconds, u64 totalBytes, uint fileCount)
+{
+  PlasmaPrint("  %-14s %10.2fms %10.1fMB/s %10.1fus/file\n",
+              name,
+              seconds * 1000.0,
+              totalBytes / (1024.0 * 1024.0) / seconds,
+              seconds * 1e6 / fileCount);
+}
+} // namespace
+
+extern "C" int main(int argc, char* argv[])
+{
+  CommandLineToStringArray(gCommandLineArguments, argv, argc);
+
+  // First parameter is exe path
+  uint firstPackage = 1;
+  int coldPath = -1;
+  if (gCommandLineArguments.Size() > 2 && gCommandLineArguments[1] == "-cold")
+  {
+    String& pathName = gCommandLineArguments[2];
+    if (pathName == "read")
+      coldPath = LoadPath::Read;
+    else if (pathName == "mapped")
+      coldPath = LoadPath::Mapped;
+    firstPackage = 3;
+  }
+
+  bool badColdPath = firstPackage == 3 && coldPath == -1;
+  if (gCommandLineArguments.Size() <= firstPackage || badColdPath)
+  {
+    printf("Usage: PackageLoadBenchmark [-cold <read|mapped>] <package> [<package> ...]\n");
+    return 1;
+  }
+
+  CommonLibrary::Initialize();
+
+  StdOutListener stdoutListener;
+  Console::Add(&stdoutListener);
+
+  int result = 0;
+  {
+    Array<String> files;
+    u64 totalBytes = 0;
+    for (uint i = firstPackage; i < gCommandLineArguments.Size(); ++i)
+      AddPackageFiles(gCommandLineArguments[i], files, totalBytes);
+
+    if (files.Empty())
+    {
+      PlasmaPrint("No files found in the given packages\n");
+      result = 1;
+    }
+    else
+    {
+      PlasmaPrint("%u files, %.2fMB\n", files.Size(), totalBytes / (1024.0 * 1024.0));
+
+      // Every path reads the same bytes, so the checksums have to match
+      u64 checksums[LoadPath::Size] = {0, 0};
+
+      // Must come first, before anything else reads the files
+      if (coldPath != -1)
+      {
+        LoadPath::Enum path = (LoadPath::Enum)coldPath;
+        double seconds = LoadAll(path, files, checksums[path]);
+        String name = String::Format("%s (cold)", LoadPath::Names[path]);
+        PrintRow(name.c_str(), seconds, totalBytes, files.Size());
+      }
+      else
+      {
+        // Warm up the cache
+        u64 warmUp = 0;
+        LoadAll(LoadPath::Read, files, warmUp);
+      }
+
+      double warmSeconds[LoadPath::Size];
+      for (uint path = 0; path < LoadPath::Size; ++path)
+      {
+        warmSeconds[path] = LoadBest((LoadPath::Enum)path, files, checksums[path]);
+        String name = String::Format("%s (warm)", LoadPath::Names[path]);
+        PrintRow(name.c_str(), warmSeconds[path], totalBytes, files.Size());
+      }
+
+      double speedup = warmSeconds[LoadPath::Read] / warmSeconds[LoadPath::Mapped];
+      PlasmaPrint("  Mapped is %.2fx the speed of Read when warm\n", speedup);
+
+      if (checksums[LoadPath::Read] != checksums[LoadPath::Mapped])
+      {
+        PlasmaPrint("The read and mapped contents differ\n");
+        result = 1;
+      }
+    }
+  }
+
+  Console::Remove(&stdoutListener);
+  CommonLibrary::Shutdown();
+  return result;
+}
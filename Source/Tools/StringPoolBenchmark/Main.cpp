@@ -0,0 +1,223 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+using namespace Plasma;
+
+// Measures how string churn on the sharded string pool scales with threads.
+// Every thread does the same amount of work, so with perfect scaling the time
+// stays flat as threads are added.
+// Usage: StringPoolBenchmark [<max threads>] [<operations per thread>]
+
+namespace
+{
+const uint cDefaultMaxThreads = 16;
+const uint cDefaultOperations = 1000000;
+const uint cRepetitions = 3;
+
+// Texts are stored in fixed size slots of one buffer so creating a String
+// from them costs only the pool (no formatting).
+const uint cTextSize = 24;
+// Distinct texts each thread interns and frees
+const uint cUniqueTexts = 4096;
+// Texts every thread shares (kept alive for the whole run)
+const uint cSharedTexts = 256;
+
+DeclareEnum3(ChurnMode,
+             // Intern a text only this thread uses and free it again, so both
+             // the insert and the final release lock a shard
+             InternAndFree,
+             // Intern a text that is already in the pool and release it, so only
+             // the lookup locks a shard
+             InternExisting,
+             // Copy and release a pooled string (reference counting only)
+             Copy);
+
+struct ChurnThread
+{
+  OsInt Run()
+  {
+    mStart->Wait();
+
+    size_t checksum = 0;
+    switch (mMode)
+    {
+    case ChurnMode::InternAndFree:
+      for (uint i = 0; i < mOperations; ++i)
+      {
+        String text(mUniqueTexts + (i % cUniqueTexts) * cTextSize);
+        checksum += text.SizeInBytes();
+      }
+      break;
+
+    case ChurnMode::InternExisting:
+      for (uint i = 0; i < mOperations; ++i)
+      {
+        String text(mSharedTexts + (i % cSharedTexts) * cTextSize);
+        checksum += text.SizeInBytes();
+      }
+      break;
+
+    case ChurnMode::Copy:
+      for (uint i = 0; i < mOperations; ++i)
+      {
+        String text = (*mSharedStrings)[i % cSharedTexts];
+        checksum += text.SizeInBytes();
+      }
+      break;
+    }
+
+    mChecksum = checksum;
+    return 0;
+  }
+
+  OsEvent* mStart;
+  ChurnMode::Enum mMode;
+  uint mOperations;
+  const char* mUniqueTexts;
+  const char* mSharedTexts;
+  const Array<String>* mSharedStrings;
+  size_t mChecksum;
+};
+
+struct StringChurn
+{
+  StringChurn(uint maxThreads, uint operations) : mOperations(operations), mChecksum(0)
+  {
+    mUniqueTexts.Resize(maxThreads * cUniqueTexts * cTextSize);
+    for (uint thread = 0; thread < maxThreads; ++thread)
+    {
+      for (uint i = 0; i < cUniqueTexts; ++i)
+      {
+        char* text = GetUniqueTexts(thread) + i * cTextSize;
+        PlasmaSPrintf(text, cTextSize, "Churn%u_%u", thread, i);
+      }
+    }
+
+    mSharedTexts.Resize(cSharedTexts * cTextSize);
+    for (uint i = 0; i < cSharedTexts; ++i)
+    {
+      char* text = mSharedTexts.Data() + i * cTextSize;
+      PlasmaSPrintf(text, cTextSize, "Shared%u", i);
+      mSharedStrings.PushBack(String(text));
+    }
+  }
+
+  char* GetUniqueTexts(uint thread)
+  {
+    return mUniqueTexts.Data() + thread * cUniqueTexts * cTextSize;
+  }
+
+  // Best wall time of all the threads churning at once, in seconds
+  double Run(ChurnMode::Enum mode, uint threadCount)
+  {
+    double best = Math::DoublePositiveMax();
+    for (uint repetition = 0; repetition < cRepetitions; ++repetition)
+    {
+      OsEvent start;
+      start.Initialize(true, false);
+
+      Array<ChurnThread> churns(threadCount);
+      Array<Thread*> threads(threadCount);
+      for (uint i = 0; i < threadCount; ++i)
+      {
+        ChurnThread& churn = churns[i];
+        churn.mStart = &start;
+        churn.mMode = mode;
+        churn.mOperations = mOperations;
+        churn.mUniqueTexts = GetUniqueTexts(i);
+        churn.mSharedTexts = mSharedTexts.Data();
+        churn.mSharedStrings = &mSharedStrings;
+        churn.mChecksum = 0;
+        threads[i] = new Thread();
+        threads[i]->Initialize(Thread::ObjectEntryCreator<ChurnThread, &ChurnThread::Run>, &churn, "StringChurn");
+      }
+
+      // Release every thread at once so they contend for the pool
+      Timer timer;
+      timer.Reset();
+      start.Signal();
+      for (uint i = 0; i < threadCount; ++i)
+        threads[i]->WaitForCompletion();
+      best = Math::Min(best, timer.UpdateAndGetTime());
+
+      for (uint i = 0; i < threadCount; ++i)
+      {
+        threads[i]->Close();
+        delete threads[i];
+        mChecksum += churns[i].mChecksum;
+      }
+      start.Close();
+    }
+    return best;
+  }
+
+  uint mOperations;
+  Array<char> mUniqueTexts;
+  Array<char> mSharedTexts;
+  Array<String> mSharedStrings;
+  size_t mChecksum;
+};
+} // namespace
+
+extern "C" int main(int argc, char* argv[])
+{
+  CommandLineToStringArray(gCommandLineArguments, argv, argc);
+
+  // First parameter is exe path
+  uint maxThreads = cDefaultMaxThreads;
+  uint operations = cDefaultOperations;
+  if (gCommandLineArguments.Size() > 1)
+    ToValue(gCommandLineArguments[1], maxThreads);
+  if (gCommandLineArguments.Size() > 2)
+    ToValue(gCommandLineArguments[2], operations);
+
+  if (maxThreads == 0 || operations == 0)
+  {
+    printf("Usage: StringPoolBenchmark [<max threads>] [<operations per thread>]\n");
+    return 1;
+  }
+
+  if (!ThreadingEnabled)
+  {
+    printf("StringPoolBenchmark needs threading.\n");
+    return 1;
+  }
+
+  CommonLibrary::Initialize();
+
+  StdOutListener stdoutListener;
+  Console::Add(&stdoutListener);
+
+  {
+    StringChurn churn(maxThreads, operations);
+
+    PlasmaPrint("%u operations per thread (best of %u)\n", operations, cRepetitions);
+    PlasmaPrint("  %-7s %-15s %10s %10s %10s\n", "Threads", "Mode", "ms", "Mops/s", "Scaling");
+    for (uint mode = 0; mode < ChurnMode::Size; ++mode)
+    {
+      double singleSeconds = 0.0;
+      for (uint threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+      {
+        double seconds = churn.Run((ChurnMode::Enum)mode, threadCount);
+        if (threadCount == 1)
+          singleSeconds = seconds;
+
+        // Throughput relative to one thread, divided by the thread count
+        // (1.00 is perfect scaling)
+        double scaling = singleSeconds / seconds;
+        PlasmaPrint("  %-7u %-15s %10.2f %10.2f %10.2f\n",
+                    threadCount,
+                    ChurnMode::Names[mode],
+                    seconds * 1000.0,
+                    (double)operations * threadCount / seconds / 1e6,
+                    scaling);
+      }
+    }
+
+    PlasmaPrint("Checksum %llu\n", (u64)churn.mChecksum);
+  }
+
+  Console::Remove(&stdoutListener);
+  CommonLibrary::Shutdown();
+  return 0;
+}